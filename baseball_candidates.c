@@ -0,0 +1,114 @@
+/**
+ * baseball_candidates.c - 플레이어별 남은 후보 집합 추적 구현
+ *
+ * 📋 동작 순서:
+ * 1) 시작할 때 후보 720개를 나열하고 (추측 g, 결과 분류 c)마다
+ *    "비밀 숫자가 s였다면 g의 결과가 c였을" s들의 비트셋을 계산 (calculate_result 그대로 사용)
+ * 2) 비밀 숫자를 정하면 후보 집합을 전부 1로
+ * 3) 추측 결과가 나오면 후보 집합 &= 마스크[g][c] 후 popcount
+ *
+ * AND는 GCC 벡터 확장(256비트)으로 작성해 컴파일러가 대상 CPU에 맞는 명령으로 내린다
+ * (-march에 따라 AVX2 한 번 또는 SSE2 두 번, 그 밖의 CPU는 64비트 연산).
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+
+#include "baseball_candidates.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 상태
+// ──────────────────────────────────────────────────────────
+
+// CandidateSet은 8바이트 정렬만 보장되므로 벡터 타입도 정렬을 8로 낮춰 비정렬 접근을 허용
+typedef uint64_t CandidateVec __attribute__((vector_size(CANDIDATE_VEC_WORDS * 8), aligned(8), may_alias));
+
+_Static_assert(CANDIDATE_WORDS % CANDIDATE_VEC_WORDS == 0, "후보 비트셋은 벡터 크기의 배수여야 함");
+_Static_assert(CANDIDATE_WORDS * 64 >= CANDIDATE_COUNT, "후보 비트셋이 720비트보다 작음");
+
+static int built = 0;
+static char numbers[CANDIDATE_COUNT][NUMBER_LENGTH + 1];    // 후보 번호 → 숫자 문자열
+static int16_t index_of[1000];                              // 세 자리 값 → 후보 번호 (-1: 후보 아님)
+static CandidateSet all_candidates;                         // 720비트만 1
+static CandidateSet class_masks[CANDIDATE_COUNT][CANDIDATE_CLASSES];
+
+// (스트라이크, 볼) → 결과 분류 (-1: 나올 수 없는 조합)
+static const int8_t class_index[NUMBER_LENGTH + 1][NUMBER_LENGTH + 1] = {
+    { 0,  1,  2,  3 },
+    { 4,  5,  6, -1 },
+    { 7, -1, -1, -1 },
+    { 8, -1, -1, -1 },
+};
+
+static inline void set_bit(CandidateSet *set, int i) {
+    set->w[i / 64] |= 1ull << (i % 64);
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 함수들
+// ──────────────────────────────────────────────────────────
+
+void candidates_init(void) {
+    if (built) return;
+
+    int n = 0;
+    memset(index_of, -1, sizeof(index_of));
+    for (int a = 0; a <= 9; a++) {
+        for (int b = 0; b <= 9; b++) {
+            for (int c = 0; c <= 9; c++) {
+                if (a == b || b == c || a == c) continue;
+                snprintf(numbers[n], sizeof(numbers[n]), "%d%d%d", a, b, c);
+                index_of[a * 100 + b * 10 + c] = (int16_t)n;
+                set_bit(&all_candidates, n);
+                n++;
+            }
+        }
+    }
+
+    memset(class_masks, 0, sizeof(class_masks));
+    for (int g = 0; g < CANDIDATE_COUNT; g++) {
+        for (int s = 0; s < CANDIDATE_COUNT; s++) {
+            GuessResult r = calculate_result(numbers[s], numbers[g]);
+            set_bit(&class_masks[g][class_index[r.strikes][r.balls]], s);
+        }
+    }
+    built = 1;
+}
+
+int candidate_index(const char *number) {
+    if (!number) return -1;
+    int value = 0;
+    for (int i = 0; i < NUMBER_LENGTH; i++) {
+        if (number[i] < '0' || number[i] > '9') return -1;
+        value = value * 10 + (number[i] - '0');
+    }
+    if (number[NUMBER_LENGTH] != '\0') return -1;
+    return index_of[value];
+}
+
+void candidates_reset(CandidateSet *set) {
+    candidates_init();
+    *set = all_candidates;
+}
+
+int candidates_count(const CandidateSet *set) {
+    int count = 0;
+    for (int i = 0; i < CANDIDATE_WORDS; i++) count += __builtin_popcountll(set->w[i]);
+    return count;
+}
+
+int candidates_narrow(CandidateSet *set, const char *guess, int strikes, int balls) {
+    int g = candidate_index(guess);
+    if (g < 0 || strikes < 0 || strikes > NUMBER_LENGTH || balls < 0 || balls > NUMBER_LENGTH ||
+        class_index[strikes][balls] < 0) {
+        return candidates_count(set);
+    }
+    candidates_init();
+
+    CandidateVec *dst = (CandidateVec *)set->w;
+    const CandidateVec *mask = (const CandidateVec *)class_masks[g][class_index[strikes][balls]].w;
+    for (int i = 0; i < CANDIDATE_VECS; i++) dst[i] &= mask[i];
+    return candidates_count(set);
+}
@@ -0,0 +1,48 @@
+// baseball_candidates.h - 플레이어별 남은 후보(비밀 숫자) 집합 추적
+// 가능한 비밀 숫자 720개를 768비트 비트셋 하나로 표현하고,
+// 추측 결과가 나올 때마다 (추측, 스트라이크/볼) 결과 분류별로 미리 계산해 둔 마스크와 AND해서 좁힌다.
+// 추측 한 번에 256비트 벡터 AND 3번과 popcount 12번이면 끝나므로 게임 처리 경로에 부담이 없다.
+#ifndef BASEBALL_CANDIDATES_H
+#define BASEBALL_CANDIDATES_H
+
+#include <stdint.h>
+
+#include "baseball_protocol.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 결과 분류 상수
+// ──────────────────────────────────────────────────────────
+#define CANDIDATE_CLASSES       9       // 가능한 (스트라이크, 볼) 조합: 0S0B~0S3B, 1S0B~1S2B, 2S0B, 3S0B
+#define CANDIDATE_VEC_WORDS     4       // 벡터 하나 = uint64_t 4개 (256비트)
+#define CANDIDATE_VECS          (CANDIDATE_WORDS / CANDIDATE_VEC_WORDS)
+
+/**
+ * 마스크 테이블 생성 (720 × 9 마스크, 약 600KB - 여러 번 불러도 한 번만 계산)
+ * game_init()이 호출하므로 게임 모듈을 쓰는 쪽은 따로 부를 필요 없음
+ */
+void candidates_init(void);
+
+/**
+ * 후보 번호 (0~719)
+ * @return: 서로 다른 세 자리 숫자가 아니면 -1
+ */
+int candidate_index(const char *number);
+
+/**
+ * 720개 후보 모두 가능한 상태로 (비밀 숫자를 새로 정했을 때)
+ */
+void candidates_reset(CandidateSet *set);
+
+/**
+ * 남은 후보 수
+ */
+int candidates_count(const CandidateSet *set);
+
+/**
+ * 추측 결과로 후보 좁히기 (set &= 마스크[guess][결과 분류])
+ * @param guess: 추측 숫자 (검증된 세 자리)
+ * @return: 남은 후보 수 (guess나 결과가 범위를 벗어나면 좁히지 않고 현재 수)
+ */
+int candidates_narrow(CandidateSet *set, const char *guess, int strikes, int balls);
+
+#endif // BASEBALL_CANDIDATES_H
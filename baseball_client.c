@@ -14,6 +14,11 @@
  * - 직관적인 명령어 시스템
  * - 상세한 결과 시각화 (스트라이크/볼)
  * - 승리/패배 화면 연출
+ * - 프레임 버퍼 렌더러: 변경된 줄만 한 번의 write()로 출력 (깜빡임 방지)
+ * - 자동 재접속: 게임 중 연결이 끊기면 재접속 토큰으로 같은 좌석에 복귀
+ * - 리더보드: 접속 시 이름 등록, 'rank' 명령으로 상위 순위와 내 순위 조회
+ * - 관전 모드: -w 옵션으로 서버의 관전 포트에 접속해 진행 중인 경기를 읽기 전용으로 시청
+ * - 로컬 전송: 같은 호스트의 서버에는 unix:<경로> (AF_UNIX) 또는 shm:<경로> (공유 메모리 링)로 접속
  * 
  * 🔧 기술적 특징:
  * - 비동기 메시지 수신 처리
@@ -24,14 +29,20 @@
  * 네트워크 프로그래밍 과제용 - 고급 TCP 클라이언트 구현
  */
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 
 #include "baseball_protocol.h"
+#include "baseball_render.h"
+#include "baseball_scan.h"
+#include "baseball_shm.h"
 
 // ──────────────────────────────────────────────────────────
 // 클라이언트 게임 상태 전역 변수
@@ -40,87 +51,165 @@ int my_player_id = -1;      // 서버에서 할당받은 플레이어 ID (0 또
 int game_started = 0;       // 게임 시작 여부 (0: 대기중, 1: 시작됨)
 int number_set = 0;         // 내 숫자 설정 완료 여부 (0: 미설정, 1: 설정완료)
 int my_turn = 0;            // 현재 내 턴 여부 (0: 상대턴, 1: 내턴)
+char resume_token[RESUME_TOKEN_LEN + 1];  // 서버가 발급한 재접속 토큰
+char my_name[PLAYER_NAME_LEN + 1];        // 리더보드에 기록될 내 이름 (빈 문자열: 익명)
+int in_tournament = 0;      // 토너먼트 서버 접속 여부 (경기가 끝나도 다음 경기를 위해 연결 유지)
+int room_capacity = DEFAULT_ROOM_PLAYERS;  // 방 정원 (3명 이상이면 다인전 - 추측 대상 지정)
+int current_turn_player = -1;              // 현재 턴 플레이어 (-1: 모름)
+int player_out[MAX_CLIENTS];               // 다인전에서 숫자가 맞춰져 탈락한 플레이어
+int server_caps = 0;        // hello로 서버와 합의한 프로토콜 기능 (PROTO_CAP_*)
+
+#define CONN_LOST   -2      // handle_server_message: 연결 끊김 (재접속 시도 대상)
+
+void print_error_message(const char* message);  // 알림 영역에 오류 표시 (UI 계층)
+
+// ──────────────────────────────────────────────────────────
+// 화면 구성 상태 (프레임 렌더러가 매 갱신마다 이 상태로 화면을 다시 구성)
+// ──────────────────────────────────────────────────────────
+#define MAX_NOTICES 3       // 화면 하단에 유지할 최근 알림 개수
+
+typedef struct {
+    int valid;              // 표시할 결과가 있는지 여부
+    char guess[NUMBER_LENGTH + 1];
+    int strikes;
+    int balls;
+    int attempts;
+    int current_player;
+    int target;             // 추측 대상 플레이어
+    int eliminated;         // 이 추측으로 대상이 탈락했는지
+    int remaining;          // 대상의 남은 후보 수 (0: 서버가 보내지 않음)
+} LastResult;
+
+typedef struct {
+    int is_error;           // 1: 오류 알림, 0: 성공/안내 알림
+    char text[256];
+} Notice;
+
+int show_rules = 1;         // 규칙 안내 표시 여부 (게임 시작, help 명령 시)
+int waiting_opponent = 0;   // 상대방 접속 대기 중 여부
+int turn_known = 0;         // 턴 정보를 받았는지 여부 (턴 표시 패널 출력용)
+int game_result = 0;        // 게임 결과 (0: 진행 중, 1: 승리, -1: 패배)
+char final_my_number[NUMBER_LENGTH + 1];       // 게임 종료 시 공개된 내 숫자
+char final_opponent_number[NUMBER_LENGTH + 1]; // 게임 종료 시 공개된 상대 숫자
+LastResult last_result;     // 가장 최근 추측 결과
+Notice notices[MAX_NOTICES];
+int notice_count = 0;
+
+#define LEADERBOARD_SHOW_TOP 10  // 'rank' 명령으로 조회할 상위 인원
+int show_leaderboard = 0;   // 리더보드 패널 표시 여부 (다음 명령 입력 시 닫힘)
+char leaderboard_lines[LEADERBOARD_SHOW_TOP + 1][96];  // 상위 N명 + 내 순위
+int leaderboard_line_count = 0;
+
+// 관전 모드 상태 (서버의 spectate 스냅샷과 turn/game_over 알림으로 갱신)
+int spectating = 0;         // 관전 모드 여부 (-w 옵션, 읽기 전용)
+char spectate_state[16];    // 방 진행 단계 (waiting/setting/playing/finished)
+char spectate_names[MAX_CLIENTS][PLAYER_NAME_LEN + 1];
+int spectate_connected[MAX_CLIENTS];
+int spectate_away[MAX_CLIENTS];
+int spectate_attempts[MAX_CLIENTS];
+int spectate_turn = -1;     // 현재 턴 플레이어 (-1: 모름)
+int spectate_winner = -1;   // 승자 (-1: 진행 중)
+char spectate_numbers[MAX_CLIENTS][NUMBER_LENGTH + 1];  // 경기 종료 시 공개된 숫자
 
 // ──────────────────────────────────────────────────────────
 // JSON 송수신 함수들 (Network Communication Layer)
 // 서버와 동일한 프로토콜 사용: [2바이트 길이] + [JSON 문자열]
 // ──────────────────────────────────────────────────────────
 
+char send_buf[2 + BUF_SIZE];     // 송신 메시지 인코딩 버퍼 (encode_<name>()이 길이 prefix까지 기록)
+ShmChannel shm;                  // 공유 메모리 연결 (shm: 주소로 접속한 경우, region이 NULL이면 소켓 연결)
+
 /**
- * JSON 객체를 서버로 전송
- * 서버와 동일한 프로토콜 사용
+ * 인코딩한 메시지를 서버로 전송
+ * 서버와 동일한 프로토콜 사용 - 길이 prefix가 이미 붙어 있어 send() 한 번으로 전송
  * 
  * @param fd: 서버 소켓 파일 디스크립터
- * @param jobj: 전송할 JSON 객체
+ * @param len: encode_<name>(send_buf, ...)가 반환한 전체 길이 (0이면 인코딩 실패)
  * @return: 성공 시 0, 실패 시 -1
  */
-int send_json(int fd, struct json_object *jobj) {
-    const char *s = json_object_to_json_string(jobj);
-    int len = strlen(s);
-    uint16_t netlen = htons(len);  // 네트워크 바이트 순서로 변환
-    
-    // 1단계: 메시지 길이 전송 (2바이트)
-    if (send(fd, &netlen, sizeof(netlen), 0) != sizeof(netlen)) {
-        printf("🚨 서버 통신 오류: 메시지 길이 전송 실패\n");
+int send_frame(int fd, size_t len) {
+    if (len == 0) {
+        print_error_message("🚨 메시지가 너무 깁니다");
         return -1;
     }
-    
-    // 2단계: JSON 문자열 전송
-    if (send(fd, s, len, 0) != len) {
-        printf("🚨 서버 통신 오류: JSON 데이터 전송 실패\n");
+    if (shm.region) {
+        struct iovec iov = { .iov_base = send_buf, .iov_len = len };
+        if (shm_channel_writev(&shm, &iov, 1) != (ssize_t)len) {
+            print_error_message("🚨 서버 통신 오류: 메시지 전송 실패");
+            return -1;
+        }
+        return 0;
+    }
+    if (send(fd, send_buf, len, 0) != (ssize_t)len) {
+        print_error_message("🚨 서버 통신 오류: 메시지 전송 실패");
         return -1;
     }
-    
     return 0;
 }
 
 /**
- * 서버에서 JSON 객체 수신
+ * 지원하는 프로토콜 기능 알림 (서버가 응답한 hello의 caps만 사용)
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int send_hello(int fd) {
+    return send_frame(fd, encode_hello(send_buf, sizeof(send_buf), &(HelloMsg){ .caps = PROTO_CAP_TURN_RESULT }));
+}
+
+/**
+ * 서버에서 메시지 프레임 수신 (파싱은 호출자가 스캔 또는 json-c로)
  * 타임아웃과 부분 수신 처리 포함
  * 
  * @param fd: 서버 소켓 파일 디스크립터
- * @return: 수신된 JSON 객체 포인터, 실패 시 NULL
+ * @param buf: BUF_SIZE + 1 바이트 버퍼 (NUL 종료된 JSON 문자열 저장)
+ * @return: JSON 문자열 길이, 읽을 프레임이 없으면 0 (공유 메모리 연결), 실패 시 -1
  */
-struct json_object *recv_json(int fd) {
+int recv_frame(int fd, char *buf) {
     uint16_t netlen;
     
+    // 공유 메모리 연결: 링에는 완전한 프레임만 게시되므로 기다리지 않고 통째로 읽음
+    if (shm.region) {
+        int len = shm_channel_next_len(&shm);
+        if (len < 0) {
+            print_error_message("🔌 서버가 연결을 종료했습니다");
+            return -1;
+        }
+        if (len > 0) {
+            shm_channel_read(&shm, buf, len);
+            buf[len] = '\0';
+        }
+        return len;
+    }
+    
     // 1단계: 메시지 길이 수신 (2바이트, 완전 수신까지 대기)
     ssize_t n = recv(fd, &netlen, sizeof(netlen), MSG_WAITALL);
     if (n <= 0) {
         if (n == 0) {
-            printf("🔌 서버가 연결을 종료했습니다\n");
+            print_error_message("🔌 서버가 연결을 종료했습니다");
         } else {
-            printf("🚨 네트워크 오류: 메시지 길이 수신 실패\n");
+            print_error_message("🚨 네트워크 오류: 메시지 길이 수신 실패");
         }
-        return NULL;
+        return -1;
     }
     
     int len = ntohs(netlen);  // 호스트 바이트 순서로 변환
     
     // 길이 유효성 검사
     if (len <= 0 || len > BUF_SIZE) {
-        printf("🚨 프로토콜 오류: 잘못된 메시지 길이 (%d bytes)\n", len);
-        return NULL;
+        char err[128];
+        snprintf(err, sizeof(err), "🚨 프로토콜 오류: 잘못된 메시지 길이 (%d bytes)", len);
+        print_error_message(err);
+        return -1;
     }
     
     // 2단계: JSON 문자열 수신
-    char buf[BUF_SIZE + 1];
     n = recv(fd, buf, len, MSG_WAITALL);
     if (n <= 0) {
-        printf("🚨 네트워크 오류: JSON 데이터 수신 실패\n");
-        return NULL;
+        print_error_message("🚨 네트워크 오류: JSON 데이터 수신 실패");
+        return -1;
     }
     
     buf[len] = '\0';  // NULL terminator 추가
-    
-    // 3단계: JSON 파싱
-    struct json_object *jobj = json_tokener_parse(buf);
-    if (jobj == NULL) {
-        printf("🚨 프로토콜 오류: JSON 파싱 실패\n");
-        return NULL;
-    }
-    
-    return jobj;
+    return len;
 }
 
 // ──────────────────────────────────────────────────────────
@@ -130,10 +219,10 @@ struct json_object *recv_json(int fd) {
 
 /**
  * 터미널 화면 완전 초기화
- * ANSI 이스케이프 시퀀스를 사용한 화면 클리어
+ * 다음 프레임 출력 시 화면을 클리어하고 전체를 다시 그리도록 표시
  */
 void clear_screen() {
-    printf("\033[2J\033[H");  // 화면 클리어 및 커서 홈으로 이동
+    render_invalidate_all();
 }
 
 /**
@@ -141,18 +230,17 @@ void clear_screen() {
  * 야구 이모지와 박스 그래픽으로 시각적 임팩트 제공
  */
 void print_animated_banner() {
-    printf("\n");
-    printf("    ⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾\n");
-    printf("   ⚾                                                    ⚾\n");
-    printf("  ⚾     🎯 ✨ 숫자 야구 네트워크 게임 ✨ 🎯           ⚾\n");
-    printf(" ⚾                                                      ⚾\n");
-    printf("⚾        🔥 REAL-TIME NETWORK BASEBALL GAME 🔥          ⚾\n");
-    printf(" ⚾                                                      ⚾\n");
-    printf("  ⚾     ⭐ 1 vs 1 온라인 대전 ⭐                      ⚾\n");
-    printf("   ⚾                                                    ⚾\n");
-    printf("    ⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾\n");
-    printf("\n");
-    fflush(stdout);
+    render_printf("\n");
+    render_printf("    ⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾\n");
+    render_printf("   ⚾                                                    ⚾\n");
+    render_printf("  ⚾     🎯 ✨ 숫자 야구 네트워크 게임 ✨ 🎯           ⚾\n");
+    render_printf(" ⚾                                                      ⚾\n");
+    render_printf("⚾        🔥 REAL-TIME NETWORK BASEBALL GAME 🔥          ⚾\n");
+    render_printf(" ⚾                                                      ⚾\n");
+    render_printf("  ⚾     ⭐ 1 vs 1 온라인 대전 ⭐                      ⚾\n");
+    render_printf("   ⚾                                                    ⚾\n");
+    render_printf("    ⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾⚾\n");
+    render_printf("\n");
 }
 
 /**
@@ -160,20 +248,21 @@ void print_animated_banner() {
  * 로딩 바와 연결 상태를 시각적으로 표현
  */
 void print_welcome_screen() {
+    render_begin();
     clear_screen();
     print_animated_banner();
     
-    printf("╭─────────────────────────────────────────────────────────────╮\n");
-    printf("│  🌟 환영합니다! Welcome to Baseball Network Game! 🌟        │\n");
-    printf("├─────────────────────────────────────────────────────────────┤\n");
-    printf("│                                                             │\n");
-    printf("│  🎮 서버에 연결 중... 잠시만 기다려주세요!                    │\n");
-    printf("│                                                             │\n");
-    printf("│  💫 Connection Status: [████████████████████] 100%%         │\n");
-    printf("│                                                             │\n");
-    printf("╰─────────────────────────────────────────────────────────────╯\n");
-    printf("\n");
-    fflush(stdout);
+    render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+    render_printf("│  🌟 환영합니다! Welcome to Baseball Network Game! 🌟        │\n");
+    render_printf("├─────────────────────────────────────────────────────────────┤\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  🎮 서버에 연결 중... 잠시만 기다려주세요!                    │\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  💫 Connection Status: [████████████████████] 100%%         │\n");
+    render_printf("│                                                             │\n");
+    render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+    render_printf("\n");
+    render_commit();
     usleep(500000); // 0.5초 대기 (사용자 경험 향상)
 }
 
@@ -182,13 +271,13 @@ void print_welcome_screen() {
  * 일관된 게임 브랜딩과 시각적 정체성 제공
  */
 void print_game_header() {
-    printf("\n");
-    printf("╔═══════════════════════════════════════════════════════════════╗\n");
-    printf("║  🎯 ⚾ 숫자 야구 네트워크 게임 ⚾ 🎯                             ║\n");
-    printf("║                                                               ║\n");
-    printf("║  🔥 실시간 1:1 대전 🔥    💎 3자리 숫자 맞추기 💎              ║\n");
-    printf("╚═══════════════════════════════════════════════════════════════╝\n");
-    printf("\n");
+    render_printf("\n");
+    render_printf("╔═══════════════════════════════════════════════════════════════╗\n");
+    render_printf("║  🎯 ⚾ 숫자 야구 네트워크 게임 ⚾ 🎯                             ║\n");
+    render_printf("║                                                               ║\n");
+    render_printf("║  🔥 실시간 1:1 대전 🔥    💎 3자리 숫자 맞추기 💎              ║\n");
+    render_printf("╚═══════════════════════════════════════════════════════════════╝\n");
+    render_printf("\n");
 }
 
 /**
@@ -199,14 +288,21 @@ void print_game_header() {
  * @param status: 현재 상태 문자열
  */
 void print_player_status(int player_id, const char* status) {
-    printf("╭─────────────────────────────────────────────────────────────╮\n");
-    printf("│  👤 플레이어 정보                                             │\n");
-    printf("├─────────────────────────────────────────────────────────────┤\n");
-    printf("│  🆔 ID: %d                                                   │\n", player_id);
-    printf("│  🎭 역할: %s                                                 │\n", player_id == 0 ? "선공" : "후공");
-    printf("│  📊 상태: %s                                                 │\n", status);
-    printf("╰─────────────────────────────────────────────────────────────╯\n");
-    printf("\n");
+    render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+    render_printf("│  👤 플레이어 정보                                             │\n");
+    render_printf("├─────────────────────────────────────────────────────────────┤\n");
+    render_printf("│  🆔 ID: %d                                                   │\n", player_id);
+    char role[64];
+    if (room_capacity == 2) {
+        snprintf(role, sizeof(role), "%s", player_id == 0 ? "선공" : "후공");
+    } else {
+        snprintf(role, sizeof(role), "%d번째 순서 (%d인전)%s", player_id + 1, room_capacity,
+                 player_out[player_id] ? " - 탈락" : "");
+    }
+    render_printf("│  🎭 역할: %s                                                 │\n", role);
+    render_printf("│  📊 상태: %s                                                 │\n", status);
+    render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+    render_printf("\n");
 }
 
 /**
@@ -214,55 +310,51 @@ void print_player_status(int player_id, const char* status) {
  * 새로운 사용자도 쉽게 이해할 수 있도록 상세한 가이드 제공
  */
 void print_game_rules() {
-    printf("╭─────────────────────────────────────────────────────────────╮\n");
-    printf("│  📋 숫자야구 게임 완전 가이드 📋                              │\n");
-    printf("├─────────────────────────────────────────────────────────────┤\n");
-    printf("│                                                             │\n");
-    printf("│  🎯 게임 목표:                                               │\n");
-    printf("│     상대방보다 먼저 3자리 비밀번호를 맞추면 승리!              │\n");
-    printf("│                                                             │\n");
-    printf("│  📝 게임 순서:                                               │\n");
-    printf("│     1️⃣ 각자 3자리 서로 다른 숫자 설정 (예: 123, 456)         │\n");
-    printf("│     2️⃣ 번갈아가며 상대방 숫자 추측                           │\n");
-    printf("│     3️⃣ 결과 확인 후 다음 추측 진행                           │\n");
-    printf("│     4️⃣ 3 스트라이크 먼저 내는 사람이 승리!                   │\n");
-    printf("│                                                             │\n");
-    printf("│  📊 결과 해석 (중요!):                                       │\n");
-    printf("│     ⚡ 스트라이크: 숫자와 위치가 모두 정확                     │\n");
-    printf("│        예) 정답 123, 추측 120 → 1, 2가 정확한 위치 = 2S     │\n");
-    printf("│     🔮 볼: 숫자는 맞지만 위치가 틀림                          │\n");
-    printf("│        예) 정답 123, 추측 321 → 모든 숫자 있지만 위치 틀림 = 3B │\n");
-    printf("│     💫 아웃: 맞는 숫자가 하나도 없음                          │\n");
-    printf("│        예) 정답 123, 추측 456 → 공통 숫자 없음 = 0S 0B      │\n");
-    printf("│                                                             │\n");
-    printf("│  💻 사용 명령어:                                             │\n");
-    printf("│     🔹 set 123     - 내 비밀번호 설정 (서로 다른 3자리)       │\n");
-    printf("│     🔹 guess 456   - 상대방 번호 추측 (내 턴일 때만)          │\n");
-    printf("│     🔹 help        - 이 도움말 다시 보기                     │\n");
-    printf("│     🔹 quit        - 게임 종료하고 나가기                     │\n");
-    printf("│                                                             │\n");
-    printf("│  ⚠️  주의사항:                                               │\n");
-    printf("│     • 같은 숫자 중복 사용 금지! (111, 223 등 불가)            │\n");
-    printf("│     • 0으로 시작하는 숫자 가능 (012, 034 등 가능)             │\n");
-    printf("│     • 턴제 게임이므로 상대방 턴에는 대기해야 함               │\n");
-    printf("│                                                             │\n");
-    printf("╰─────────────────────────────────────────────────────────────╯\n");
-    printf("\n");
+    render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+    render_printf("│  📋 숫자야구 게임 완전 가이드 📋                              │\n");
+    render_printf("├─────────────────────────────────────────────────────────────┤\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  🎯 게임 목표:                                               │\n");
+    render_printf("│     상대방보다 먼저 3자리 비밀번호를 맞추면 승리!              │\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  📝 게임 순서:                                               │\n");
+    render_printf("│     1️⃣ 각자 3자리 서로 다른 숫자 설정 (예: 123, 456)         │\n");
+    render_printf("│     2️⃣ 번갈아가며 상대방 숫자 추측                           │\n");
+    render_printf("│     3️⃣ 결과 확인 후 다음 추측 진행                           │\n");
+    render_printf("│     4️⃣ 3 스트라이크 먼저 내는 사람이 승리!                   │\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  📊 결과 해석 (중요!):                                       │\n");
+    render_printf("│     ⚡ 스트라이크: 숫자와 위치가 모두 정확                     │\n");
+    render_printf("│        예) 정답 123, 추측 120 → 1, 2가 정확한 위치 = 2S     │\n");
+    render_printf("│     🔮 볼: 숫자는 맞지만 위치가 틀림                          │\n");
+    render_printf("│        예) 정답 123, 추측 321 → 모든 숫자 있지만 위치 틀림 = 3B │\n");
+    render_printf("│     💫 아웃: 맞는 숫자가 하나도 없음                          │\n");
+    render_printf("│        예) 정답 123, 추측 456 → 공통 숫자 없음 = 0S 0B      │\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  💻 사용 명령어:                                             │\n");
+    render_printf("│     🔹 set 123     - 내 비밀번호 설정 (서로 다른 3자리)       │\n");
+    render_printf("│     🔹 guess 456   - 상대방 번호 추측 (내 턴일 때만)          │\n");
+    render_printf("│     🔹 guess 456 3 - 다인전: 3번 플레이어의 번호 추측         │\n");
+    render_printf("│     🔹 rank        - 리더보드 (상위 10명 + 내 순위)          │\n");
+    render_printf("│     🔹 help        - 이 도움말 다시 보기                     │\n");
+    render_printf("│     🔹 quit        - 게임 종료하고 나가기                     │\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  ⚠️  주의사항:                                               │\n");
+    render_printf("│     • 같은 숫자 중복 사용 금지! (111, 223 등 불가)            │\n");
+    render_printf("│     • 0으로 시작하는 숫자 가능 (012, 034 등 가능)             │\n");
+    render_printf("│     • 턴제 게임이므로 상대방 턴에는 대기해야 함               │\n");
+    render_printf("│                                                             │\n");
+    render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+    render_printf("\n");
 }
 
 /**
- * 상대방 대기 중 애니메이션 출력
- * 동적인 점 애니메이션으로 대기 상태를 시각화
+ * 상대방 대기 중 안내 출력
+ * 프레임 단위로 그려지므로 블로킹 애니메이션 대신 고정 문구 사용
  */
 void print_waiting_animation() {
-    printf("  ⏳ 상대방을 기다리는 중");
-    for (int i = 0; i < 3; i++) {
-        printf(".");
-        fflush(stdout);
-        usleep(200000); // 0.2초 대기
-    }
-    printf(" 🎭\n");
-    printf("  💫 곧 상대방이 접속할 예정입니다! 조금만 기다려주세요~\n\n");
+    render_printf("  ⏳ 상대방을 기다리는 중... 🎭\n");
+    render_printf("  💫 곧 상대방이 접속할 예정입니다! 조금만 기다려주세요~\n\n");
 }
 
 /**
@@ -272,27 +364,55 @@ void print_waiting_animation() {
  * @param is_my_turn: 내 턴 여부 (1: 내턴, 0: 상대턴)
  */
 void print_turn_indicator(int is_my_turn) {
+    if (!is_my_turn && room_capacity > 2 && current_turn_player >= 0) {
+        // 다인전: 누구의 턴인지 표시
+        render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+        render_printf("│  ⏰ 플레이어 %d의 턴 - 대기 중... WAITING... ⏰\n", current_turn_player + 1);
+        render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+        render_printf("\n");
+        return;
+    }
     if (is_my_turn) {
-        printf("╭─────────────────────────────────────────────────────────────╮\n");
-        printf("│  🎯 당신의 턴입니다! YOUR TURN! 🎯                           │\n");
-        printf("├─────────────────────────────────────────────────────────────┤\n");
-        printf("│                                                             │\n");
-        printf("│  🔥 상대방의 숫자를 추측해보세요!                            │\n");
-        printf("│  💡 명령어: guess <3자리숫자>                               │\n");
-        printf("│  📝 예시: guess 123, guess 456                             │\n");
-        printf("│                                                             │\n");
-        printf("╰─────────────────────────────────────────────────────────────╯\n");
+        render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+        render_printf("│  🎯 당신의 턴입니다! YOUR TURN! 🎯                           │\n");
+        render_printf("├─────────────────────────────────────────────────────────────┤\n");
+        render_printf("│                                                             │\n");
+        render_printf("│  🔥 상대방의 숫자를 추측해보세요!                            │\n");
+        render_printf("│  💡 명령어: guess <3자리숫자>%s\n", room_capacity > 2 ? " [대상 번호]" : "                               │");
+        render_printf("│  📝 예시: guess 123, guess 456                             │\n");
+        render_printf("│                                                             │\n");
+        render_printf("╰─────────────────────────────────────────────────────────────╯\n");
     } else {
-        printf("╭─────────────────────────────────────────────────────────────╮\n");
-        printf("│  ⏰ 상대방의 턴 - 대기 중... WAITING... ⏰                   │\n");
-        printf("├─────────────────────────────────────────────────────────────┤\n");
-        printf("│                                                             │\n");
-        printf("│  🤔 상대방이 추측하고 있습니다...                            │\n");
-        printf("│  ☕ 커피 한 잔 하며 기다려보세요!                            │\n");
-        printf("│                                                             │\n");
-        printf("╰─────────────────────────────────────────────────────────────╯\n");
+        render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+        render_printf("│  ⏰ 상대방의 턴 - 대기 중... WAITING... ⏰                   │\n");
+        render_printf("├─────────────────────────────────────────────────────────────┤\n");
+        render_printf("│                                                             │\n");
+        render_printf("│  🤔 상대방이 추측하고 있습니다...                            │\n");
+        render_printf("│  ☕ 커피 한 잔 하며 기다려보세요!                            │\n");
+        render_printf("│                                                             │\n");
+        render_printf("╰─────────────────────────────────────────────────────────────╯\n");
     }
-    printf("\n");
+    render_printf("\n");
+}
+
+/**
+ * 결과 패널용 플레이어 표시 이름
+ * 1:1 플레이어 모드는 당신/상대방, 다인전과 관전 모드는 플레이어 번호 (관전 모드는 이름 포함)
+ */
+const char *player_label(int player_id) {
+    static char label[64];
+    if (!spectating && (room_capacity == 2 || player_id == my_player_id)) {
+        return (player_id == my_player_id) ? "🟢 당신" : "🔴 상대방";
+    }
+    if (player_id < 0 || player_id >= MAX_CLIENTS) return "플레이어";
+    if (!spectating) {
+        snprintf(label, sizeof(label), "🔴 플레이어 %d", player_id + 1);
+        return label;
+    }
+    const char *name = spectate_names[player_id];
+    snprintf(label, sizeof(label), "%s 플레이어 %d%s%s%s", player_id == 0 ? "🔵" : "🟠",
+             player_id + 1, name[0] ? " (" : "", name, name[0] ? ")" : "");
+    return label;
 }
 
 /**
@@ -307,105 +427,290 @@ void print_turn_indicator(int is_my_turn) {
  */
 void print_result_board(const char* guess, int strikes, int balls, int attempts, int current_player) {
     // 플레이어 구분 표시
-    const char* player_name = (current_player == my_player_id) ? "🟢 당신" : "🔴 상대방";
+    const char* player_name = player_label(current_player);
     
-    printf("╭─────────────────────────────────────────────────────────────╮\n");
-    printf("│  📊 %s의 추측 결과 - GUESS RESULT 📊                        │\n", player_name);
-    printf("├─────────────────────────────────────────────────────────────┤\n");
-    printf("│                                                             │\n");
-    printf("│  🎯 추측한 숫자: %s                                          │\n", guess);
-    printf("│                                                             │\n");
+    render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+    render_printf("│  📊 %s의 추측 결과 - GUESS RESULT 📊                        │\n", player_name);
+    render_printf("├─────────────────────────────────────────────────────────────┤\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  🎯 추측한 숫자: %s                                          │\n", guess);
+    if (room_capacity > 2) {
+        render_printf("│  🎯 추측 대상: %s\n", player_label(last_result.target));
+    }
+    render_printf("│                                                             │\n");
     
     // 스트라이크 시각화 (불꽃 이모지 사용)
-    printf("│  ⚡ 스트라이크: %d  ", strikes);
-    for (int i = 0; i < strikes; i++) printf("🔥");
-    for (int i = strikes; i < 3; i++) printf("⚪");
-    printf("                              │\n");
+    render_printf("│  ⚡ 스트라이크: %d  ", strikes);
+    for (int i = 0; i < strikes; i++) render_printf("🔥");
+    for (int i = strikes; i < 3; i++) render_printf("⚪");
+    render_printf("                              │\n");
     
     // 볼 시각화 (다이아몬드 이모지 사용)
-    printf("│  🔮 볼: %d         ", balls);
-    for (int i = 0; i < balls; i++) printf("💎");
-    for (int i = balls; i < 3; i++) printf("⚫");
-    printf("                              │\n");
+    render_printf("│  🔮 볼: %d         ", balls);
+    for (int i = 0; i < balls; i++) render_printf("💎");
+    for (int i = balls; i < 3; i++) render_printf("⚫");
+    render_printf("                              │\n");
+    
+    // 이 결과까지 반영한 남은 후보 수 (서버가 추적)
+    if (last_result.remaining > 0) {
+        render_printf("│  🔎 남은 후보: %3d / %d개                                  │\n",
+                      last_result.remaining, CANDIDATE_COUNT);
+    }
     
-    printf("│                                                             │\n");
-    printf("│  📈 %s 시도 횟수: %d번                                      │\n", 
-           (current_player == my_player_id) ? "당신의" : "상대방", attempts);
-    printf("│                                                             │\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  📈 %s 시도 횟수: %d번                                      │\n", 
+           spectating ? player_name : (current_player == my_player_id) ? "당신의" : "상대방", attempts);
+    render_printf("│                                                             │\n");
     
     // 정답인 경우 축하 메시지
-    if (strikes == 3) {
-        if (current_player == my_player_id) {
-            printf("│  🎊🎊🎊 축하합니다! 당신이 정답을 맞췄습니다! 🎊🎊🎊         │\n");
+    if (strikes == 3 && room_capacity > 2 && game_result == 0) {
+        // 다인전: 대상만 탈락하고 게임은 계속
+        render_printf("│  💥 %s 탈락!\n", player_label(last_result.target));
+    } else if (strikes == 3) {
+        if (spectating) {
+            render_printf("│  🏁🏁🏁 %s 정답! 🏁🏁🏁\n", player_name);
+        } else if (current_player == my_player_id) {
+            render_printf("│  🎊🎊🎊 축하합니다! 당신이 정답을 맞췄습니다! 🎊🎊🎊         │\n");
         } else {
-            printf("│  😢😢😢 아쉽게도 상대방이 정답을 맞췄습니다... 😢😢😢        │\n");
+            render_printf("│  😢😢😢 아쉽게도 상대방이 정답을 맞췄습니다... 😢😢😢        │\n");
         }
     }
     
-    printf("╰─────────────────────────────────────────────────────────────╯\n");
-    printf("\n");
+    render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+    render_printf("\n");
 }
 
 void print_victory_screen() {
-    printf("\n\n");
-    printf("    🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊\n");
-    printf("   🎊                                                    🎊\n");
-    printf("  🎊     🏆✨ VICTORY! 승리! CONGRATULATIONS! ✨🏆       🎊\n");
-    printf(" 🎊                                                      🎊\n");
-    printf("🎊        🎯 YOU ARE THE BASEBALL CHAMPION! 🎯           🎊\n");
-    printf(" 🎊                                                      🎊\n");
-    printf("  🎊     🌟 최고의 추리 실력을 보여주셨습니다! 🌟          🎊\n");
-    printf("   🎊                                                    🎊\n");
-    printf("    🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊\n");
-    printf("\n");
+    render_printf("\n\n");
+    render_printf("    🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊\n");
+    render_printf("   🎊                                                    🎊\n");
+    render_printf("  🎊     🏆✨ VICTORY! 승리! CONGRATULATIONS! ✨🏆       🎊\n");
+    render_printf(" 🎊                                                      🎊\n");
+    render_printf("🎊        🎯 YOU ARE THE BASEBALL CHAMPION! 🎯           🎊\n");
+    render_printf(" 🎊                                                      🎊\n");
+    render_printf("  🎊     🌟 최고의 추리 실력을 보여주셨습니다! 🌟          🎊\n");
+    render_printf("   🎊                                                    🎊\n");
+    render_printf("    🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊🎊\n");
+    render_printf("\n");
 }
 
 void print_defeat_screen() {
-    printf("\n\n");
-    printf("    😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢\n");
-    printf("   😢                                                    😢\n");
-    printf("  😢     💪 아쉽지만 좋은 경기였습니다! 💪                  😢\n");
-    printf(" 😢                                                      😢\n");
-    printf("😢        🔥 다음번엔 더 잘할 수 있을 거예요! 🔥           😢\n");
-    printf(" 😢                                                      😢\n");
-    printf("  😢     ⭐ 포기하지 마세요! 재도전하세요! ⭐               😢\n");
-    printf("   😢                                                    😢\n");
-    printf("    😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢\n");
-    printf("\n");
+    render_printf("\n\n");
+    render_printf("    😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢\n");
+    render_printf("   😢                                                    😢\n");
+    render_printf("  😢     💪 아쉽지만 좋은 경기였습니다! 💪                  😢\n");
+    render_printf(" 😢                                                      😢\n");
+    render_printf("😢        🔥 다음번엔 더 잘할 수 있을 거예요! 🔥           😢\n");
+    render_printf(" 😢                                                      😢\n");
+    render_printf("  😢     ⭐ 포기하지 마세요! 재도전하세요! ⭐               😢\n");
+    render_printf("   😢                                                    😢\n");
+    render_printf("    😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢😢\n");
+    render_printf("\n");
 }
 
 void print_game_over_info(const char* my_number, const char* opponent_number) {
-    printf("╭─────────────────────────────────────────────────────────────╮\n");
-    printf("│  📝 게임 결과 - FINAL RESULT 📝                              │\n");
-    printf("├─────────────────────────────────────────────────────────────┤\n");
-    printf("│                                                             │\n");
-    printf("│  🔐 당신의 숫자:   %s                                       │\n", my_number);
-    printf("│  🎭 상대방 숫자:   %s                                       │\n", opponent_number);
-    printf("│                                                             │\n");
-    printf("│  💡 잘 기억해두세요! 다음 게임에 도움이 될 거예요!            │\n");
-    printf("│                                                             │\n");
-    printf("╰─────────────────────────────────────────────────────────────╯\n");
-    printf("\n");
+    render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+    render_printf("│  📝 게임 결과 - FINAL RESULT 📝                              │\n");
+    render_printf("├─────────────────────────────────────────────────────────────┤\n");
+    render_printf("│                                                             │\n");
+    render_printf("│  🔐 당신의 숫자:   %s                                       │\n", my_number);
+    render_printf("│  🎭 상대방 숫자:   %s                                       │\n", opponent_number);
+    render_printf("│                                                             │\n");
+    render_printf("│  💡 잘 기억해두세요! 다음 게임에 도움이 될 거예요!            │\n");
+    render_printf("│                                                             │\n");
+    render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+    render_printf("\n");
 }
 
 void print_input_prompt() {
-    printf("┌─ 💬 명령어 입력 ─────────────────────────────────────────────┐\n");
-    printf("│  ");
-    fflush(stdout);
+    render_printf("┌─ 💬 명령어 입력 ─────────────────────────────────────────────┐\n");
+    render_printf("│  ");
+}
+
+/**
+ * 알림 추가 (최근 MAX_NOTICES개만 유지, 다음 프레임에 표시)
+ * @param is_error: 오류 알림 여부
+ * @param message: 알림 내용
+ */
+void push_notice(int is_error, const char* message) {
+    if (notice_count == MAX_NOTICES) {
+        memmove(&notices[0], &notices[1], sizeof(Notice) * (MAX_NOTICES - 1));
+        notice_count--;
+    }
+    notices[notice_count].is_error = is_error;
+    snprintf(notices[notice_count].text, sizeof(notices[notice_count].text), "%s", message);
+    notice_count++;
 }
 
 void print_success_message(const char* message) {
-    printf("┌─ ✅ 성공 ──────────────────────────────────────────────────┐\n");
-    printf("│  %s\n", message);
-    printf("└─────────────────────────────────────────────────────────────┘\n");
-    printf("\n");
+    push_notice(0, message);
 }
 
 void print_error_message(const char* message) {
-    printf("┌─ ❌ 오류 ──────────────────────────────────────────────────┐\n");
-    printf("│  %s\n", message);
-    printf("└─────────────────────────────────────────────────────────────┘\n");
-    printf("\n");
+    push_notice(1, message);
+}
+
+/**
+ * 누적된 알림 박스 출력
+ */
+void print_notices() {
+    for (int i = 0; i < notice_count; i++) {
+        if (notices[i].is_error) {
+            render_printf("┌─ ❌ 오류 ──────────────────────────────────────────────────┐\n");
+        } else {
+            render_printf("┌─ ✅ 성공 ──────────────────────────────────────────────────┐\n");
+        }
+        render_printf("│  %s\n", notices[i].text);
+        render_printf("└─────────────────────────────────────────────────────────────┘\n");
+    }
+    if (notice_count > 0) render_printf("\n");
+}
+
+/**
+ * 관전 패널 출력 (양쪽 플레이어 상태, 현재 턴, 경기 결과)
+ */
+void print_spectator_panel() {
+    const char *stage = "상대를 기다리는 중 ⏳";
+    if (strcmp(spectate_state, "setting") == 0) stage = "숫자 설정 중 ✍️";
+    else if (strcmp(spectate_state, "playing") == 0) stage = "경기 진행 중 ⚾";
+    else if (strcmp(spectate_state, "finished") == 0) stage = "경기 종료 🏁";
+
+    render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+    render_printf("│  👀 관전 모드 - SPECTATOR 👀                                  │\n");
+    render_printf("├─────────────────────────────────────────────────────────────┤\n");
+    render_printf("│  📊 상태: %s\n", stage);
+    for (int i = 0; i < room_capacity; i++) {
+        const char *conn = player_out[i] ? "탈락"
+                         : !spectate_connected[i] ? (spectate_away[i] ? "재접속 대기" : "빈 자리")
+                                                  : "접속 중";
+        render_printf("│  %s  %s  시도 %d회%s\n", player_label(i), conn, spectate_attempts[i],
+                      (spectate_winner < 0 && spectate_turn == i &&
+                       strcmp(spectate_state, "playing") == 0) ? "  ◀ 추측 중" : "");
+    }
+    if (spectate_winner >= 0) {
+        render_printf("├─────────────────────────────────────────────────────────────┤\n");
+        render_printf("│  🏆 승자: %s\n", player_label(spectate_winner));
+        for (int i = 0; i < room_capacity; i++) {
+            render_printf("│  🔐 플레이어 %d의 숫자: %s\n", i + 1,
+                          spectate_numbers[i][0] ? spectate_numbers[i] : "-");
+        }
+    }
+    render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+    render_printf("\n");
+}
+
+/**
+ * 리더보드 패널 출력
+ */
+void print_leaderboard() {
+    render_printf("╭─────────────────────────────────────────────────────────────╮\n");
+    render_printf("│  🏆 리더보드 - LEADERBOARD 🏆                                │\n");
+    render_printf("├─────────────────────────────────────────────────────────────┤\n");
+    if (leaderboard_line_count == 0) {
+        render_printf("│  아직 기록된 경기가 없습니다.\n");
+    }
+    for (int i = 0; i < leaderboard_line_count; i++) {
+        render_printf("│  %s\n", leaderboard_lines[i]);
+    }
+    render_printf("╰─────────────────────────────────────────────────────────────╯\n");
+    render_printf("\n");
+}
+
+/**
+ * 턴 변경 반영 (turn 알림, turn_result의 다음 턴)
+ * @param current: 이번 턴 플레이어
+ */
+void apply_turn(int current) {
+    spectate_turn = current_turn_player = current;
+    snprintf(spectate_state, sizeof(spectate_state), "playing");
+    if (!spectating) {
+        my_turn = (current_turn_player == my_player_id);
+        turn_known = 1;
+        show_rules = 0;  // 턴 진행 중에는 결과/턴 패널만 갱신
+    }
+}
+
+/**
+ * 추측 결과 반영 (guess_result, turn_result 공통 필드)
+ */
+void apply_guess_result(const ServerMsg *m) {
+    const uint32_t required = SMSG_GUESS | SMSG_STRIKES | SMSG_BALLS | SMSG_ATTEMPTS | SMSG_CURRENT_PLAYER;
+    if ((m->fields & required) != required) return;
+    
+    snprintf(last_result.guess, sizeof(last_result.guess), "%s", m->guess);
+    last_result.strikes = m->strikes;
+    last_result.balls = m->balls;
+    last_result.attempts = m->attempts;
+    last_result.current_player = m->current_player;
+    last_result.target = (m->fields & SMSG_TARGET) ? m->target : -1;
+    last_result.eliminated = (m->fields & SMSG_ELIMINATED) ? m->eliminated : 0;
+    last_result.remaining = (m->fields & SMSG_REMAINING) ? m->remaining : 0;
+    last_result.valid = 1;
+    
+    // 다인전 탈락 처리 (내 숫자가 맞춰지면 남은 경기는 지켜보기만 함)
+    if (last_result.eliminated && last_result.target >= 0 && last_result.target < MAX_CLIENTS) {
+        player_out[last_result.target] = 1;
+        if (!spectating && last_result.target == my_player_id && room_capacity > 2) {
+            print_error_message("💥 내 숫자가 맞춰져 탈락했습니다! 남은 경기를 지켜보세요.");
+        }
+    }
+    if (spectating && last_result.current_player >= 0 && last_result.current_player < MAX_CLIENTS) {
+        spectate_attempts[last_result.current_player] = last_result.attempts;
+    }
+}
+
+/**
+ * 현재 화면 상태로 한 프레임을 구성하여 출력
+ * 이전 프레임과 달라진 줄만 한 번의 write()로 터미널에 반영됨
+ */
+void draw_screen() {
+    render_begin();
+    print_game_header();
+
+    if (spectating) {
+        print_spectator_panel();
+        if (last_result.valid) {
+            print_result_board(last_result.guess, last_result.strikes, last_result.balls,
+                               last_result.attempts, last_result.current_player);
+        }
+        print_notices();
+        render_printf("  💬 'quit' 입력 시 관전을 종료합니다.\n");
+        render_commit();
+        return;
+    }
+
+    if (my_player_id >= 0) {
+        const char *status = "연결됨 ✅";
+        if (game_result != 0) status = "게임 종료 🏁";
+        else if (turn_known) status = "게임 진행 중 ⚾";
+        else if (number_set) status = "숫자 설정 완료 🔐";
+        else if (game_started) status = "숫자 설정 중 ✍️";
+        print_player_status(my_player_id, status);
+    }
+
+    if (show_rules) print_game_rules();
+    if (waiting_opponent) print_waiting_animation();
+
+    if (last_result.valid) {
+        print_result_board(last_result.guess, last_result.strikes, last_result.balls,
+                           last_result.attempts, last_result.current_player);
+    }
+
+    if (game_result > 0) {
+        print_victory_screen();
+    } else if (game_result < 0) {
+        print_defeat_screen();
+    }
+    if (game_result != 0 && final_my_number[0] && final_opponent_number[0]) {
+        print_game_over_info(final_my_number, final_opponent_number);
+    } else if (turn_known && game_result == 0) {
+        print_turn_indicator(my_turn);
+    }
+
+    if (show_leaderboard) print_leaderboard();
+    print_notices();
+    if (game_result == 0) print_input_prompt();
+    render_commit();
 }
 
 // ──────────────────────────────────────────────────────────
@@ -413,31 +718,52 @@ void print_error_message(const char* message) {
 // ──────────────────────────────────────────────────────────
 int handle_user_input(int sockfd) {
     char input[256];
-    print_input_prompt();
     
     if (!fgets(input, sizeof(input), stdin)) {
         return -1; // EOF
     }
     
-    printf("└─────────────────────────────────────────────────────────────┘\n\n");
+    // 터미널 에코로 바뀐 프롬프트 줄은 다음 프레임에서 다시 그림
+    render_invalidate_from_cursor();
     
     // 줄바꿈 제거
     input[strcspn(input, "\n")] = '\0';
     
+    // 리더보드 패널은 다음 명령까지만 표시
+    show_leaderboard = 0;
+    
     // 빈 입력
     if (strlen(input) == 0) {
+        draw_screen();
         return 0;
     }
     
     // quit 명령
     if (strcmp(input, "quit") == 0) {
-        printf("🚪 게임을 종료합니다... 안녕히 가세요! 👋\n");
+        print_success_message("🚪 게임을 종료합니다... 안녕히 가세요! 👋");
+        draw_screen();
         return -1;
     }
     
+    // 관전 모드는 읽기 전용
+    if (spectating) {
+        print_error_message("관전 모드에서는 'quit'만 사용할 수 있습니다.");
+        draw_screen();
+        return 0;
+    }
+    
     // help 명령
     if (strcmp(input, "help") == 0) {
-        print_game_rules();
+        show_rules = 1;
+        draw_screen();
+        return 0;
+    }
+    
+    // rank 명령 (리더보드 조회)
+    if (strcmp(input, "rank") == 0) {
+        send_frame(sockfd, encode_leaderboard(send_buf, sizeof(send_buf),
+                                              &(LeaderboardMsg){ .top = LEADERBOARD_SHOW_TOP }));
+        draw_screen();
         return 0;
     }
     
@@ -445,25 +771,24 @@ int handle_user_input(int sockfd) {
     if (strncmp(input, "set ", 4) == 0) {
         if (number_set) {
             print_error_message("이미 숫자를 설정했습니다!");
+            draw_screen();
             return 0;
         }
         
         char *number = input + 4;
         
         if (!is_valid_number(number)) {
-            print_error_message("올바르지 않은 숫자입니다! 3자리 서로 다른 숫자를 입력하세요.");
-            printf("   💡 예시: set 123, set 789\n\n");
+            print_error_message("올바르지 않은 숫자입니다! 3자리 서로 다른 숫자를 입력하세요. (💡 예시: set 123)");
+            draw_screen();
             return 0;
         }
         
-        struct json_object *jmsg = create_message(ACTION_SET_NUMBER);
-        json_object_object_add(jmsg, "number", json_object_new_string(number));
-        send_json(sockfd, jmsg);
-        json_object_put(jmsg);
+        send_frame(sockfd, encode_set_number(send_buf, sizeof(send_buf), &(SetNumberMsg){ .number = number }));
         
         char success_msg[100];
         snprintf(success_msg, sizeof(success_msg), "숫자를 설정했습니다: %s ✨", number);
         print_success_message(success_msg);
+        draw_screen();
         return 0;
     }
     
@@ -471,27 +796,40 @@ int handle_user_input(int sockfd) {
     if (strncmp(input, "guess ", 6) == 0) {
         if (!my_turn) {
             print_error_message("지금은 당신의 턴이 아닙니다!");
+            draw_screen();
             return 0;
         }
         
+        // guess <숫자> [대상 번호] - 대상을 생략하면 서버가 다음 순서의 플레이어로 지정
         char *guess = input + 6;
+        int target = -1;
+        char *space = strchr(guess, ' ');
+        if (space) {
+            *space = '\0';
+            target = atoi(space + 1) - 1;
+            if (target < 0 || target >= room_capacity || target == my_player_id) {
+                print_error_message("추측 대상 번호가 올바르지 않습니다! (💡 예시: guess 123 3)");
+                draw_screen();
+                return 0;
+            }
+        }
         
         if (!is_valid_number(guess)) {
-            print_error_message("올바르지 않은 숫자입니다! 3자리 서로 다른 숫자를 입력하세요.");
-            printf("   💡 예시: guess 123, guess 789\n\n");
+            print_error_message("올바르지 않은 숫자입니다! 3자리 서로 다른 숫자를 입력하세요. (💡 예시: guess 123)");
+            draw_screen();
             return 0;
         }
         
-        struct json_object *jmsg = create_message(ACTION_GUESS);
-        json_object_object_add(jmsg, "guess", json_object_new_string(guess));
-        send_json(sockfd, jmsg);
-        json_object_put(jmsg);
+        send_frame(sockfd, encode_guess(send_buf, sizeof(send_buf),
+                                        &(GuessMsg){ .guess = guess, .target = target }));
         
+        draw_screen();
         return 0;
     }
     
     // 알 수 없는 명령
     print_error_message("알 수 없는 명령어입니다. 'help'를 입력하여 도움말을 확인하세요.");
+    draw_screen();
     return 0;
 }
 
@@ -499,43 +837,138 @@ int handle_user_input(int sockfd) {
 // 서버 메시지 처리
 // ──────────────────────────────────────────────────────────
 int handle_server_message(int sockfd) {
-    struct json_object *jmsg = recv_json(sockfd);
-    if (!jmsg) {
+    char buf[BUF_SIZE + 1];
+    int len = recv_frame(sockfd, buf);
+    if (len == 0) return 0;  // 이미 읽은 프레임의 깨우기만 남은 경우
+    
+    // 고정 필드는 수신 버퍼에서 바로 스캔, 배열 필드가 있는 메시지(스냅샷, 리더보드 등)만 json-c로 파싱
+    ServerMsg m;
+    struct json_object *jmsg = NULL;
+    if (len >= 0 && scan_server_msg(buf, len, &m) != SCAN_OK) {
+        jmsg = json_tokener_parse(buf);
+        if (jmsg) {
+            server_msg_from_json(jmsg, &m);
+        } else {
+            print_error_message("🚨 프로토콜 오류: JSON 파싱 실패");
+            len = -1;
+        }
+    }
+    if (len < 0) {
         print_error_message("서버와의 연결이 끊어졌습니다.");
-        return -1;
+        draw_screen();
+        return CONN_LOST;
     }
     
-    struct json_object *jact = NULL;
-    if (!json_object_object_get_ex(jmsg, "action", &jact)) {
+    if (!(m.fields & SMSG_ACTION)) {
         json_object_put(jmsg);
         return 0;
     }
     
-    const char *action = json_object_get_string(jact);
+    const char *action = m.action;
+    
+    // 관전: 방 상태 스냅샷
+    if (strcmp(action, ACTION_SPECTATE) == 0) {
+        struct json_object *jval = NULL, *jplayers = NULL;
+        if (m.fields & SMSG_STATE) {
+            snprintf(spectate_state, sizeof(spectate_state), "%s", m.state);
+        }
+        if (m.fields & SMSG_CURRENT_PLAYER) {
+            spectate_turn = m.current_player;
+        }
+        if (m.fields & SMSG_CAPACITY) {
+            room_capacity = m.capacity;
+        }
+        if (jmsg && json_object_object_get_ex(jmsg, "players", &jplayers)) {
+            int n = json_object_array_length(jplayers);
+            for (int i = 0; i < n && i < MAX_CLIENTS; i++) {
+                struct json_object *jp = json_object_array_get_idx(jplayers, i);
+                if (json_object_object_get_ex(jp, "name", &jval)) {
+                    snprintf(spectate_names[i], sizeof(spectate_names[i]), "%s", json_object_get_string(jval));
+                }
+                if (json_object_object_get_ex(jp, "connected", &jval)) spectate_connected[i] = json_object_get_int(jval);
+                if (json_object_object_get_ex(jp, "away", &jval)) spectate_away[i] = json_object_get_int(jval);
+                if (json_object_object_get_ex(jp, "attempts", &jval)) spectate_attempts[i] = json_object_get_int(jval);
+                if (json_object_object_get_ex(jp, "out", &jval)) player_out[i] = json_object_get_int(jval);
+            }
+        }
+        // 새 경기 준비/시작 시 이전 경기 결과 정리
+        if (strcmp(spectate_state, "waiting") == 0 || strcmp(spectate_state, "setting") == 0) {
+            spectate_winner = -1;
+            last_result.valid = 0;
+        }
+    }
+    
+    // 턴 변경 (방 전체 공유 알림 - 턴 플레이어는 your_turn도 따로 받음)
+    else if (strcmp(action, ACTION_TURN) == 0) {
+        if (m.fields & SMSG_CURRENT_PLAYER) {
+            apply_turn(m.current_player);
+        }
+    }
     
     // 플레이어 ID 할당
-    if (strcmp(action, ACTION_ASSIGN_ID) == 0) {
-        struct json_object *jpid = NULL;
-        if (json_object_object_get_ex(jmsg, "player_id", &jpid)) {
-            my_player_id = json_object_get_int(jpid);
-            print_player_status(my_player_id, "연결됨 ✅");
+    else if (strcmp(action, ACTION_ASSIGN_ID) == 0) {
+        if (m.fields & SMSG_PLAYER_ID) {
+            my_player_id = m.player_id;
+        }
+        if (m.fields & SMSG_RESUME_TOKEN) {
+            snprintf(resume_token, sizeof(resume_token), "%s", m.resume_token);
+        }
+    }
+    
+    // 재접속 완료 - 서버가 보낸 스냅샷으로 화면 상태 복원
+    else if (strcmp(action, ACTION_RESUMED) == 0) {
+        if (m.fields & SMSG_PLAYER_ID) {
+            my_player_id = m.player_id;
+        }
+        if (m.fields & SMSG_NUMBER) {
+            number_set = m.number[0] != '\0';
+        }
+        if (m.fields & SMSG_STATE) {
+            game_started = strcmp(m.state, "waiting") != 0;
+            turn_known = strcmp(m.state, "playing") == 0;
+        }
+        if (m.fields & SMSG_YOUR_TURN) {
+            my_turn = m.your_turn;
+        }
+        if (m.fields & SMSG_CURRENT_PLAYER) {
+            current_turn_player = m.current_player;
+        }
+        if (m.fields & SMSG_CAPACITY) {
+            room_capacity = m.capacity;
+        }
+        if ((m.fields & SMSG_OUT) && my_player_id >= 0) {
+            player_out[my_player_id] = m.out;
+        }
+        waiting_opponent = 0;
+        show_rules = !turn_known;
+        print_success_message("🔄 게임에 다시 접속했습니다! 이어서 진행하세요.");
+    }
+    
+    // 상대방 연결 끊김 / 복귀
+    else if (strcmp(action, ACTION_OPPONENT_AWAY) == 0 ||
+             strcmp(action, ACTION_OPPONENT_BACK) == 0) {
+        if (m.fields & SMSG_MESSAGE) {
+            print_success_message(m.message);
         }
     }
     
     // 대기 메시지
     else if (strcmp(action, ACTION_WAIT_PLAYER) == 0) {
-        print_waiting_animation();
+        waiting_opponent = 1;
     }
     
     // 게임 시작
     else if (strcmp(action, ACTION_GAME_START) == 0) {
+        if (m.fields & SMSG_CAPACITY) {
+            room_capacity = m.capacity;
+        }
+        memset(player_out, 0, sizeof(player_out));
         game_started = 1;
+        waiting_opponent = 0;
+        show_rules = 1;
         clear_screen();
-        print_game_header();
-        print_game_rules();
         
-        printf("🎮 게임이 시작되었습니다! 이제 당신의 비밀 숫자를 설정하세요!\n");
-        printf("💡 'set <3자리숫자>' 명령으로 숫자를 설정하세요! (예: set 123)\n\n");
+        print_success_message("🎮 게임이 시작되었습니다! 'set <3자리숫자>' 명령으로 숫자를 설정하세요! (예: set 123)");
     }
     
     // 숫자 설정 완료
@@ -547,120 +980,309 @@ int handle_server_message(int sockfd) {
     // 내 턴
     else if (strcmp(action, ACTION_YOUR_TURN) == 0) {
         my_turn = 1;
-        print_turn_indicator(1);
-    }
-    
-    // 상대방 턴
-    else if (strcmp(action, ACTION_WAIT_TURN) == 0) {
-        my_turn = 0;
-        print_turn_indicator(0);
+        turn_known = 1;
+        show_rules = 0;  // 턴 진행 중에는 결과/턴 패널만 갱신
     }
     
     // 추측 결과
     else if (strcmp(action, ACTION_GUESS_RESULT) == 0) {
-        struct json_object *jguess = NULL, *jstrikes = NULL, *jballs = NULL, *jattempts = NULL, *jcurrent_player = NULL;
+        apply_guess_result(&m);
+    }
+    
+    // 추측 결과 + 다음 턴 (turn_result 기능을 합의한 경우 guess_result/turn/your_turn 대신 한 번에)
+    else if (strcmp(action, ACTION_TURN_RESULT) == 0) {
+        apply_guess_result(&m);
+        if (m.fields & SMSG_NEXT_PLAYER) {
+            apply_turn(m.next_player);
+        }
+    }
+    
+    // 기능 협상 응답
+    else if (strcmp(action, ACTION_HELLO) == 0) {
+        server_caps = (m.fields & SMSG_CAPS) ? m.caps : 0;
+    }
+    
+    // 하트비트: 타임스탬프를 그대로 돌려줌 (서버가 왕복 시간 측정)
+    else if (strcmp(action, ACTION_HEARTBEAT) == 0) {
+        if (m.fields & SMSG_TIMESTAMP) {
+            send_frame(sockfd, encode_heartbeat(send_buf, sizeof(send_buf),
+                                                &(HeartbeatMsg){ .timestamp = m.timestamp }));
+        }
+    }
+    
+    // 관전: 경기 종료 (연결은 유지하고 다음 경기를 계속 관전)
+    else if (spectating && strcmp(action, ACTION_GAME_OVER) == 0) {
+        struct json_object *jval = NULL;
+        if (m.fields & SMSG_WINNER) {
+            spectate_winner = m.winner;
+        }
+        if (jmsg && json_object_object_get_ex(jmsg, "numbers", &jval)) {
+            for (int i = 0; i < room_capacity && i < (int)json_object_array_length(jval); i++) {
+                snprintf(spectate_numbers[i], sizeof(spectate_numbers[i]), "%s",
+                         json_object_get_string(json_object_array_get_idx(jval, i)));
+            }
+        }
+        snprintf(spectate_state, sizeof(spectate_state), "finished");
+    }
+    
+    // 토너먼트 진행 알림
+    else if (strcmp(action, ACTION_TOURNAMENT) == 0) {
+        const char *status = m.status;    // 필드가 없으면 빈 문자열
+        const char *message = m.message;
+        in_tournament = 1;
+        
+        if (strcmp(status, "advance") == 0) {
+            // 다음 경기를 위해 화면 상태 초기화 (서버가 새 방에서 다시 game_start를 보냄)
+            game_started = 0;
+            number_set = 0;
+            my_turn = 0;
+            turn_known = 0;
+            game_result = 0;
+            last_result.valid = 0;
+            final_my_number[0] = '\0';
+            final_opponent_number[0] = '\0';
+            waiting_opponent = 1;
+        } else if (strcmp(status, "checked_in") == 0) {
+            waiting_opponent = 1;
+        }
         
-        if (json_object_object_get_ex(jmsg, "guess", &jguess) &&
-            json_object_object_get_ex(jmsg, "strikes", &jstrikes) &&
-            json_object_object_get_ex(jmsg, "balls", &jballs) &&
-            json_object_object_get_ex(jmsg, "attempts", &jattempts) &&
-            json_object_object_get_ex(jmsg, "current_player", &jcurrent_player)) {
-            
-            const char *guess = json_object_get_string(jguess);
-            int strikes = json_object_get_int(jstrikes);
-            int balls = json_object_get_int(jballs);
-            int attempts = json_object_get_int(jattempts);
-            int current_player = json_object_get_int(jcurrent_player);
-            
-            print_result_board(guess, strikes, balls, attempts, current_player);
+        if (strcmp(status, "eliminated") == 0 || strcmp(status, "champion") == 0) {
+            print_success_message(message);
+            draw_screen();
+            json_object_put(jmsg);
+            return -1;
         }
+        print_success_message(message);
     }
     
     // 게임 종료
     else if (strcmp(action, ACTION_GAME_OVER) == 0) {
-        struct json_object *jresult = NULL;
-        struct json_object *jyour_num = NULL, *jopp_num = NULL;
-        
-        if (json_object_object_get_ex(jmsg, "result", &jresult)) {
-            const char *result = json_object_get_string(jresult);
-            if (strcmp(result, "victory") == 0) {
-                print_victory_screen();
-            } else {
-                print_defeat_screen();
-            }
+        if (m.fields & SMSG_RESULT) {
+            game_result = (strcmp(m.result, "victory") == 0) ? 1 : -1;
         }
         
         // 정답 공개
-        if (json_object_object_get_ex(jmsg, "your_number", &jyour_num) &&
-            json_object_object_get_ex(jmsg, "opponent_number", &jopp_num)) {
-            print_game_over_info(json_object_get_string(jyour_num), 
-                                json_object_get_string(jopp_num));
+        if ((m.fields & SMSG_YOUR_NUMBER) && (m.fields & SMSG_OPPONENT_NUMBER)) {
+            snprintf(final_my_number, sizeof(final_my_number), "%s", m.your_number);
+            snprintf(final_opponent_number, sizeof(final_opponent_number), "%s", m.opponent_number);
         }
         
-        printf("🚪 게임이 종료됩니다... 수고하셨습니다! 👏\n\n");
-        json_object_put(jmsg);
-        return -1;
+        if (in_tournament) {
+            // 토너먼트: 서버가 대진표를 갱신한 뒤 통과/탈락을 알려줌
+            print_success_message("🏁 경기 종료! 대진표 결과를 기다리는 중...");
+        } else {
+            print_success_message("🚪 게임이 종료됩니다... 수고하셨습니다! 👏");
+            draw_screen();
+            json_object_put(jmsg);
+            return -1;
+        }
+    }
+    
+    // 리더보드 조회 결과
+    else if (strcmp(action, ACTION_LEADERBOARD_RESULT) == 0) {
+        struct json_object *jtop = NULL, *jplayer = NULL, *jv = NULL;
+        leaderboard_line_count = 0;
+        if (jmsg && json_object_object_get_ex(jmsg, "top", &jtop)) {
+            int n = json_object_array_length(jtop);
+            for (int i = 0; i < n && leaderboard_line_count < LEADERBOARD_SHOW_TOP; i++) {
+                struct json_object *jrow = json_object_array_get_idx(jtop, i);
+                int rank = 0, wins = 0, losses = 0;
+                double avg = 0;
+                const char *name = "";
+                if (json_object_object_get_ex(jrow, "rank", &jv)) rank = json_object_get_int(jv);
+                if (json_object_object_get_ex(jrow, "name", &jv)) name = json_object_get_string(jv);
+                if (json_object_object_get_ex(jrow, "wins", &jv)) wins = json_object_get_int(jv);
+                if (json_object_object_get_ex(jrow, "losses", &jv)) losses = json_object_get_int(jv);
+                if (json_object_object_get_ex(jrow, "avg_attempts", &jv)) avg = json_object_get_double(jv);
+                snprintf(leaderboard_lines[leaderboard_line_count++], sizeof(leaderboard_lines[0]),
+                         "%2d위  %-16s  %3d승 %3d패  평균 %.1f회", rank, name, wins, losses, avg);
+            }
+        }
+        if (jmsg && json_object_object_get_ex(jmsg, "player", &jplayer) &&
+            json_object_object_get_ex(jplayer, "rank", &jv)) {
+            snprintf(leaderboard_lines[leaderboard_line_count++], sizeof(leaderboard_lines[0]),
+                     "👉 내 순위: %d위", json_object_get_int(jv));
+        }
+        show_leaderboard = 1;
     }
     
     // 에러 메시지
     else if (strcmp(action, ACTION_ERROR) == 0) {
-        struct json_object *jmessage = NULL;
-        if (json_object_object_get_ex(jmsg, "message", &jmessage)) {
-            print_error_message(json_object_get_string(jmessage));
+        if (m.fields & SMSG_MESSAGE) {
+            print_error_message(m.message);
         }
     }
     
+    // 서버 재시작 안내 - 연결이 끊긴 것과 같이 처리 (게임 중이면 재접속 토큰으로 복귀)
+    else if (strcmp(action, ACTION_RECONNECT) == 0) {
+        if (m.fields & SMSG_MESSAGE) {
+            print_error_message(m.message);
+        }
+        json_object_put(jmsg);
+        draw_screen();
+        return CONN_LOST;
+    }
+    
     json_object_put(jmsg);
+    draw_screen();
     return 0;
 }
 
+// ──────────────────────────────────────────────────────────
+// 서버 연결 및 재접속
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 서버 주소 (TCP, 같은 호스트의 AF_UNIX 소켓, 또는 공유 메모리 접속 소켓)
+ */
+typedef struct {
+    struct sockaddr_storage addr;   // TCP/AF_UNIX 주소
+    socklen_t addr_len;
+    const char *shm_path;           // 공유 메모리 접속 소켓 경로 (NULL: 소켓 연결)
+} ServerAddr;
+
+/**
+ * 서버에 연결
+ * @return: 연결된 소켓 (공유 메모리 연결은 수신 eventfd - select 감시용), 실패 시 -1
+ */
+int connect_to_server(const ServerAddr *server) {
+    if (server->shm_path) {
+        if (shm_channel_connect(&shm, server->shm_path) < 0) return -1;
+        return shm.rx_efd;
+    }
+    
+    int sockfd = socket(server->addr.ss_family, SOCK_STREAM, 0);
+    if (sockfd < 0) return -1;
+    
+    if (connect(sockfd, (const struct sockaddr *)&server->addr, server->addr_len) < 0) {
+        close(sockfd);
+        return -1;
+    }
+    return sockfd;
+}
+
+/**
+ * 서버 연결 닫기 (공유 메모리 연결은 채널을 닫힘으로 표시한 뒤 매핑과 fd 정리)
+ */
+void disconnect_from_server(int sockfd) {
+    if (shm.region) {
+        shm_channel_shutdown(&shm);
+        shm_channel_close(&shm);
+    } else if (sockfd >= 0) {
+        close(sockfd);
+    }
+}
+
+/**
+ * 게임 중 끊긴 연결을 재접속 토큰으로 복구
+ * RESUME_BACKOFF_MS부터 두 배씩 늘려가며 최대 RESUME_MAX_RETRIES회 시도
+ * 
+ * @return: 새 소켓 (resume 요청 전송 완료), 실패 시 -1
+ */
+int reconnect_with_backoff(const ServerAddr *server) {
+    int delay_ms = RESUME_BACKOFF_MS;
+    
+    for (int attempt = 1; attempt <= RESUME_MAX_RETRIES; attempt++) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "🔄 재접속 시도 중... (%d/%d)", attempt, RESUME_MAX_RETRIES);
+        print_success_message(msg);
+        draw_screen();
+        usleep(delay_ms * 1000);
+        
+        int sockfd = connect_to_server(server);
+        if (sockfd >= 0) {
+            size_t len = encode_resume(send_buf, sizeof(send_buf), &(ResumeMsg){ .token = resume_token });
+            if (send_frame(sockfd, len) == 0 && send_hello(sockfd) == 0) return sockfd;
+            disconnect_from_server(sockfd);
+        }
+        delay_ms *= 2;
+    }
+    return -1;
+}
+
 // ──────────────────────────────────────────────────────────
 // 메인 함수
 // ──────────────────────────────────────────────────────────
 int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        printf("사용법: %s <서버IP> <포트>\n", argv[0]);
-        return 1;
+    const char *prog = argv[0];
+    
+    // -w: 관전 모드 (서버의 관전 포트로 접속)
+    if (argc > 1 && strcmp(argv[1], "-w") == 0) {
+        spectating = 1;
+        argv++;
+        argc--;
     }
     
-    const char *server_ip = argv[1];
-    int port = atoi(argv[2]);
+    // 같은 호스트의 서버는 unix:<경로> / shm:<경로>로 지정 (포트 없음, 관전은 TCP 관전 포트만)
+    const char *target = argc > 1 ? argv[1] : "";
+    int local = strncmp(target, "unix:", 5) == 0 || strncmp(target, "shm:", 4) == 0;
+    int name_idx = local ? 2 : 3;
+    if (argc < name_idx || argc > name_idx + 1 || (spectating && (local || argc != name_idx))) {
+        printf("사용법: %s <서버IP> <포트> [이름]\n", prog);
+        printf("        %s unix:<소켓경로> [이름]\n", prog);
+        printf("        %s shm:<공유메모리소켓경로> [이름]\n", prog);
+        printf("        %s -w <서버IP> <관전포트>\n", prog);
+        return 1;
+    }
+    if (argc == name_idx + 1) snprintf(my_name, sizeof(my_name), "%s", argv[name_idx]);
     
     // 웰컴 스크린 표시
+    render_init(STDOUT_FILENO);
     print_welcome_screen();
     
-    // 소켓 생성
-    int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    // 서버 연결
+    ServerAddr server;
+    memset(&server, 0, sizeof(server));
+    if (strncmp(target, "shm:", 4) == 0) {
+        server.shm_path = target + 4;
+    } else if (local) {
+        struct sockaddr_un *un = (struct sockaddr_un *)&server.addr;
+        un->sun_family = AF_UNIX;
+        snprintf(un->sun_path, sizeof(un->sun_path), "%s", target + 5);
+        server.addr_len = sizeof(*un);
+    } else {
+        struct sockaddr_in *in = (struct sockaddr_in *)&server.addr;
+        in->sin_family = AF_INET;
+        in->sin_port = htons(atoi(argv[2]));
+        inet_pton(AF_INET, target, &in->sin_addr);
+        server.addr_len = sizeof(*in);
+    }
+    
+    int sockfd = connect_to_server(&server);
     if (sockfd < 0) {
-        perror("socket");
+        print_error_message("서버에 연결할 수 없습니다. 서버가 실행 중인지 확인해주세요.");
+        draw_screen();
+        printf("\n");
         return 1;
     }
     
-    // 서버 연결
-    struct sockaddr_in serv_addr;
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    serv_addr.sin_port = htons(port);
-    inet_pton(AF_INET, server_ip, &serv_addr.sin_addr);
+    // 기능 협상 (관전 연결은 읽기 전용이라 생략)
+    if (!spectating) {
+        send_hello(sockfd);
+    }
     
-    if (connect(sockfd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
-        print_error_message("서버에 연결할 수 없습니다. 서버가 실행 중인지 확인해주세요.");
-        return 1;
+    // 리더보드 기록용 이름 등록
+    if (my_name[0]) {
+        send_frame(sockfd, encode_set_name(send_buf, sizeof(send_buf), &(SetNameMsg){ .name = my_name }));
     }
     
     clear_screen();
-    print_game_header();
-    printf("🎊 서버에 성공적으로 연결되었습니다! 🎊\n\n");
-    print_game_rules();
+    print_success_message(spectating ? "👀 관전을 시작합니다! 🎊"
+                                     : "🎊 서버에 성공적으로 연결되었습니다! 🎊");
+    draw_screen();
     
     // 메인 루프 (select 사용)
     fd_set read_fds;
-    int max_fd = sockfd;
     
     while (1) {
         FD_ZERO(&read_fds);
         FD_SET(STDIN_FILENO, &read_fds);  // 표준 입력
         FD_SET(sockfd, &read_fds);        // 서버 소켓
+        int max_fd = sockfd > STDIN_FILENO ? sockfd : STDIN_FILENO;
+        if (shm.region) {
+            FD_SET(shm.ctl_fd, &read_fds);  // 공유 메모리 연결: 서버 프로세스 종료 감지 (접속 소켓 EOF)
+            if (shm.ctl_fd > max_fd) max_fd = shm.ctl_fd;
+        }
         
         int activity = select(max_fd + 1, &read_fds, NULL, NULL, NULL);
         if (activity < 0) {
@@ -668,9 +1290,26 @@ int main(int argc, char *argv[]) {
             break;
         }
         
+        // 서버가 끝났으면 채널을 닫아 두고, 링에 남은 메시지를 읽은 뒤 일반 연결 끊김으로 처리
+        if (shm.region && FD_ISSET(shm.ctl_fd, &read_fds) && !shm_channel_peer_alive(&shm)) {
+            shm_channel_shutdown(&shm);
+        }
+        
         // 서버 메시지 처리
         if (FD_ISSET(sockfd, &read_fds)) {
-            if (handle_server_message(sockfd) < 0) {
+            int ret = handle_server_message(sockfd);
+            if (ret == CONN_LOST && game_started && resume_token[0]) {
+                // 게임 중 연결 끊김: 같은 좌석으로 재접속 시도
+                disconnect_from_server(sockfd);
+                sockfd = reconnect_with_backoff(&server);
+                if (sockfd < 0) {
+                    print_error_message("재접속에 실패했습니다. 게임을 종료합니다.");
+                    draw_screen();
+                    break;
+                }
+                continue;
+            }
+            if (ret < 0) {
                 break;
             }
         }
@@ -683,6 +1322,7 @@ int main(int argc, char *argv[]) {
         }
     }
     
-    close(sockfd);
+    printf("\n");
+    disconnect_from_server(sockfd);
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**
+ * baseball_clock.c - 이벤트 루프용 캐시 시계 구현
+ *
+ * 한 반복 안의 모든 타이머 판정이 같은 시각을 보도록 반복 시작에 한 번만 읽는다.
+ * (플레이어마다 time(NULL)을 부르던 방식은 초 단위라 거칠고, 시스템 시각 변경에 따라 튀었음)
+ */
+
+#define _GNU_SOURCE
+
+#include <time.h>
+
+#include "baseball_clock.h"
+
+// coarse 시계가 없는 플랫폼은 일반 단조 시계로
+#ifdef CLOCK_MONOTONIC_COARSE
+#define LOOP_MONOTONIC_CLOCK    CLOCK_MONOTONIC_COARSE
+#else
+#define LOOP_MONOTONIC_CLOCK    CLOCK_MONOTONIC
+#endif
+
+LoopClock loop_clock;
+
+void clock_update(void) {
+    struct timespec ts;
+    clock_gettime(LOOP_MONOTONIC_CLOCK, &ts);
+    loop_clock.mono_ms = (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    loop_clock.wall_ms = (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+    if (!loop_clock.anchored) {
+        loop_clock.game_offset_ms = (int64_t)loop_clock.wall_ms - (int64_t)loop_clock.mono_ms;
+        loop_clock.anchored = 1;
+    }
+    loop_clock.game_ms = (uint64_t)((int64_t)loop_clock.mono_ms + loop_clock.game_offset_ms);
+    loop_clock.updates++;
+}
+
+uint64_t clock_precise_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -0,0 +1,72 @@
+// baseball_clock.h - 이벤트 루프용 캐시 시계
+// 루프 반복마다 시계를 한 번만 읽어 두고, 타임아웃/하트비트/속도 제한/통계 주기 코드는 모두 그 값을 쓴다.
+// 경과 시간은 CLOCK_MONOTONIC(가능하면 coarse)으로 재므로 NTP가 시스템 시각을 옮겨도 타이머가 튀지 않는다.
+// 게임 로직(재접속 대기/새 게임 준비 마감)과 저널은 게임 시계를 쓴다: 시작할 때 epoch에 맞춰 두고
+// 이후로는 단조 시계로만 진행하므로 저널에서는 epoch 시각으로 읽히면서도 시스템 시각 변경에 흔들리지 않는다.
+// 스냅샷처럼 실제 시각이 필요한 곳만 epoch 시각을 그대로 쓴다.
+#ifndef BASEBALL_CLOCK_H
+#define BASEBALL_CLOCK_H
+
+#include <stdint.h>
+
+// ──────────────────────────────────────────────────────────
+// 1) 캐시된 시각 (clock_update()가 반복마다 갱신)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint64_t mono_ms;               // 단조 시계 (밀리초) - 경과 시간, 타임아웃, 주기 판정
+    uint64_t wall_ms;               // epoch 밀리초 - 스냅샷 타임스탬프
+    uint64_t game_ms;               // 게임 시계 = mono_ms + game_offset_ms - 게임 시계 훅, 저널 타임스탬프
+    int64_t  game_offset_ms;        // 첫 갱신 때의 epoch - 단조 차이 (무중단 재시작은 이전 프로세스 값을 이어받음)
+    int      anchored;              // game_offset_ms가 정해졌는지
+    uint64_t updates;               // 시계를 읽은 횟수 (= 루프 반복 수)
+} LoopClock;
+
+extern LoopClock loop_clock;
+
+// ──────────────────────────────────────────────────────────
+// 2) 시계 API
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 시계 읽기 - 이벤트 루프 반복 시작마다 한 번 호출
+ * 단조 시계는 coarse 변형(틱 단위 정밀도, vDSO에서 카운터 읽기 없이 반환)을 우선 사용
+ */
+void clock_update(void);
+
+/**
+ * 이번 반복의 단조 시각 (밀리초, 시스템 콜 없음)
+ */
+static inline uint64_t clock_now_ms(void) {
+    return loop_clock.mono_ms;
+}
+
+/**
+ * 이번 반복의 epoch 시각 (밀리초, 시스템 콜 없음)
+ */
+static inline uint64_t clock_wall_ms(void) {
+    return loop_clock.wall_ms;
+}
+
+/**
+ * 이번 반복의 게임 시계 (epoch 기준 밀리초지만 단조 증가, 시스템 콜 없음)
+ */
+static inline uint64_t clock_game_ms(void) {
+    return loop_clock.game_ms;
+}
+
+/**
+ * 게임 시계 기준점 이어받기 (무중단 재시작 - 같은 호스트의 단조 시계는 프로세스가 바뀌어도 이어지므로
+ * 이전 프로세스의 기준점을 쓰면 인계된 마감 시각이 그대로 유효). 다음 clock_update()부터 반영
+ */
+static inline void clock_set_game_offset(int64_t offset_ms) {
+    loop_clock.game_offset_ms = offset_ms;
+    loop_clock.anchored = 1;
+}
+
+/**
+ * 지금 이 순간의 정밀 단조 시각 (마이크로초) - 캐시하지 않음
+ * coarse 시계의 틱(수 ms)보다 짧은 구간을 재는 곳(하트비트 RTT)에서만 사용
+ */
+uint64_t clock_precise_us(void);
+
+#endif // BASEBALL_CLOCK_H
@@ -0,0 +1,771 @@
+/**
+ * baseball_game.c - 숫자 야구 게임 로직 (소켓과 분리된 상태 머신)
+ *
+ * 📋 주요 기능:
+ * - 플레이어 입장/퇴장, 숫자 설정, 추측, 턴 전환, 게임 종료 처리
+ * - 모든 출력은 GameHooks를 통해 전달 (전송, 이벤트 기록, 시계)
+ * - 서버(baseball_server.c)와 리플레이 도구(baseball_replay.c)가 공유
+ *
+ * 🔧 기술적 특징:
+ * - 블로킹 없음: 게임 종료 후 대기는 game_tick()의 시간 기반 초기화로 처리
+ * - 재접속: 게임 중 끊긴 좌석은 토큰과 함께 유지되고 만료 시 상대방 승리
+ * - 다인전: 2~8인 방, 라운드 로빈 턴, 추측 대상 지정, 숫자가 맞춰진 플레이어는 탈락
+ *   (턴마다 개별 메시지는 턴 플레이어 한 명뿐이고 나머지는 공유 메시지 1회 직렬화)
+ * - 결정적 동작: 같은 입력 순서와 시계를 주면 항상 같은 결과
+ * - 남은 후보 추적: 추측 결과마다 대상 좌석의 후보 비트셋을 좁혀 결과 메시지에 남은 수를 담음
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "baseball_game.h"
+#include "baseball_candidates.h"
+
+// ──────────────────────────────────────────────────────────
+// 전역 변수
+// ──────────────────────────────────────────────────────────
+static GameHooks hooks;     // 호스트가 등록한 훅
+
+// ──────────────────────────────────────────────────────────
+// 함수 전방 선언 (Forward Declarations)
+// ──────────────────────────────────────────────────────────
+static void start_game(GameManager *g);
+static void check_all_numbers_set(GameManager *g);
+static void start_turn(GameManager *g, int announced);
+static void end_game(GameManager *g, int winner_id, int cracked_id);
+static void expire_suspended(GameManager *g, int player_id);
+static void publish_game_over(GameManager *g, int winner_id);
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 게임 진행 로그 (verbose 모드에서만 출력)
+ */
+static void game_log(const char *fmt, ...) {
+    if (!hooks.verbose) return;
+    va_list ap;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+/**
+ * 플레이어에게 메시지 전송 (f의 참조를 넘겨받아 전송 후 해제)
+ */
+static void send_to_player(GameManager *g, int player_id, SharedFrame *f) {
+    if (!f) return;
+    if (hooks.send_to_player) hooks.send_to_player(g, player_id, f);
+    frame_unref(f);
+}
+
+const char *game_state_name(GameState state) {
+    switch (state) {
+        case GAME_SETTING:  return "setting";
+        case GAME_PLAYING:  return "playing";
+        case GAME_FINISHED: return "finished";
+        default:            return "waiting";
+    }
+}
+
+/**
+ * 방 전체 메시지 전송 (publish 훅이 없으면 플레이어별 개별 전송, f의 참조를 넘겨받음)
+ */
+static void publish(GameManager *g, SharedFrame *f, int audience) {
+    if (!f) return;
+    if (hooks.publish) {
+        hooks.publish(g, f, audience);
+    } else if ((audience & AUDIENCE_PLAYERS) && hooks.send_to_player) {
+        for (int i = 0; i < g->capacity; i++) {
+            if (g->players[i].connected) hooks.send_to_player(g, i, f);
+        }
+    }
+    frame_unref(f);
+}
+
+/**
+ * 턴 전환을 turn_result 한 프레임으로 받기로 협상한 플레이어인지
+ */
+static int wants_turn_result(const PlayerInfo *p) {
+    return p->connected && (p->caps & PROTO_CAP_TURN_RESULT);
+}
+
+static int count_turn_result(GameManager *g) {
+    int count = 0;
+    for (int i = 0; i < g->capacity; i++) {
+        if (wants_turn_result(&g->players[i])) count++;
+    }
+    return count;
+}
+
+/**
+ * 방 전체 메시지를 turn_result로 이미 받은 플레이어만 빼고 전송 (f의 참조를 넘겨받음)
+ * 그런 플레이어가 없으면 일반 publish와 같음
+ */
+static void publish_legacy(GameManager *g, SharedFrame *f) {
+    if (!f) return;
+    if (count_turn_result(g) == 0) {
+        publish(g, f, AUDIENCE_ALL);
+        return;
+    }
+    for (int i = 0; i < g->capacity; i++) {
+        PlayerInfo *p = &g->players[i];
+        if (p->connected && !wants_turn_result(p)) send_to_player(g, i, frame_ref(f));
+    }
+    publish(g, f, AUDIENCE_SPECTATORS);
+}
+
+/**
+ * 관전자에게 현재 방 상태 스냅샷 전송 (방 구성/진행 단계가 바뀔 때)
+ */
+static void publish_snapshot(GameManager *g) {
+    if (!hooks.publish) return;
+    publish(g, game_spectate_snapshot(g), AUDIENCE_SPECTATORS);
+}
+
+static void emit_event(GameManager *g, JournalEventType type, int player_id,
+                       const char *number, const GuessResult *result) {
+    if (hooks.on_event) hooks.on_event(g, type, player_id, number, result);
+}
+
+static uint64_t now_ms(void) {
+    return hooks.now_ms ? hooks.now_ms() : 0;
+}
+
+/**
+ * 게임에 참여 중인 좌석인지 (접속 중이거나 재접속 대기 중이고, 탈락하지 않음)
+ */
+static int in_play(const PlayerInfo *p) {
+    return (p->connected || p->suspended) && !p->eliminated;
+}
+
+/**
+ * 아직 탈락하지 않은 플레이어 수
+ */
+static int count_in_play(GameManager *g) {
+    int count = 0;
+    for (int i = 0; i < g->capacity; i++) {
+        if (in_play(&g->players[i])) count++;
+    }
+    return count;
+}
+
+/**
+ * from 다음 좌석부터 돌아가며 처음 만나는 참여 중인 플레이어 (라운드 로빈 턴 순서)
+ * 1:1 방에서는 항상 상대방
+ * @return: 좌석 번호, 참여 중인 플레이어가 없으면 -1
+ */
+static int next_in_play(GameManager *g, int from) {
+    for (int k = 1; k <= g->capacity; k++) {
+        int i = (from + k) % g->capacity;
+        if (in_play(&g->players[i])) return i;
+    }
+    return -1;
+}
+
+// ──────────────────────────────────────────────────────────
+// 게임 초기화 및 훅 등록
+// ──────────────────────────────────────────────────────────
+
+void game_set_hooks(const GameHooks *h) {
+    hooks = *h;
+}
+
+void game_init(GameManager *g) {
+    // 게임 전체 상태 초기화
+    g->state = GAME_WAITING;
+    g->capacity = DEFAULT_ROOM_PLAYERS;
+    g->current_turn = 0;
+    g->players_ready = 0;
+    g->game_start_time = time(NULL);
+    g->last_heartbeat = time(NULL);
+    g->match_id = 0;
+    g->room_id = 0;
+    g->reset_at_ms = 0;
+    candidates_init();
+
+    // 모든 플레이어 정보 초기화
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        g->players[i].sockfd = -1;
+        g->players[i].player_id = i;
+        g->players[i].connected = 0;
+        g->players[i].state = PLAYER_WAITING;
+        memset(g->players[i].secret_number, 0, 4);
+        g->players[i].attempts = 0;
+        g->players[i].is_winner = 0;
+        g->players[i].last_activity_ms = 0;        // 네트워크 지연 처리용 (서버가 프레임을 받을 때 단조 시계로 기록)
+        g->players[i].retry_count = 0;             // 재시도 횟수 초기화
+        g->players[i].suspended = 0;
+        g->players[i].resume_deadline_ms = 0;
+        g->players[i].resume_token[0] = '\0';
+        g->players[i].name[0] = '\0';
+        g->players[i].eliminated = 0;
+        g->players[i].caps = 0;
+        candidates_reset(&g->players[i].candidates);
+    }
+}
+
+/**
+ * 좌석의 게임 진행 데이터 초기화 (비밀 숫자, 시도 횟수 등)
+ */
+static void reset_seat(PlayerInfo *player) {
+    player->state = PLAYER_WAITING;
+    memset(player->secret_number, 0, 4);
+    player->attempts = 0;
+    player->is_winner = 0;
+    player->eliminated = 0;
+    candidates_reset(&player->candidates);
+}
+
+// ──────────────────────────────────────────────────────────
+// 메시징 및 브로드캐스트 함수들 (Messaging Layer)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 모든 연결된 플레이어에게 메시지 브로드캐스트
+ * 게임 상태 변경, 공지사항 등 전체 알림용
+ *
+ * @param f: 브로드캐스트할 메시지 (참조를 넘겨받음)
+ */
+void broadcast_to_all(GameManager *g, SharedFrame *f) {
+    int sent_count = 0;
+
+    for (int i = 0; i < g->capacity; i++) {
+        if (g->players[i].connected) sent_count++;
+    }
+    publish(g, f, AUDIENCE_PLAYERS);
+
+    game_log("[Server] 브로드캐스트 완료: %d명에게 전송\n", sent_count);
+}
+
+SharedFrame *game_spectate_snapshot(GameManager *g) {
+    // 플레이어별 객체 배열이 있어 스키마 대신 json-c로 생성 (방 구성이 바뀔 때만 전송)
+    struct json_object *jmsg = create_message(ACTION_SPECTATE);
+    json_object_object_add(jmsg, "state", json_object_new_string(game_state_name(g->state)));
+    json_object_object_add(jmsg, "current_player", json_object_new_int(g->current_turn));
+    json_object_object_add(jmsg, "capacity", json_object_new_int(g->capacity));
+
+    struct json_object *jplayers = json_object_new_array();
+    for (int i = 0; i < g->capacity; i++) {
+        PlayerInfo *p = &g->players[i];
+        struct json_object *jp = json_object_new_object();
+        json_object_object_add(jp, "player_id", json_object_new_int(i));
+        json_object_object_add(jp, "name", json_object_new_string(p->name));
+        json_object_object_add(jp, "connected", json_object_new_int(p->connected));
+        json_object_object_add(jp, "away", json_object_new_int(p->suspended));
+        json_object_object_add(jp, "attempts", json_object_new_int(p->attempts));
+        json_object_object_add(jp, "out", json_object_new_int(p->eliminated));
+        json_object_array_add(jplayers, jp);
+    }
+    json_object_object_add(jmsg, "players", jplayers);
+    SharedFrame *f = frame_from_json(jmsg);
+    json_object_put(jmsg);
+    return f;
+}
+
+// ──────────────────────────────────────────────────────────
+// 입장 / 퇴장 처리
+// ──────────────────────────────────────────────────────────
+
+void game_player_join(GameManager *g, int player_id) {
+    reset_seat(&g->players[player_id]);  // 이전 좌석 주인의 시도 횟수 등이 남지 않도록
+    g->players[player_id].connected = 1;
+    g->players[player_id].suspended = 0;
+    g->players_ready++;
+    emit_event(g, JOURNAL_CONNECT, player_id, NULL, NULL);
+
+    // 플레이어 ID 할당 메시지 (재접속 토큰 포함)
+    const char *token = g->players[player_id].resume_token;
+    send_to_player(g, player_id, frame_assign_id(&(AssignIdMsg){
+        .player_id = player_id,
+        .resume_token = token[0] ? token : NULL,
+    }));
+
+    if (g->players_ready == g->capacity) {
+        start_game(g);
+    } else {
+        // 상대방 대기 중 메시지 (다인전은 현재 인원 표시)
+        char text[96];
+        if (g->capacity == 2) {
+            snprintf(text, sizeof(text), "상대방을 기다리고 있습니다...");
+        } else {
+            snprintf(text, sizeof(text), "다른 플레이어를 기다리고 있습니다... (%d/%d명)",
+                     g->players_ready, g->capacity);
+        }
+        send_to_player(g, player_id, frame_wait_player(&(WaitPlayerMsg){
+            .message = text,
+            .players = g->players_ready,
+            .capacity = g->capacity,
+        }));
+        publish_snapshot(g);
+    }
+}
+
+void game_player_leave(GameManager *g, int player_id) {
+    PlayerInfo *player = &g->players[player_id];
+    emit_event(g, JOURNAL_DISCONNECT, player_id, NULL, NULL);
+    player->connected = 0;
+
+    // 게임 중이 아니면 즉시 좌석 해제
+    if (g->state != GAME_PLAYING && g->state != GAME_SETTING) {
+        g->players_ready--;
+        player->resume_token[0] = '\0';
+        player->name[0] = '\0';
+        publish_snapshot(g);
+        return;
+    }
+
+    // 게임 중이면 비밀 숫자/시도 횟수를 유지한 채 재접속 대기
+    player->suspended = 1;
+    player->resume_deadline_ms = now_ms() + RESUME_GRACE_MS;
+    game_log("[Server] 플레이어 %d 재접속 대기 (%d초)\n", player_id, RESUME_GRACE_SEC);
+
+    // 남은 플레이어에게 대기 알림 (끊긴 플레이어는 이미 연결 해제 상태라 제외됨)
+    char text[96];
+    if (g->capacity == 2) {
+        snprintf(text, sizeof(text), "상대방의 연결이 끊겼습니다. 재접속을 기다리는 중...");
+    } else {
+        snprintf(text, sizeof(text), "플레이어 %d의 연결이 끊겼습니다. 재접속을 기다리는 중...", player_id + 1);
+    }
+    publish(g, frame_opponent_away(&(OpponentAwayMsg){
+        .player_id = player_id,
+        .grace_sec = RESUME_GRACE_SEC,
+        .message = text,
+    }), AUDIENCE_PLAYERS);
+    publish_snapshot(g);
+}
+
+void game_restore_room(GameManager *g) {
+    if (g->state != GAME_PLAYING && g->state != GAME_SETTING) {
+        int capacity = g->capacity;
+        uint16_t room_id = g->room_id;
+        uint32_t match_id = g->match_id;
+        game_init(g);
+        g->capacity = capacity;
+        g->room_id = room_id;
+        g->match_id = match_id;
+        return;
+    }
+
+    // 스냅샷 시점의 연결은 모두 사라졌으므로 앉아 있던 좌석은 새 대기 시간으로 재접속을 기다림
+    uint64_t deadline = now_ms() + RESUME_GRACE_MS;
+    for (int i = 0; i < g->capacity; i++) {
+        PlayerInfo *player = &g->players[i];
+        if (!player->connected && !player->suspended) continue;
+        player->sockfd = -1;
+        player->connected = 0;
+        player->suspended = 1;
+        player->resume_deadline_ms = deadline;
+    }
+}
+
+int game_find_resume_seat(GameManager *g, const char *token) {
+    if (!token || !token[0]) return -1;
+    for (int i = 0; i < g->capacity; i++) {
+        if (g->players[i].suspended &&
+            strncmp(g->players[i].resume_token, token, RESUME_TOKEN_LEN) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int game_has_suspended(GameManager *g) {
+    for (int i = 0; i < g->capacity; i++) {
+        if (g->players[i].suspended) return 1;
+    }
+    return 0;
+}
+
+void game_player_resume(GameManager *g, int player_id) {
+    PlayerInfo *player = &g->players[player_id];
+
+    player->suspended = 0;
+    player->resume_deadline_ms = 0;
+
+    // 다른 플레이어에게 복귀 알림 (복귀한 플레이어는 연결 표시 전이라 제외됨)
+    char text[96];
+    if (g->capacity == 2) {
+        snprintf(text, sizeof(text), "상대방이 다시 접속했습니다! 게임을 계속합니다.");
+    } else {
+        snprintf(text, sizeof(text), "플레이어 %d가 다시 접속했습니다! 게임을 계속합니다.", player_id + 1);
+    }
+    publish(g, frame_opponent_back(&(OpponentBackMsg){
+        .player_id = player_id,
+        .message = text,
+    }), AUDIENCE_PLAYERS);
+
+    player->connected = 1;
+    emit_event(g, JOURNAL_RESUME, player_id, NULL, NULL);
+    game_log("[Server] 플레이어 %d 재접속 완료\n", player_id);
+
+    // 끊긴 동안 턴이 넘어왔을 수 있으므로 현재 턴 기준으로 상태 재계산
+    if (g->state == GAME_PLAYING) {
+        player->state = (g->current_turn == player_id) ? PLAYER_TURN : PLAYER_WAITING_TURN;
+    }
+
+    // 게임 상태 스냅샷 (클라이언트 화면 복원용 최소 정보)
+    send_to_player(g, player_id, frame_resumed(&(ResumedMsg){
+        .player_id = player_id,
+        .state = game_state_name(g->state),
+        .number = player->secret_number,
+        .attempts = player->attempts,
+        .your_turn = player->state == PLAYER_TURN,
+        .current_player = g->current_turn,
+        .capacity = g->capacity,
+        .out = player->eliminated,
+    }));
+    publish_snapshot(g);
+
+    // 숫자 설정 단계였다면 복귀로 양쪽 준비가 끝났을 수 있음
+    if (g->state == GAME_SETTING) check_all_numbers_set(g);
+}
+
+/**
+ * 재접속 대기 시간 만료 처리
+ * 좌석을 해제하고, 게임 중이었다면 남은 플레이어가 한 명일 때 그 플레이어의 승리로 게임 종료
+ * (다인전에서 두 명 이상 남았으면 남은 플레이어끼리 계속 진행)
+ */
+static void expire_suspended(GameManager *g, int player_id) {
+    PlayerInfo *player = &g->players[player_id];
+
+    game_log("[Server] 플레이어 %d 재접속 대기 만료 - 좌석 해제\n", player_id);
+    int in_game = (g->state == GAME_PLAYING || g->state == GAME_SETTING);
+
+    // 만료된 플레이어를 뺀 남은 참여자
+    int other_player = -1, remaining = 0;
+    for (int i = 0; i < g->capacity; i++) {
+        if (i != player_id && in_play(&g->players[i])) {
+            other_player = i;
+            remaining++;
+        }
+    }
+
+    // 좌석을 비우기 전에 결과 알림 (이벤트 훅이 패자 정보를 볼 수 있도록)
+    if (in_game && remaining == 1 && g->players[other_player].connected) {
+        emit_event(g, JOURNAL_GAME_OVER, other_player, NULL, NULL);
+        send_to_player(g, other_player, frame_game_over(&(GameOverMsg){
+            .result = "victory",
+            .message = "🎉 상대방이 돌아오지 않았습니다. 당신의 승리!",
+        }));
+        publish_game_over(g, other_player);
+    }
+
+    player->suspended = 0;
+    player->resume_deadline_ms = 0;
+    player->resume_token[0] = '\0';
+    player->name[0] = '\0';
+    reset_seat(player);
+    g->players_ready--;
+
+    if (in_game && remaining >= 2) {
+        // 다인전: 만료된 플레이어의 턴이었다면 다음 플레이어로, 숫자 설정 중이었다면 준비 재확인
+        if (g->state == GAME_PLAYING && g->current_turn == player_id) {
+            g->current_turn = next_in_play(g, player_id);
+            start_turn(g, 0);
+        } else if (g->state == GAME_SETTING) {
+            check_all_numbers_set(g);
+        }
+    } else if (in_game) {
+        // 게임을 끝내고 남은 좌석은 새 상대를 기다리는 상태로
+        g->state = GAME_WAITING;
+        g->current_turn = 0;
+        for (int i = 0; i < g->capacity; i++) {
+            if (g->players[i].connected) reset_seat(&g->players[i]);
+        }
+    }
+    publish_snapshot(g);
+}
+
+// ──────────────────────────────────────────────────────────
+// 게임 초기화
+// ──────────────────────────────────────────────────────────
+static void start_game(GameManager *g) {
+    if (g->state != GAME_WAITING || g->players_ready < g->capacity) return;
+
+    g->state = GAME_SETTING;
+    g->match_id++;
+    emit_event(g, JOURNAL_GAME_START, 0, NULL, NULL);
+    game_log("[Server] 게임 시작! 플레이어들이 숫자를 설정하세요.\n");
+
+    // 모든 플레이어에게 게임 시작 알림
+    broadcast_to_all(g, frame_game_start(&(GameStartMsg){
+        .message = "게임이 시작되었습니다! 3자리 숫자를 설정하세요.",
+        .capacity = g->capacity,
+    }));
+
+    // 각 플레이어 상태를 설정 중으로 변경
+    for (int i = 0; i < g->capacity; i++) {
+        if (g->players[i].connected) {
+            g->players[i].state = PLAYER_SETTING;
+        }
+    }
+    publish_snapshot(g);
+}
+
+// ──────────────────────────────────────────────────────────
+// 숫자 설정 완료 확인 및 게임 진행 시작
+// ──────────────────────────────────────────────────────────
+static void check_all_numbers_set(GameManager *g) {
+    // 참여 중인 모든 플레이어가 접속해 있고 숫자를 설정해야 시작
+    int ready_count = 0;
+    for (int i = 0; i < g->capacity; i++) {
+        PlayerInfo *p = &g->players[i];
+        if (!in_play(p)) continue;
+        if (!p->connected || p->state != PLAYER_READY) return;
+        ready_count++;
+    }
+
+    if (ready_count >= 2) {
+        g->state = GAME_PLAYING;
+        g->current_turn = next_in_play(g, g->capacity - 1);  // 첫 번째 플레이어부터 시작
+
+        game_log("[Server] 모든 플레이어가 숫자를 설정했습니다. 게임을 시작합니다!\n");
+
+        // 턴 알림
+        start_turn(g, 0);
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 턴 시작 처리
+// announced: 1이면 turn_result로 다음 턴을 이미 받은 플레이어에게는 턴 알림을 보내지 않음
+// ──────────────────────────────────────────────────────────
+static void start_turn(GameManager *g, int announced) {
+    for (int i = 0; i < g->capacity; i++) {
+        if (in_play(&g->players[i])) {
+            g->players[i].state = (i == g->current_turn) ? PLAYER_TURN : PLAYER_WAITING_TURN;
+        }
+    }
+
+    // 현재 턴 플레이어에게만 개별 알림
+    PlayerInfo *next = &g->players[g->current_turn];
+    if (next->connected && !(announced && wants_turn_result(next))) {
+        send_to_player(g, g->current_turn, frame_your_turn(&(YourTurnMsg){
+            .message = "당신의 턴입니다! 3자리 숫자를 추측하세요.",
+        }));
+    }
+
+    // 나머지 플레이어와 관전자는 같은 턴 알림을 공유 (인원수와 무관하게 직렬화 1회)
+    SharedFrame *turn = frame_turn(&(TurnMsg){ .current_player = g->current_turn });
+    if (announced) {
+        publish_legacy(g, turn);
+    } else {
+        publish(g, turn, AUDIENCE_ALL);
+    }
+}
+
+/**
+ * 추측 결과 전송
+ * turn_result를 협상한 플레이어는 결과와 다음 턴(next >= 0일 때)을 한 프레임으로 받고,
+ * 나머지 플레이어와 관전자는 guess_result를 받은 뒤 start_turn()의 your_turn/turn을 따로 받음
+ * @param next: 다음 턴 플레이어, 게임이 끝나면 -1 (모두 guess_result)
+ */
+static void publish_guess_result(GameManager *g, const GuessResultMsg *m, int next) {
+    if (next < 0 || count_turn_result(g) == 0) {
+        publish(g, frame_guess_result(m), AUDIENCE_ALL);
+        return;
+    }
+
+    SharedFrame *combined = frame_turn_result(&(TurnResultMsg){
+        .guess = m->guess,
+        .strikes = m->strikes,
+        .balls = m->balls,
+        .attempts = m->attempts,
+        .current_player = m->current_player,
+        .target = m->target,
+        .eliminated = m->eliminated,
+        .remaining = m->remaining,
+        .next_player = next,
+    });
+    if (combined) {
+        for (int i = 0; i < g->capacity; i++) {
+            if (wants_turn_result(&g->players[i])) send_to_player(g, i, frame_ref(combined));
+        }
+        frame_unref(combined);
+    }
+    publish_legacy(g, frame_guess_result(m));
+}
+
+/**
+ * 관전자용 경기 결과 (승자와 양쪽 비밀 숫자 공개)
+ */
+static void publish_game_over(GameManager *g, int winner_id) {
+    if (!hooks.publish) return;
+
+    GameSummaryMsg m = { .result = "finished", .winner = winner_id, .count = g->capacity };
+    for (int i = 0; i < g->capacity; i++) {
+        m.numbers[i] = g->players[i].secret_number;
+        m.attempts[i] = g->players[i].attempts;
+    }
+    publish(g, frame_game_summary(&m), AUDIENCE_SPECTATORS);
+}
+
+// ──────────────────────────────────────────────────────────
+// 게임 종료 처리
+// ──────────────────────────────────────────────────────────
+static void end_game(GameManager *g, int winner_id, int cracked_id) {
+    g->state = GAME_FINISHED;
+    emit_event(g, JOURNAL_GAME_OVER, winner_id, NULL, NULL);
+
+    for (int i = 0; i < g->capacity; i++) {
+        if (!g->players[i].connected) continue;
+
+        GameOverMsg m;
+        if (i == winner_id) {
+            m.result = "victory";
+            m.message = "🎉 축하합니다! 숫자를 맞추셨습니다!";
+        } else {
+            m.result = "defeat";
+            m.message = g->capacity == 2
+                ? "😢 아쉽네요! 상대방이 먼저 맞췄습니다."
+                : "😢 아쉽네요! 다른 플레이어가 마지막까지 살아남았습니다.";
+        }
+
+        // 정답 공개
+        m.your_number = g->players[i].secret_number;
+        // 상대 숫자: 승자에게는 마지막으로 맞춘 숫자, 나머지에게는 승자의 숫자
+        int opponent = (i == winner_id) ? cracked_id : winner_id;
+        m.opponent_number = g->players[opponent].secret_number;
+
+        send_to_player(g, i, frame_game_over(&m));
+    }
+
+    publish_game_over(g, winner_id);
+    game_log("[Server] 게임 종료! 플레이어 %d 승리\n", winner_id);
+
+    // 이벤트 루프를 멈추지 않도록 초기화는 game_tick()에서 지연 수행
+    game_log("[Server] 5초 후 새 게임 준비...\n");
+    g->reset_at_ms = now_ms() + GAME_RESET_DELAY_MS;
+}
+
+void game_tick(GameManager *g) {
+    uint64_t now = now_ms();
+
+    // 재접속 대기 만료 확인
+    for (int i = 0; i < g->capacity; i++) {
+        if (g->players[i].suspended && now >= g->players[i].resume_deadline_ms) {
+            expire_suspended(g, i);
+        }
+    }
+
+    if (g->state != GAME_FINISHED || now < g->reset_at_ms) return;
+
+    // 게임 상태 초기화 (플레이어 연결은 유지)
+    g->state = GAME_WAITING;
+    g->current_turn = 0;
+    g->reset_at_ms = 0;
+
+    for (int i = 0; i < g->capacity; i++) {
+        if (g->players[i].connected) reset_seat(&g->players[i]);
+    }
+    publish_snapshot(g);
+
+    game_log("[Server] 새 게임 준비 완료 - 플레이어들이 새 게임을 시작할 수 있습니다!\n");
+}
+
+// ──────────────────────────────────────────────────────────
+// 클라이언트 메시지 처리
+// ──────────────────────────────────────────────────────────
+void game_handle_message(GameManager *g, int player_id, const ClientMsg *msg) {
+    // action 필드 확인
+    if (!(msg->fields & CMSG_ACTION)) {
+        return;
+    }
+
+    const char *action = msg->action;
+    PlayerInfo *player = &g->players[player_id];
+
+    // 숫자 설정 처리
+    if (strcmp(action, ACTION_SET_NUMBER) == 0) {
+        if (player->state != PLAYER_SETTING) {
+            send_to_player(g, player_id, frame_error(&(ErrorMsg){ .message = "지금은 숫자를 설정할 수 없습니다." }));
+            return;
+        }
+
+        if (msg->fields & CMSG_NUMBER) {
+            const char *number = msg->number;
+
+            if (is_valid_number(number)) {
+                strcpy(player->secret_number, number);
+                candidates_reset(&player->candidates);
+                player->state = PLAYER_READY;
+                emit_event(g, JOURNAL_SET_NUMBER, player_id, number, NULL);
+
+                send_to_player(g, player_id, frame_number_set(&(NumberSetMsg){
+                    .message = "숫자가 설정되었습니다. 상대방을 기다리는 중...",
+                }));
+
+                game_log("[Server] 플레이어 %d가 숫자를 설정했습니다.\n", player_id);
+                check_all_numbers_set(g);
+            } else {
+                send_to_player(g, player_id, frame_error(&(ErrorMsg){ .message = "올바르지 않은 숫자입니다. 3자리 서로 다른 숫자를 입력하세요." }));
+            }
+        }
+    }
+    // 추측 처리
+    else if (strcmp(action, ACTION_GUESS) == 0) {
+        if (player->state != PLAYER_TURN) {
+            send_to_player(g, player_id, frame_error(&(ErrorMsg){ .message = "지금은 당신의 턴이 아닙니다." }));
+            return;
+        }
+
+        if (msg->fields & CMSG_GUESS) {
+            const char *guess = msg->guess;
+
+            // 추측 대상: 지정하지 않으면 턴 순서상 다음 플레이어 (1:1에서는 상대방)
+            int target = next_in_play(g, player_id);
+            if (msg->fields & CMSG_TARGET) {
+                target = msg->target;
+            }
+            if (target < 0 || target >= g->capacity || target == player_id ||
+                !in_play(&g->players[target])) {
+                send_to_player(g, player_id, frame_error(&(ErrorMsg){ .message = "추측 대상이 올바르지 않습니다. 탈락하지 않은 다른 플레이어를 선택하세요." }));
+                return;
+            }
+
+            if (is_valid_number(guess)) {
+                GuessResult result = calculate_result(g->players[target].secret_number, guess);
+                result.target = target;
+                result.remaining = candidates_narrow(&g->players[target].candidates, guess,
+                                                     result.strikes, result.balls);
+
+                player->attempts++;
+                emit_event(g, JOURNAL_GUESS, player_id, guess, &result);
+
+                // 숫자가 맞춰진 플레이어는 탈락
+                if (result.is_correct) g->players[target].eliminated = 1;
+
+                // 마지막 한 명이 남으면 게임 종료, 아니면 다음 턴 (라운드 로빈, 탈락자 건너뜀)
+                int game_over = result.is_correct && count_in_play(g) == 1;
+                if (!game_over) g->current_turn = next_in_play(g, g->current_turn);
+
+                // 방의 모든 플레이어와 관전자에게 결과 전송 (종류별 인코딩 1회)
+                publish_guess_result(g, &(GuessResultMsg){
+                    .guess = guess,
+                    .strikes = result.strikes,
+                    .balls = result.balls,
+                    .attempts = player->attempts,
+                    .current_player = player_id,
+                    .target = target,
+                    .eliminated = result.is_correct,
+                    .remaining = result.remaining,
+                }, game_over ? -1 : g->current_turn);
+
+                game_log("[Server] 플레이어 %d 추측 (대상 %d): %s -> %dS %dB (남은 후보 %d개)\n",
+                         player_id, target, guess, result.strikes, result.balls, result.remaining);
+
+                if (game_over) {
+                    end_game(g, player_id, target);
+                } else {
+                    if (result.is_correct) game_log("[Server] 플레이어 %d 탈락\n", target);
+                    start_turn(g, 1);
+                }
+            } else {
+                send_to_player(g, player_id, frame_error(&(ErrorMsg){ .message = "올바르지 않은 숫자입니다. 3자리 서로 다른 숫자를 입력하세요." }));
+            }
+        }
+    }
+}
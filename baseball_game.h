@@ -0,0 +1,131 @@
+// baseball_game.h - 숫자 야구 게임 로직 계층 (소켓과 분리된 상태 머신)
+// 서버와 리플레이 도구가 동일한 게임 로직을 공유하기 위한 인터페이스
+#ifndef BASEBALL_GAME_H
+#define BASEBALL_GAME_H
+
+#include "baseball_protocol.h"
+#include "baseball_journal.h"
+#include "baseball_scan.h"
+#include "baseball_outbox.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 게임 로직 설정 상수
+// ──────────────────────────────────────────────────────────
+#define GAME_RESET_DELAY_MS   5000    // 게임 종료 후 새 게임 준비까지 대기 시간 (밀리초)
+#define RESUME_GRACE_MS       (RESUME_GRACE_SEC * 1000)  // 재접속 대기 시간 (밀리초)
+
+// 방 전체 메시지의 수신 대상 (비트 조합)
+#define AUDIENCE_PLAYERS      0x1     // 방의 플레이어
+#define AUDIENCE_SPECTATORS   0x2     // 관전자
+#define AUDIENCE_ALL          (AUDIENCE_PLAYERS | AUDIENCE_SPECTATORS)
+
+// ──────────────────────────────────────────────────────────
+// 2) 게임 로직 → 호스트(서버/리플레이) 연결 훅
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    /**
+     * 특정 플레이어에게 메시지 전송 (서버: 소켓 전송, 리플레이: 크기만 집계)
+     * f는 게임 로직이 소유 - 보관하려면 frame_ref()
+     */
+    void (*send_to_player)(GameManager *g, int player_id, SharedFrame *f);
+
+    /**
+     * 방 전체 메시지 전송 - 한 번 인코딩한 버퍼를 audience의 모든 연결이 공유
+     * (서버: 플레이어/관전자 소켓, 리플레이: 크기만 집계)
+     * 등록하지 않으면 플레이어별 send_to_player()로 대체하고 관전자 메시지는 생략
+     */
+    void (*publish)(GameManager *g, SharedFrame *f, int audience);
+
+    /**
+     * 게임 이벤트 발생 알림 (서버: 저널 기록, 리플레이: 기록과 비교)
+     */
+    void (*on_event)(GameManager *g, JournalEventType type, int player_id,
+                     const char *number, const GuessResult *result);
+
+    /**
+     * 현재 시각 (밀리초) - 서버는 실제 시계, 리플레이는 가상 시계
+     */
+    uint64_t (*now_ms)(void);
+
+    int verbose;    // 1이면 게임 진행 로그 출력
+} GameHooks;
+
+/**
+ * 게임 로직 훅 등록 (프로세스 시작 시 한 번 호출)
+ */
+void game_set_hooks(const GameHooks *hooks);
+
+/**
+ * 게임 매니저 초기화 (모든 플레이어 슬롯 비우기)
+ */
+void game_init(GameManager *g);
+
+/**
+ * 빈 좌석에 플레이어 입장 처리
+ * ID 할당 메시지 전송 후 방 정원(g->capacity)이 모이면 게임 시작
+ * @param player_id: 배정된 좌석 번호 (호출자가 sockfd 설정)
+ */
+void game_player_join(GameManager *g, int player_id);
+
+/**
+ * 플레이어 연결 해제 처리
+ * 게임 중이었다면 좌석을 RESUME_GRACE_MS 동안 유지하고 다른 플레이어에게 대기 알림,
+ * 대기 시간이 지나면 game_tick()에서 탈락 처리 (남은 플레이어가 한 명이면 그 플레이어 승리)
+ */
+void game_player_leave(GameManager *g, int player_id);
+
+/**
+ * 재접속 토큰과 일치하는 유지 중인 좌석 찾기
+ * @return: 좌석 번호, 없으면 -1
+ */
+int game_find_resume_seat(GameManager *g, const char *token);
+
+/**
+ * 유지 중인 좌석으로 플레이어 복귀 (호출자가 sockfd 설정)
+ * 게임 상태 스냅샷을 전송하고 상대방에게 복귀 알림
+ */
+void game_player_resume(GameManager *g, int player_id);
+
+/**
+ * 크래시 복구 스냅샷에서 되살린 방 정리 (서버 재시작 직후, 리플레이의 복원 지점에서 동일하게 호출)
+ * 게임 중인 방은 앉아 있던 모든 플레이어를 재접속 대기(RESUME_GRACE_MS)로 돌리고,
+ * 게임 전/종료 후인 방은 좌석을 모두 비움 (정원, 방/경기 번호는 유지)
+ * 이벤트나 메시지는 발생시키지 않음 (연결이 하나도 없는 상태)
+ */
+void game_restore_room(GameManager *g);
+
+/**
+ * 재접속을 기다리며 유지 중인 좌석이 있는지 확인
+ */
+int game_has_suspended(GameManager *g);
+
+/**
+ * 게임 상태 이름 (재접속/관전 스냅샷, 게이트웨이 상태 보고용)
+ */
+const char *game_state_name(GameState state);
+
+/**
+ * 플레이어가 보낸 메시지 처리 (set_number, guess)
+ * @param msg: 스캔한 메시지 필드 (scan_client_msg / client_msg_from_json)
+ */
+void game_handle_message(GameManager *g, int player_id, const ClientMsg *msg);
+
+/**
+ * 시간 경과 처리 (게임 종료 후 지연 초기화 등)
+ * 이벤트 루프에서 매 반복마다 호출
+ */
+void game_tick(GameManager *g);
+
+/**
+ * 모든 연결된 플레이어에게 메시지 브로드캐스트
+ */
+void broadcast_to_all(GameManager *g, SharedFrame *f);
+
+/**
+ * 관전자용 방 상태 스냅샷 (비밀 숫자 제외)
+ * 관전자 접속 직후와 방 구성이 바뀔 때 전송
+ * @return: 새 송신 버퍼 (호출자가 frame_unref로 해제), 실패하면 NULL
+ */
+SharedFrame *game_spectate_snapshot(GameManager *g);
+
+#endif // BASEBALL_GAME_H
@@ -0,0 +1,911 @@
+/**
+ * baseball_gateway.c - 숫자 야구 연결 다중화 게이트웨이 + 방 라우터
+ *
+ * 📋 주요 기능:
+ * - 클라이언트 TCP 연결을 직접 받고, 게임 서버(-G 포트)와는 소수의 지속 링크만 유지
+ * - 클라이언트 프레임 앞에 세션 id를 붙여 링크로 올리고, 서버가 보낸 레코드는 세션 id로 클라이언트를 찾아 내려보냄
+ * - 서버의 세션은 그 서버 링크 중 세션이 가장 적은 링크에 배정 (세션 열림/닫힘은 제어 레코드로 알림)
+ * - 서버 링크가 끊기면 그 링크의 클라이언트 연결을 닫음 → 클라이언트는 재접속 토큰으로 복귀,
+ *   게이트웨이는 GATEWAY_RECONNECT_MS마다 링크를 다시 연결 (무중단 재시작한 새 서버 프로세스 포함)
+ *
+ * 🗺️ 여러 게임 서버 (서버 주소/포트를 여러 쌍 주면 라우터로 동작):
+ * - 서버 프로세스 하나가 방 하나를 맡음. 게이트웨이가 방 번호를 매기고 일관 해싱 링(baseball_ring)으로 주인 서버를 정함
+ * - 새 플레이어(첫 프레임이 hello 등)는 상대를 기다리는 방이 있으면 그 서버로, 없으면 새 방 번호를 링에 해시해
+ *   시계 방향으로 처음 만나는 빈 서버로 (주인 후보가 게임 중이면 다음 후보) - 빈 서버가 없으면 게이트웨이에서 대기
+ * - 서버는 링크로 방 상태(node_status)를 보고: 상태가 바뀔 때와 GWLINK_STATUS_MS마다.
+ *   보고가 GATEWAY_STATUS_STALE_MS 넘게 끊긴 서버에는 새 경기를 배정하지 않음
+ * - 서버가 내려보낸 assign_id의 재접속 토큰을 기억해 두고, 첫 프레임이 resume이면 토큰을 발급한 서버로 보냄
+ *
+ * 🔧 기술적 특징:
+ * - select() 루프 하나, 모든 소켓 non-blocking
+ * - JSON은 해석하지 않음: 길이 prefix로 프레임 경계만 확인해 그대로 전달
+ * - 링크 레코드는 반복 끝에 링크마다 send() 한 번으로, 클라이언트 프레임도 반복 끝에 연결마다 send() 한 번으로
+ * - 링크 송신 버퍼가 차면 클라이언트 수신을 멈춤 (역압), 내려보낼 바이트가 예산을 넘는 클라이언트는 느린 소비자로 끊음
+ *
+ * 사용법: baseball_gateway [-n 서버당 링크수] <포트> <서버주소> <서버 게이트웨이포트> [<서버주소> <포트> ...]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+
+#include "baseball_protocol.h"
+#include "baseball_gwlink.h"
+#include "baseball_pool.h"
+#include "baseball_ring.h"
+#include "baseball_scan.h"
+#include "baseball_clock.h"
+
+// ──────────────────────────────────────────────────────────
+// 게이트웨이 설정 상수
+// ──────────────────────────────────────────────────────────
+#define GATEWAY_CLIENT_OUT      (32 * 1024)     // 클라이언트별 미전송 바이트 상한 (서버의 연결별 송신 예산과 같음)
+#define GATEWAY_PREALLOC_CONNS  128             // 미리 할당할 클라이언트 연결 레코드 수 (넘으면 malloc)
+#define GATEWAY_ACCEPT_BATCH    256             // 한 번 깨어날 때 수락하는 최대 연결 수
+#define GATEWAY_RECONNECT_MS    1000            // 끊긴 링크 재연결 간격
+#define GATEWAY_SELECT_MS       100             // select() 타임아웃 (링크 재연결, 통계 출력 주기 확인)
+#define GATEWAY_REPORT_MS       10000           // 통계 출력 간격 (변화가 있을 때만)
+#define GATEWAY_MAX_LINKS       32              // 모든 서버의 링크 합계 상한 (서버 수 × -n)
+#define GATEWAY_STATUS_STALE_MS (3 * GWLINK_STATUS_MS) // 상태 보고가 이만큼 없으면 새 경기를 배정하지 않음
+#define GATEWAY_TOKEN_SLOTS     4096            // 재접속 토큰 → 서버 표 크기 (2의 거듭제곱)
+#define GATEWAY_TOKEN_PROBE     8               // 토큰 표 선형 탐사 길이 (넘으면 처음 자리를 덮어씀)
+
+/**
+ * 클라이언트 연결 (fd로 바로 찾기 - 세션 id의 슬롯이 곧 fd)
+ */
+typedef struct {
+    uint32_t sid;                   // 세션 id (세대 + 슬롯)
+    int link;                       // 배정된 링크 (-1: 아직 서버를 정하지 않음 - 받은 프레임은 보관)
+    int backend;                    // 배정된 서버
+    uint32_t room;                  // 게이트웨이가 매긴 방 번호 (로그, 토큰 표)
+    int queued;                     // 빈 서버를 기다리는 중 (대기열에 있음)
+    int learned;                    // 재접속 토큰을 기억함 (더 이상 assign_id를 찾지 않음)
+    int dirty;                      // 이번 반복에 내려보낼 프레임이 생김 (반복 끝 전송 목록에 있음)
+    size_t in_len;                  // 아직 올려보내지 못한 바이트 (불완전한 프레임 또는 링크가 가득 차 대기 중인 프레임)
+    size_t out_len;                 // 미전송 바이트
+    char in[2 + BUF_SIZE];
+    char out[GATEWAY_CLIENT_OUT];
+} GatewayConn;
+
+/**
+ * 게임 서버 (링크 link_count개, 상태는 서버의 node_status 보고)
+ */
+typedef struct {
+    struct sockaddr_in addr;
+    char label[32];                 // "주소:포트" (링 key, 로그)
+    int sessions;                   // 이 게이트웨이가 연 세션 수 (보고를 기다리지 않는 정확한 값)
+    uint64_t status_ms;             // 마지막 상태 보고 시각 (0: 보고 없음)
+    char state[16];                 // 방 상태 (waiting/setting/playing/finished)
+    int capacity;                   // 방 정원
+    int players;                    // 연결된 플레이어 (다른 경로로 들어온 연결 포함)
+    int suspended;                  // 재접속 대기 좌석
+    uint32_t room;                  // 마지막으로 배정한 방 번호
+    uint64_t rooms;                 // 배정한 방 수
+    uint64_t resumes;               // 보낸 재접속 수
+} Backend;
+
+/**
+ * 재접속 토큰 → 토큰을 발급한 서버
+ */
+typedef struct {
+    char token[RESUME_TOKEN_LEN + 1];
+    int backend;
+    uint32_t room;
+} TokenRoute;
+
+typedef struct {
+    uint64_t accepted;              // 받은 클라이언트 연결 수
+    uint64_t rejected;              // 링크가 없어 거부한 연결 수
+    uint64_t resumed;               // 토큰 표로 찾아 보낸 재접속 수
+    uint64_t resume_misses;         // 표에 없는 토큰 (링으로 대신 정함)
+    uint64_t queued;                // 빈 서버를 기다린 새 플레이어 수
+    uint64_t frames_up;             // 클라이언트 → 서버 프레임 수
+    uint64_t frames_down;           // 서버 → 클라이언트 프레임 수
+    uint64_t slow_consumers;        // 예산을 넘겨 끊은 클라이언트 수
+    uint64_t reported;              // 마지막 출력 시점의 이벤트 합계
+} GatewayStats;
+
+// ──────────────────────────────────────────────────────────
+// 전역 변수
+// ──────────────────────────────────────────────────────────
+GwLink links[GATEWAY_MAX_LINKS];        // 서버 링크 (서버 b의 링크는 b * link_count부터 link_count개)
+int link_count = GWLINK_DEFAULT_LINKS;  // 서버당 유지할 링크 수 (-n 옵션)
+uint64_t link_retry_ms[GATEWAY_MAX_LINKS]; // 끊긴 링크의 다음 연결 시도 시각
+int link_warned[GATEWAY_MAX_LINKS];     // 연결 실패를 이미 알림 (재시도마다 출력하지 않음)
+Backend backends[RING_MAX_NODES];       // 게임 서버
+int backend_count = 0;
+HashRing ring;                          // 방 번호 → 주인 서버 후보
+uint32_t room_seq = 0;                  // 마지막으로 매긴 방 번호
+TokenRoute routes[GATEWAY_TOKEN_SLOTS]; // 재접속 토큰 → 서버
+int match_queue[FD_SETSIZE];            // 빈 서버를 기다리는 새 플레이어 (fd, 접속 순서)
+uint32_t match_queue_sid[FD_SETSIZE];   // 대기열 항목의 세션 id (그 사이 닫히고 fd가 재사용된 항목은 건너뜀)
+int match_head = 0;
+int match_count = 0;
+GatewayConn *conns[FD_SETSIZE];         // 클라이언트 연결 (fd로 찾기)
+uint16_t slot_gen[FD_SETSIZE];          // 슬롯(fd)별 세대 - 같은 fd를 재사용해도 세션 id가 달라짐
+int dirty_fds[FD_SETSIZE];              // 이번 반복에 내려보낼 프레임이 생긴 클라이언트
+int dirty_count = 0;
+int forward_blocked = 0;                // 링크가 가득 차 올려보내지 못한 프레임이 있음
+int client_count = 0;
+Pool conn_pool;                         // 클라이언트 연결 레코드 슬랩
+GatewayStats stats;
+uint64_t loop_now_ms = 0;               // 이벤트 루프 반복 시작 시각 (단조 시계)
+char reply_down[256];                   // 서버에 연결할 수 없을 때 보내는 오류 응답 (한 번만 인코딩)
+size_t reply_down_len = 0;
+char reply_queued[256];                 // 빈 서버를 기다릴 때 보내는 대기 알림
+size_t reply_queued_len = 0;
+
+// ──────────────────────────────────────────────────────────
+// 시계, 소켓 헬퍼
+// ──────────────────────────────────────────────────────────
+
+void update_loop_clock(void) {
+    clock_update();
+    loop_now_ms = clock_now_ms();
+}
+
+void set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags >= 0) fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+/**
+ * 클라이언트용 TCP 리스닝 소켓 생성 (non-blocking)
+ * @return: 리스닝 소켓, 실패 시 -1
+ */
+int create_listen_socket(int port) {
+    int listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    int opt = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, 1024) < 0) {
+        perror("bind/listen");
+        close(listen_fd);
+        return -1;
+    }
+    return listen_fd;
+}
+
+// ──────────────────────────────────────────────────────────
+// 게임 서버 상태
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 서버의 링크 중 하나라도 살아 있는지
+ */
+int backend_live(int b) {
+    for (int i = b * link_count; i < (b + 1) * link_count; i++) {
+        if (links[i].fd >= 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * 방의 찬 좌석 수 (이 게이트웨이가 연 세션과 서버가 보고한 연결 중 큰 값 + 재접속 대기)
+ * 세션 수는 바로 반영되고 보고는 늦게 오므로, 둘 중 큰 값을 써서 같은 자리에 두 번 배정하지 않음
+ */
+int backend_occupied(const Backend *be) {
+    return (be->sessions > be->players ? be->sessions : be->players) + be->suspended;
+}
+
+/**
+ * 새 플레이어를 받을 수 있는 서버인지 (링크 연결, 최근 보고, 대기 상태, 빈 좌석)
+ * @param idle_only: 1이면 빈 방만 (새 방 배정), 0이면 상대를 기다리는 방도
+ */
+int backend_accepting(int b, int idle_only) {
+    const Backend *be = &backends[b];
+    if (!backend_live(b) || be->status_ms == 0 || loop_now_ms - be->status_ms > GATEWAY_STATUS_STALE_MS) return 0;
+    if (strcmp(be->state, "waiting") != 0 || be->capacity <= 0) return 0;
+    int occupied = backend_occupied(be);
+    return idle_only ? occupied == 0 : occupied < be->capacity;
+}
+
+/**
+ * 서버의 링크 중 세션이 가장 적은 살아 있는 링크
+ * @return: 링크 번호, 살아 있는 링크가 없으면 -1
+ */
+int pick_link(int b) {
+    int best = -1;
+    for (int i = b * link_count; i < (b + 1) * link_count; i++) {
+        if (links[i].fd < 0) continue;
+        if (best < 0 || links[i].sessions < links[best].sessions) best = i;
+    }
+    return best;
+}
+
+// ──────────────────────────────────────────────────────────
+// 재접속 토큰 표 (토큰 → 발급한 서버)
+// 항목은 지우지 않음: 오래된 토큰은 서버가 거부하고, 표가 차면 새 토큰이 덮어씀
+// ──────────────────────────────────────────────────────────
+
+void token_put(const char *token, int backend, uint32_t room) {
+    uint32_t home = ring_hash(token, strlen(token)) & (GATEWAY_TOKEN_SLOTS - 1);
+    uint32_t slot = home;
+    for (int i = 0; i < GATEWAY_TOKEN_PROBE; i++) {
+        TokenRoute *t = &routes[(home + i) & (GATEWAY_TOKEN_SLOTS - 1)];
+        if (t->token[0] == '\0' || strcmp(t->token, token) == 0) {
+            slot = (home + i) & (GATEWAY_TOKEN_SLOTS - 1);
+            break;
+        }
+    }
+    snprintf(routes[slot].token, sizeof(routes[slot].token), "%s", token);
+    routes[slot].backend = backend;
+    routes[slot].room = room;
+}
+
+const TokenRoute *token_find(const char *token) {
+    uint32_t home = ring_hash(token, strlen(token)) & (GATEWAY_TOKEN_SLOTS - 1);
+    for (int i = 0; i < GATEWAY_TOKEN_PROBE; i++) {
+        const TokenRoute *t = &routes[(home + i) & (GATEWAY_TOKEN_SLOTS - 1)];
+        if (t->token[0] == '\0') return NULL;
+        if (strcmp(t->token, token) == 0) return t;
+    }
+    return NULL;
+}
+
+// ──────────────────────────────────────────────────────────
+// 클라이언트 연결
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 클라이언트 연결 닫기
+ * @param notify: 서버에 세션 닫힘 알림 (서버가 먼저 닫았거나 링크가 끊겼으면 0)
+ */
+void client_close(int fd, int notify) {
+    GatewayConn *c = conns[fd];
+    if (c->link >= 0) {
+        GwLink *l = &links[c->link];
+        if (l->fd >= 0) {
+            if (notify) gwlink_send_control(l, c->sid, GWLINK_CLOSE);
+            l->sessions--;
+        }
+        backends[c->backend].sessions--;
+    }
+    close(fd);
+    pool_free(&conn_pool, c);
+    conns[fd] = NULL;
+    client_count--;
+}
+
+/**
+ * 반복 끝 전송 목록에 등록
+ */
+void client_mark_dirty(int fd) {
+    if (conns[fd]->dirty) return;
+    conns[fd]->dirty = 1;
+    dirty_fds[dirty_count++] = fd;
+}
+
+/**
+ * 밀린 프레임을 send() 한 번으로 전송 (다 나가지 않은 부분은 앞으로 당겨 유지)
+ * @return: 0 (정상), 전송 오류면 -1
+ */
+int client_flush(int fd) {
+    GatewayConn *c = conns[fd];
+    while (c->out_len > 0) {
+        ssize_t n = send(fd, c->out, c->out_len, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        c->out_len -= (size_t)n;
+        memmove(c->out, c->out + n, c->out_len);
+    }
+    return 0;
+}
+
+/**
+ * 수신 버퍼의 완전한 프레임을 링크로 올려보냄 (링크가 가득 차면 남겨 두고 다음 반복에 재시도)
+ * 서버를 정하기 전에는 보관만 함 (배정되면 그 서버로 순서대로 전달)
+ * @return: 0 (정상), 잘못된 프레임이면 -1 (호출자가 연결 정리)
+ */
+int client_forward(int fd) {
+    GatewayConn *c = conns[fd];
+    if (c->link < 0) return 0;
+    GwLink *l = &links[c->link];
+    size_t pos = 0;
+    while (c->in_len - pos >= 2) {
+        uint16_t netlen;
+        memcpy(&netlen, c->in + pos, 2);
+        int len = ntohs(netlen);
+        if (len <= 0 || len > BUF_SIZE) return -1;
+        if (c->in_len - pos < 2 + (size_t)len) break;
+
+        struct iovec iov = { .iov_base = c->in + pos, .iov_len = 2 + (size_t)len };
+        if (gwlink_writev(l, c->sid, &iov, 1) < 0) {
+            forward_blocked = 1;
+            break;
+        }
+        pos += 2 + (size_t)len;
+        stats.frames_up++;
+    }
+    c->in_len -= pos;
+    memmove(c->in, c->in + pos, c->in_len);
+    return 0;
+}
+
+/**
+ * 게이트웨이가 직접 만든 응답을 클라이언트 송신 버퍼에 추가 (반복 끝에 전송)
+ */
+void client_reply(int fd, const char *frame, size_t len) {
+    GatewayConn *c = conns[fd];
+    if (len == 0 || c->out_len + len > GATEWAY_CLIENT_OUT) return;
+    memcpy(c->out + c->out_len, frame, len);
+    c->out_len += len;
+    client_mark_dirty(fd);
+}
+
+/**
+ * 서버에 세션을 열고 보관해 둔 프레임 전달
+ * @return: 성공 시 0, 서버의 링크가 없거나 가득 차면 -1
+ */
+int route_open(int fd, int b) {
+    GatewayConn *c = conns[fd];
+    int l = pick_link(b);
+    if (l < 0 || gwlink_send_control(&links[l], c->sid, GWLINK_OPEN) < 0) return -1;
+    c->link = l;
+    c->backend = b;
+    links[l].sessions++;
+    backends[b].sessions++;
+    return client_forward(fd);
+}
+
+/**
+ * 새 플레이어를 받을 서버 고르기
+ * 1) 상대를 기다리는 방 (가장 많이 찬 방부터 - 먼저 온 플레이어가 오래 기다리지 않도록)
+ * 2) 새 방: 다음 방 번호를 링에 해시해 시계 방향으로 처음 만나는 빈 서버
+ * @return: 서버 번호, 받을 수 있는 서버가 없으면 -1
+ */
+int pick_match_backend(void) {
+    int best = -1;
+    for (int b = 0; b < backend_count; b++) {
+        if (backend_occupied(&backends[b]) == 0 || !backend_accepting(b, 0)) continue;
+        if (best < 0 || backend_occupied(&backends[b]) > backend_occupied(&backends[best])) best = b;
+    }
+    if (best >= 0) return best;
+
+    uint32_t room = room_seq + 1;
+    int order[RING_MAX_NODES];
+    int n = ring_walk(&ring, ring_hash(&room, sizeof(room)), order, RING_MAX_NODES);
+    for (int k = 0; k < n; k++) {
+        int b = order[k];
+        if (!backend_accepting(b, 1)) continue;
+        room_seq = room;
+        backends[b].room = room;
+        backends[b].rooms++;
+        if (k == 0) {
+            printf("[Gateway] 방 %u → 서버 %d (%s)\n", room, b, backends[b].label);
+        } else {
+            printf("[Gateway] 방 %u → 서버 %d (%s, 링의 %d번째 후보 - 앞선 후보는 게임 중이거나 응답 없음)\n",
+                   room, b, backends[b].label, k + 1);
+        }
+        return b;
+    }
+    return -1;
+}
+
+/**
+ * 새 플레이어 배정 (받을 서버가 없으면 대기열에 넣고 대기 알림)
+ */
+void route_new(int fd) {
+    GatewayConn *c = conns[fd];
+    int b = pick_match_backend();
+    if (b < 0) {
+        if (!c->queued) {
+            c->queued = 1;
+            match_queue[(match_head + match_count) % FD_SETSIZE] = fd;
+            match_queue_sid[(match_head + match_count) % FD_SETSIZE] = c->sid;
+            match_count++;
+            stats.queued++;
+            client_reply(fd, reply_queued, reply_queued_len);
+        }
+        return;
+    }
+    c->queued = 0;
+    c->room = backends[b].room;
+    if (route_open(fd, b) < 0) {
+        client_reply(fd, reply_down, reply_down_len);
+        client_flush(fd);
+        client_close(fd, 0);
+    }
+}
+
+/**
+ * 재접속 배정 (토큰을 발급한 서버로, 표에 없는 토큰은 토큰 해시의 링 주인으로)
+ * 발급한 서버의 링크가 끊겨 있으면 거부 - 클라이언트는 재접속 간격을 늘려 다시 시도
+ */
+void route_resume(int fd, const char *token) {
+    GatewayConn *c = conns[fd];
+    const TokenRoute *t = token_find(token);
+    int b = -1;
+    if (t) {
+        b = t->backend;
+        c->room = t->room;
+        stats.resumed++;
+    } else {
+        int order[RING_MAX_NODES];
+        int n = ring_walk(&ring, ring_hash(token, strlen(token)), order, RING_MAX_NODES);
+        for (int k = 0; k < n && b < 0; k++) {
+            if (backend_live(order[k])) b = order[k];
+        }
+        stats.resume_misses++;
+    }
+    c->learned = 1;  // 재접속한 좌석의 토큰은 그대로
+
+    if (b < 0 || route_open(fd, b) < 0) {
+        client_reply(fd, reply_down, reply_down_len);
+        client_flush(fd);
+        client_close(fd, 0);
+        return;
+    }
+    backends[b].resumes++;
+}
+
+/**
+ * 서버를 정하지 않은 연결의 첫 프레임으로 배정 (resume이면 토큰의 서버, 아니면 새 플레이어)
+ */
+void client_route(int fd) {
+    GatewayConn *c = conns[fd];
+    if (c->in_len < 2) return;
+    uint16_t netlen;
+    memcpy(&netlen, c->in, 2);
+    int len = ntohs(netlen);
+    if (len <= 0 || len > BUF_SIZE || c->in_len < 2 + (size_t)len) return;
+
+    ClientMsg msg;
+    if (scan_client_msg(c->in + 2, (size_t)len, &msg) == SCAN_OK &&
+        (msg.fields & CMSG_TOKEN) && strcmp(msg.action, ACTION_RESUME) == 0) {
+        route_resume(fd, msg.token);
+    } else {
+        route_new(fd);
+    }
+}
+
+/**
+ * 대기열의 새 플레이어를 빈 서버에 배정 (상태 보고를 받은 뒤 반복마다)
+ */
+void dispatch_queue(void) {
+    while (match_count > 0) {
+        int fd = match_queue[match_head];
+        GatewayConn *c = conns[fd];
+        if (c && c->queued && c->sid == match_queue_sid[match_head]) {
+            route_new(fd);
+            if (conns[fd] && conns[fd]->queued) return;  // 아직 받을 서버가 없음 - 순서를 지켜 다음 반복에
+        }
+        match_head = (match_head + 1) % FD_SETSIZE;
+        match_count--;
+    }
+}
+
+/**
+ * 클라이언트에서 받을 수 있는 만큼 읽고 완전한 프레임을 올려보냄
+ */
+void client_receive(int fd) {
+    GatewayConn *c = conns[fd];
+    ssize_t n = recv(fd, c->in + c->in_len, sizeof(c->in) - c->in_len, MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        client_close(fd, 1);
+        return;
+    }
+    if (n > 0) c->in_len += (size_t)n;
+    if (c->link < 0 && !c->queued) {
+        client_route(fd);
+        if (!conns[fd]) return;
+    }
+    if (client_forward(fd) < 0) {
+        printf("[Gateway] 잘못된 프레임 길이 - 클라이언트 연결을 닫습니다 (fd=%d)\n", fd);
+        client_close(fd, 1);
+    }
+}
+
+/**
+ * 대기열을 비우며 클라이언트 연결 수락
+ * 서버가 하나면 바로 세션을 열고, 여러 개면 첫 프레임을 보고 배정 (client_route())
+ * 살아 있는 서버 링크가 하나도 없으면 오류 응답 후 바로 닫음 (클라이언트는 재접속 대기 후 재시도)
+ */
+void client_accept(int listen_fd) {
+    int live = 0;
+    for (int b = 0; b < backend_count && !live; b++) live = backend_live(b);
+
+    for (int n = 0; n < GATEWAY_ACCEPT_BATCH; n++) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept4");
+            return;
+        }
+
+        GatewayConn *c = NULL;
+        if (fd < FD_SETSIZE && live) c = pool_alloc(&conn_pool);
+        if (c) {
+            c->sid = GWLINK_SID(++slot_gen[fd], fd);
+            c->link = -1;
+            c->backend = -1;
+            c->room = 0;
+            c->queued = 0;
+            c->learned = backend_count == 1;  // 서버가 하나면 토큰 표가 필요 없음
+            c->dirty = 0;
+            c->in_len = 0;
+            c->out_len = 0;
+            conns[fd] = c;
+            client_count++;
+        }
+        if (!c || (backend_count == 1 && route_open(fd, 0) < 0)) {
+            send(fd, reply_down, reply_down_len, MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (c) client_close(fd, 0);
+            else close(fd);
+            stats.rejected++;
+            continue;
+        }
+        stats.accepted++;
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 서버 링크
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 링크 연결 (실패하면 GATEWAY_RECONNECT_MS 뒤 재시도 예약)
+ */
+void link_connect(int i) {
+    const Backend *be = &backends[i / link_count];
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, (const struct sockaddr *)&be->addr, sizeof(be->addr)) < 0) {
+        if (!link_warned[i]) {
+            printf("[Gateway] 링크 %d 연결 실패 (%s): %s - %dms마다 재시도\n", i, be->label, strerror(errno),
+                   GATEWAY_RECONNECT_MS);
+            link_warned[i] = 1;
+        }
+        if (fd >= 0) close(fd);
+        link_retry_ms[i] = loop_now_ms + GATEWAY_RECONNECT_MS;
+        return;
+    }
+    // 레코드는 반복 끝에 직접 모아 보내므로 Nagle 지연을 더할 필요 없음
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    set_nonblocking(fd);
+    gwlink_reset(&links[i], fd);
+    link_warned[i] = 0;
+    printf("[Gateway] 링크 %d 연결 (서버 %s)\n", i, be->label);
+}
+
+/**
+ * 링크 끊김 - 링크의 클라이언트 연결을 모두 닫음 (서버 쪽 좌석은 재접속 대기로 유지됨)
+ * 서버의 마지막 링크였으면 상태 보고도 무효 (다시 연결되어 새 보고가 올 때까지 배정하지 않음)
+ */
+void link_down(int i) {
+    GwLink *l = &links[i];
+    int closed = 0;
+    for (int fd = 0; fd < FD_SETSIZE; fd++) {
+        if (!conns[fd] || conns[fd]->link != i) continue;
+        client_flush(fd);  // 이미 받은 프레임은 가능한 만큼 전달
+        client_close(fd, 0);
+        closed++;
+    }
+    printf("[Gateway] 링크 %d 끊김 - 클라이언트 %d명 연결 종료 (받은 레코드 %llu개, 보낸 레코드 %llu개)\n",
+           i, closed, (unsigned long long)l->records_in, (unsigned long long)l->records_out);
+    close(l->fd);
+    gwlink_reset(l, -1);
+    link_retry_ms[i] = loop_now_ms + GATEWAY_RECONNECT_MS;
+    if (!backend_live(i / link_count)) backends[i / link_count].status_ms = 0;
+}
+
+/**
+ * 서버의 방 상태 보고 반영
+ */
+void backend_status(int b, const GwRecord *rec) {
+    ServerMsg m;
+    if (scan_server_msg(rec->frame + 2, (size_t)rec->len, &m) != SCAN_OK ||
+        strcmp(m.action, ACTION_NODE_STATUS) != 0) return;
+    Backend *be = &backends[b];
+    snprintf(be->state, sizeof(be->state), "%s", m.state);
+    be->capacity = m.capacity;
+    be->players = m.players;
+    be->suspended = m.suspended;
+    be->status_ms = loop_now_ms;
+}
+
+/**
+ * 서버가 내려보낸 assign_id에서 재접속 토큰을 기억 (세션마다 토큰을 찾을 때까지만 확인)
+ */
+void learn_token(GatewayConn *c, const GwRecord *rec) {
+    size_t head = rec->len < 48 ? (size_t)rec->len : 48;  // 인코더는 action을 맨 앞에 씀
+    if (!memmem(rec->frame + 2, head, "\"" ACTION_ASSIGN_ID "\"", sizeof(ACTION_ASSIGN_ID) + 1)) return;
+    ServerMsg m;
+    if (scan_server_msg(rec->frame + 2, (size_t)rec->len, &m) != SCAN_OK || !(m.fields & SMSG_RESUME_TOKEN)) return;
+    token_put(m.resume_token, c->backend, c->room);
+    c->learned = 1;
+}
+
+/**
+ * 링크에서 받은 레코드를 세션 id로 클라이언트에 전달 (서버 상태 레코드는 상태 반영)
+ */
+void link_receive(int i) {
+    GwLink *l = &links[i];
+    ssize_t n = gwlink_receive(l);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        link_down(i);
+        return;
+    }
+
+    size_t pos = 0;
+    GwRecord rec;
+    int rc;
+    while ((rc = gwlink_next(l, &pos, &rec)) > 0) {
+        if (rec.sid == GWLINK_SID_NODE) {
+            if (rec.type == GWREC_DATA) backend_status(i / link_count, &rec);
+            continue;
+        }
+        int fd = GWLINK_SLOT(rec.sid);
+        if (fd >= FD_SETSIZE || !conns[fd] || conns[fd]->sid != rec.sid) continue;  // 이미 닫은 세션
+        GatewayConn *c = conns[fd];
+
+        if (rec.type == GWREC_CLOSE) {
+            // 서버가 연결을 닫음: 남은 프레임(거부 사유 등)을 보내 보고 닫음
+            client_flush(fd);
+            client_close(fd, 0);
+            continue;
+        }
+        if (rec.type != GWREC_DATA) continue;
+        if (!c->learned) learn_token(c, &rec);
+
+        size_t frame_len = 2 + (size_t)rec.len;
+        if (c->out_len + frame_len > GATEWAY_CLIENT_OUT) {
+            printf("[Gateway] 느린 클라이언트 - 송신 예산 초과로 연결을 끊습니다 (fd=%d, 미전송 %zu바이트)\n",
+                   fd, c->out_len);
+            stats.slow_consumers++;
+            client_close(fd, 1);
+            continue;
+        }
+        memcpy(c->out + c->out_len, rec.frame, frame_len);
+        c->out_len += frame_len;
+        stats.frames_down++;
+        client_mark_dirty(fd);
+    }
+    gwlink_consume(l, pos);
+
+    if (rc < 0) {
+        printf("[Gateway] 링크 %d 레코드 형식 오류 - 링크를 닫습니다\n", i);
+        link_down(i);
+    }
+}
+
+/**
+ * 모든 링크의 송신 버퍼 전송 (전송 오류는 링크 끊김으로 처리)
+ */
+void flush_links(void) {
+    for (int i = 0; i < backend_count * link_count; i++) {
+        if (links[i].fd < 0 || !gwlink_pending(&links[i])) continue;
+        if (gwlink_flush(&links[i]) < 0) link_down(i);
+    }
+}
+
+/**
+ * 통계 출력 (force가 0이면 지난 출력 이후 새 이벤트가 있을 때만)
+ * 서버가 여러 개면 서버별 방 상태와 배정 수도 출력
+ */
+void gateway_report(int force) {
+    uint64_t total = stats.accepted + stats.rejected + stats.frames_up + stats.frames_down;
+    if (!force && total == stats.reported) return;
+    stats.reported = total;
+
+    int live = 0;
+    unsigned long long records = 0, writes = 0;
+    for (int i = 0; i < backend_count * link_count; i++) {
+        if (links[i].fd >= 0) live++;
+        records += links[i].records_out;
+        writes += links[i].writes;
+    }
+    printf("[Gateway] 클라이언트 %d명, 링크 %d/%d개, 올린 프레임 %llu개, 내린 프레임 %llu개, "
+           "링크 쓰기 %llu회 (호출당 레코드 %.2f개), 거부 %llu회, 느린 클라이언트 %llu명\n",
+           client_count, live, backend_count * link_count,
+           (unsigned long long)stats.frames_up, (unsigned long long)stats.frames_down,
+           writes, writes ? (double)records / writes : 0.0,
+           (unsigned long long)stats.rejected, (unsigned long long)stats.slow_consumers);
+    if (backend_count == 1) return;
+
+    printf("[Gateway] 방 %u개 배정, 대기열 %d명 (누적 %llu명), 재접속 %llu회 (토큰 표에 없음 %llu회)\n",
+           room_seq, match_count, (unsigned long long)stats.queued,
+           (unsigned long long)stats.resumed, (unsigned long long)stats.resume_misses);
+    for (int b = 0; b < backend_count; b++) {
+        const Backend *be = &backends[b];
+        int fresh = be->status_ms != 0 && loop_now_ms - be->status_ms <= GATEWAY_STATUS_STALE_MS;
+        printf("[Gateway]   서버 %d (%s): %s, 세션 %d, 좌석 %d/%d, 재접속 대기 %d, 방 %llu개, 재접속 %llu회\n",
+               b, be->label, !backend_live(b) ? "끊김" : fresh ? be->state : "보고 없음",
+               be->sessions, backend_occupied(be), be->capacity, be->suspended,
+               (unsigned long long)be->rooms, (unsigned long long)be->resumes);
+    }
+}
+
+/**
+ * 사용법 출력
+ */
+void print_usage(const char *prog) {
+    printf("사용법: %s [-n 서버당 링크수] <포트> <서버주소> <서버 게이트웨이포트> [<서버주소> <포트> ...]\n", prog);
+}
+
+// ──────────────────────────────────────────────────────────
+// 메인 함수
+// ──────────────────────────────────────────────────────────
+int main(int argc, char *argv[]) {
+    int opt_ch;
+
+    // 옵션 파싱: -n <서버당 링크 수>
+    while ((opt_ch = getopt(argc, argv, "n:")) != -1) {
+        switch (opt_ch) {
+            case 'n':
+                link_count = atoi(optarg);
+                if (link_count < 1 || link_count > GWLINK_MAX_LINKS) {
+                    printf("[Gateway] 링크 수는 1~%d개여야 합니다.\n", GWLINK_MAX_LINKS);
+                    return 1;
+                }
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    int pairs = argc - optind - 1;
+    if (pairs < 2 || pairs % 2 != 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (pairs / 2 > RING_MAX_NODES || pairs / 2 * link_count > GATEWAY_MAX_LINKS) {
+        printf("[Gateway] 서버는 최대 %d개, 링크는 합계 %d개까지입니다.\n", RING_MAX_NODES, GATEWAY_MAX_LINKS);
+        return 1;
+    }
+
+    int port = atoi(argv[optind]);
+    ring_init(&ring);
+    for (int a = optind + 1; a < argc; a += 2) {
+        Backend *be = &backends[backend_count];
+        memset(be, 0, sizeof(*be));
+        be->addr.sin_family = AF_INET;
+        be->addr.sin_port = htons(atoi(argv[a + 1]));
+        if (inet_pton(AF_INET, argv[a], &be->addr.sin_addr) <= 0) {
+            printf("[Gateway] 잘못된 서버 주소: %s\n", argv[a]);
+            return 1;
+        }
+        snprintf(be->label, sizeof(be->label), "%s:%d", argv[a], ntohs(be->addr.sin_port));
+        ring_add(&ring, be->label);
+        backend_count++;
+    }
+
+    reply_down_len = encode_error(reply_down, sizeof(reply_down), &(ErrorMsg){
+        .message = "게임 서버에 연결할 수 없습니다. 나중에 다시 시도해주세요." });
+    reply_queued_len = encode_wait_player(reply_queued, sizeof(reply_queued), &(WaitPlayerMsg){
+        .message = "빈 게임 서버를 기다리는 중입니다...", .players = 0, .capacity = 0 });
+    if (pool_init(&conn_pool, "클라이언트 연결", sizeof(GatewayConn), GATEWAY_PREALLOC_CONNS) < 0) {
+        printf("[Gateway] 메모리 풀을 준비할 수 없습니다\n");
+        return 1;
+    }
+
+    update_loop_clock();
+    int total_links = backend_count * link_count;
+    for (int i = 0; i < GATEWAY_MAX_LINKS; i++) gwlink_reset(&links[i], -1);
+    for (int i = 0; i < total_links; i++) link_connect(i);
+
+    int listen_fd = create_listen_socket(port);
+    if (listen_fd < 0) return 1;
+    if (backend_count == 1) {
+        printf("[Gateway] 포트 %d에서 클라이언트를 받아 서버 %s로 링크 %d개에 다중화합니다.\n",
+               port, backends[0].label, link_count);
+    } else {
+        printf("[Gateway] 포트 %d에서 클라이언트를 받아 서버 %d개에 방 단위로 배정합니다 (서버당 링크 %d개).\n",
+               port, backend_count, link_count);
+    }
+
+    uint64_t last_report_ms = loop_now_ms;
+    while (1) {
+        fd_set read_set, write_set;
+        FD_ZERO(&read_set);
+        FD_ZERO(&write_set);
+        FD_SET(listen_fd, &read_set);
+        int max_fd = listen_fd;
+
+        for (int i = 0; i < total_links; i++) {
+            if (links[i].fd < 0) continue;
+            FD_SET(links[i].fd, &read_set);
+            if (gwlink_pending(&links[i])) FD_SET(links[i].fd, &write_set);
+            if (links[i].fd > max_fd) max_fd = links[i].fd;
+        }
+        // 클라이언트 수신은 배정된 링크에 프레임을 더 넣을 수 있을 때만 (역압, 배정 전에는 보관 버퍼가 찰 때까지)
+        for (int fd = 0; fd < FD_SETSIZE; fd++) {
+            GatewayConn *c = conns[fd];
+            if (!c) continue;
+            if ((c->link < 0 || gwlink_has_room(&links[c->link])) && c->in_len < sizeof(c->in)) {
+                FD_SET(fd, &read_set);
+            }
+            if (c->out_len > 0) FD_SET(fd, &write_set);
+            if (fd > max_fd) max_fd = fd;
+        }
+
+        struct timeval tv = { 0, GATEWAY_SELECT_MS * 1000 };
+        int activity = select(max_fd + 1, &read_set, &write_set, NULL, &tv);
+        if (activity < 0 && errno != EINTR) {
+            perror("select");
+            break;
+        }
+        update_loop_clock();
+
+        // 끊긴 링크 재연결
+        for (int i = 0; i < total_links; i++) {
+            if (links[i].fd < 0 && loop_now_ms >= link_retry_ms[i]) link_connect(i);
+        }
+        if (loop_now_ms - last_report_ms >= GATEWAY_REPORT_MS) {
+            gateway_report(0);
+            last_report_ms = loop_now_ms;
+        }
+
+        if (activity > 0) {
+            // 링크: 밀린 레코드 전송, 받은 레코드를 클라이언트별로 분배
+            for (int i = 0; i < total_links; i++) {
+                int lfd = links[i].fd;
+                if (lfd < 0) continue;
+                if (FD_ISSET(lfd, &write_set) && gwlink_flush(&links[i]) < 0) {
+                    link_down(i);
+                    continue;
+                }
+                if (FD_ISSET(lfd, &read_set)) link_receive(i);
+            }
+            // 클라이언트: 밀린 프레임 전송, 받은 프레임을 링크로
+            for (int fd = 0; fd <= max_fd; fd++) {
+                if (!conns[fd] || fd == listen_fd) continue;
+                if (FD_ISSET(fd, &write_set) && client_flush(fd) < 0) {
+                    client_close(fd, 1);
+                    continue;
+                }
+                if (FD_ISSET(fd, &read_set)) client_receive(fd);
+            }
+            if (FD_ISSET(listen_fd, &read_set)) client_accept(listen_fd);
+        }
+
+        // 빈 서버가 생겼으면 (상태 보고, 세션 종료) 대기 중인 새 플레이어 배정
+        if (match_count > 0) dispatch_queue();
+
+        // 링크가 가득 차 남겨 둔 프레임 재시도 (링크가 비워진 만큼)
+        if (forward_blocked) {
+            forward_blocked = 0;
+            for (int fd = 0; fd < FD_SETSIZE; fd++) {
+                if (conns[fd] && conns[fd]->in_len > 0 && client_forward(fd) < 0) client_close(fd, 1);
+            }
+        }
+
+        // 이번 반복에 생긴 프레임을 연결마다, 링크마다 시스템 콜 한 번으로 전송
+        for (int i = 0; i < dirty_count; i++) {
+            int fd = dirty_fds[i];
+            if (!conns[fd] || !conns[fd]->dirty) continue;
+            conns[fd]->dirty = 0;
+            if (client_flush(fd) < 0) client_close(fd, 1);
+        }
+        dirty_count = 0;
+        flush_links();
+    }
+
+    gateway_report(1);
+    pool_report(&conn_pool);
+    close(listen_fd);
+    return 0;
+}
@@ -0,0 +1,240 @@
+/**
+ * baseball_gwlink.c - 게이트웨이 다중화 링크 구현
+ *
+ * 📋 동작 방식:
+ * - 수신: 소켓에서 받은 바이트를 링크 버퍼에 이어 붙이고 완전한 레코드만 꺼냄 (끝에 걸친 레코드는 다음 수신까지 보관)
+ * - 송신: 세션들의 프레임을 세션 id와 함께 링크 버퍼에 모았다가 반복 끝에 send() 한 번으로 전송
+ *   (여러 클라이언트의 메시지가 같은 시스템 콜과 TCP 세그먼트를 공유)
+ * - 송신 버퍼 끝의 GWLINK_CTRL_RESERVE는 닫힘 알림 전용: 데이터로 가득 차도 세션 종료는 전달됨
+ * - 서버 측 세션은 링크에서 받은 프레임을 자기 버퍼에 쌓고 eventfd로 깨움 → 메인 루프는 소켓과 같은 경로로 읽음
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+
+#include "baseball_gwlink.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 레코드 헤더 쓰기 (세션 id + 길이/제어 값, 네트워크 바이트 순서)
+ */
+static void put_header(char *p, uint32_t sid, uint16_t len) {
+    uint32_t netsid = htonl(sid);
+    uint16_t netlen = htons(len);
+    memcpy(p, &netsid, 4);
+    memcpy(p + 4, &netlen, 2);
+}
+
+/**
+ * eventfd 카운터 올리기 / 비우기 (non-blocking - 실패해도 다음 깨우기에서 회복)
+ */
+static void wake(int efd) {
+    uint64_t one = 1;
+    ssize_t n = write(efd, &one, sizeof(one));
+    (void)n;
+}
+
+static void drain_wake(int efd) {
+    uint64_t count;
+    ssize_t n = read(efd, &count, sizeof(count));
+    (void)n;
+}
+
+// ──────────────────────────────────────────────────────────
+// 링크
+// ──────────────────────────────────────────────────────────
+
+void gwlink_reset(GwLink *l, int fd) {
+    l->fd = fd;
+    l->sessions = 0;
+    l->in_len = 0;
+    l->out_len = 0;
+    l->records_in = 0;
+    l->records_out = 0;
+    l->writes = 0;
+}
+
+ssize_t gwlink_receive(GwLink *l) {
+    ssize_t n = recv(l->fd, l->in + l->in_len, GWLINK_IN_BUF - l->in_len, MSG_DONTWAIT);
+    if (n > 0) l->in_len += (size_t)n;
+    return n;
+}
+
+int gwlink_next(GwLink *l, size_t *pos, GwRecord *rec) {
+    size_t avail = l->in_len - *pos;
+    if (avail < GWLINK_HEADER_LEN) return 0;
+
+    const char *p = l->in + *pos;
+    uint32_t netsid;
+    uint16_t netlen;
+    memcpy(&netsid, p, 4);
+    memcpy(&netlen, p + 4, 2);
+    rec->sid = ntohl(netsid);
+    int len = ntohs(netlen);
+
+    if (len == GWLINK_OPEN || len == GWLINK_CLOSE) {
+        rec->type = len == GWLINK_OPEN ? GWREC_OPEN : GWREC_CLOSE;
+        rec->frame = NULL;
+        rec->len = 0;
+        *pos += GWLINK_HEADER_LEN;
+        l->records_in++;
+        return 1;
+    }
+    if (len > BUF_SIZE) return -1;
+    if (avail < GWLINK_HEADER_LEN + (size_t)len) return 0;
+
+    rec->type = GWREC_DATA;
+    rec->frame = p + 4;  // 길이 prefix부터 - 클라이언트 프레임 그대로
+    rec->len = len;
+    *pos += GWLINK_HEADER_LEN + (size_t)len;
+    l->records_in++;
+    return 1;
+}
+
+void gwlink_consume(GwLink *l, size_t pos) {
+    if (pos == 0) return;
+    l->in_len -= pos;
+    memmove(l->in, l->in + pos, l->in_len);
+}
+
+ssize_t gwlink_writev(GwLink *l, uint32_t sid, const struct iovec *iov, int iovcnt) {
+    size_t limit = GWLINK_OUT_BUF - GWLINK_CTRL_RESERVE;
+    size_t written = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        size_t frame_len = iov[i].iov_len;
+        if (l->out_len + 4 + frame_len > limit) break;
+        // 프레임의 길이 prefix는 그대로 쓰고 앞에 세션 id만 붙임
+        uint32_t netsid = htonl(sid);
+        memcpy(l->out + l->out_len, &netsid, 4);
+        memcpy(l->out + l->out_len + 4, iov[i].iov_base, frame_len);
+        l->out_len += 4 + frame_len;
+        l->records_out++;
+        written += frame_len;
+    }
+    if (written == 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+    return (ssize_t)written;
+}
+
+int gwlink_send_control(GwLink *l, uint32_t sid, uint16_t code) {
+    if (l->out_len + GWLINK_HEADER_LEN > GWLINK_OUT_BUF) return -1;
+    put_header(l->out + l->out_len, sid, code);
+    l->out_len += GWLINK_HEADER_LEN;
+    l->records_out++;
+    return 0;
+}
+
+int gwlink_flush(GwLink *l) {
+    while (l->out_len > 0) {
+        ssize_t n = send(l->fd, l->out, l->out_len, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        l->writes++;
+        l->out_len -= (size_t)n;
+        memmove(l->out, l->out + n, l->out_len);
+    }
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────
+// 서버 측 세션
+// ──────────────────────────────────────────────────────────
+
+int gw_session_open(GwSession *s, GwLink *link, uint32_t sid) {
+    s->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (s->efd < 0) return -1;
+    s->link = link;
+    s->sid = sid;
+    s->closed = 0;
+    s->peer_closed = 0;
+    s->rx_off = 0;
+    s->rx_len = 0;
+    link->sessions++;
+    return s->efd;
+}
+
+int gw_session_deliver(GwSession *s, const GwRecord *rec) {
+    if (rec->type == GWREC_CLOSE) {
+        s->closed = 1;
+        s->peer_closed = 1;
+        wake(s->efd);
+        return 0;
+    }
+    if (rec->type != GWREC_DATA || s->closed) return 0;
+
+    // 읽은 부분을 앞으로 당겨 공간 확보
+    size_t frame_len = 2 + (size_t)rec->len;
+    if (s->rx_len + frame_len > GWLINK_SESSION_RX && s->rx_off > 0) {
+        s->rx_len -= s->rx_off;
+        memmove(s->rx, s->rx + s->rx_off, s->rx_len);
+        s->rx_off = 0;
+    }
+    if (s->rx_len + frame_len > GWLINK_SESSION_RX) return -1;
+
+    memcpy(s->rx + s->rx_len, rec->frame, frame_len);
+    s->rx_len += frame_len;
+    wake(s->efd);
+    return 0;
+}
+
+ssize_t gw_session_writev(GwSession *s, const struct iovec *iov, int iovcnt) {
+    if (s->closed || !s->link) {
+        errno = EPIPE;
+        return -1;
+    }
+    return gwlink_writev(s->link, s->sid, iov, iovcnt);
+}
+
+int gw_session_next_len(GwSession *s) {
+    drain_wake(s->efd);
+    if (s->rx_len - s->rx_off < 2) return s->closed ? -1 : 0;
+
+    uint16_t netlen;
+    memcpy(&netlen, s->rx + s->rx_off, 2);
+    int len = ntohs(netlen);
+    if (len <= 0 || len > BUF_SIZE || s->rx_len - s->rx_off < 2 + (size_t)len) return -1;
+    return len;
+}
+
+void gw_session_read(GwSession *s, char *buf, int len) {
+    memcpy(buf, s->rx + s->rx_off + 2, len);
+    s->rx_off += 2 + (size_t)len;
+    if (s->rx_off == s->rx_len) {
+        s->rx_off = s->rx_len = 0;
+    }
+
+    // 남은 프레임(또는 닫힘)이 있으면 계속 읽기 가능하도록
+    if (s->rx_len > 0 || s->closed) wake(s->efd);
+}
+
+void gw_session_shutdown(GwSession *s) {
+    s->closed = 1;
+    wake(s->efd);
+}
+
+void gw_session_close(GwSession *s) {
+    if (s->link) {
+        if (!s->peer_closed && gwlink_send_control(s->link, s->sid, GWLINK_CLOSE) < 0) {
+            printf("[Gateway] 링크 송신 버퍼 부족 - 세션 닫힘 알림 실패 (sid=%08x)\n", s->sid);
+        }
+        s->link->sessions--;
+        s->link = NULL;
+    }
+    if (s->efd >= 0) close(s->efd);
+    s->efd = -1;
+}
@@ -0,0 +1,180 @@
+// baseball_gwlink.h - 게이트웨이 ⇄ 게임 서버 다중화 링크
+// 게이트웨이 프로세스(baseball_gateway)가 클라이언트 연결을 직접 받고, 게임 서버와는 소수의 지속 연결(링크)
+// 위에 여러 클라이언트의 프레임을 섞어 주고받는다. 링크 레코드는 기존 프레임 앞에 세션 id만 붙인 모양:
+//   [4바이트 세션 id] + [2바이트 길이] + [JSON 문자열]
+// 길이 자리의 예약 값은 제어 레코드: GWLINK_OPEN(게이트웨이→서버, 클라이언트 접속),
+// GWLINK_CLOSE(양방향, 상대 쪽 연결이 끊김 - 받은 쪽도 세션을 닫고 답하지 않음)
+//
+// 세션 id GWLINK_SID_NODE는 클라이언트가 아닌 서버 자신의 레코드: 서버가 방 상태(node_status)를
+// 바뀔 때마다, 그리고 GWLINK_STATUS_MS마다 모든 링크로 보내고 게이트웨이는 새 경기를 배정할 서버를 고른다.
+//
+// 세션 id의 하위 16비트는 게이트웨이의 슬롯(클라이언트 fd), 상위 16비트는 슬롯을 재사용할 때마다 바뀌는 세대.
+// 서버는 세션마다 eventfd 하나를 연결 식별 fd로 쓰므로 좌석/송신 큐/속도 제한 등 fd 기반 자료구조와
+// select() 루프는 그대로이고, 세션마다 소켓 버퍼나 TCP 상태를 두지 않는다 (공유 메모리 연결과 같은 방식).
+#ifndef BASEBALL_GWLINK_H
+#define BASEBALL_GWLINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/select.h>
+
+#include "baseball_protocol.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 링크 설정 상수
+// ──────────────────────────────────────────────────────────
+#define GWLINK_MAX_LINKS        8                   // 서버가 받는 / 게이트웨이가 여는 최대 링크 수
+#define GWLINK_DEFAULT_LINKS    2                   // 게이트웨이 기본 링크 수 (-n 옵션)
+#define GWLINK_MAX_SLOTS        FD_SETSIZE          // 세션 슬롯 수 (게이트웨이의 클라이언트 fd 범위)
+#define GWLINK_HEADER_LEN       6                   // 세션 id + 길이
+#define GWLINK_IN_BUF           (64 * 1024)         // 링크 수신 버퍼 (레코드 경계가 걸친 부분 보관)
+#define GWLINK_OUT_BUF          (256 * 1024)        // 링크 송신 버퍼 (반복 끝에 send() 한 번으로 전송)
+#define GWLINK_CTRL_RESERVE     (4 * 1024)          // 송신 버퍼 끝의 제어 레코드 전용 여유 (닫힘 알림은 버리지 않음)
+#define GWLINK_SESSION_RX       (2 * (2 + BUF_SIZE)) // 서버 측 세션별 수신 대기 프레임 (최대 프레임 2개 이상)
+#define GWLINK_STATUS_MS        1000                // 변화가 없어도 서버 상태를 보고하는 간격
+
+#define GWLINK_OPEN             0xFFFF              // 길이 자리: 세션 열림
+#define GWLINK_CLOSE            0x0000              // 길이 자리: 세션 닫힘
+
+#define GWLINK_SID_NODE         0xFFFFFFFFu         // 서버 상태 레코드의 세션 id (슬롯 범위 밖)
+
+#define GWLINK_SID(gen, slot)   (((uint32_t)(gen) << 16) | (uint32_t)(slot))
+#define GWLINK_SLOT(sid)        ((int)((sid) & 0xFFFF))
+
+// ──────────────────────────────────────────────────────────
+// 2) 링크 (양쪽 공통 - 레코드 단위 수신/송신 버퍼)
+// ──────────────────────────────────────────────────────────
+typedef struct GwLink {
+    int fd;                         // 링크 소켓 (-1: 빈 링크)
+    int sessions;                   // 이 링크에 열린 세션 수 (게이트웨이의 링크 선택, 통계)
+    size_t in_len;                  // 수신 버퍼에 쌓인 바이트 (끝의 불완전한 레코드 포함)
+    size_t out_len;                 // 송신 버퍼의 미전송 바이트
+    uint64_t records_in;            // 받은 레코드 수
+    uint64_t records_out;           // 보낸 레코드 수
+    uint64_t writes;                // 송신 시스템 콜 수 (records_out 대비 모아 보낸 정도)
+    char in[GWLINK_IN_BUF];
+    char out[GWLINK_OUT_BUF];
+} GwLink;
+
+typedef enum {
+    GWREC_DATA = 0,                 // 클라이언트 프레임
+    GWREC_OPEN,                     // 세션 열림
+    GWREC_CLOSE                     // 세션 닫힘
+} GwRecordType;
+
+typedef struct {
+    uint32_t sid;                   // 세션 id
+    int type;                       // GwRecordType
+    const char *frame;              // GWREC_DATA: [2바이트 길이] + [JSON] (수신 버퍼 안을 가리킴)
+    int len;                        // GWREC_DATA: JSON 길이
+} GwRecord;
+
+/**
+ * 링크 초기화 (fd가 -1이면 빈 링크로)
+ */
+void gwlink_reset(GwLink *l, int fd);
+
+/**
+ * 소켓에서 받을 수 있는 만큼 수신 버퍼에 추가 (MSG_DONTWAIT, 한 번만 호출)
+ * @return: 받은 바이트 수, 연결 종료면 0, 오류면 -1 (EAGAIN이면 다음 이벤트에서 다시)
+ */
+ssize_t gwlink_receive(GwLink *l);
+
+/**
+ * 수신 버퍼에서 pos부터 다음 레코드 하나 꺼내기 (pos는 레코드 뒤로 전진)
+ * @return: 레코드가 있으면 1, 끝에 불완전한 레코드만 남았으면 0, 길이가 잘못된 레코드면 -1
+ */
+int gwlink_next(GwLink *l, size_t *pos, GwRecord *rec);
+
+/**
+ * 처리한 레코드(pos 앞부분)를 수신 버퍼에서 제거
+ */
+void gwlink_consume(GwLink *l, size_t pos);
+
+/**
+ * 앞에서부터 들어가는 만큼의 프레임에 세션 id를 붙여 송신 버퍼에 추가 (shm_channel_writev()와 같은 모양)
+ * 각 iovec은 완전한 프레임 하나여야 하며, 일부만 쓰는 일은 없음 (제어 레코드 여유분은 남겨 둠)
+ * @return: 추가한 프레임 바이트 수 (세션 id 제외), 첫 프레임도 들어가지 않으면 -1 (errno = EAGAIN)
+ */
+ssize_t gwlink_writev(GwLink *l, uint32_t sid, const struct iovec *iov, int iovcnt);
+
+/**
+ * 제어 레코드 추가 (GWLINK_OPEN / GWLINK_CLOSE, 제어 레코드 여유분 사용)
+ * @return: 성공 시 0, 송신 버퍼가 가득 차면 -1
+ */
+int gwlink_send_control(GwLink *l, uint32_t sid, uint16_t code);
+
+/**
+ * 송신 버퍼를 send() 한 번으로 전송 (MSG_DONTWAIT, 다 나가지 않은 부분은 앞으로 당겨 유지)
+ * @return: 0 (정상, 남은 바이트가 있을 수 있음), 전송 오류면 -1
+ */
+int gwlink_flush(GwLink *l);
+
+/**
+ * 송신 버퍼에 프레임 하나(최대 크기)를 더 넣을 수 있는지 (게이트웨이의 클라이언트 수신 조절)
+ */
+static inline int gwlink_has_room(const GwLink *l) {
+    return l->out_len + GWLINK_HEADER_LEN + 2 + BUF_SIZE + GWLINK_CTRL_RESERVE <= GWLINK_OUT_BUF;
+}
+
+static inline int gwlink_pending(const GwLink *l) {
+    return l->out_len > 0;
+}
+
+// ──────────────────────────────────────────────────────────
+// 3) 서버 측 세션 (링크 위의 클라이언트 하나 - eventfd로 식별)
+//    링크에서 받은 프레임은 세션의 수신 버퍼에 넣고 eventfd를 올려 select()가 소켓처럼 알리게 함
+// ──────────────────────────────────────────────────────────
+typedef struct GwSession {
+    GwLink *link;                   // 세션이 속한 링크 (NULL: 링크가 끊김)
+    uint32_t sid;                   // 세션 id
+    int efd;                        // 연결 식별 fd (select 대상, 좌석의 sockfd)
+    int closed;                     // 더 받을 프레임 없음 (게이트웨이 쪽 닫힘, 링크 끊김, 서버의 shutdown)
+    int peer_closed;                // 게이트웨이가 먼저 닫음 (닫힘 알림을 돌려보내지 않음)
+    size_t rx_off;                  // 수신 버퍼에서 다음 프레임 위치
+    size_t rx_len;                  // 수신 버퍼 끝
+    char rx[GWLINK_SESSION_RX];     // 읽지 않은 프레임 ([2바이트 길이] + [JSON] 연속)
+} GwSession;
+
+/**
+ * 세션 생성 (eventfd 할당)
+ * @return: 연결 식별 fd, 실패 시 -1
+ */
+int gw_session_open(GwSession *s, GwLink *link, uint32_t sid);
+
+/**
+ * 링크에서 받은 레코드를 세션에 전달 (데이터는 수신 버퍼에 복사, 닫힘은 표시) 후 깨움
+ * @return: 성공 시 0, 읽지 않은 프레임이 너무 많으면 -1 (호출자가 세션 종료)
+ */
+int gw_session_deliver(GwSession *s, const GwRecord *rec);
+
+/**
+ * 세션의 프레임을 링크 송신 버퍼에 추가 (송신 큐의 전송 함수)
+ * @return: gwlink_writev()와 같음, 닫힌 세션이면 -1 (errno = EPIPE)
+ */
+ssize_t gw_session_writev(GwSession *s, const struct iovec *iov, int iovcnt);
+
+/**
+ * 다음 프레임의 JSON 길이 확인 (shm_channel_next_len()과 같은 규칙)
+ * @return: JSON 길이, 읽을 프레임이 없으면 0, 닫혔으면 -1
+ */
+int gw_session_next_len(GwSession *s);
+
+/**
+ * 다음 프레임의 JSON 문자열을 buf에 복사하고 제거 (남은 프레임이 있으면 다시 깨움)
+ */
+void gw_session_read(GwSession *s, char *buf, int len);
+
+/**
+ * 세션을 닫힘으로 표시하고 깨움 (shutdown()에 해당 - 정리는 다음 수신에서)
+ */
+void gw_session_shutdown(GwSession *s);
+
+/**
+ * 게이트웨이에 닫힘 알림 (게이트웨이가 먼저 닫지 않았고 링크가 살아 있으면), eventfd 닫기
+ */
+void gw_session_close(GwSession *s);
+
+#endif // BASEBALL_GWLINK_H
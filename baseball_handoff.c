@@ -0,0 +1,306 @@
+/**
+ * baseball_handoff.c - 무중단 재시작 (소켓 + 방 상태 인계) 구현
+ *
+ * 📋 동작 순서:
+ * 1) 새 프로세스가 기존 프로세스의 제어 소켓(AF_UNIX)에 접속
+ * 2) 기존 프로세스는 방 상태를 HandoffState로 직렬화하고
+ *    리스닝 소켓(관전 포트 포함) + 모든 플레이어 소켓을 SCM_RIGHTS로 함께 전송
+ * 3) 새 프로세스는 fd 번호를 자기 것으로 바꿔 방 상태를 복원한 뒤 1바이트 응답
+ * 4) 응답을 받은 기존 프로세스는 종료 (소켓은 새 프로세스가 계속 보유)
+ *
+ * 커널 소켓은 그대로이므로 클라이언트는 재시작을 알아차리지 못하며,
+ * 아직 읽지 않은 요청은 소켓 수신 버퍼에 남아 새 프로세스가 처리한다.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "baseball_handoff.h"
+#include "baseball_clock.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * AF_UNIX 주소 구성
+ * @return: 성공 시 0, 경로가 너무 길면 -1
+ */
+static int handoff_addr(const char *path, struct sockaddr_un *addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) {
+        printf("[Handoff] 제어 소켓 경로가 너무 깁니다: %s\n", path);
+        return -1;
+    }
+    strcpy(addr->sun_path, path);
+    return 0;
+}
+
+/**
+ * fd 배열에 소켓을 추가하고 위치 반환
+ */
+static int32_t add_fd(int *fds, uint32_t *count, int fd) {
+    if (fd < 0 || *count >= HANDOFF_MAX_FDS) return -1;
+    fds[*count] = fd;
+    return (int32_t)(*count)++;
+}
+
+/**
+ * 인계 메시지 유효성 검사 (fd 위치가 받은 fd 범위 안인지 포함)
+ */
+static int validate_state(const HandoffState *st, int fd_count) {
+    if (st->magic != HANDOFF_MAGIC || st->version != HANDOFF_VERSION) return -1;
+    if ((int)st->fd_count != fd_count || fd_count < 1) return -1;
+    if (st->extra_count > HANDOFF_MAX_FDS) return -1;
+    if (st->watch_fd_index >= fd_count) return -1;
+    if (st->capacity < 2 || st->capacity > MAX_CLIENTS || st->current_turn >= st->capacity) return -1;
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (st->players[i].fd_index >= fd_count) return -1;
+    }
+    for (uint32_t i = 0; i < st->extra_count; i++) {
+        if (st->extra_fd_index[i] < 0 || st->extra_fd_index[i] >= fd_count) return -1;
+    }
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────
+// 방 상태 직렬화 (인계와 스냅샷이 공유)
+// ──────────────────────────────────────────────────────────
+
+void handoff_pack_room(const GameManager *g, HandoffState *st, int *fds) {
+    st->game_state = (uint8_t)g->state;
+    st->current_turn = (uint8_t)g->current_turn;
+    st->capacity = (uint8_t)g->capacity;
+    st->players_ready = g->players_ready;
+    st->game_start_time = g->game_start_time;
+    st->last_heartbeat = g->last_heartbeat;
+    st->match_id = g->match_id;
+    st->reset_at_ms = g->reset_at_ms;
+
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        const PlayerInfo *p = &g->players[i];
+        HandoffPlayer *hp = &st->players[i];
+        hp->fd_index = (fds && p->connected) ? add_fd(fds, &st->fd_count, p->sockfd) : -1;
+        hp->connected = (uint8_t)p->connected;
+        hp->state = (uint8_t)p->state;
+        hp->suspended = (uint8_t)p->suspended;
+        hp->is_winner = (uint8_t)p->is_winner;
+        hp->eliminated = (uint8_t)p->eliminated;
+        hp->caps = (uint8_t)p->caps;
+        memcpy(hp->secret_number, p->secret_number, sizeof(hp->secret_number));
+        hp->attempts = p->attempts;
+        hp->retry_count = p->retry_count;
+        hp->last_activity = (int64_t)p->last_activity_ms;
+        hp->resume_deadline_ms = p->resume_deadline_ms;
+        memcpy(hp->resume_token, p->resume_token, sizeof(hp->resume_token));
+        memcpy(hp->name, p->name, sizeof(hp->name));
+        memcpy(hp->candidates, p->candidates.w, sizeof(hp->candidates));
+    }
+}
+
+void handoff_unpack_room(const HandoffState *st, const int *fds, GameManager *g) {
+    g->state = (GameState)st->game_state;
+    g->current_turn = st->current_turn;
+    g->capacity = st->capacity;
+    g->players_ready = st->players_ready;
+    g->game_start_time = (time_t)st->game_start_time;
+    g->last_heartbeat = (time_t)st->last_heartbeat;
+    g->match_id = st->match_id;
+    g->reset_at_ms = st->reset_at_ms;
+
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        const HandoffPlayer *hp = &st->players[i];
+        PlayerInfo *p = &g->players[i];
+        p->player_id = i;
+        p->sockfd = (fds && hp->fd_index >= 0) ? fds[hp->fd_index] : -1;
+        p->connected = hp->connected && p->sockfd >= 0;
+        p->state = (PlayerState)hp->state;
+        p->suspended = hp->suspended;
+        p->is_winner = hp->is_winner;
+        p->eliminated = hp->eliminated;
+        p->caps = hp->caps;
+        memcpy(p->secret_number, hp->secret_number, sizeof(p->secret_number));
+        p->secret_number[NUMBER_LENGTH] = '\0';
+        p->attempts = hp->attempts;
+        p->retry_count = hp->retry_count;
+        p->last_activity_ms = (uint64_t)hp->last_activity;
+        p->resume_deadline_ms = hp->resume_deadline_ms;
+        memcpy(p->resume_token, hp->resume_token, sizeof(p->resume_token));
+        p->resume_token[RESUME_TOKEN_LEN] = '\0';
+        memcpy(p->name, hp->name, sizeof(p->name));
+        memcpy(p->candidates.w, hp->candidates, sizeof(p->candidates.w));
+        p->name[PLAYER_NAME_LEN] = '\0';
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+int handoff_listen(const char *path) {
+    struct sockaddr_un addr;
+    if (handoff_addr(path, &addr) < 0) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket(AF_UNIX)");
+        return -1;
+    }
+
+    unlink(path);  // 이전 프로세스가 남긴 소켓 파일 교체
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 1) < 0) {
+        printf("[Handoff] 제어 소켓 생성 실패 (%s): %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int handoff_receive(const char *path, GameManager *g, int *listen_fd, int *watch_fd,
+                    int *extra_fds, int max_extra, int *extra_count) {
+    struct sockaddr_un addr;
+    if (handoff_addr(path, &addr) < 0) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        int err = errno;
+        close(fd);
+        // 소켓 파일이 없거나 아무도 듣고 있지 않으면 일반 시작
+        return (err == ENOENT || err == ECONNREFUSED) ? 0 : -1;
+    }
+
+    // 1단계: 상태 + fd 수신 (fd는 첫 바이트와 함께 도착)
+    HandoffState st;
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * HANDOFF_MAX_FDS)];
+        struct cmsghdr align;
+    } control;
+    struct iovec iov = { .iov_base = &st, .iov_len = sizeof(st) };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    ssize_t n = recvmsg(fd, &msg, 0);
+    int fds[HANDOFF_MAX_FDS];
+    int fd_count = 0;
+    for (struct cmsghdr *c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+        if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS) {
+            fd_count = (c->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            memcpy(fds, CMSG_DATA(c), fd_count * sizeof(int));
+        }
+    }
+
+    // 2단계: 남은 상태 바이트 수신
+    size_t got = n > 0 ? (size_t)n : 0;
+    while (n > 0 && got < sizeof(st)) {
+        n = recv(fd, (char *)&st + got, sizeof(st) - got, 0);
+        if (n > 0) got += n;
+    }
+
+    if (got != sizeof(st) || (msg.msg_flags & MSG_CTRUNC) || validate_state(&st, fd_count) < 0) {
+        printf("[Handoff] 인계 메시지가 올바르지 않습니다 (%zu bytes, fd %d개)\n", got, fd_count);
+        for (int i = 0; i < fd_count; i++) close(fds[i]);
+        close(fd);
+        return -1;
+    }
+
+    // 3단계: 상태 복원 (재접속 대기/새 게임 준비 마감은 이전 프로세스의 게임 시계 기준)
+    handoff_unpack_room(&st, fds, g);
+    clock_set_game_offset(st.clock_offset_ms);
+    *listen_fd = fds[0];
+    *watch_fd = st.watch_fd_index >= 0 ? fds[st.watch_fd_index] : -1;
+    *extra_count = 0;
+    for (uint32_t i = 0; i < st.extra_count; i++) {
+        int efd = fds[st.extra_fd_index[i]];
+        if (*extra_count < max_extra) {
+            extra_fds[(*extra_count)++] = efd;
+        } else {
+            close(efd);
+        }
+    }
+
+    // 4단계: 인수 완료 응답 → 이전 프로세스 종료
+    char ack = 1;
+    if (send(fd, &ack, 1, 0) != 1) {
+        printf("[Handoff] 인수 완료 응답 실패: %s\n", strerror(errno));
+    }
+    close(fd);
+
+    printf("[Handoff] 이전 프로세스에서 소켓 %d개와 방 상태 인수 완료 (경기 번호 %u)\n",
+           fd_count, g->match_id);
+    return 1;
+}
+
+int handoff_send(int ctl_fd, const GameManager *g, int listen_fd, int watch_fd,
+                 const int *extra_fds, int extra_count) {
+    int fd = accept(ctl_fd, NULL, NULL);
+    if (fd < 0) {
+        perror("accept(handoff)");
+        return -1;
+    }
+
+    // 1단계: 상태 직렬화 (0번 fd는 리스닝 소켓)
+    HandoffState st;
+    int fds[HANDOFF_MAX_FDS];
+    memset(&st, 0, sizeof(st));
+    st.magic = HANDOFF_MAGIC;
+    st.version = HANDOFF_VERSION;
+    add_fd(fds, &st.fd_count, listen_fd);
+    st.watch_fd_index = add_fd(fds, &st.fd_count, watch_fd);
+    handoff_pack_room(g, &st, fds);
+    st.clock_offset_ms = loop_clock.game_offset_ms;
+    for (int i = 0; i < extra_count; i++) {
+        int32_t idx = add_fd(fds, &st.fd_count, extra_fds[i]);
+        if (idx >= 0) st.extra_fd_index[st.extra_count++] = idx;
+    }
+
+    // 2단계: 상태 + fd 전송
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * HANDOFF_MAX_FDS)];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+    struct iovec iov = { .iov_base = &st, .iov_len = sizeof(st) };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * st.fd_count);
+    struct cmsghdr *c = CMSG_FIRSTHDR(&msg);
+    c->cmsg_level = SOL_SOCKET;
+    c->cmsg_type = SCM_RIGHTS;
+    c->cmsg_len = CMSG_LEN(sizeof(int) * st.fd_count);
+    memcpy(CMSG_DATA(c), fds, sizeof(int) * st.fd_count);
+
+    if (sendmsg(fd, &msg, 0) != (ssize_t)sizeof(st)) {
+        printf("[Handoff] 인계 메시지 전송 실패: %s\n", strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    // 3단계: 새 프로세스의 인수 완료 응답 대기
+    struct timeval tv = { HANDOFF_ACK_TIMEOUT_SEC, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    char ack = 0;
+    ssize_t n = recv(fd, &ack, 1, 0);
+    close(fd);
+    if (n != 1 || ack != 1) {
+        printf("[Handoff] 새 프로세스가 인수를 완료하지 않았습니다 - 계속 서비스합니다\n");
+        return -1;
+    }
+
+    printf("[Handoff] 소켓 %u개와 방 상태를 새 프로세스에 인계했습니다\n", st.fd_count);
+    return 0;
+}
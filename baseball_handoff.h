@@ -0,0 +1,108 @@
+// baseball_handoff.h - 무중단 재시작 (소켓 + 방 상태 인계)
+// 실행 중인 서버가 리스닝 소켓, 클라이언트 소켓, 방 상태를 AF_UNIX 소켓(SCM_RIGHTS)으로
+// 새 서버 프로세스에 넘겨 진행 중인 게임을 끊지 않고 바이너리를 교체한다.
+#ifndef BASEBALL_HANDOFF_H
+#define BASEBALL_HANDOFF_H
+
+#include "baseball_protocol.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 인계 설정 상수
+// ──────────────────────────────────────────────────────────
+#define HANDOFF_MAGIC           0x42424846u  // "BBHF"
+#define HANDOFF_VERSION         7
+#define HANDOFF_MAX_FDS         24           // 한 번에 넘길 수 있는 소켓 수 (리스닝 소켓 + 8인 방 + 재접속 대기)
+#define HANDOFF_ACK_TIMEOUT_SEC 5            // 새 프로세스의 인수 완료 응답 대기 시간
+#define HANDOFF_DRAIN_MS        2000         // 인계 전 송신 큐를 비우며 기다리는 최대 시간
+
+// ──────────────────────────────────────────────────────────
+// 2) 인계 메시지 형식 (고정 크기 필드만 사용 - 빌드가 달라도 호환)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    int32_t  fd_index;               // 함께 넘긴 fd 배열 내 위치 (-1: 소켓 없음)
+    uint8_t  connected;
+    uint8_t  state;                  // PlayerState
+    uint8_t  suspended;
+    uint8_t  is_winner;
+    uint8_t  eliminated;
+    uint8_t  caps;                   // 협상한 프로토콜 기능 (PROTO_CAP_*)
+    char     secret_number[4];
+    int32_t  attempts;
+    int32_t  retry_count;
+    int64_t  last_activity;          // 단조 시계 밀리초 (같은 호스트의 프로세스끼리는 그대로 이어짐)
+    uint64_t resume_deadline_ms;
+    char     resume_token[RESUME_TOKEN_LEN + 1];
+    char     name[PLAYER_NAME_LEN + 1];
+    uint64_t candidates[CANDIDATE_WORDS];   // 이 좌석의 남은 후보 비트셋
+} HandoffPlayer;
+
+typedef struct {
+    uint32_t magic;                  // HANDOFF_MAGIC
+    uint32_t version;                // HANDOFF_VERSION
+    uint32_t fd_count;               // 함께 넘긴 fd 수 (0번은 항상 리스닝 소켓)
+    uint32_t extra_count;            // 방에 속하지 않은 연결 수 (재접속 대기 목록 등)
+    int32_t  watch_fd_index;         // 관전자 리스닝 소켓 위치 (-1: 관전 포트 없음)
+    int32_t  extra_fd_index[HANDOFF_MAX_FDS];
+    uint8_t  game_state;             // GameState
+    uint8_t  current_turn;
+    uint8_t  capacity;               // 방 정원
+    int32_t  players_ready;
+    int64_t  game_start_time;
+    int64_t  last_heartbeat;
+    uint32_t match_id;
+    uint64_t reset_at_ms;
+    int64_t  clock_offset_ms;        // 게임 시계 기준점 (무중단 재시작에서만 - 마감 시각이 그대로 이어지도록)
+    HandoffPlayer players[MAX_CLIENTS];
+} HandoffState;
+
+// ──────────────────────────────────────────────────────────
+// 3) 방 상태 직렬화 (인계와 크래시 복구 스냅샷이 공유)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 게임 상태 → 인계 레코드 (연결된 좌석의 sockfd는 fd 배열 위치로 변환)
+ * @param fds: 함께 넘길 fd 배열 (st->fd_count가 다음 위치), NULL이면 소켓 없이 상태만 기록
+ */
+void handoff_pack_room(const GameManager *g, HandoffState *st, int *fds);
+
+/**
+ * 인계 레코드 → 게임 상태 (fd 배열 위치를 받은 fd로 변환)
+ * @param fds: 받은 fd 배열, NULL이면 모든 좌석의 sockfd를 -1로
+ */
+void handoff_unpack_room(const HandoffState *st, const int *fds, GameManager *g);
+
+// ──────────────────────────────────────────────────────────
+// 4) 인계 API
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 후속 프로세스의 인계 요청을 받을 제어 소켓 생성
+ * @param path: AF_UNIX 소켓 경로 (기존 파일은 교체)
+ * @return: 리스닝 소켓, 실패 시 -1
+ */
+int handoff_listen(const char *path);
+
+/**
+ * 이전 프로세스가 있으면 소켓과 방 상태를 인수
+ * @param path: 이전 프로세스의 제어 소켓 경로
+ * @param g: 복원할 게임 상태 (sockfd는 새 프로세스의 fd로 바뀜)
+ * @param listen_fd: 인수한 리스닝 소켓
+ * @param watch_fd: 인수한 관전자 리스닝 소켓 (이전 프로세스에 없었으면 -1)
+ * @param extra_fds: 방에 속하지 않은 연결 (최대 max_extra개)
+ * @param extra_count: 인수한 추가 연결 수
+ * @return: 인수 완료 1, 이전 프로세스 없음 0, 실패 -1
+ */
+int handoff_receive(const char *path, GameManager *g, int *listen_fd, int *watch_fd,
+                    int *extra_fds, int max_extra, int *extra_count);
+
+/**
+ * 제어 소켓으로 들어온 후속 프로세스에 소켓과 방 상태 전달
+ * 새 프로세스가 인수 완료를 알려야 성공으로 간주 (호출자는 이후 종료)
+ * 관전자 연결은 넘기지 않음 (관전자는 다시 접속해 스냅샷을 받음)
+ * @param ctl_fd: handoff_listen()으로 만든 제어 소켓
+ * @return: 성공 시 0, 실패 시 -1 (호출자는 계속 서비스)
+ */
+int handoff_send(int ctl_fd, const GameManager *g, int listen_fd, int watch_fd,
+                 const int *extra_fds, int extra_count);
+
+#endif // BASEBALL_HANDOFF_H
@@ -0,0 +1,182 @@
+/**
+ * baseball_heartbeat.c - 트래픽을 고려한 연결별 하트비트 스케줄러 구현
+ *
+ * 📋 동작 순서:
+ * 1) 입장한 연결은 now + 주기 + 지터 칸에 예약
+ * 2) 프레임을 보낼 때마다 last_tx_ms만 갱신 (휠 조작 없음)
+ * 3) 매 반복 커서가 지나간 칸의 연결만 꺼내서
+ *    - 한 주기 내내 송신이 없었으면 하트비트 대상, now + 주기 + 지터로 재예약
+ *    - 그 사이 송신이 있었으면 last_tx + 주기 + 지터로 재예약 (하트비트 생략)
+ * 4) 하트비트의 타임스탬프가 돌아오면 RTT 표본으로 이동 평균/최소/최대 갱신
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "baseball_heartbeat.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 0 ~ jitter_ms 사이 지터 (xorshift32)
+ */
+static uint32_t next_jitter(HeartbeatScheduler *hb) {
+    if (hb->jitter_ms == 0) return 0;
+    uint32_t x = hb->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    hb->rng = x;
+    return x % (hb->jitter_ms + 1);
+}
+
+static void unlink_fd(HeartbeatScheduler *hb, int fd) {
+    int s = hb->slot[fd];
+    if (s < 0) return;
+    if (hb->prev[fd] >= 0) hb->next[hb->prev[fd]] = hb->next[fd];
+    else hb->heads[s] = hb->next[fd];
+    if (hb->next[fd] >= 0) hb->prev[hb->next[fd]] = hb->prev[fd];
+    hb->slot[fd] = -1;
+}
+
+/**
+ * deadline_ms가 속한 칸에 예약
+ * 커서가 이미 지나간 칸이면 커서 다음 칸으로, 한 바퀴를 넘으면 마지막 칸으로
+ * (일찍 꺼내도 last_tx 기준으로 다시 확인하므로 하트비트가 앞당겨지지는 않음)
+ */
+static void schedule_fd(HeartbeatScheduler *hb, int fd, uint64_t deadline_ms) {
+    uint64_t tick = deadline_ms / HEARTBEAT_SLOT_MS;
+    if (tick <= hb->cursor) tick = hb->cursor + 1;
+    if (tick >= hb->cursor + HEARTBEAT_WHEEL_SLOTS) tick = hb->cursor + HEARTBEAT_WHEEL_SLOTS - 1;
+
+    int s = (int)(tick % HEARTBEAT_WHEEL_SLOTS);
+    hb->slot[fd] = s;
+    hb->prev[fd] = -1;
+    hb->next[fd] = hb->heads[s];
+    if (hb->heads[s] >= 0) hb->prev[hb->heads[s]] = fd;
+    hb->heads[s] = fd;
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 함수들
+// ──────────────────────────────────────────────────────────
+
+void heartbeat_init(HeartbeatScheduler *hb, uint32_t interval_ms, uint64_t now_ms) {
+    memset(hb, 0, sizeof(*hb));
+    for (int i = 0; i < FD_SETSIZE; i++) hb->slot[i] = -1;
+    for (int i = 0; i < HEARTBEAT_WHEEL_SLOTS; i++) hb->heads[i] = -1;
+    hb->cursor = now_ms / HEARTBEAT_SLOT_MS;
+    hb->interval_ms = interval_ms;
+    hb->jitter_ms = interval_ms / HEARTBEAT_JITTER_DIV;
+    hb->rng = (uint32_t)(now_ms ^ (now_ms >> 32)) | 1u;
+}
+
+void heartbeat_track(HeartbeatScheduler *hb, int fd, uint64_t now_ms) {
+    if (fd < 0 || fd >= FD_SETSIZE) return;
+    if (hb->slot[fd] >= 0) unlink_fd(hb, fd);
+    else hb->tracked++;
+    hb->last_tx_ms[fd] = now_ms;
+    memset(&hb->rtt[fd], 0, sizeof(hb->rtt[fd]));
+    schedule_fd(hb, fd, now_ms + hb->interval_ms + next_jitter(hb));
+}
+
+void heartbeat_untrack(HeartbeatScheduler *hb, int fd) {
+    if (fd < 0 || fd >= FD_SETSIZE || hb->slot[fd] < 0) return;
+    unlink_fd(hb, fd);
+    hb->tracked--;
+}
+
+int heartbeat_collect_due(HeartbeatScheduler *hb, uint64_t now_ms, int *out, int max) {
+    uint64_t now_tick = now_ms / HEARTBEAT_SLOT_MS;
+    if (now_tick > hb->cursor + HEARTBEAT_WHEEL_SLOTS) {
+        // 루프가 한 바퀴 넘게 멈췄으면 모든 칸을 한 번씩만 처리
+        hb->cursor = now_tick - HEARTBEAT_WHEEL_SLOTS;
+    }
+
+    int count = 0;
+    while (hb->cursor <= now_tick) {
+        int s = (int)(hb->cursor % HEARTBEAT_WHEEL_SLOTS);
+        while (hb->heads[s] >= 0) {
+            if (count >= max) goto out;  // 남은 연결은 다음 반복에서 같은 칸부터
+            int fd = hb->heads[s];
+            unlink_fd(hb, fd);
+
+            uint64_t idle_until = hb->last_tx_ms[fd] + hb->interval_ms;
+            if (now_ms >= idle_until) {
+                out[count++] = fd;
+                schedule_fd(hb, fd, now_ms + hb->interval_ms + next_jitter(hb));
+            } else {
+                hb->piggybacked++;
+                schedule_fd(hb, fd, idle_until + next_jitter(hb));
+            }
+        }
+        hb->cursor++;
+    }
+
+out:
+    hb->sent += (uint64_t)count;
+    return count;
+}
+
+void heartbeat_probe(HeartbeatScheduler *hb, int fd, uint64_t stamp_us) {
+    if (fd < 0 || fd >= FD_SETSIZE) return;
+    hb->rtt[fd].probe_us = stamp_us;
+}
+
+int heartbeat_echo(HeartbeatScheduler *hb, int fd, const char *timestamp, uint64_t now_us) {
+    if (fd < 0 || fd >= FD_SETSIZE || !timestamp) return -1;
+    HeartbeatRtt *r = &hb->rtt[fd];
+    char *end = NULL;
+    unsigned long long stamp = strtoull(timestamp, &end, 10);
+    if (r->probe_us == 0 || end == timestamp || *end != '\0' || stamp != r->probe_us || stamp > now_us) {
+        hb->stale_echoes++;
+        return -1;
+    }
+    r->probe_us = 0;
+
+    uint64_t sample64 = now_us - stamp;
+    uint32_t sample = sample64 > UINT32_MAX ? UINT32_MAX : (uint32_t)sample64;
+    if (r->samples == 0) {
+        r->ewma_us = r->min_us = r->max_us = sample;
+    } else {
+        // ewma += (sample - ewma) / 8 (부호 있는 차이로 계산)
+        int64_t diff = (int64_t)sample - (int64_t)r->ewma_us;
+        r->ewma_us = (uint32_t)((int64_t)r->ewma_us + diff / (1 << HEARTBEAT_RTT_SHIFT));
+        if (sample < r->min_us) r->min_us = sample;
+        if (sample > r->max_us) r->max_us = sample;
+    }
+    r->samples++;
+    hb->echoes++;
+    return 0;
+}
+
+void heartbeat_report(HeartbeatScheduler *hb, int force) {
+    if (!force && hb->sent == hb->reported_sent) return;
+    hb->reported_sent = hb->sent;
+    printf("[Heartbeat] 전송 %llu회, 송신 트래픽으로 생략 %llu회 (추적 연결 %d개, 주기 %ums + 지터 0~%ums)\n",
+           (unsigned long long)hb->sent, (unsigned long long)hb->piggybacked,
+           hb->tracked, hb->interval_ms, hb->jitter_ms);
+
+    // 측정된 연결들의 RTT 분포 (연결별 이동 평균의 평균/최소/최대, 관측된 최대)
+    int measured = 0;
+    uint64_t ewma_sum = 0;
+    uint32_t ewma_min = UINT32_MAX, ewma_max = 0, peak = 0;
+    for (int fd = 0; fd < FD_SETSIZE; fd++) {
+        const HeartbeatRtt *r = &hb->rtt[fd];
+        if (hb->slot[fd] < 0 || r->samples == 0) continue;
+        measured++;
+        ewma_sum += r->ewma_us;
+        if (r->ewma_us < ewma_min) ewma_min = r->ewma_us;
+        if (r->ewma_us > ewma_max) ewma_max = r->ewma_us;
+        if (r->max_us > peak) peak = r->max_us;
+    }
+    if (measured == 0) return;
+    printf("[Heartbeat] RTT 측정 연결 %d개 (응답 %llu회, 무시 %llu회): 평균 %.2fms, 연결별 %.2f~%.2fms, 최대 표본 %.2fms\n",
+           measured, (unsigned long long)hb->echoes, (unsigned long long)hb->stale_echoes,
+           ewma_sum / 1000.0 / measured, ewma_min / 1000.0, ewma_max / 1000.0, peak / 1000.0);
+}
@@ -0,0 +1,117 @@
+// baseball_heartbeat.h - 트래픽을 고려한 연결별 하트비트 스케줄러
+// 연결마다 마지막 송신 시각을 기록해 두고, 한 주기 내내 아무것도 보내지 않은 연결에만 하트비트를 보낸다.
+// 게임 메시지가 오가는 연결은 그 메시지가 곧 생존 신호이므로 하트비트를 생략한다.
+// 마감 시각은 연결마다 지터를 더해 흩어 두고 타이밍 휠로 관리하므로,
+// 연결이 많아도 한 순간에 몰리지 않고 매 반복 마감이 된 연결만 살펴본다.
+// 하트비트에는 단조 시계 타임스탬프를 담고, 클라이언트가 그대로 돌려주면 왕복 시간(RTT)을 잰다.
+#ifndef BASEBALL_HEARTBEAT_H
+#define BASEBALL_HEARTBEAT_H
+
+#include <stdint.h>
+#include <sys/select.h>
+
+// ──────────────────────────────────────────────────────────
+// 1) 스케줄러 설정 상수
+// ──────────────────────────────────────────────────────────
+#define HEARTBEAT_JITTER_DIV    4       // 지터 최대값 = 주기 / 4 (주기 10초면 0~2.5초)
+#define HEARTBEAT_SLOT_MS       100     // 타이밍 휠 칸 하나의 길이
+#define HEARTBEAT_WHEEL_SLOTS   256     // 휠 한 바퀴 = 25.6초 (주기 + 지터보다 길어야 함)
+#define HEARTBEAT_RTT_SHIFT     3       // RTT 이동 평균 가중치 1/8 (TCP SRTT와 같은 값)
+#define HEARTBEAT_STAMP_LEN     24      // 타임스탬프 문자열 (단조 시계 마이크로초, 10진수)
+
+// ──────────────────────────────────────────────────────────
+// 2) 스케줄러 구조
+//    휠의 칸마다 fd 이중 연결 리스트 (next/prev 배열을 fd로 바로 찾음)
+//    송신할 때는 last_tx_ms만 갱신하고 휠 위치는 그대로 두며,
+//    칸이 돌아왔을 때 그 사이 송신이 있었으면 마지막 송신 기준으로 다시 예약한다.
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint64_t probe_us;                  // 응답을 기다리는 하트비트의 타임스탬프 (0: 없음)
+    uint32_t ewma_us;                   // 왕복 시간 이동 평균
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t samples;                   // 받은 응답 수
+} HeartbeatRtt;
+
+typedef struct {
+    uint64_t last_tx_ms[FD_SETSIZE];    // 마지막으로 프레임을 보낸 시각 (하트비트 포함)
+    int next[FD_SETSIZE];               // 같은 칸의 다음 fd (-1: 끝)
+    int prev[FD_SETSIZE];               // 같은 칸의 이전 fd (-1: 칸의 첫 fd)
+    int slot[FD_SETSIZE];               // 예약된 칸 (-1: 추적하지 않음)
+    int heads[HEARTBEAT_WHEEL_SLOTS];   // 칸별 첫 fd
+    HeartbeatRtt rtt[FD_SETSIZE];       // 연결별 왕복 시간 (매칭/지연 원인 구분용)
+    uint64_t cursor;                    // 다음에 처리할 칸 번호 (시각 / HEARTBEAT_SLOT_MS)
+    uint32_t interval_ms;
+    uint32_t jitter_ms;
+    uint32_t rng;                       // 지터용 xorshift 상태
+    int tracked;                        // 추적 중인 연결 수
+    uint64_t sent;                      // 보낸 하트비트 수
+    uint64_t piggybacked;               // 다른 송신이 있어 미룬 마감 수
+    uint64_t echoes;                    // RTT로 반영한 응답 수
+    uint64_t stale_echoes;              // 기다리던 타임스탬프와 다른 응답 (늦게 온 응답, 위조)
+    uint64_t reported_sent;             // 마지막 통계 출력 시점의 sent
+} HeartbeatScheduler;
+
+/**
+ * 스케줄러 초기화
+ * @param interval_ms: 이 시간 동안 송신이 없는 연결에 하트비트를 보냄
+ * @param now_ms: 루프의 단조 시각 (clock_now_ms(), 밀리초 - 이후 호출도 같은 시계)
+ */
+void heartbeat_init(HeartbeatScheduler *hb, uint32_t interval_ms, uint64_t now_ms);
+
+/**
+ * 새 연결 추적 시작 (같은 fd를 쓰던 이전 연결의 예약과 RTT 기록은 지움)
+ * 첫 마감은 now + 주기 + 지터
+ */
+void heartbeat_track(HeartbeatScheduler *hb, int fd, uint64_t now_ms);
+
+/**
+ * 연결 추적 중단 (연결을 닫을 때)
+ */
+void heartbeat_untrack(HeartbeatScheduler *hb, int fd);
+
+/**
+ * 프레임 송신 기록 - 하트비트 주기를 다시 시작 (O(1), 휠은 건드리지 않음)
+ */
+static inline void heartbeat_note_tx(HeartbeatScheduler *hb, int fd, uint64_t now_ms) {
+    if (fd >= 0 && fd < FD_SETSIZE) hb->last_tx_ms[fd] = now_ms;
+}
+
+/**
+ * 마감이 지난 칸들을 처리하고 하트비트가 필요한 연결을 out에 모음
+ * 한 주기 동안 송신이 없던 연결만 고르고 (다음 마감은 now + 주기 + 지터),
+ * 그 사이 송신이 있던 연결은 마지막 송신 + 주기 + 지터로 다시 예약
+ * @param out: 하트비트를 보낼 fd 목록 (호출자가 보낸 뒤 heartbeat_note_tx로 기록됨)
+ * @param max: out 크기 (넘치는 연결은 다음 칸으로 미룸)
+ * @return: out에 담은 fd 수
+ */
+int heartbeat_collect_due(HeartbeatScheduler *hb, uint64_t now_ms, int *out, int max);
+
+/**
+ * 하트비트 전송 기록 - 이 타임스탬프의 응답을 기다림 (아직 응답 없는 이전 하트비트는 대체)
+ * @param stamp_us: 하트비트에 담은 단조 시계 시각 (마이크로초)
+ */
+void heartbeat_probe(HeartbeatScheduler *hb, int fd, uint64_t stamp_us);
+
+/**
+ * 클라이언트가 돌려준 하트비트 타임스탬프로 RTT 갱신
+ * 기다리던 타임스탬프와 정확히 같을 때만 반영 (위조나 늦게 온 응답이 통계를 흔들지 않도록)
+ * @param timestamp: 응답의 timestamp 필드 (10진수 문자열)
+ * @param now_us: 응답을 읽은 단조 시계 시각 (루프 시각이 아닌 읽은 순간)
+ * @return: 반영했으면 0, 무시했으면 -1
+ */
+int heartbeat_echo(HeartbeatScheduler *hb, int fd, const char *timestamp, uint64_t now_us);
+
+/**
+ * 연결의 RTT 통계 (samples가 0이면 아직 측정 전)
+ */
+static inline const HeartbeatRtt *heartbeat_rtt(const HeartbeatScheduler *hb, int fd) {
+    return (fd >= 0 && fd < FD_SETSIZE) ? &hb->rtt[fd] : NULL;
+}
+
+/**
+ * 누적 통계와 추적 중인 연결들의 RTT 분포 출력 (force가 0이면 지난 출력 이후 보낸 하트비트가 있을 때만)
+ */
+void heartbeat_report(HeartbeatScheduler *hb, int force);
+
+#endif // BASEBALL_HEARTBEAT_H
@@ -0,0 +1,81 @@
+/**
+ * baseball_inbox.c - 연결별 수신 버퍼 구현
+ *
+ * 📋 동작 순서:
+ * 1) 길이 prefix 2바이트를 받을 때까지 prefix에 이어 붙임
+ * 2) 길이를 검증한 뒤 본문을 그 길이만큼 body에 이어 붙임
+ * 3) 본문이 다 차면 NUL을 붙여 길이를 돌려주고 다음 프레임을 위해 비움
+ *
+ * 한 호출에서 한 프레임 경계를 넘겨 읽지 않으므로, 뒤따르는 프레임은 커널 버퍼에 남아
+ * select()가 다시 읽기 가능으로 알려 준다 (호출자는 프레임마다 한 번씩 부르면 됨).
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "baseball_inbox.h"
+
+InboxStats inbox_stats;
+
+/**
+ * 남은 바이트를 non-blocking으로 받기
+ * @return: 받은 바이트 수 (0 이상), 닫힘/오류면 InboxResult
+ */
+static int recv_some(int fd, void *dst, size_t want) {
+    for (;;) {
+        ssize_t n = recv(fd, dst, want, MSG_DONTWAIT);
+        if (n > 0) return (int)n;
+        if (n == 0) return INBOX_CLOSED;
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        return INBOX_ERROR;
+    }
+}
+
+int inbox_read(Inbox *ib, int fd) {
+    // 1단계: 길이 prefix
+    if (ib->have < 2) {
+        int n = recv_some(fd, ib->prefix + ib->have, 2 - ib->have);
+        if (n < 0) return n;
+        ib->have += (uint16_t)n;
+        if (ib->have < 2) {
+            if (ib->have > 0) inbox_stats.partial++;
+            return INBOX_PARTIAL;
+        }
+        uint16_t netlen;
+        memcpy(&netlen, ib->prefix, sizeof(netlen));
+        ib->len = ntohs(netlen);
+        if (ib->len == 0 || ib->len > BUF_SIZE) return INBOX_BAD_LEN;
+    }
+
+    // 2단계: 본문 (prefix를 받은 읽기 이벤트에서 본문까지 와 있으면 바로 이어서)
+    int got = ib->have - 2;
+    if (got < ib->len) {
+        int n = recv_some(fd, ib->body + got, ib->len - got);
+        if (n < 0) return n;
+        ib->have += (uint16_t)n;
+        got += n;
+        if (got < ib->len) {
+            inbox_stats.partial++;
+            return INBOX_PARTIAL;
+        }
+    }
+
+    // 3단계: 완성 - 본문은 다음 호출 전까지 유효
+    ib->body[ib->len] = '\0';
+    ib->have = 0;
+    inbox_stats.frames++;
+    return ib->len;
+}
+
+void inbox_report(int force) {
+    if (!force && inbox_stats.partial == inbox_stats.reported) return;
+    inbox_stats.reported = inbox_stats.partial;
+    printf("[Inbox] 조립 완료 프레임 %llu개, 프레임 중간에서 멈춘 읽기 %llu회\n",
+           (unsigned long long)inbox_stats.frames, (unsigned long long)inbox_stats.partial);
+}
@@ -0,0 +1,69 @@
+// baseball_inbox.h - 연결별 수신 버퍼 (non-blocking 소켓에서 프레임 조립)
+// 소켓은 항상 non-blocking으로 두고, 읽기 이벤트마다 받을 수 있는 만큼만 읽어 프레임을 이어 붙인다.
+// 길이 prefix만 보내고 본문을 보내지 않는 상대가 있어도 이벤트 루프는 막히지 않고,
+// 조립 중인 프레임은 그 연결의 버퍼에 남아 다음 읽기 이벤트에서 이어진다. (송신 쪽 Outbox의 offset과 같은 역할)
+#ifndef BASEBALL_INBOX_H
+#define BASEBALL_INBOX_H
+
+#include <stdint.h>
+
+#include "baseball_protocol.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 수신 결과
+// ──────────────────────────────────────────────────────────
+typedef enum {
+    INBOX_PARTIAL = 0,              // 프레임 일부만 도착 (나머지는 다음 읽기 이벤트에서)
+    INBOX_CLOSED  = -1,             // 상대가 연결을 닫음
+    INBOX_ERROR   = -2,             // 수신 오류 (errno)
+    INBOX_BAD_LEN = -3              // 길이 prefix가 0이거나 BUF_SIZE 초과
+} InboxResult;
+
+// ──────────────────────────────────────────────────────────
+// 2) 수신 버퍼: [2바이트 길이] + [본문]을 받는 대로 채움
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint16_t have;                  // 지금 프레임에서 받은 바이트 수 (길이 prefix 포함)
+    uint16_t len;                   // 본문 길이 (prefix 2바이트를 받은 뒤 유효)
+    unsigned char prefix[2];
+    char body[BUF_SIZE + 1];        // 본문 + NUL
+} Inbox;
+
+/**
+ * 전체 수신 버퍼 통계 (주기 출력용)
+ */
+typedef struct {
+    uint64_t frames;                // 조립을 마친 프레임 수
+    uint64_t partial;               // 프레임 중간에서 멈춘 읽기 수 (느린/악의적 송신자 지표)
+    uint64_t reported;              // 마지막 출력 시점의 partial
+} InboxStats;
+
+extern InboxStats inbox_stats;
+
+/**
+ * 새 연결용 초기화
+ */
+static inline void inbox_reset(Inbox *ib) {
+    ib->have = 0;
+    ib->len = 0;
+}
+
+/**
+ * 프레임 하나를 완성할 때까지만 읽기 (MSG_DONTWAIT - 소켓에 남은 다음 프레임은 다음 읽기 이벤트로)
+ * @return: 완성된 본문 길이 (> 0, ib->body에 NUL로 끝남 - 다음 호출 전까지 유효), 또는 InboxResult
+ */
+int inbox_read(Inbox *ib, int fd);
+
+/**
+ * 조립 중인 프레임이 있는지 (무중단 재시작 전 확인용)
+ */
+static inline int inbox_pending(const Inbox *ib) {
+    return ib->have > 0;
+}
+
+/**
+ * 통계 출력 (force가 0이면 지난 출력 이후 멈춘 읽기가 있을 때만)
+ */
+void inbox_report(int force);
+
+#endif // BASEBALL_INBOX_H
@@ -0,0 +1,306 @@
+/**
+ * baseball_journal.c - mmap 기반 append-only 경기 저널 구현
+ *
+ * 📋 동작 방식:
+ * - 파일 = [64바이트 헤더] + [32바이트 레코드 × capacity]
+ * - 파일을 미리 할당(fallocate)하고 MAP_SHARED로 매핑하여
+ *   레코드 추가는 메모리 복사 + 헤더 count 증가만으로 끝남
+ * - 이벤트 루프는 배치 단위로 msync(MS_ASYNC)만 요청 (블로킹 없음)
+ * - 실제 디스크 동기화(fdatasync)는 백그라운드 스레드가 주기적으로 수행
+ * - 용량이 차면 JOURNAL_CHUNK_RECORDS 단위로 파일을 늘리고 다시 매핑
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "baseball_journal.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 현재 시각 (epoch 밀리초)
+ */
+static uint64_t journal_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * 레코드 수에 해당하는 파일 크기
+ */
+static size_t journal_file_size(uint64_t capacity) {
+    return sizeof(JournalHeader) + capacity * sizeof(JournalRecord);
+}
+
+/**
+ * 파일 공간 사전 할당 (디스크 블록까지 확보하여 쓰기 중 ENOSPC/SIGBUS 방지)
+ */
+static int journal_preallocate(int fd, size_t size) {
+#ifdef __linux__
+    int err = posix_fallocate(fd, 0, size);
+    if (err == 0) return 0;
+    if (err != EOPNOTSUPP && err != EINVAL) {
+        errno = err;
+        return -1;
+    }
+#endif
+    return ftruncate(fd, size);
+}
+
+/**
+ * 파일 전체를 매핑하고 헤더/레코드 포인터 설정
+ */
+static int journal_map(Journal *j, size_t size) {
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, j->fd, 0);
+    if (map == MAP_FAILED) return -1;
+    j->map = map;
+    j->map_size = size;
+    j->header = (JournalHeader *)map;
+    j->records = (JournalRecord *)(j->map + sizeof(JournalHeader));
+    return 0;
+}
+
+/**
+ * 용량이 가득 찬 경우 파일 확장 후 다시 매핑
+ * 새 매핑이 만들어진 뒤에만 기존 매핑을 해제 (실패하면 기존 매핑은 그대로 두고
+ * 저널을 닫아 fd < 0으로 - 이후 기록은 모두 건너뜀)
+ */
+static int journal_grow(Journal *j) {
+    uint64_t new_capacity = j->header->capacity + JOURNAL_CHUNK_RECORDS;
+    size_t new_size = journal_file_size(new_capacity);
+    char *old_map = j->map;
+    size_t old_size = j->map_size;
+
+    if (journal_preallocate(j->fd, new_size) < 0 || journal_map(j, new_size) < 0) {
+        printf("[Journal] 저널 파일 확장 실패: %s - 저널 기록을 중단합니다\n", strerror(errno));
+        journal_close(j);
+        return -1;
+    }
+
+    // 확장 전까지 기록된 내용은 커널에 넘겨두고 기존 매핑 해제
+    msync(old_map, old_size, MS_ASYNC);
+    munmap(old_map, old_size);
+    j->header->capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * 백그라운드 동기화 스레드
+ * 이벤트 루프 대신 주기적으로 fdatasync를 수행하여 디스크 지연을 흡수
+ */
+static void *journal_sync_main(void *arg) {
+    Journal *j = arg;
+
+    pthread_mutex_lock(&j->lock);
+    while (j->sync_running) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += JOURNAL_SYNC_INTERVAL_MS / 1000;
+        deadline.tv_nsec += (JOURNAL_SYNC_INTERVAL_MS % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&j->cond, &j->lock, &deadline);
+
+        // fd 기반 동기화이므로 매핑 재생성과 경쟁하지 않음
+        pthread_mutex_unlock(&j->lock);
+        fdatasync(j->fd);
+        pthread_mutex_lock(&j->lock);
+    }
+    pthread_mutex_unlock(&j->lock);
+    return NULL;
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+int journal_open(Journal *j, const char *path) {
+    memset(j, 0, sizeof(*j));
+    j->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (j->fd < 0) {
+        printf("[Journal] 저널 파일 열기 실패 (%s): %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(j->fd, &st) < 0) goto fail;
+
+    if (st.st_size == 0) {
+        // 새 저널: 헤더 작성 및 첫 청크 사전 할당
+        size_t size = journal_file_size(JOURNAL_CHUNK_RECORDS);
+        if (journal_preallocate(j->fd, size) < 0 || journal_map(j, size) < 0) goto fail;
+        memcpy(j->header->magic, JOURNAL_MAGIC, sizeof(j->header->magic));
+        j->header->version = JOURNAL_VERSION;
+        j->header->record_size = sizeof(JournalRecord);
+        j->header->capacity = JOURNAL_CHUNK_RECORDS;
+        j->header->count = 0;
+    } else {
+        // 기존 저널: 헤더 검증 후 이어서 기록
+        if ((size_t)st.st_size < sizeof(JournalHeader) || journal_map(j, st.st_size) < 0) goto fail;
+        if (memcmp(j->header->magic, JOURNAL_MAGIC, sizeof(j->header->magic)) != 0 ||
+            j->header->record_size != sizeof(JournalRecord) ||
+            journal_file_size(j->header->capacity) > (size_t)st.st_size ||
+            j->header->count > j->header->capacity) {
+            printf("[Journal] 저널 파일 형식이 올바르지 않습니다: %s\n", path);
+            errno = EINVAL;
+            goto fail;
+        }
+    }
+
+    j->flushed_count = j->header->count;
+    j->last_flush_ms = 0;  // 호출자의 단조 시계 기준 - 첫 확인에서 밀린 레코드가 있으면 바로 flush
+
+    pthread_mutex_init(&j->lock, NULL);
+    pthread_cond_init(&j->cond, NULL);
+    j->sync_running = 1;
+    if (pthread_create(&j->sync_thread, NULL, journal_sync_main, j) != 0) {
+        j->sync_running = 0;
+        pthread_mutex_destroy(&j->lock);
+        pthread_cond_destroy(&j->cond);
+        goto fail;
+    }
+
+    printf("[Journal] 저널 열기 완료: %s (기존 레코드 %llu개)\n",
+           path, (unsigned long long)j->header->count);
+    return 0;
+
+fail:
+    if (j->map) munmap(j->map, j->map_size);
+    close(j->fd);
+    j->fd = -1;
+    j->map = NULL;
+    return -1;
+}
+
+void journal_close(Journal *j) {
+    if (j->fd < 0) return;
+
+    // 동기화 스레드 종료
+    pthread_mutex_lock(&j->lock);
+    j->sync_running = 0;
+    pthread_cond_signal(&j->cond);
+    pthread_mutex_unlock(&j->lock);
+    pthread_join(j->sync_thread, NULL);
+    pthread_mutex_destroy(&j->lock);
+    pthread_cond_destroy(&j->cond);
+
+    // 남은 레코드를 동기적으로 디스크에 반영
+    msync(j->map, j->map_size, MS_SYNC);
+    fdatasync(j->fd);
+    munmap(j->map, j->map_size);
+    close(j->fd);
+    j->fd = -1;
+    j->map = NULL;
+}
+
+int journal_append(Journal *j, const JournalRecord *rec) {
+    if (j->fd < 0) return -1;
+    if (j->header->count >= j->header->capacity && journal_grow(j) < 0) return -1;
+
+    // 레코드를 먼저 쓰고 count를 증가시켜 커밋 (count 이하만 유효)
+    j->records[j->header->count] = *rec;
+    if (j->records[j->header->count].timestamp_ms == 0) {
+        j->records[j->header->count].timestamp_ms = journal_now_ms();
+    }
+    j->header->count++;
+    return 0;
+}
+
+void journal_flush_if_due(Journal *j, uint64_t now_ms) {
+    if (j->fd < 0) return;
+
+    uint64_t pending = j->header->count - j->flushed_count;
+    if (pending == 0) return;
+
+    if (pending < JOURNAL_FLUSH_BATCH && now_ms - j->last_flush_ms < JOURNAL_FLUSH_INTERVAL_MS) {
+        return;
+    }
+
+    // 새로 기록된 레코드 구간만 페이지 단위로 맞춰 비동기 flush 요청
+    long page = sysconf(_SC_PAGESIZE);
+    size_t start = sizeof(JournalHeader) + j->flushed_count * sizeof(JournalRecord);
+    size_t end = sizeof(JournalHeader) + j->header->count * sizeof(JournalRecord);
+    start -= start % page;
+    msync(j->map + start, end - start, MS_ASYNC);
+    msync(j->map, sizeof(JournalHeader), MS_ASYNC);  // 헤더의 count 갱신
+
+    j->flushed_count = j->header->count;
+    j->last_flush_ms = now_ms;
+}
+
+uint32_t journal_last_match_id(const Journal *j) {
+    if (j->fd < 0 || j->header->count == 0) return 0;
+    return j->records[j->header->count - 1].match_id;
+}
+
+void *journal_map_readonly(const char *path, const JournalRecord **out_records,
+                           uint64_t *out_count, size_t *out_map_size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("[Journal] 저널 파일 열기 실패 (%s): %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(JournalHeader)) {
+        printf("[Journal] 저널 파일이 비어 있거나 읽을 수 없습니다: %s\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // 매핑은 fd를 닫아도 유지됨
+    if (map == MAP_FAILED) {
+        printf("[Journal] 저널 매핑 실패: %s\n", strerror(errno));
+        return NULL;
+    }
+
+    const JournalHeader *hdr = map;
+    if (memcmp(hdr->magic, JOURNAL_MAGIC, sizeof(hdr->magic)) != 0 ||
+        hdr->record_size != sizeof(JournalRecord) ||
+        journal_file_size(hdr->count) > (size_t)st.st_size) {
+        printf("[Journal] 저널 파일 형식이 올바르지 않습니다: %s\n", path);
+        munmap(map, st.st_size);
+        return NULL;
+    }
+
+    *out_records = (const JournalRecord *)((const char *)map + sizeof(JournalHeader));
+    *out_count = hdr->count;
+    *out_map_size = st.st_size;
+    return map;
+}
+
+void journal_unmap_readonly(void *map, size_t map_size) {
+    if (map) munmap(map, map_size);
+}
+
+const char *journal_event_name(uint8_t type) {
+    switch (type) {
+        case JOURNAL_CONNECT:    return "connect";
+        case JOURNAL_DISCONNECT: return "disconnect";
+        case JOURNAL_GAME_START: return "game_start";
+        case JOURNAL_SET_NUMBER: return "set_number";
+        case JOURNAL_GUESS:      return "guess";
+        case JOURNAL_GAME_OVER:  return "game_over";
+        case JOURNAL_SERVER_START: return "server_start";
+        case JOURNAL_RESUME:     return "resume";
+        case JOURNAL_HANDOFF:    return "handoff";
+        case JOURNAL_ROOM_OPEN:  return "room_open";
+        case JOURNAL_RESTORE:    return "restore";
+        default:                 return "unknown";
+    }
+}
@@ -0,0 +1,139 @@
+// baseball_journal.h - 경기 이벤트 저널 (append-only, mmap 기반)
+// 모든 방 이벤트를 고정 크기 레코드로 미리 할당된 파일에 순차 기록한다.
+#ifndef BASEBALL_JOURNAL_H
+#define BASEBALL_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+// ──────────────────────────────────────────────────────────
+// 1) 저널 설정 상수
+// ──────────────────────────────────────────────────────────
+#define JOURNAL_MAGIC               "BBJRNL01"  // 파일 식별자 (8바이트)
+#define JOURNAL_VERSION             1
+#define JOURNAL_CHUNK_RECORDS       65536       // 파일 확장 단위 (레코드 수, 2MB)
+#define JOURNAL_FLUSH_BATCH         4096        // 이 개수만큼 쌓이면 비동기 flush 요청
+#define JOURNAL_FLUSH_INTERVAL_MS   200         // flush 요청 최대 간격 (밀리초)
+#define JOURNAL_SYNC_INTERVAL_MS    1000        // 백그라운드 fdatasync 간격 (밀리초)
+
+// ──────────────────────────────────────────────────────────
+// 2) 저널 이벤트 종류
+// ──────────────────────────────────────────────────────────
+typedef enum {
+    JOURNAL_CONNECT = 1,     // 플레이어 접속 (좌석 배정)
+    JOURNAL_DISCONNECT,      // 플레이어 연결 해제
+    JOURNAL_GAME_START,      // 게임 시작 (숫자 설정 단계 진입)
+    JOURNAL_SET_NUMBER,      // 비밀 숫자 설정
+    JOURNAL_GUESS,           // 추측 및 결과 (스트라이크/볼)
+    JOURNAL_GAME_OVER,       // 게임 종료 (player_id = 승자)
+    JOURNAL_SERVER_START,    // 서버 (재)시작 - 이전 방 상태는 모두 사라짐
+    JOURNAL_RESUME,          // 연결 끊긴 플레이어가 재접속 토큰으로 좌석 복귀
+    JOURNAL_HANDOFF,         // 무중단 재시작 - 새 프로세스가 방 상태를 그대로 인수
+    JOURNAL_ROOM_OPEN,       // 토너먼트 경기 방 배정 - 해당 room_id의 방을 비우고 새 경기 준비
+    JOURNAL_RESTORE          // 크래시 복구 - 해당 방을 snapshot_seq 시점 상태로 되돌린 뒤 좌석을 재접속 대기로
+} JournalEventType;
+
+// ──────────────────────────────────────────────────────────
+// 3) 저널 레코드 (32바이트 고정 크기)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint64_t timestamp_ms;   // 이벤트 발생 시각 (epoch 밀리초)
+    uint32_t match_id;       // 경기 번호
+    uint16_t room_id;        // 방 번호
+    uint8_t  type;           // JournalEventType
+    uint8_t  player_id;      // 이벤트 주체 플레이어 (게임 종료 시 승자)
+    char     number[4];      // 설정/추측한 숫자 (3자리 + null)
+    uint8_t  strikes;        // 스트라이크 수 (JOURNAL_GUESS)
+    uint8_t  balls;          // 볼 수 (JOURNAL_GUESS)
+    uint16_t attempts;       // 누적 시도 횟수 (JOURNAL_GUESS)
+    uint8_t  target;         // 추측 대상 플레이어 (JOURNAL_GUESS)
+    uint8_t  capacity;       // 방 정원 (0: 정원 기록 이전 저널 = 2명)
+    uint16_t remaining;      // 추측 후 대상의 남은 후보 수 (JOURNAL_GUESS, 0: 기록 이전 저널)
+    uint32_t snapshot_seq;   // 복원한 스냅샷 시점의 저널 레코드 수 (JOURNAL_RESTORE)
+} JournalRecord;
+
+// ──────────────────────────────────────────────────────────
+// 4) 저널 파일 헤더 (64바이트, 파일 맨 앞)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    char     magic[8];       // JOURNAL_MAGIC
+    uint32_t version;        // JOURNAL_VERSION
+    uint32_t record_size;    // sizeof(JournalRecord)
+    uint64_t capacity;       // 파일에 할당된 레코드 수
+    uint64_t count;          // 기록 완료된 레코드 수 (커밋 지점)
+    uint8_t  reserved[32];
+} JournalHeader;
+
+// ──────────────────────────────────────────────────────────
+// 5) 저널 핸들
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    int fd;                          // 저널 파일 디스크립터 (-1: 비활성)
+    char *map;                       // mmap 영역 시작 주소
+    size_t map_size;                 // mmap 영역 크기
+    JournalHeader *header;           // 헤더 포인터 (map 시작)
+    JournalRecord *records;          // 레코드 배열 시작
+    uint64_t flushed_count;          // 마지막 flush 요청 시점의 레코드 수
+    uint64_t last_flush_ms;          // 마지막 flush 요청 시각 (호출자의 단조 시계)
+    pthread_t sync_thread;           // 백그라운드 fdatasync 스레드
+    pthread_mutex_t lock;            // sync 스레드 종료 신호 보호
+    pthread_cond_t cond;
+    int sync_running;                // sync 스레드 동작 여부
+} Journal;
+
+/**
+ * 저널 파일 열기 (없으면 생성 및 사전 할당)
+ * 기존 파일이면 헤더를 검증하고 마지막 레코드 뒤부터 이어서 기록
+ * @param j: 저널 핸들
+ * @param path: 저널 파일 경로
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int journal_open(Journal *j, const char *path);
+
+/**
+ * 저널 닫기 (남은 레코드를 동기 flush 후 해제)
+ */
+void journal_close(Journal *j);
+
+/**
+ * 레코드 추가 (mmap 영역에 복사만 하므로 디스크 I/O로 블로킹되지 않음)
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int journal_append(Journal *j, const JournalRecord *rec);
+
+/**
+ * 배치 크기 또는 시간 간격을 넘었으면 비동기 flush(msync MS_ASYNC) 요청
+ * 이벤트 루프에서 매 반복마다 호출
+ * @param now_ms: 루프의 단조 시각 (clock_now_ms() - 시스템 시각 변경과 무관하게 간격 판정)
+ */
+void journal_flush_if_due(Journal *j, uint64_t now_ms);
+
+/**
+ * 마지막으로 기록된 경기 번호 (서버 재시작 시 경기 번호를 이어가기 위함)
+ * @return: 기록이 없으면 0
+ */
+uint32_t journal_last_match_id(const Journal *j);
+
+/**
+ * 저널 파일을 읽기 전용으로 매핑 (리플레이/분석 도구용)
+ * @param path: 저널 파일 경로
+ * @param out_records: 레코드 배열 시작 주소
+ * @param out_count: 레코드 수
+ * @param out_map_size: 매핑 크기 (journal_unmap_readonly에 전달)
+ * @return: 매핑 시작 주소, 실패 시 NULL
+ */
+void *journal_map_readonly(const char *path, const JournalRecord **out_records,
+                           uint64_t *out_count, size_t *out_map_size);
+
+/**
+ * journal_map_readonly로 얻은 매핑 해제
+ */
+void journal_unmap_readonly(void *map, size_t map_size);
+
+/**
+ * 이벤트 종류 이름 문자열
+ */
+const char *journal_event_name(uint8_t type);
+
+#endif // BASEBALL_JOURNAL_H
@@ -0,0 +1,290 @@
+/**
+ * baseball_leaderboard.c - 영구 리더보드 구현
+ *
+ * 📋 자료 구조:
+ * - 해시 슬롯: 이름 → 통계, FNV-1a 해시 + 선형 탐사 (오픈 어드레싱)
+ * - Fenwick 트리: 승수별 인원 수 → "나보다 승수가 많은 인원"을 O(log W)로 계산
+ * - 상위 K 인덱스: 순위 순으로 정렬된 슬롯 번호 배열, 승리할 때만 위로 이동
+ *
+ * 순위 기준은 승수 내림차순, 동률이면 그 승수에 먼저 도달한 쪽이 위.
+ * 점수가 줄어드는 경우가 없으므로 상위 K 인덱스는 전체 스캔 없이 정확하게 유지된다.
+ *
+ * 파일은 MAP_SHARED로 매핑되어 갱신 즉시 페이지 캐시에 반영되며
+ * (프로세스가 죽어도 유지), 디스크 동기화는 닫을 때 수행한다.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "baseball_leaderboard.h"
+
+// ──────────────────────────────────────────────────────────
+// 파일 레이아웃 계산
+// ──────────────────────────────────────────────────────────
+#define LB_ALIGN(x)         (((x) + 63) & ~(size_t)63)
+#define LB_FENWICK_OFFSET   LB_ALIGN(sizeof(LeaderboardHeader))
+#define LB_FENWICK_SIZE     ((size_t)(LEADERBOARD_MAX_WINS + 1) * sizeof(uint32_t))
+#define LB_ENTRIES_OFFSET   LB_ALIGN(LB_FENWICK_OFFSET + LB_FENWICK_SIZE)
+#define LB_FILE_SIZE        (LB_ENTRIES_OFFSET + (size_t)LEADERBOARD_CAPACITY * sizeof(LeaderboardEntry))
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 이름 해시 (FNV-1a 32비트)
+ */
+static uint32_t name_hash(const char *name) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * 이름으로 슬롯 찾기 (선형 탐사)
+ * @param create: 없으면 빈 슬롯에 새로 등록
+ * @return: 슬롯 번호, 없거나 가득 차면 -1
+ */
+static int32_t find_slot(Leaderboard *lb, const char *name, int create) {
+    uint32_t mask = lb->header->capacity - 1;
+    uint32_t idx = name_hash(name) & mask;
+
+    for (uint32_t probe = 0; probe < lb->header->capacity; probe++, idx = (idx + 1) & mask) {
+        LeaderboardEntry *e = &lb->entries[idx];
+        if (e->name[0] == '\0') {
+            if (!create) return -1;
+            if (lb->header->count >= LEADERBOARD_MAX_LOAD) {
+                printf("[Leaderboard] 등록 인원이 가득 찼습니다 - '%s' 기록 생략\n", name);
+                return -1;
+            }
+            memset(e, 0, sizeof(*e));
+            snprintf(e->name, sizeof(e->name), "%s", name);
+            e->topk_pos = -1;
+            e->reached_seq = ++lb->header->seq;
+            lb->header->count++;
+            return (int32_t)idx;
+        }
+        if (strncmp(e->name, name, sizeof(e->name)) == 0) return (int32_t)idx;
+    }
+    return -1;
+}
+
+/**
+ * 읽기 전용 슬롯 조회
+ */
+static int32_t lookup_slot(const Leaderboard *lb, const char *name) {
+    return find_slot((Leaderboard *)lb, name, 0);
+}
+
+/**
+ * Fenwick 트리 위치 (승수 → 1-based 인덱스, 상한 적용)
+ */
+static uint32_t fenwick_index(uint32_t wins) {
+    return (wins > LEADERBOARD_MAX_WINS ? LEADERBOARD_MAX_WINS : wins) + 1;
+}
+
+static void fenwick_add(Leaderboard *lb, uint32_t wins, int32_t delta) {
+    for (uint32_t i = fenwick_index(wins); i <= LEADERBOARD_MAX_WINS + 1; i += i & (~i + 1)) {
+        lb->fenwick[i - 1] += delta;
+    }
+}
+
+static uint32_t fenwick_prefix(const Leaderboard *lb, uint32_t idx) {
+    uint32_t sum = 0;
+    for (uint32_t i = idx; i > 0; i -= i & (~i + 1)) {
+        sum += lb->fenwick[i - 1];
+    }
+    return sum;
+}
+
+/**
+ * a가 b보다 순위가 높은지 (승수 내림차순, 동률이면 먼저 도달한 쪽)
+ */
+static int ranks_above(const LeaderboardEntry *a, const LeaderboardEntry *b) {
+    if (a->wins != b->wins) return a->wins > b->wins;
+    return a->reached_seq < b->reached_seq;
+}
+
+/**
+ * 점수가 오른 슬롯을 상위 K 인덱스에 반영 (삽입 또는 위로 이동)
+ */
+static void topk_promote(Leaderboard *lb, uint32_t slot) {
+    LeaderboardHeader *h = lb->header;
+    LeaderboardEntry *e = &lb->entries[slot];
+    int32_t pos = e->topk_pos;
+
+    if (pos < 0) {
+        if (h->topk_count < LEADERBOARD_TOP_K) {
+            pos = h->topk_count++;
+        } else {
+            // 가득 찼으면 꼴찌보다 높을 때만 꼴찌를 밀어내고 진입
+            LeaderboardEntry *last = &lb->entries[h->topk[LEADERBOARD_TOP_K - 1]];
+            if (!ranks_above(e, last)) return;
+            last->topk_pos = -1;
+            pos = LEADERBOARD_TOP_K - 1;
+        }
+        h->topk[pos] = slot;
+        e->topk_pos = pos;
+    }
+
+    // 바로 위 순위보다 높으면 자리 교환 (삽입 정렬 한 단계)
+    while (pos > 0 && ranks_above(e, &lb->entries[h->topk[pos - 1]])) {
+        uint32_t above = h->topk[pos - 1];
+        h->topk[pos] = above;
+        lb->entries[above].topk_pos = pos;
+        pos--;
+    }
+    h->topk[pos] = slot;
+    e->topk_pos = pos;
+}
+
+/**
+ * 한 플레이어의 경기 결과 반영
+ */
+static void record_one(Leaderboard *lb, const char *name, int won, int attempts) {
+    if (!name || !name[0]) return;  // 익명 플레이어
+
+    int32_t slot = find_slot(lb, name, 1);
+    if (slot < 0) return;
+    LeaderboardEntry *e = &lb->entries[slot];
+    int is_new = e->wins == 0 && e->losses == 0;
+
+    if (won) {
+        if (!is_new) fenwick_add(lb, e->wins, -1);
+        e->wins++;
+        e->reached_seq = ++lb->header->seq;
+        fenwick_add(lb, e->wins, 1);
+    } else {
+        e->losses++;
+        if (is_new) fenwick_add(lb, 0, 1);
+    }
+    e->total_attempts += attempts > 0 ? (uint64_t)attempts : 0;
+
+    // 새 플레이어(빈자리가 있을 때) 또는 승리한 플레이어만 인덱스가 바뀜
+    if (won || is_new) topk_promote(lb, slot);
+}
+
+/**
+ * 슬롯 → 조회 결과 행
+ */
+static void fill_row(const Leaderboard *lb, uint32_t slot, LeaderboardRow *row) {
+    const LeaderboardEntry *e = &lb->entries[slot];
+    memcpy(row->name, e->name, PLAYER_NAME_LEN);  // 등록 시 길이 검사 완료
+    row->name[PLAYER_NAME_LEN] = '\0';
+    row->wins = e->wins;
+    row->losses = e->losses;
+    uint32_t games = e->wins + e->losses;
+    row->avg_attempts = games ? (double)e->total_attempts / games : 0.0;
+
+    if (e->topk_pos >= 0) {
+        row->rank = e->topk_pos + 1;
+    } else {
+        // 상위 K 밖: 나보다 승수가 많은 인원 + 1 (같은 승수는 공동 순위)
+        uint32_t total = fenwick_prefix(lb, LEADERBOARD_MAX_WINS + 1);
+        row->rank = total - fenwick_prefix(lb, fenwick_index(e->wins)) + 1;
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+int leaderboard_open(Leaderboard *lb, const char *path) {
+    memset(lb, 0, sizeof(*lb));
+    lb->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (lb->fd < 0) {
+        printf("[Leaderboard] 리더보드 파일 열기 실패 (%s): %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(lb->fd, &st) < 0) goto fail;
+    int is_new = st.st_size == 0;
+    if (is_new && ftruncate(lb->fd, LB_FILE_SIZE) < 0) goto fail;
+    if (!is_new && (size_t)st.st_size != LB_FILE_SIZE) {
+        printf("[Leaderboard] 리더보드 파일 크기가 올바르지 않습니다: %s\n", path);
+        goto fail;
+    }
+
+    void *map = mmap(NULL, LB_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, lb->fd, 0);
+    if (map == MAP_FAILED) goto fail;
+    lb->map = map;
+    lb->map_size = LB_FILE_SIZE;
+    lb->header = (LeaderboardHeader *)lb->map;
+    lb->fenwick = (uint32_t *)(lb->map + LB_FENWICK_OFFSET);
+    lb->entries = (LeaderboardEntry *)(lb->map + LB_ENTRIES_OFFSET);
+
+    if (is_new) {
+        // 새 파일은 0으로 채워져 있으므로 헤더만 작성
+        memcpy(lb->header->magic, LEADERBOARD_MAGIC, sizeof(lb->header->magic));
+        lb->header->version = LEADERBOARD_VERSION;
+        lb->header->capacity = LEADERBOARD_CAPACITY;
+    } else if (memcmp(lb->header->magic, LEADERBOARD_MAGIC, sizeof(lb->header->magic)) != 0 ||
+               lb->header->capacity != LEADERBOARD_CAPACITY ||
+               lb->header->topk_count > LEADERBOARD_TOP_K) {
+        printf("[Leaderboard] 리더보드 파일 형식이 올바르지 않습니다: %s\n", path);
+        goto fail;
+    }
+
+    printf("[Leaderboard] 리더보드 열기 완료: %s (플레이어 %u명)\n", path, lb->header->count);
+    return 0;
+
+fail:
+    if (lb->map) munmap(lb->map, lb->map_size);
+    close(lb->fd);
+    lb->fd = -1;
+    lb->map = NULL;
+    return -1;
+}
+
+void leaderboard_close(Leaderboard *lb) {
+    if (lb->fd < 0) return;
+    msync(lb->map, lb->map_size, MS_SYNC);
+    munmap(lb->map, lb->map_size);
+    close(lb->fd);
+    lb->fd = -1;
+    lb->map = NULL;
+}
+
+void leaderboard_record_result(Leaderboard *lb, const char *winner, int winner_attempts,
+                               const char *loser, int loser_attempts) {
+    if (lb->fd < 0) return;
+    record_one(lb, winner, 1, winner_attempts);
+    record_one(lb, loser, 0, loser_attempts);
+}
+
+int leaderboard_top(const Leaderboard *lb, int n, LeaderboardRow *out) {
+    if (lb->fd < 0) return 0;
+    if (n > (int)lb->header->topk_count) n = lb->header->topk_count;
+    for (int i = 0; i < n; i++) {
+        fill_row(lb, lb->header->topk[i], &out[i]);
+    }
+    return n < 0 ? 0 : n;
+}
+
+int leaderboard_lookup(const Leaderboard *lb, const char *name, LeaderboardRow *out) {
+    if (lb->fd < 0 || !name || !name[0]) return -1;
+    int32_t slot = lookup_slot(lb, name);
+    if (slot < 0) return -1;
+    fill_row(lb, slot, out);
+    return 0;
+}
+
+int leaderboard_valid_name(const char *name) {
+    size_t len = strlen(name);
+    if (len == 0 || len > PLAYER_NAME_LEN) return 0;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        if (*p < 0x20 || *p == 0x7f) return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,101 @@
+// baseball_leaderboard.h - 영구 리더보드 (mmap 기반 오픈 어드레싱 해시 + 상위 K 인덱스)
+// 플레이어 이름별 승/패/평균 시도 횟수를 파일에 유지하고
+// 상위 N명 조회와 개인 순위 조회를 전체 스캔 없이 처리한다.
+#ifndef BASEBALL_LEADERBOARD_H
+#define BASEBALL_LEADERBOARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "baseball_protocol.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 리더보드 설정 상수
+// ──────────────────────────────────────────────────────────
+#define LEADERBOARD_MAGIC       "BBLDRB01"  // 파일 식별자 (8바이트)
+#define LEADERBOARD_VERSION     1
+#define LEADERBOARD_CAPACITY    65536       // 해시 슬롯 수 (2의 거듭제곱)
+#define LEADERBOARD_MAX_LOAD    (LEADERBOARD_CAPACITY / 10 * 9)  // 최대 등록 인원 (적재율 90%)
+#define LEADERBOARD_TOP_K       100         // 순서대로 유지하는 상위 인원
+#define LEADERBOARD_MAX_WINS    65535       // 순위 계산용 승수 상한 (이상은 같은 구간)
+
+// ──────────────────────────────────────────────────────────
+// 2) 파일 레이아웃: [헤더] + [승수별 인원 Fenwick 트리] + [해시 슬롯 × capacity]
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    char     name[PLAYER_NAME_LEN + 8];  // 플레이어 이름 (빈 문자열: 빈 슬롯)
+    uint32_t wins;                       // 승리 수
+    uint32_t losses;                     // 패배 수
+    uint64_t total_attempts;             // 모든 경기의 추측 횟수 합 (평균 계산용)
+    uint64_t reached_seq;                // 현재 승수에 도달한 순번 (동률 시 먼저 도달한 쪽이 위)
+    int32_t  topk_pos;                   // 상위 K 인덱스 내 위치 (-1: 밖)
+    uint8_t  reserved[12];
+} LeaderboardEntry;                      // 64바이트
+
+typedef struct {
+    char     magic[8];                   // LEADERBOARD_MAGIC
+    uint32_t version;
+    uint32_t capacity;                   // 해시 슬롯 수
+    uint32_t count;                      // 등록된 플레이어 수
+    uint32_t topk_count;                 // 상위 K 인덱스에 들어 있는 인원
+    uint64_t seq;                        // reached_seq 발급 카운터
+    uint32_t topk[LEADERBOARD_TOP_K];    // 상위 K 슬롯 번호 (순위 순)
+    uint8_t  reserved[48];
+} LeaderboardHeader;
+
+// ──────────────────────────────────────────────────────────
+// 3) 리더보드 핸들 및 조회 결과
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    int fd;                              // 리더보드 파일 디스크립터 (-1: 비활성)
+    char *map;                           // mmap 영역 시작 주소
+    size_t map_size;
+    LeaderboardHeader *header;
+    uint32_t *fenwick;                   // 승수별 인원 수 (1-based, LEADERBOARD_MAX_WINS + 1칸)
+    LeaderboardEntry *entries;           // 해시 슬롯 배열
+} Leaderboard;
+
+typedef struct {
+    uint32_t rank;                       // 순위 (상위 K 밖은 승수 기준 공동 순위)
+    char name[PLAYER_NAME_LEN + 1];
+    uint32_t wins;
+    uint32_t losses;
+    double avg_attempts;                 // 경기당 평균 추측 횟수
+} LeaderboardRow;
+
+/**
+ * 리더보드 파일 열기 (없으면 생성)
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int leaderboard_open(Leaderboard *lb, const char *path);
+
+/**
+ * 리더보드 닫기 (변경 내용 동기 flush)
+ */
+void leaderboard_close(Leaderboard *lb);
+
+/**
+ * 경기 결과 반영 (승자/패자 통계, Fenwick 트리, 상위 K 인덱스를 증분 갱신)
+ * 이름이 비어 있는 쪽(익명 플레이어)은 기록하지 않음
+ */
+void leaderboard_record_result(Leaderboard *lb, const char *winner, int winner_attempts,
+                               const char *loser, int loser_attempts);
+
+/**
+ * 상위 N명 조회 (N은 LEADERBOARD_TOP_K 이하)
+ * @return: 채운 행 수
+ */
+int leaderboard_top(const Leaderboard *lb, int n, LeaderboardRow *out);
+
+/**
+ * 플레이어 한 명의 순위와 통계 조회 (해시 조회 + Fenwick 질의)
+ * @return: 찾으면 0, 기록이 없으면 -1
+ */
+int leaderboard_lookup(const Leaderboard *lb, const char *name, LeaderboardRow *out);
+
+/**
+ * 플레이어 이름 유효성 검사 (1~PLAYER_NAME_LEN 바이트, 제어 문자 불가)
+ */
+int leaderboard_valid_name(const char *name);
+
+#endif // BASEBALL_LEADERBOARD_H
@@ -0,0 +1,326 @@
+/**
+ * baseball_outbox.c - 연결별 송신 큐 구현
+ *
+ * 📋 전송 방식:
+ * - 메시지는 큐에 넣기만 하고, 이벤트 루프 반복 끝에 연결마다 밀린 메시지를 sendmsg() 한 번으로 전송
+ *   (추측 결과 + 턴 알림처럼 한 반복에 여러 메시지가 생겨도 수신자당 시스템 콜 1회)
+ * - 소켓 버퍼에 다 들어가지 않은 부분은 select() 쓰기 가능 이벤트에서 outbox_flush()로 이어서 전송
+ * - 공유 메모리 연결(ob->shm)은 sendmsg() 대신 링에 쓰기 (프레임 단위로만 쓰므로 offset은 항상 0)
+ * - 게이트웨이 세션(ob->gw)도 프레임 단위로 링크 송신 버퍼에 추가 (여러 세션이 링크의 send() 하나를 공유)
+ * - 저가치 메시지는 같은 종류가 대기 중이면 새 것으로 교체, 예산이 모자라면 먼저 버림
+ * - 필수 메시지가 예산에 들어가지 않으면 대기 중인 저가치 메시지를 모두 비우고,
+ *   그래도 모자라면 느린 소비자로 판정 (호출자가 연결 정리)
+ *
+ * 큐 맨 앞 메시지가 일부 전송된 상태면 그 메시지는 교체하거나 버리지 않는다 (프레임 경계 유지).
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "baseball_outbox.h"
+#include "baseball_shm.h"
+#include "baseball_gwlink.h"
+
+OutboxStats outbox_stats;
+
+// 송신 버퍼 등급별 블록 크기 (헤더 포함) - 턴/결과 알림, 스냅샷, 최대 메시지
+static const size_t frame_class_size[FRAME_POOL_CLASSES] = { 256, 1024, sizeof(SharedFrame) + 2 + BUF_SIZE };
+static const char *frame_class_name[FRAME_POOL_CLASSES] = { "송신 버퍼(소)", "송신 버퍼(중)", "송신 버퍼(대)" };
+static Pool frame_pools[FRAME_POOL_CLASSES];
+
+static Outbox *dirty_head;      // 이번 반복에 메시지가 들어온 송신 큐 목록
+
+// ──────────────────────────────────────────────────────────
+// 공유 송신 버퍼
+// ──────────────────────────────────────────────────────────
+
+int frame_pools_init(size_t capacity) {
+    for (int c = 0; c < FRAME_POOL_CLASSES; c++) {
+        // 큰 등급일수록 드물게 쓰이므로 적게 준비
+        if (pool_init(&frame_pools[c], frame_class_name[c], frame_class_size[c], capacity >> (2 * c)) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void frame_pools_report(void) {
+    for (int c = 0; c < FRAME_POOL_CLASSES; c++) {
+        if (frame_pools[c].block_size > 0) pool_report(&frame_pools[c]);
+    }
+}
+
+/**
+ * 크기에 맞는 등급의 풀에서 버퍼 할당
+ */
+static SharedFrame *frame_alloc(size_t size) {
+    for (int c = 0; c < FRAME_POOL_CLASSES; c++) {
+        if (size > frame_class_size[c] || frame_pools[c].block_size == 0) continue;
+        SharedFrame *f = pool_alloc(&frame_pools[c]);
+        if (f) f->size_class = (uint8_t)c;
+        return f;
+    }
+    SharedFrame *f = malloc(size);
+    if (f) f->size_class = FRAME_HEAP_CLASS;
+    return f;
+}
+
+SharedFrame *frame_from_json(struct json_object *jmsg) {
+    size_t len = 0;
+    const char *s = json_object_to_json_string_length(jmsg, JSON_C_TO_STRING_PLAIN, &len);
+    if (!s || len > UINT16_MAX) return NULL;
+
+    SharedFrame *f = frame_alloc(sizeof(SharedFrame) + 2 + len);
+    if (!f) return NULL;
+    f->refcount = 1;
+    f->msg_id = FRAME_UNTYPED;
+    f->len = 2 + len;
+
+    // 길이 prefix와 본문을 붙여 두면 전송이 send() 한 번으로 끝남
+    uint16_t netlen = htons((uint16_t)len);
+    memcpy(f->data, &netlen, 2);
+    memcpy(f->data + 2, s, len);
+    return f;
+}
+
+/**
+ * 버퍼를 할당한 곳(풀 또는 힙)에 반환
+ */
+static void frame_release(SharedFrame *f) {
+    if (f->size_class == FRAME_HEAP_CLASS) {
+        free(f);
+    } else {
+        pool_free(&frame_pools[f->size_class], f);
+    }
+}
+
+SharedFrame *frame_encode(FrameEncoder encode, const void *msg, uint8_t msg_id) {
+    // 대부분의 메시지는 가장 작은 등급에 들어가므로 크기를 미리 계산하지 않고 바로 써 봄
+    for (int c = 0; c < FRAME_POOL_CLASSES; c++) {
+        SharedFrame *f = frame_alloc(frame_class_size[c]);
+        if (!f) return NULL;
+        size_t len = encode(f->data, frame_class_size[c] - sizeof(SharedFrame), msg);
+        if (len > 0) {
+            f->refcount = 1;
+            f->msg_id = msg_id;
+            f->len = len;
+            return f;
+        }
+        frame_release(f);
+    }
+    return NULL;  // 가장 큰 등급은 BUF_SIZE 본문이 들어가는 크기 - 그보다 크면 보낼 수 없음
+}
+
+SharedFrame *frame_ref(SharedFrame *f) {
+    f->refcount++;
+    return f;
+}
+
+void frame_unref(SharedFrame *f) {
+    if (!f || --f->refcount > 0) return;
+    frame_release(f);
+}
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 교체/삭제할 수 있는 첫 위치 (맨 앞 메시지가 일부 전송됐으면 그 다음부터)
+ */
+static int first_unsent(const Outbox *ob) {
+    return ob->offset > 0 ? 1 : 0;
+}
+
+/**
+ * 아직 전송을 시작하지 않은 같은 종류의 메시지 위치
+ * @return: 원형 큐 슬롯, 없으면 -1
+ */
+static int find_kind(const Outbox *ob, int kind) {
+    for (int i = first_unsent(ob); i < ob->count; i++) {
+        int slot = (ob->head + i) % OUTBOX_QUEUE_LEN;
+        if (ob->kind[slot] == kind) return slot;
+    }
+    return -1;
+}
+
+/**
+ * 새 메시지가 예산 안에 들어가는지
+ */
+static int fits(const Outbox *ob, size_t len) {
+    return ob->count < OUTBOX_QUEUE_LEN && ob->bytes + len <= OUTBOX_BYTE_BUDGET;
+}
+
+/**
+ * 반복 끝 전송 목록에 등록 / 제거
+ */
+static void mark_dirty(Outbox *ob, int fd) {
+    ob->fd = fd;
+    if (ob->dirty) return;
+    ob->dirty = 1;
+    ob->dirty_prev = NULL;
+    ob->dirty_next = dirty_head;
+    if (dirty_head) dirty_head->dirty_prev = ob;
+    dirty_head = ob;
+}
+
+static void unmark_dirty(Outbox *ob) {
+    if (!ob->dirty) return;
+    if (ob->dirty_prev) ob->dirty_prev->dirty_next = ob->dirty_next;
+    else dirty_head = ob->dirty_next;
+    if (ob->dirty_next) ob->dirty_next->dirty_prev = ob->dirty_prev;
+    ob->dirty = 0;
+    ob->dirty_prev = ob->dirty_next = NULL;
+}
+
+/**
+ * 대기 중인 저가치 메시지를 모두 버리고 필수 메시지만 순서대로 남김
+ */
+static void evict_low_value(Outbox *ob) {
+    int kept = first_unsent(ob);
+    for (int i = kept; i < ob->count; i++) {
+        int from = (ob->head + i) % OUTBOX_QUEUE_LEN;
+        if (ob->kind[from] != OUTBOX_ESSENTIAL) {
+            ob->bytes -= ob->queue[from]->len;
+            frame_unref(ob->queue[from]);
+            outbox_stats.dropped_low++;
+            continue;
+        }
+        int to = (ob->head + kept) % OUTBOX_QUEUE_LEN;
+        ob->queue[to] = ob->queue[from];
+        ob->kind[to] = ob->kind[from];
+        kept++;
+    }
+    ob->count = kept;
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+int outbox_push(Outbox *ob, int fd, SharedFrame *f, int kind) {
+    if (kind != OUTBOX_ESSENTIAL) {
+        // 같은 종류가 아직 안 나갔으면 최신 메시지로 교체 (큐 길이와 바이트가 늘지 않음)
+        int slot = find_kind(ob, kind);
+        if (slot >= 0) {
+            ob->bytes = ob->bytes - ob->queue[slot]->len + f->len;
+            frame_unref(ob->queue[slot]);
+            ob->queue[slot] = frame_ref(f);
+            outbox_stats.coalesced++;
+            mark_dirty(ob, fd);
+            return 0;
+        }
+    }
+
+    if (!fits(ob, f->len)) {
+        if (kind != OUTBOX_ESSENTIAL) {
+            outbox_stats.dropped_low++;
+            return 0;
+        }
+        evict_low_value(ob);
+        if (!fits(ob, f->len)) {
+            outbox_stats.slow_consumers++;
+            return -1;
+        }
+    }
+
+    int slot = (ob->head + ob->count) % OUTBOX_QUEUE_LEN;
+    ob->queue[slot] = frame_ref(f);
+    ob->kind[slot] = (uint8_t)kind;
+    ob->count++;
+    ob->bytes += f->len;
+    mark_dirty(ob, fd);
+    return 0;
+}
+
+int outbox_flush(Outbox *ob, int fd) {
+    while (ob->count > 0) {
+        // 밀린 메시지 전체를 iovec 하나로 (맨 앞 메시지는 이미 보낸 부분 제외)
+        struct iovec iov[OUTBOX_QUEUE_LEN];
+        for (int i = 0; i < ob->count; i++) {
+            SharedFrame *f = ob->queue[(ob->head + i) % OUTBOX_QUEUE_LEN];
+            size_t skip = i == 0 ? ob->offset : 0;
+            iov[i].iov_base = f->data + skip;
+            iov[i].iov_len = f->len - skip;
+        }
+        struct msghdr mh = { .msg_iov = iov, .msg_iovlen = (size_t)ob->count };
+        ssize_t n = ob->shm ? shm_channel_writev(ob->shm, iov, ob->count)
+                  : ob->gw  ? gw_session_writev(ob->gw, iov, ob->count)
+                            : sendmsg(fd, &mh, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        outbox_stats.writes++;
+        ob->bytes -= n;
+
+        // 다 보낸 메시지는 큐에서 제거하고, 일부만 나간 메시지는 offset으로 표시
+        size_t sent = (size_t)n;
+        while (ob->count > 0) {
+            SharedFrame *f = ob->queue[ob->head];
+            size_t left = f->len - ob->offset;
+            if (sent < left) {
+                ob->offset += sent;
+                return 0;  // 소켓 버퍼가 가득 참 - 쓰기 가능할 때 이어서
+            }
+            sent -= left;
+            frame_unref(f);
+            ob->head = (ob->head + 1) % OUTBOX_QUEUE_LEN;
+            ob->count--;
+            ob->offset = 0;
+            outbox_stats.frames_written++;
+        }
+    }
+    return 0;
+}
+
+void outbox_flush_dirty(void) {
+    while (dirty_head) {
+        Outbox *ob = dirty_head;
+        unmark_dirty(ob);
+        if (outbox_flush(ob, ob->fd) < 0) {
+            outbox_clear(ob);
+            if (ob->shm) {
+                shm_channel_shutdown(ob->shm);
+            } else if (ob->gw) {
+                gw_session_shutdown(ob->gw);
+            } else {
+                shutdown(ob->fd, SHUT_RDWR);
+            }
+        }
+    }
+}
+
+void outbox_clear(Outbox *ob) {
+    unmark_dirty(ob);
+    while (ob->count > 0) {
+        frame_unref(ob->queue[ob->head]);
+        ob->head = (ob->head + 1) % OUTBOX_QUEUE_LEN;
+        ob->count--;
+    }
+    ob->head = 0;
+    ob->offset = 0;
+    ob->bytes = 0;
+}
+
+void outbox_report(int force) {
+    uint64_t total = outbox_stats.coalesced + outbox_stats.dropped_low + outbox_stats.slow_consumers +
+                     outbox_stats.writes;
+    if (!force && total == outbox_stats.reported) return;
+    outbox_stats.reported = total;
+    double per_write = outbox_stats.writes ? (double)outbox_stats.frames_written / outbox_stats.writes : 0.0;
+    printf("[Outbox] 쓰기 %llu회 (호출당 메시지 %.2f개), 느린 소비자 %llu회, 합친 메시지 %llu개, "
+           "버린 저가치 메시지 %llu개 (연결별 예산 %d바이트)\n",
+           (unsigned long long)outbox_stats.writes, per_write,
+           (unsigned long long)outbox_stats.slow_consumers,
+           (unsigned long long)outbox_stats.coalesced,
+           (unsigned long long)outbox_stats.dropped_low, OUTBOX_BYTE_BUDGET);
+}
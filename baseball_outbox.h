@@ -0,0 +1,165 @@
+// baseball_outbox.h - 연결별 송신 큐 (미전송 바이트 상한이 있는 non-blocking 전송)
+// 메시지는 한 번 직렬화한 참조 카운트 버퍼(SharedFrame)로 큐에 넣고, 소켓이 받아 주는 만큼만 보낸다.
+// 이벤트 루프 한 반복 동안 쌓인 메시지는 반복 끝에 연결마다 sendmsg() 한 번으로 모아 보낸다.
+// 읽지 않는 상대 때문에 send()가 막히거나 버퍼가 끝없이 쌓이지 않도록 연결마다 바이트 예산을 두고,
+// 예산을 넘으면 하트비트 같은 저가치 메시지부터 합치거나 버린 뒤, 그래도 넘치면 느린 소비자로 판정한다.
+#ifndef BASEBALL_OUTBOX_H
+#define BASEBALL_OUTBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "baseball_protocol.h"
+#include "baseball_pool.h"
+
+struct ShmChannel;
+struct GwSession;
+
+// ──────────────────────────────────────────────────────────
+// 1) 송신 큐 설정 상수
+// ──────────────────────────────────────────────────────────
+#define OUTBOX_QUEUE_LEN     64             // 연결별 미전송 메시지 수
+#define OUTBOX_BYTE_BUDGET   (32 * 1024)    // 연결별 미전송 바이트 상한 (길이 prefix 포함)
+
+// ──────────────────────────────────────────────────────────
+// 2) 공유 송신 버퍼: [2바이트 길이] + [JSON 문자열]을 한 덩어리로 보관
+//    버퍼는 크기별 슬랩 풀에서 할당 (가장 큰 등급보다 크면 malloc)
+// ──────────────────────────────────────────────────────────
+#define FRAME_POOL_CLASSES   3
+#define FRAME_HEAP_CLASS     0xFF           // 풀 밖에서 할당한 버퍼
+#define FRAME_UNTYPED        0xFF           // 스키마 밖 메시지 (json-c로 직렬화)
+
+typedef struct {
+    int refcount;                   // 이 버퍼를 참조하는 큐 + 생성자 수
+    uint8_t size_class;             // 할당한 풀 등급 (FRAME_HEAP_CLASS: malloc)
+    uint8_t msg_id;                 // 메시지 종류 (MessageId, FRAME_UNTYPED)
+    size_t len;                     // data 전체 길이 (길이 prefix 포함)
+    char data[];
+} SharedFrame;
+
+/**
+ * 송신 버퍼 풀 준비 (등급별로 capacity개씩 미리 할당)
+ * 호출하지 않으면 모든 버퍼를 malloc으로 할당
+ * @return: 성공 시 0, 메모리 부족이면 -1
+ */
+int frame_pools_init(size_t capacity);
+
+/**
+ * 송신 버퍼 풀 사용량 출력
+ */
+void frame_pools_report(void);
+
+/**
+ * JSON 메시지를 한 번 직렬화해 공유 버퍼 생성 (참조 카운트 1)
+ * @return: 생성된 버퍼, 메시지가 너무 크거나 메모리 부족이면 NULL
+ */
+SharedFrame *frame_from_json(struct json_object *jmsg);
+
+/**
+ * 스키마 인코더 (encode_<name>과 같은 모양 - 메시지 구조체만 void *로)
+ */
+typedef size_t (*FrameEncoder)(char *buf, size_t cap, const void *msg);
+
+/**
+ * 스키마 메시지를 풀 버퍼에 바로 인코딩해 공유 버퍼 생성 (참조 카운트 1)
+ * 작은 등급부터 시도하고, 넘치면 다음 등급에 다시 인코딩
+ * @return: 생성된 버퍼, 메시지가 너무 크거나 메모리 부족이면 NULL
+ */
+SharedFrame *frame_encode(FrameEncoder encode, const void *msg, uint8_t msg_id);
+
+// 메시지별 생성 함수: SharedFrame *frame_<name>(const <Type>Msg *m)
+#define FRAME_DEFINE_BUILDER(Type, name, action, FIELDS) \
+    static inline size_t frame_encode_##name(char *buf, size_t cap, const void *msg) { \
+        return encode_##name(buf, cap, msg); \
+    } \
+    static inline SharedFrame *frame_##name(const Type##Msg *m) { \
+        return frame_encode(frame_encode_##name, m, MSG_ID_##name); \
+    }
+MESSAGE_SCHEMA(FRAME_DEFINE_BUILDER)
+
+/**
+ * 참조 추가 / 해제 (마지막 참조가 해제되면 버퍼 반환)
+ */
+SharedFrame *frame_ref(SharedFrame *f);
+void frame_unref(SharedFrame *f);
+
+// ──────────────────────────────────────────────────────────
+// 3) 메시지 종류
+//    OUTBOX_ESSENTIAL 외의 종류는 저가치 메시지: 같은 종류가 아직 안 나갔으면 새 것으로 교체(합치기),
+//    예산이 부족하면 먼저 버림 (마지막 상태만 의미 있는 메시지)
+// ──────────────────────────────────────────────────────────
+typedef enum {
+    OUTBOX_ESSENTIAL = 0,           // 게임 진행 메시지 (버리지 않음 - 못 보내면 느린 소비자)
+    OUTBOX_HEARTBEAT,               // 하트비트
+    OUTBOX_TURN_UPDATE              // 관전자용 턴 변경 알림 (최신 턴만 의미 있음)
+} OutboxKind;
+
+typedef struct Outbox {
+    SharedFrame *queue[OUTBOX_QUEUE_LEN];   // 미전송 메시지 (원형 큐)
+    uint8_t kind[OUTBOX_QUEUE_LEN];         // 메시지 종류 (OutboxKind)
+    int head;
+    int count;
+    size_t offset;                          // 큐 맨 앞 메시지에서 이미 보낸 바이트 수
+    size_t bytes;                           // 미전송 바이트 (offset 제외)
+    int fd;                                 // 반복 끝 전송 대상 소켓 (dirty일 때만 유효)
+    struct ShmChannel *shm;                 // 공유 메모리 연결이면 링으로 전송 (NULL: 소켓)
+    struct GwSession *gw;                   // 게이트웨이 세션이면 링크 송신 버퍼로 전송 (NULL: 소켓)
+    int dirty;                              // 이번 반복에 새 메시지가 들어와 전송 목록에 있음
+    struct Outbox *dirty_prev;              // 전송 목록 (연결을 닫으면 O(1)로 제거)
+    struct Outbox *dirty_next;
+} Outbox;
+
+/**
+ * 전체 송신 큐 통계 (튜닝용으로 주기적으로 출력)
+ */
+typedef struct {
+    uint64_t coalesced;             // 같은 종류의 대기 메시지를 새 것으로 교체한 수
+    uint64_t dropped_low;           // 예산 부족으로 버린 저가치 메시지 수
+    uint64_t slow_consumers;        // 예산을 넘겨 느린 소비자로 판정한 연결 수
+    uint64_t writes;                // 송신 시스템 콜 수 (sendmsg)
+    uint64_t frames_written;        // 전송을 마친 메시지 수 (writes 대비 모아 보낸 정도)
+    uint64_t reported;              // 마지막 출력 시점의 이벤트 합계
+} OutboxStats;
+
+extern OutboxStats outbox_stats;
+
+/**
+ * 메시지를 큐에 넣고 이번 반복의 전송 목록에 등록 (전송은 outbox_flush_dirty()에서)
+ * @param kind: OutboxKind
+ * @return: 0 (대기), 예산 초과면 -1 (호출자가 연결 정리)
+ */
+int outbox_push(Outbox *ob, int fd, SharedFrame *f, int kind);
+
+/**
+ * 밀린 메시지를 sendmsg() 한 번으로 전송 (MSG_DONTWAIT, 소켓 버퍼가 차면 남은 부분은 큐에 유지)
+ * 공유 메모리 연결은 링에 들어가는 만큼의 메시지를 통째로 쓰고 eventfd로 한 번 깨움
+ * 게이트웨이 세션은 링크 송신 버퍼에 들어가는 만큼 세션 id를 붙여 추가 (링크 전송은 호출자가 반복 끝에)
+ * @return: 0 (정상, 남은 메시지가 있을 수 있음), 전송 오류면 -1
+ */
+int outbox_flush(Outbox *ob, int fd);
+
+/**
+ * 이번 반복에 메시지가 들어온 모든 연결 전송 (이벤트 루프 반복 끝에 호출)
+ * 전송 오류가 난 연결은 큐를 비우고 shutdown() - 정리는 다음 수신(EOF)에서 일반 연결 해제와 같은 경로로
+ * (공유 메모리 연결과 게이트웨이 세션은 채널/세션을 닫힘으로 표시해 같은 경로로)
+ */
+void outbox_flush_dirty(void);
+
+/**
+ * 큐의 모든 메시지 참조 해제 (연결 종료 시)
+ */
+void outbox_clear(Outbox *ob);
+
+/**
+ * 미전송 메시지가 남아 있는지 (select() 쓰기 감시 여부)
+ */
+static inline int outbox_pending(const Outbox *ob) {
+    return ob->count > 0;
+}
+
+/**
+ * 통계 출력 (force가 0이면 지난 출력 이후 새 이벤트가 있을 때만)
+ */
+void outbox_report(int force);
+
+#endif // BASEBALL_OUTBOX_H
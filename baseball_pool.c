@@ -0,0 +1,169 @@
+/**
+ * baseball_pool.c - 슬랩 풀, 아레나, 힙 할당 카운터 구현
+ *
+ * 📋 동작 방식:
+ * - 풀: 시작할 때 capacity개 블록을 한 덩어리로 할당하고 free list로 연결
+ *       할당/반환은 리스트 앞에서 꺼내고 넣기만 하므로 O(1)
+ * - 아레나: 반복마다 used를 0으로 되돌리는 bump 할당
+ * - 카운터: 디버그 빌드에서 malloc 계열을 가로채 모든 힙 할당을 셈
+ *           (json-c 같은 라이브러리 내부 할당까지 포함 - 남아 있는 할당 지점을 찾는 용도)
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "baseball_pool.h"
+
+AllocStats alloc_stats;
+
+// ──────────────────────────────────────────────────────────
+// 힙 할당 카운터
+// ──────────────────────────────────────────────────────────
+
+#if defined(BASEBALL_ALLOC_DEBUG) && defined(__GLIBC__)
+// glibc의 실제 할당 함수 - 실행 파일에 정의한 malloc이 공유 라이브러리의 호출까지 대신 받음
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static void count_heap_alloc(void) {
+    __atomic_fetch_add(&alloc_stats.heap_allocs, 1, __ATOMIC_RELAXED);  // 저널 쓰기 스레드도 호출할 수 있음
+}
+
+void *malloc(size_t size) {
+    count_heap_alloc();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    count_heap_alloc();
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    count_heap_alloc();
+    return __libc_realloc(ptr, size);
+}
+#define ALLOC_COUNTS_ALL 1
+#else
+static void count_heap_alloc(void) {
+    alloc_stats.heap_allocs++;
+}
+#define ALLOC_COUNTS_ALL 0
+#endif
+
+uint64_t alloc_heap_count(void) {
+    return __atomic_load_n(&alloc_stats.heap_allocs, __ATOMIC_RELAXED);
+}
+
+void alloc_note_message(uint64_t before) {
+    alloc_stats.messages++;
+    alloc_stats.message_allocs += alloc_heap_count() - before;
+}
+
+void alloc_report(int force) {
+    if (!force && alloc_stats.messages == alloc_stats.reported) return;
+    alloc_stats.reported = alloc_stats.messages;
+    double per_msg = alloc_stats.messages ? (double)alloc_stats.message_allocs / alloc_stats.messages : 0.0;
+    printf("[Alloc] 메시지 %llu개 처리 중 힙 할당 %llu회 (메시지당 %.2f회, %s)\n",
+           (unsigned long long)alloc_stats.messages, (unsigned long long)alloc_stats.message_allocs,
+           per_msg, ALLOC_COUNTS_ALL ? "라이브러리 포함 전체" : "풀/아레나 대체 할당만");
+}
+
+// ──────────────────────────────────────────────────────────
+// 슬랩 풀
+// ──────────────────────────────────────────────────────────
+
+int pool_init(Pool *p, const char *name, size_t block_size, size_t capacity) {
+    memset(p, 0, sizeof(*p));
+    p->name = name;
+    p->block_size = (block_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    if (p->block_size < sizeof(PoolBlock)) p->block_size = sizeof(PoolBlock);
+    p->capacity = capacity;
+    if (capacity == 0) return 0;
+
+    p->slab = malloc(p->block_size * capacity);
+    if (!p->slab) {
+        printf("[Pool] %s 풀 할당 실패 (%zu x %zu바이트)\n", name, capacity, p->block_size);
+        return -1;
+    }
+
+    // 앞 블록부터 꺼내지도록 뒤에서부터 연결
+    for (size_t i = capacity; i-- > 0;) {
+        PoolBlock *b = (PoolBlock *)(p->slab + i * p->block_size);
+        b->next = p->free_list;
+        p->free_list = b;
+    }
+    return 0;
+}
+
+void *pool_alloc(Pool *p) {
+    void *ptr;
+    if (p->free_list) {
+        ptr = p->free_list;
+        p->free_list = p->free_list->next;
+    } else {
+        ptr = malloc(p->block_size);
+        if (!ptr) return NULL;
+        p->fallback++;
+        if (!ALLOC_COUNTS_ALL) count_heap_alloc();
+    }
+    if (++p->in_use > p->high_water) p->high_water = p->in_use;
+    return ptr;
+}
+
+void pool_free(Pool *p, void *ptr) {
+    if (!ptr) return;
+    p->in_use--;
+    char *c = ptr;
+    if (p->slab && c >= p->slab && c < p->slab + p->block_size * p->capacity) {
+        PoolBlock *b = ptr;
+        b->next = p->free_list;
+        p->free_list = b;
+    } else {
+        free(ptr);
+    }
+}
+
+void pool_destroy(Pool *p) {
+    free(p->slab);
+    p->slab = NULL;
+    p->free_list = NULL;
+}
+
+void pool_report(const Pool *p) {
+    printf("[Pool] %s: 용량 %zu개 x %zu바이트, 최대 사용 %zu개, 대체 할당 %llu회\n",
+           p->name, p->capacity, p->block_size, p->high_water, (unsigned long long)p->fallback);
+}
+
+// ──────────────────────────────────────────────────────────
+// 아레나
+// ──────────────────────────────────────────────────────────
+
+int arena_init(Arena *a, size_t size) {
+    memset(a, 0, sizeof(*a));
+    a->base = malloc(size);
+    if (!a->base) return -1;
+    a->size = size;
+    return 0;
+}
+
+void *arena_alloc(Arena *a, size_t n) {
+    size_t start = (a->used + 7) & ~(size_t)7;
+    if (start + n > a->size) {
+        a->overflow++;
+        return NULL;
+    }
+    a->used = start + n;
+    if (a->used > a->high_water) a->high_water = a->used;
+    return a->base + start;
+}
+
+void arena_destroy(Arena *a) {
+    free(a->base);
+    a->base = NULL;
+    a->size = a->used = 0;
+}
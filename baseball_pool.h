@@ -0,0 +1,119 @@
+// baseball_pool.h - 고정 크기 슬랩 풀과 반복 단위 아레나 (게임 진행 중 힙 할당 제거)
+// 연결/방 레코드와 송신 버퍼처럼 자주 만들고 버리는 객체는 시작할 때 설정 용량만큼 미리 할당해 두고
+// free list로 재사용한다. 한 이벤트 루프 반복 안에서만 쓰는 임시 데이터는 아레나에서 잘라 쓰고
+// 반복이 끝날 때 한 번에 되돌린다.
+#ifndef BASEBALL_POOL_H
+#define BASEBALL_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ──────────────────────────────────────────────────────────
+// 1) 슬랩 풀: 같은 크기 블록을 연속 메모리로 미리 할당
+//    풀이 비면 malloc으로 대체하고 fallback으로 집계 (용량 튜닝 지표)
+// ──────────────────────────────────────────────────────────
+typedef struct PoolBlock {
+    struct PoolBlock *next;
+} PoolBlock;
+
+typedef struct {
+    const char *name;           // 통계 출력용 이름
+    size_t block_size;          // 블록 크기 (포인터 정렬로 올림)
+    size_t capacity;            // 미리 할당한 블록 수
+    char *slab;                 // 미리 할당한 연속 메모리
+    PoolBlock *free_list;
+    size_t in_use;              // 사용 중인 블록 수 (대체 할당 포함)
+    size_t high_water;          // in_use 최대값
+    uint64_t fallback;          // 풀이 비어 malloc으로 대체한 횟수
+} Pool;
+
+/**
+ * 풀 초기화 (capacity개 블록을 한 번에 할당)
+ * @return: 성공 시 0, 메모리 부족이면 -1
+ */
+int pool_init(Pool *p, const char *name, size_t block_size, size_t capacity);
+
+/**
+ * 블록 하나 할당 (내용은 초기화하지 않음)
+ * @return: 블록, 풀이 비고 malloc도 실패하면 NULL
+ */
+void *pool_alloc(Pool *p);
+
+/**
+ * 블록 반환 (슬랩 밖의 대체 할당 블록은 free)
+ */
+void pool_free(Pool *p, void *ptr);
+
+/**
+ * 풀 메모리 해제 (종료 시)
+ */
+void pool_destroy(Pool *p);
+
+/**
+ * 사용량 출력 (최대 사용량, 대체 할당 횟수)
+ */
+void pool_report(const Pool *p);
+
+// ──────────────────────────────────────────────────────────
+// 2) 아레나: 반복 단위 임시 메모리 (bump 할당, 개별 해제 없음)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    char *base;
+    size_t size;
+    size_t used;
+    size_t high_water;          // 한 반복에서 쓴 최대 바이트
+    uint64_t overflow;          // 크기가 모자라 할당에 실패한 횟수
+} Arena;
+
+/**
+ * 아레나 초기화
+ * @return: 성공 시 0, 메모리 부족이면 -1
+ */
+int arena_init(Arena *a, size_t size);
+
+/**
+ * 아레나에서 n바이트 할당 (8바이트 정렬)
+ * @return: 메모리, 남은 공간이 없으면 NULL (호출자가 처리)
+ */
+void *arena_alloc(Arena *a, size_t n);
+
+/**
+ * 반복이 끝날 때 아레나 전체를 되돌림
+ */
+static inline void arena_reset(Arena *a) {
+    a->used = 0;
+}
+
+void arena_destroy(Arena *a);
+
+// ──────────────────────────────────────────────────────────
+// 3) 힙 할당 카운터
+//    BASEBALL_ALLOC_DEBUG 빌드(make ALLOC_DEBUG=1)에서는 malloc/calloc/realloc을 가로채
+//    라이브러리 내부 할당까지 모두 센다. 일반 빌드에서는 풀/아레나가 malloc으로 대체한 횟수만 센다.
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint64_t heap_allocs;       // 힙 할당 횟수 (위 설명 참조)
+    uint64_t messages;          // 측정한 메시지 처리 수
+    uint64_t message_allocs;    // 메시지 처리 중 발생한 힙 할당 수
+    uint64_t reported;          // 마지막 출력 시점의 messages
+} AllocStats;
+
+extern AllocStats alloc_stats;
+
+/**
+ * 현재까지의 힙 할당 횟수
+ */
+uint64_t alloc_heap_count(void);
+
+/**
+ * 메시지 하나를 처리하는 동안의 힙 할당 집계
+ * @param before: 처리 시작 시점의 alloc_heap_count()
+ */
+void alloc_note_message(uint64_t before);
+
+/**
+ * 메시지당 힙 할당 통계 출력 (force가 0이면 지난 출력 이후 처리한 메시지가 있을 때만)
+ */
+void alloc_report(int force);
+
+#endif // BASEBALL_POOL_H
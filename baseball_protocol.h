@@ -6,9 +6,11 @@
 #include <json-c/json.h>
 #include <sys/time.h>    // 타임아웃 처리용
 #include <sys/socket.h>  // 소켓 옵션 상수용
+#include <arpa/inet.h>   // htons() - 인코더의 길이 prefix용
 #include <errno.h>       // 에러 코드 처리용
 #include <time.h>        // time() 함수용
 #include <string.h>      // strlen() 함수용
+#include <stdint.h>      // 고정 크기 정수 타입용
 
 // ──────────────────────────────────────────────────────────
 // 1) 네트워크 설정 및 타임아웃 상수
@@ -18,6 +20,10 @@
 #define MAX_RETRY_COUNT         3       // 최대 재시도 횟수
 #define RECV_TIMEOUT_SEC        5       // recv() 타임아웃 (초)
 #define SEND_TIMEOUT_SEC        5       // send() 타임아웃 (초)
+#define RESUME_GRACE_SEC        30      // 연결 끊긴 좌석을 유지하는 시간 (초)
+#define RESUME_TOKEN_LEN        16      // 재접속 토큰 길이 (16진수 문자)
+#define RESUME_MAX_RETRIES      5       // 클라이언트 재접속 최대 시도 횟수
+#define RESUME_BACKOFF_MS       500     // 클라이언트 재접속 첫 대기 시간 (이후 2배씩 증가)
 
 // ──────────────────────────────────────────────────────────
 // 2) 서버⇄클라이언트 간 메시지 Action 문자열 정의
@@ -25,25 +31,45 @@
 #define ACTION_JOIN           "join"           // 플레이어가 서버에 접속
 #define ACTION_ASSIGN_ID      "assign_id"      // 서버가 플레이어에게 ID 할당
 #define ACTION_WAIT_PLAYER    "wait_player"    // 상대방 대기 중
-#define ACTION_GAME_START     "game_start"     // 게임 시작 (2명 모두 접속)
+#define ACTION_GAME_START     "game_start"     // 게임 시작 (방 정원이 모두 접속)
 #define ACTION_SET_NUMBER     "set_number"     // 플레이어가 3자리 숫자 설정
 #define ACTION_NUMBER_SET     "number_set"     // 숫자 설정 완료 응답
 #define ACTION_YOUR_TURN      "your_turn"      // 당신의 턴
-#define ACTION_WAIT_TURN      "wait_turn"      // 상대방 턴 대기
 #define ACTION_GUESS          "guess"          // 숫자 추측
 #define ACTION_GUESS_RESULT   "guess_result"   // 추측 결과 (스트라이크/볼)
 #define ACTION_GAME_OVER      "game_over"      // 게임 종료 (승리/패배)
 #define ACTION_ERROR          "error"          // 오류 메시지
 #define ACTION_HEARTBEAT      "heartbeat"      // 연결 상태 확인 (새로 추가)
 #define ACTION_TIMEOUT        "timeout"        // 타임아웃 발생 (새로 추가)
+#define ACTION_RESUME         "resume"         // 재접속 토큰으로 기존 좌석 복귀 요청
+#define ACTION_RESUMED        "resumed"        // 좌석 복귀 완료 + 게임 상태 스냅샷
+#define ACTION_OPPONENT_AWAY  "opponent_away"  // 상대방 연결 끊김 (재접속 대기 중)
+#define ACTION_OPPONENT_BACK  "opponent_back"  // 상대방 재접속 완료
+#define ACTION_SET_NAME       "set_name"       // 플레이어 이름 등록 (접속 직후)
+#define ACTION_LEADERBOARD    "leaderboard"    // 리더보드 조회 (상위 N명 / 개인 순위)
+#define ACTION_LEADERBOARD_RESULT "leaderboard_result" // 리더보드 조회 결과
+#define ACTION_SPECTATE       "spectate"       // 관전자용 방 상태 스냅샷 (접속 직후, 게임 시작 시)
+#define ACTION_TURN           "turn"           // 턴 변경 알림 (방 전체 + 관전자, 현재 턴 플레이어)
+#define ACTION_TOURNAMENT     "tournament"     // 토너먼트 진행 알림 (체크인, 통과, 탈락, 우승, 경기 결과)
+#define ACTION_HELLO          "hello"          // 프로토콜 기능 협상 (클라이언트 제안 → 서버가 받아들인 기능으로 응답)
+#define ACTION_TURN_RESULT    "turn_result"    // 추측 결과 + 다음 턴 묶음 (PROTO_CAP_TURN_RESULT 협상 시 guess_result/your_turn/turn 대신)
+#define ACTION_RECONNECT      "reconnect"      // 서버 재시작으로 이 연결을 닫음 - 재접속 토큰으로 다시 연결
+#define ACTION_NODE_STATUS    "node_status"    // 게임 서버 → 게이트웨이 링크: 방 상태와 인원 (새 경기 배정 판단용)
+
+// 협상 가능한 프로토콜 기능 (hello의 caps 비트) - 협상하지 않은 클라이언트는 기존 메시지 흐름 유지
+#define PROTO_CAP_TURN_RESULT 0x1              // 턴 전환을 turn_result 한 프레임으로 받음
+#define SERVER_CAPS           (PROTO_CAP_TURN_RESULT)  // 서버가 지원하는 기능
 
 // ──────────────────────────────────────────────────────────
 // 3) 게임 설정 상수
 // ──────────────────────────────────────────────────────────
-#define MAX_CLIENTS     2       // 1:1 대전 게임
+#define MAX_CLIENTS     8       // 한 방의 최대 인원 (좌석 배열 크기)
+#define DEFAULT_ROOM_PLAYERS 2  // 기본 방 정원 (1:1 대전, 서버 -P 옵션으로 3~8인 방)
 #define NUMBER_LENGTH   3       // 3자리 숫자 사용
 #define MAX_ATTEMPTS   10       // 최대 10번 추측 허용
 #define BUF_SIZE     4096       // 네트워크 버퍼 크기
+#define PLAYER_NAME_LEN   16    // 플레이어 이름 최대 길이 (바이트)
+#define LEADERBOARD_QUERY_MAX 20 // 한 번에 조회할 수 있는 상위 인원
 
 // ──────────────────────────────────────────────────────────
 // 4) 게임 상태 열거형 (게임 전체 진행 상태)
@@ -69,16 +95,32 @@ typedef enum {
 // ──────────────────────────────────────────────────────────
 // 6) 플레이어 정보 구조체 (각 플레이어의 상태와 데이터 관리)
 // ──────────────────────────────────────────────────────────
+// 비밀 숫자 후보 집합: 서로 다른 세 자리 숫자 720개(10 × 9 × 8)를 비트 하나씩
+// 워드 12개 = 768비트 (256비트 벡터 3개로 나누어 떨어지도록, 720번 이후 비트는 항상 0)
+#define CANDIDATE_COUNT         720
+#define CANDIDATE_WORDS         12
+
+typedef struct {
+    uint64_t w[CANDIDATE_WORDS];
+} CandidateSet;
+
 typedef struct {
     int sockfd;                     // 소켓 파일 디스크립터
-    int player_id;                  // 플레이어 ID (0 또는 1)
+    int player_id;                  // 플레이어 ID (좌석 번호, 0 ~ 방 정원-1)
     int connected;                  // 연결 상태 (1: 연결됨, 0: 연결 해제)
     PlayerState state;              // 현재 플레이어 상태
     char secret_number[4];          // 비밀 숫자 (3자리 + null terminator)
     int attempts;                   // 현재까지 추측 시도 횟수
     int is_winner;                  // 승리 여부 (1: 승리, 0: 미승리)
-    time_t last_activity;           // 마지막 활동 시간 (타임아웃 체크용)
+    uint64_t last_activity_ms;      // 마지막 수신 시각 (단조 시계 밀리초, 타임아웃 체크용, 0: 아직 없음)
     int retry_count;                // 네트워크 재시도 횟수
+    int suspended;                  // 연결은 끊겼지만 재접속을 기다리며 좌석 유지 중
+    uint64_t resume_deadline_ms;    // 재접속 대기 만료 시각 (밀리초)
+    char resume_token[RESUME_TOKEN_LEN + 1]; // 재접속 토큰 (ID 할당 시 발급)
+    char name[PLAYER_NAME_LEN + 1];  // 플레이어 이름 (리더보드 기록용, 빈 문자열: 익명)
+    int eliminated;                 // 비밀 숫자가 맞춰져 탈락 (턴과 추측 대상에서 제외)
+    int caps;                       // 이 좌석의 연결이 협상한 프로토콜 기능 (PROTO_CAP_* 비트, 연결마다 0부터)
+    CandidateSet candidates;        // 이 좌석의 비밀 숫자로 아직 가능한 후보 (이 좌석을 향한 추측 결과로 좁힘)
 } PlayerInfo;
 
 // ──────────────────────────────────────────────────────────
@@ -86,11 +128,15 @@ typedef struct {
 // ──────────────────────────────────────────────────────────
 typedef struct {
     GameState state;                // 현재 게임 상태
-    PlayerInfo players[MAX_CLIENTS]; // 모든 플레이어 정보 배열
-    int current_turn;               // 현재 턴인 플레이어 ID (0 또는 1)
-    int players_ready;              // 게임 준비 완료된 플레이어 수
+    PlayerInfo players[MAX_CLIENTS]; // 모든 플레이어 정보 배열 (앞쪽 capacity개 좌석만 사용)
+    int capacity;                   // 방 정원 (이 인원이 모이면 게임 시작, 2 ~ MAX_CLIENTS)
+    int current_turn;               // 현재 턴인 플레이어 ID
+    int players_ready;              // 좌석에 앉은 플레이어 수
     time_t game_start_time;         // 게임 시작 시간
     time_t last_heartbeat;          // 마지막 연결 상태 확인 시간
+    uint32_t match_id;              // 경기 번호 (게임 시작마다 증가, 저널 기록용)
+    uint64_t reset_at_ms;           // 게임 종료 후 새 게임 준비 예정 시각 (밀리초)
+    uint16_t room_id;               // 방 번호 (0: 일반 대전 방, 1~: 토너먼트 경기 방)
 } GameManager;
 
 // ──────────────────────────────────────────────────────────
@@ -100,6 +146,8 @@ typedef struct {
     int strikes;        // 스트라이크 수 (숫자와 위치 모두 정확)
     int balls;          // 볼 수 (숫자는 맞지만 위치 틀림)
     int is_correct;     // 정답 여부 (3스트라이크 = 정답)
+    int target;         // 추측 대상 플레이어 ID (게임 로직이 채움)
+    int remaining;      // 이 결과까지 반영한 대상의 남은 후보 수 (게임 로직이 채움)
 } GuessResult;
 
 // ──────────────────────────────────────────────────────────
@@ -131,21 +179,24 @@ static inline int set_socket_timeout(int sockfd, int timeout_sec) {
 }
 
 /**
- * 플레이어 활동 시간 업데이트 (타임아웃 방지용)
+ * 플레이어 활동 시간 업데이트 (타임아웃 방지용 - 입장/재접속과 프레임을 받을 때마다)
  * @param player: 업데이트할 플레이어 정보
+ * @param now_ms: 이벤트 루프의 단조 시각 (clock_now_ms())
  */
-static inline void update_player_activity(PlayerInfo *player) {
-    player->last_activity = time(NULL);
+static inline void update_player_activity(PlayerInfo *player, uint64_t now_ms) {
+    player->last_activity_ms = now_ms;
 }
 
 /**
  * 플레이어 타임아웃 체크
+ * 기록이 없거나 지금보다 뒤인 활동 시각(재부팅 전 스냅샷에서 복원한 값 등)은 타임아웃으로 보지 않음
  * @param player: 체크할 플레이어 정보
+ * @param now_ms: 이벤트 루프의 단조 시각 (clock_now_ms())
  * @return: 타임아웃 시 1, 정상 시 0
  */
-static inline int is_player_timeout(PlayerInfo *player) {
-    time_t current_time = time(NULL);
-    return (current_time - player->last_activity) > NETWORK_TIMEOUT_SEC;
+static inline int is_player_timeout(const PlayerInfo *player, uint64_t now_ms) {
+    if (player->last_activity_ms == 0 || player->last_activity_ms > now_ms) return 0;
+    return now_ms - player->last_activity_ms > (uint64_t)NETWORK_TIMEOUT_SEC * 1000;
 }
 
 // ──────────────────────────────────────────────────────────
@@ -163,40 +214,209 @@ static inline struct json_object *create_message(const char *action) {
     return jmsg;
 }
 
+// ──────────────────────────────────────────────────────────
+// 11) 메시지 스키마 (X-macro) - 액션별 필드를 한 번만 선언
+//     스키마 한 줄에서 메시지 구조체(<Type>Msg)와 인코더(encode_<name>)가 생성된다.
+//     인코더는 객체 트리 없이 [2바이트 길이] + [JSON]을 호출자 버퍼에 바로 쓴다.
+//     중첩 객체 배열이 있는 관전 스냅샷/리더보드 결과는 json-c(create_message)로 생성.
+//
+//     필드 종류:
+//       STR      문자열 (NULL이면 "")         OPT_STR  문자열 (NULL이면 생략)
+//       INT      정수                        OPT_INT  정수 (음수면 생략)
+//       FLAG     0이면 생략, 아니면 1          COUNT    배열 필드 길이 (출력 없음, 이름은 count)
+//       STRS     문자열 배열 (count개)         INTS     정수 배열 (count개)
+// ──────────────────────────────────────────────────────────
+
+// 서버 → 클라이언트
+#define MSG_FIELDS_ASSIGN_ID(F)       F(INT, player_id) F(OPT_STR, resume_token)
+#define MSG_FIELDS_WAIT_PLAYER(F)     F(STR, message) F(INT, players) F(INT, capacity)
+#define MSG_FIELDS_GAME_START(F)      F(STR, message) F(INT, capacity)
+#define MSG_FIELDS_NUMBER_SET(F)      F(STR, message)
+#define MSG_FIELDS_YOUR_TURN(F)       F(STR, message)
+#define MSG_FIELDS_TURN(F)            F(INT, current_player)
+#define MSG_FIELDS_GUESS_RESULT(F)    F(STR, guess) F(INT, strikes) F(INT, balls) F(INT, attempts) \
+                                      F(INT, current_player) F(INT, target) F(FLAG, eliminated) \
+                                      F(INT, remaining)
+#define MSG_FIELDS_TURN_RESULT(F)     MSG_FIELDS_GUESS_RESULT(F) F(INT, next_player)
+#define MSG_FIELDS_GAME_OVER(F)       F(STR, result) F(STR, message) \
+                                      F(OPT_STR, your_number) F(OPT_STR, opponent_number)
+#define MSG_FIELDS_GAME_SUMMARY(F)    F(STR, result) F(INT, winner) F(COUNT, count) \
+                                      F(STRS, numbers) F(INTS, attempts)
+#define MSG_FIELDS_OPPONENT_AWAY(F)   F(INT, player_id) F(INT, grace_sec) F(STR, message)
+#define MSG_FIELDS_OPPONENT_BACK(F)   F(INT, player_id) F(STR, message)
+#define MSG_FIELDS_RESUMED(F)         F(INT, player_id) F(STR, state) F(STR, number) F(INT, attempts) \
+                                      F(INT, your_turn) F(INT, current_player) F(INT, capacity) F(INT, out)
+#define MSG_FIELDS_TOURNAMENT(F)      F(STR, status) F(INT, round) F(INT, rounds) F(STR, message)
+#define MSG_FIELDS_ERROR(F)           F(STR, message)
+#define MSG_FIELDS_TIMEOUT(F)         F(STR, reason)
+#define MSG_FIELDS_RECONNECT(F)       F(STR, message)
+#define MSG_FIELDS_HEARTBEAT(F)       F(STR, timestamp)
+#define MSG_FIELDS_HELLO(F)           F(INT, caps)     // 양방향 (클라이언트 제안 / 서버 수락)
+
+// 클라이언트 → 서버
+#define MSG_FIELDS_SET_NUMBER(F)      F(STR, number)
+#define MSG_FIELDS_GUESS(F)           F(STR, guess) F(OPT_INT, target)
+#define MSG_FIELDS_RESUME(F)          F(STR, token)
+#define MSG_FIELDS_SET_NAME(F)        F(STR, name)
+#define MSG_FIELDS_LEADERBOARD(F)     F(INT, top)
+
+// 게임 서버 → 게이트웨이 (링크의 GWLINK_SID_NODE 레코드)
+#define MSG_FIELDS_NODE_STATUS(F)     F(STR, state) F(INT, capacity) F(INT, players) F(INT, suspended)
+
+// M(구조체 이름, 인코더 이름, 액션 문자열, 필드 목록)
+#define MESSAGE_SCHEMA(M) \
+    M(AssignId,      assign_id,      ACTION_ASSIGN_ID,     MSG_FIELDS_ASSIGN_ID) \
+    M(WaitPlayer,    wait_player,    ACTION_WAIT_PLAYER,   MSG_FIELDS_WAIT_PLAYER) \
+    M(GameStart,     game_start,     ACTION_GAME_START,    MSG_FIELDS_GAME_START) \
+    M(NumberSet,     number_set,     ACTION_NUMBER_SET,    MSG_FIELDS_NUMBER_SET) \
+    M(YourTurn,      your_turn,      ACTION_YOUR_TURN,     MSG_FIELDS_YOUR_TURN) \
+    M(Turn,          turn,           ACTION_TURN,          MSG_FIELDS_TURN) \
+    M(GuessResult,   guess_result,   ACTION_GUESS_RESULT,  MSG_FIELDS_GUESS_RESULT) \
+    M(TurnResult,    turn_result,    ACTION_TURN_RESULT,   MSG_FIELDS_TURN_RESULT) \
+    M(GameOver,      game_over,      ACTION_GAME_OVER,     MSG_FIELDS_GAME_OVER) \
+    M(GameSummary,   game_summary,   ACTION_GAME_OVER,     MSG_FIELDS_GAME_SUMMARY) \
+    M(OpponentAway,  opponent_away,  ACTION_OPPONENT_AWAY, MSG_FIELDS_OPPONENT_AWAY) \
+    M(OpponentBack,  opponent_back,  ACTION_OPPONENT_BACK, MSG_FIELDS_OPPONENT_BACK) \
+    M(Resumed,       resumed,        ACTION_RESUMED,       MSG_FIELDS_RESUMED) \
+    M(Tournament,    tournament,     ACTION_TOURNAMENT,    MSG_FIELDS_TOURNAMENT) \
+    M(Error,         error,          ACTION_ERROR,         MSG_FIELDS_ERROR) \
+    M(Timeout,       timeout,        ACTION_TIMEOUT,       MSG_FIELDS_TIMEOUT) \
+    M(Reconnect,     reconnect,      ACTION_RECONNECT,     MSG_FIELDS_RECONNECT) \
+    M(Heartbeat,     heartbeat,      ACTION_HEARTBEAT,     MSG_FIELDS_HEARTBEAT) \
+    M(Hello,         hello,          ACTION_HELLO,         MSG_FIELDS_HELLO) \
+    M(SetNumber,     set_number,     ACTION_SET_NUMBER,    MSG_FIELDS_SET_NUMBER) \
+    M(Guess,         guess,          ACTION_GUESS,         MSG_FIELDS_GUESS) \
+    M(Resume,        resume,         ACTION_RESUME,        MSG_FIELDS_RESUME) \
+    M(SetName,       set_name,       ACTION_SET_NAME,      MSG_FIELDS_SET_NAME) \
+    M(Leaderboard,   leaderboard,    ACTION_LEADERBOARD,   MSG_FIELDS_LEADERBOARD) \
+    M(NodeStatus,    node_status,    ACTION_NODE_STATUS,   MSG_FIELDS_NODE_STATUS)
+
+// 메시지 종류 번호 (MSG_ID_<인코더 이름>) - 송신 버퍼에 붙여 메시지 종류별 처리에 사용
+#define MSG_DECLARE_ID(Type, name, action, FIELDS) MSG_ID_##name,
+typedef enum {
+    MESSAGE_SCHEMA(MSG_DECLARE_ID)
+    MSG_ID_COUNT
+} MessageId;
+
+// 메시지 구조체 (<Type>Msg)
+#define MSG_FIELD_STR(n)        const char *n;
+#define MSG_FIELD_OPT_STR(n)    const char *n;
+#define MSG_FIELD_INT(n)        int n;
+#define MSG_FIELD_OPT_INT(n)    int n;
+#define MSG_FIELD_FLAG(n)       int n;
+#define MSG_FIELD_COUNT(n)      int n;
+#define MSG_FIELD_STRS(n)       const char *n[MAX_CLIENTS];
+#define MSG_FIELD_INTS(n)       int n[MAX_CLIENTS];
+#define MSG_DECLARE_FIELD(type, n) MSG_FIELD_##type(n)
+#define MSG_DECLARE_STRUCT(Type, name, action, FIELDS) typedef struct { FIELDS(MSG_DECLARE_FIELD) } Type##Msg;
+MESSAGE_SCHEMA(MSG_DECLARE_STRUCT)
+
 /**
- * 에러 메시지 JSON 객체 생성
- * @param message: 에러 메시지 내용
- * @return: 에러 JSON 객체 포인터
+ * 출력 버퍼에 JSON을 이어 쓰는 커서 (넘치면 overflow만 표시하고 이후 쓰기는 무시)
  */
-static inline struct json_object *create_error(const char *message) {
-    struct json_object *jmsg = create_message(ACTION_ERROR);
-    json_object_object_add(jmsg, "message", json_object_new_string(message));
-    return jmsg;
+typedef struct {
+    char *buf;
+    size_t cap;
+    size_t len;
+    int overflow;
+} JsonWriter;
+
+static inline void jw_raw(JsonWriter *w, const char *s, size_t n) {
+    if (w->overflow || n > w->cap - w->len) {
+        w->overflow = 1;
+        return;
+    }
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
 }
 
 /**
- * 타임아웃 메시지 JSON 객체 생성
- * @param reason: 타임아웃 발생 이유
- * @return: 타임아웃 JSON 객체 포인터
+ * JSON 문자열 (따옴표, 역슬래시, 제어 문자만 이스케이프 - UTF-8은 그대로)
  */
-static inline struct json_object *create_timeout_message(const char *reason) {
-    struct json_object *jmsg = create_message(ACTION_TIMEOUT);
-    json_object_object_add(jmsg, "reason", json_object_new_string(reason));
-    return jmsg;
+static inline void jw_string(JsonWriter *w, const char *s) {
+    static const char hex[] = "0123456789abcdef";
+    jw_raw(w, "\"", 1);
+    if (s) {
+        const char *run = s;  // 이스케이프가 필요 없는 구간은 한 번에 복사
+        for (; *s; s++) {
+            unsigned char c = (unsigned char)*s;
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            jw_raw(w, run, (size_t)(s - run));
+            char esc[6] = { '\\', (char)c, '0', '0', hex[c >> 4], hex[c & 0xF] };
+            if (c == '"' || c == '\\') {
+                jw_raw(w, esc, 2);
+            } else if (c == '\n') {
+                jw_raw(w, "\\n", 2);
+            } else if (c == '\t') {
+                jw_raw(w, "\\t", 2);
+            } else if (c == '\r') {
+                jw_raw(w, "\\r", 2);
+            } else {
+                esc[1] = 'u';
+                jw_raw(w, esc, 6);
+            }
+            run = s + 1;
+        }
+        jw_raw(w, run, (size_t)(s - run));
+    }
+    jw_raw(w, "\"", 1);
+}
+
+static inline void jw_int(JsonWriter *w, int v) {
+    char tmp[12];
+    size_t n = 0;
+    unsigned int u = v < 0 ? 0u - (unsigned int)v : (unsigned int)v;
+    do {
+        tmp[sizeof(tmp) - 1 - n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0) tmp[sizeof(tmp) - 1 - n++] = '-';
+    jw_raw(w, tmp + sizeof(tmp) - n, n);
 }
 
 /**
- * 하트비트(연결 확인) 메시지 JSON 객체 생성
- * @return: 하트비트 JSON 객체 포인터
+ * 앞 2바이트에 본문 길이 기록
+ * @return: 전체 길이 (prefix 포함), 버퍼가 모자랐거나 BUF_SIZE를 넘으면 0
  */
-static inline struct json_object *create_heartbeat_message(void) {
-    struct json_object *jmsg = create_message(ACTION_HEARTBEAT);
-    json_object_object_add(jmsg, "timestamp", json_object_new_string("heartbeat"));
-    return jmsg;
+static inline size_t jw_finish(JsonWriter *w) {
+    if (w->overflow || w->len - 2 > BUF_SIZE) return 0;
+    uint16_t netlen = htons((uint16_t)(w->len - 2));
+    memcpy(w->buf, &netlen, 2);
+    return w->len;
 }
 
+// 필드별 출력 (인코더 안에서 w, m 사용)
+#define MSG_KEY(n)              jw_raw(&w, ",\"" #n "\":", sizeof(",\"" #n "\":") - 1);
+#define MSG_ENCODE_STR(n)       MSG_KEY(n) jw_string(&w, m->n);
+#define MSG_ENCODE_OPT_STR(n)   if (m->n) { MSG_KEY(n) jw_string(&w, m->n); }
+#define MSG_ENCODE_INT(n)       MSG_KEY(n) jw_int(&w, m->n);
+#define MSG_ENCODE_OPT_INT(n)   if (m->n >= 0) { MSG_KEY(n) jw_int(&w, m->n); }
+#define MSG_ENCODE_FLAG(n)      if (m->n) { MSG_KEY(n) jw_raw(&w, "1", 1); }
+#define MSG_ENCODE_COUNT(n)
+#define MSG_ENCODE_STRS(n)      MSG_KEY(n) jw_raw(&w, "[", 1); \
+                                for (int i = 0; i < m->count; i++) { if (i) jw_raw(&w, ",", 1); jw_string(&w, m->n[i]); } \
+                                jw_raw(&w, "]", 1);
+#define MSG_ENCODE_INTS(n)      MSG_KEY(n) jw_raw(&w, "[", 1); \
+                                for (int i = 0; i < m->count; i++) { if (i) jw_raw(&w, ",", 1); jw_int(&w, m->n[i]); } \
+                                jw_raw(&w, "]", 1);
+#define MSG_ENCODE_FIELD(type, n) MSG_ENCODE_##type(n)
+
+/**
+ * 인코더: size_t encode_<name>(char *buf, size_t cap, const <Type>Msg *m)
+ * buf에 [2바이트 길이] + [JSON]을 쓰고 전체 길이 반환 (cap이 모자라면 0 - 더 큰 버퍼로 다시 호출)
+ */
+#define MSG_DEFINE_ENCODER(Type, name, action, FIELDS) \
+    static inline size_t encode_##name(char *buf, size_t cap, const Type##Msg *m) { \
+        JsonWriter w = { buf, cap, 2, cap < 2 }; \
+        jw_raw(&w, "{\"action\":\"" action "\"", sizeof("{\"action\":\"" action "\"") - 1); \
+        FIELDS(MSG_ENCODE_FIELD) \
+        jw_raw(&w, "}", 1); \
+        return jw_finish(&w); \
+    }
+MESSAGE_SCHEMA(MSG_DEFINE_ENCODER)
+
 // ──────────────────────────────────────────────────────────
-// 11) 게임 로직 검증 함수들
+// 12) 게임 로직 검증 함수들
 // ──────────────────────────────────────────────────────────
 
 /**
@@ -234,7 +454,7 @@ static inline int is_valid_number(const char *number) {
  * @return: GuessResult 구조체 (스트라이크, 볼, 정답여부)
  */
 static inline GuessResult calculate_result(const char *secret, const char *guess) {
-    GuessResult result = {0, 0, 0};
+    GuessResult result = {0, 0, 0, 0, 0};
     
     // 1단계: 스트라이크 계산 (같은 위치의 같은 숫자)
     for (int i = 0; i < NUMBER_LENGTH; i++) {
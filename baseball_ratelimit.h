@@ -0,0 +1,76 @@
+// baseball_ratelimit.h - 연결별 수신 메시지 속도 제한 (토큰 버킷)
+// 메시지를 JSON으로 파싱하기 전에 fd별 버킷에서 토큰을 꺼내 보고, 토큰이 없으면 프레임을 버린다.
+// 계속 버킷을 넘기는 연결은 위반 점수가 쌓여 강제 종료되므로 한 소켓이 서버 CPU를 독점할 수 없다.
+#ifndef BASEBALL_RATELIMIT_H
+#define BASEBALL_RATELIMIT_H
+
+#include <stdint.h>
+#include <sys/select.h>
+
+// ──────────────────────────────────────────────────────────
+// 1) 속도 제한 기본값 (-R 옵션으로 변경)
+// ──────────────────────────────────────────────────────────
+#define RATE_LIMIT_PER_SEC      4       // 초당 충전되는 토큰 수 (지속 허용 메시지 수)
+#define RATE_LIMIT_BURST        8       // 버킷 크기 (순간적으로 허용하는 메시지 수)
+#define RATE_LIMIT_KICK_SCORE   32      // 위반 점수가 이 값에 닿으면 연결 해제
+#define RATE_TOKEN_UNIT         1000    // 토큰 1개 = 1000 단위 (밀리초 단위 충전을 정수로 계산)
+#define RATE_LIMIT_REPORT_MS    10000   // 통계 출력 간격 (버린 메시지가 있을 때만)
+
+// ──────────────────────────────────────────────────────────
+// 2) 버킷 구조
+//    위반 점수: 버린 메시지마다 +1, 통과한 메시지마다 -1
+//    → 잠깐 몰아친 정상 입력은 금방 회복되고, 폭주가 이어지는 연결만 점수가 쌓임
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint64_t last_ms;       // 마지막 충전 시각 (0: 아직 사용 전 - 첫 메시지에서 가득 채움)
+    uint32_t tokens;        // 남은 토큰 (RATE_TOKEN_UNIT 단위)
+    uint32_t score;         // 위반 점수
+    uint32_t dropped;       // 이 연결에서 버린 메시지 수
+} RateBucket;
+
+typedef enum {
+    RATE_PASS = 0,          // 처리
+    RATE_DROP,              // 버림 (연결 유지)
+    RATE_KICK               // 반복 위반 - 연결 해제
+} RateVerdict;
+
+typedef struct {
+    RateBucket buckets[FD_SETSIZE];     // fd로 바로 찾기
+    uint32_t per_sec;                   // 0이면 속도 제한 끔
+    uint32_t burst;
+    uint64_t passed;                    // 통과한 메시지 수
+    uint64_t dropped;                   // 버린 메시지 수
+    uint64_t kicked;                    // 강제 종료한 연결 수
+    uint64_t reported_dropped;          // 마지막 통계 출력 시점의 dropped
+} RateLimiter;
+
+/**
+ * 속도 제한 초기화
+ * @param per_sec: 초당 허용 메시지 수 (0이면 제한 없음)
+ * @param burst: 순간 허용 메시지 수 (per_sec보다 작으면 per_sec로 맞춤)
+ */
+void ratelimit_init(RateLimiter *rl, uint32_t per_sec, uint32_t burst);
+
+/**
+ * 새 연결의 버킷 초기화 (이전에 같은 fd를 쓰던 연결의 기록 제거)
+ */
+void ratelimit_reset(RateLimiter *rl, int fd);
+
+/**
+ * 수신한 메시지 한 개에 대한 판정 (JSON 파싱 전에 호출)
+ * @param now_ms: 루프의 단조 시각 (clock_now_ms(), 밀리초)
+ * @return: RATE_PASS / RATE_DROP / RATE_KICK
+ */
+RateVerdict ratelimit_admit(RateLimiter *rl, int fd, uint64_t now_ms);
+
+/**
+ * 이 fd에서 버린 메시지 수
+ */
+uint32_t ratelimit_dropped(const RateLimiter *rl, int fd);
+
+/**
+ * 누적 통계 출력 (force가 0이면 지난 출력 이후 버린 메시지가 있을 때만)
+ */
+void ratelimit_report(RateLimiter *rl, int force);
+
+#endif // BASEBALL_RATELIMIT_H
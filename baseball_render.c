@@ -0,0 +1,204 @@
+/**
+ * baseball_render.c - 프레임 버퍼 기반 터미널 렌더러 구현
+ *
+ * 📋 동작 방식:
+ * - 백 버퍼: 이번에 그릴 화면을 줄 단위로 모음 (render_printf)
+ * - 프론트 버퍼: 터미널에 마지막으로 출력된 화면
+ * - commit 시 두 버퍼를 줄 단위로 비교하여 바뀐 줄만
+ *   "커서 이동 + 줄 내용 + 줄 끝 지우기" 시퀀스로 출력
+ * - 출력 시퀀스는 하나의 버퍼에 모아 write() 한 번으로 전송 (깜빡임 방지)
+ * - 프레임이 터미널보다 길면 아래쪽 (터미널 높이 - 1)줄만 화면에 두고 그 안에서 비교
+ *   (마지막 한 줄은 입력 에코용으로 비워 두어 Enter로 화면이 스크롤되지 않도록 함)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+
+#include "baseball_render.h"
+
+// ──────────────────────────────────────────────────────────
+// 프레임 버퍼 구조체
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    char text[RENDER_MAX_COLS];     // 줄 내용 (개행 문자 제외)
+    int len;                        // 줄 길이 (-1: 무효화되어 반드시 다시 그려야 함)
+} RenderLine;
+
+typedef struct {
+    RenderLine lines[RENDER_MAX_ROWS];
+    int rows;                       // 사용 중인 줄 수
+} RenderFrame;
+
+static RenderFrame frames[2];       // 더블 버퍼
+static RenderFrame *front = &frames[0];  // 터미널에 출력된 프레임
+static RenderFrame *back = &frames[1];   // 작성 중인 프레임
+static int out_fd = STDOUT_FILENO;
+static int need_full_redraw = 1;    // 첫 프레임은 화면 클리어 후 전체 출력
+static int cursor_row = 0;          // 마지막 commit 후 커서가 위치한 줄 (프레임 기준)
+static int front_top = 0;           // 프론트 프레임에서 화면 첫 줄에 해당하는 줄 번호
+static char out_buf[RENDER_OUT_SIZE];
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 출력 버퍼에 바이트 추가 (넘치면 잘라냄)
+ */
+static int out_append(int pos, const char *s, int n) {
+    if (pos + n > (int)sizeof(out_buf)) n = (int)sizeof(out_buf) - pos;
+    if (n <= 0) return pos;
+    memcpy(out_buf + pos, s, n);
+    return pos + n;
+}
+
+/**
+ * 커서를 지정 줄의 첫 칸으로 이동하는 ANSI 시퀀스 추가
+ */
+static int out_move(int pos, int row) {
+    char seq[32];
+    int n = snprintf(seq, sizeof(seq), "\033[%d;1H", row + 1);
+    return out_append(pos, seq, n);
+}
+
+/**
+ * 터미널 높이 조회 (실패 시 0)
+ */
+static int terminal_rows(void) {
+    struct winsize ws;
+    if (ioctl(out_fd, TIOCGWINSZ, &ws) == 0) return ws.ws_row;
+    return 0;
+}
+
+/**
+ * 출력 버퍼 전체를 write()로 전송 (부분 쓰기 및 EINTR 처리)
+ */
+static void write_all(int len) {
+    int off = 0;
+    while (off < len) {
+        ssize_t n = write(out_fd, out_buf + off, len - off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        off += n;
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+void render_init(int fd) {
+    out_fd = fd;
+    front->rows = 0;
+    back->rows = 0;
+    front_top = 0;
+    need_full_redraw = 1;
+}
+
+void render_begin(void) {
+    back->rows = 1;
+    back->lines[0].len = 0;
+}
+
+void render_printf(const char *fmt, ...) {
+    char tmp[RENDER_MAX_COLS * 4];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    if (n >= (int)sizeof(tmp)) n = (int)sizeof(tmp) - 1;
+    if (back->rows == 0) render_begin();
+
+    // 개행 단위로 현재 줄에 이어 붙이거나 새 줄 시작
+    for (int i = 0; i < n; i++) {
+        RenderLine *line = &back->lines[back->rows - 1];
+        if (tmp[i] == '\n') {
+            if (back->rows >= RENDER_MAX_ROWS) continue;  // 최대 줄 수 초과분은 버림
+            back->lines[back->rows].len = 0;
+            back->rows++;
+        } else if (line->len < RENDER_MAX_COLS) {
+            line->text[line->len++] = tmp[i];
+        }
+    }
+}
+
+void render_commit(void) {
+    if (back->rows == 0) render_begin();
+
+    int pos = 0;
+    int term_rows = terminal_rows();
+
+    // 화면에 둘 줄 범위: 프레임이 터미널보다 길면 커서가 있는 아래쪽만 (절대 좌표가 어긋나지 않도록)
+    int limit = term_rows > 1 ? term_rows - 1 : 0;
+    int top = (limit > 0 && back->rows > limit) ? back->rows - limit : 0;
+    int visible = back->rows - top;
+
+    if (need_full_redraw) {
+        pos = out_append(pos, "\033[2J\033[H", 7);
+        for (int i = 0; i < visible; i++) {
+            RenderLine *line = &back->lines[top + i];
+            pos = out_append(pos, line->text, line->len);
+            if (i + 1 < visible) pos = out_append(pos, "\r\n", 2);
+        }
+        need_full_redraw = 0;
+    } else {
+        // 화면 줄 r에 있던 내용(front_top + r)과 새 내용(top + r)을 비교
+        int old_visible = front->rows - front_top;
+        int max_rows = visible > old_visible ? visible : old_visible;
+        for (int r = 0; r < max_rows; r++) {
+            if (r >= visible) {
+                // 이전 프레임보다 짧아진 경우 남은 줄 지우기
+                pos = out_move(pos, r);
+                pos = out_append(pos, "\033[K", 3);
+                continue;
+            }
+            RenderLine *nl = &back->lines[top + r];
+            RenderLine *ol = r < old_visible ? &front->lines[front_top + r] : NULL;
+            if (ol && ol->len == nl->len && memcmp(ol->text, nl->text, nl->len) == 0) {
+                continue;  // 변경 없음
+            }
+            pos = out_move(pos, r);
+            pos = out_append(pos, nl->text, nl->len);
+            pos = out_append(pos, "\033[K", 3);
+        }
+        // 커서를 프레임 마지막 줄 끝으로 이동 (입력 프롬프트 위치)
+        RenderLine *last = &back->lines[back->rows - 1];
+        pos = out_move(pos, visible - 1);
+        pos = out_append(pos, last->text, last->len);
+    }
+
+    if (pos > 0) write_all(pos);
+
+    cursor_row = back->rows - 1;
+    front_top = top;
+
+    // 버퍼 교체: 방금 출력한 프레임이 프론트가 됨
+    RenderFrame *tmp = front;
+    front = back;
+    back = tmp;
+    back->rows = 0;
+}
+
+void render_invalidate_from_cursor(void) {
+    for (int i = cursor_row; i < front->rows; i++) {
+        front->lines[i].len = -1;
+    }
+    // 사용자가 Enter를 치면 커서가 한 줄 내려가므로 그 줄도 다시 그려야 함
+    if (front->rows < RENDER_MAX_ROWS && cursor_row + 1 >= front->rows) {
+        front->lines[front->rows].len = -1;
+        front->rows++;
+    }
+}
+
+void render_invalidate_all(void) {
+    need_full_redraw = 1;
+}
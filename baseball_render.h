@@ -0,0 +1,49 @@
+// baseball_render.h - 클라이언트 프레임 버퍼 기반 터미널 렌더러
+// 한 화면 분량의 출력을 버퍼에 모은 뒤 이전 프레임과 줄 단위로 비교하여
+// 변경된 줄만 ANSI 커서 이동 + 한 번의 write()로 출력한다.
+#ifndef BASEBALL_RENDER_H
+#define BASEBALL_RENDER_H
+
+// ──────────────────────────────────────────────────────────
+// 렌더러 설정 상수
+// ──────────────────────────────────────────────────────────
+#define RENDER_MAX_ROWS     128     // 한 프레임의 최대 줄 수
+#define RENDER_MAX_COLS     512     // 한 줄의 최대 바이트 수 (UTF-8 기준)
+#define RENDER_OUT_SIZE     (RENDER_MAX_ROWS * (RENDER_MAX_COLS + 16))  // 출력 버퍼 크기
+
+/**
+ * 렌더러 초기화
+ * @param fd: 출력 대상 파일 디스크립터 (보통 STDOUT_FILENO)
+ */
+void render_init(int fd);
+
+/**
+ * 새 프레임 작성 시작 (백 버퍼 비우기)
+ */
+void render_begin(void);
+
+/**
+ * 현재 프레임에 printf 형식으로 내용 추가
+ * '\n'으로 줄이 나뉘며, 마지막 줄 끝이 커서 위치가 된다.
+ */
+void render_printf(const char *fmt, ...)
+    __attribute__((format(printf, 1, 2)));
+
+/**
+ * 작성한 프레임을 이전 프레임과 비교하여 변경된 줄만 출력
+ * 모든 출력은 한 번의 write() 호출로 내보낸다.
+ */
+void render_commit(void);
+
+/**
+ * 현재 커서가 있는 줄부터 아래를 무효화
+ * 사용자가 입력을 에코하여 화면이 바뀐 경우 다음 프레임에서 다시 그리도록 함
+ */
+void render_invalidate_from_cursor(void);
+
+/**
+ * 화면 전체 무효화 (다음 프레임에서 화면 클리어 후 전체 출력)
+ */
+void render_invalidate_all(void);
+
+#endif // BASEBALL_RENDER_H
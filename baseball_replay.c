@@ -0,0 +1,570 @@
+/**
+ * baseball_replay.c - 경기 저널 결정적 리플레이 도구
+ *
+ * 📋 주요 기능:
+ * - 서버가 기록한 저널(-j)을 읽어 입력 이벤트(접속, 숫자 설정, 추측, 연결 해제, 재접속)를
+ *   서버와 동일한 게임 로직(baseball_game.c)에 그대로 다시 투입
+ * - 게임 로직이 발생시키는 이벤트를 기록된 이벤트와 한 건씩 비교하여 검증
+ * - 소켓 없이 가상 시계로 최대 속도 실행 후 초당 처리 이벤트 수 보고
+ * - 토너먼트 저널은 레코드의 방 번호로 경기 방을 나누어 동시에 진행된 경기를 그대로 재현
+ * - 크래시 복구 표시(restore)는 스냅샷 시점까지 되감아 서버와 같은 복원 상태에서 이어서 검증
+ * - 추측 레코드의 남은 후보 수로 시도 횟수별 후보 감소 추이 분석
+ *
+ * 🔧 사용 목적:
+ * - 게임 로직 변경 시 실제 트래픽 형태를 이용한 회귀 테스트
+ * - 게임 로직 + 메시지 직렬화 경로의 성능 측정
+ * - 크래시 복구 스냅샷의 방 수별 fork/기록/복원 시간 측정 (-b)
+ *
+ * 사용법: baseball_replay [-r 반복횟수] [-v] <저널파일>
+ *         baseball_replay -b <최대 방 수>
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/wait.h>
+
+#include "baseball_protocol.h"
+#include "baseball_journal.h"
+#include "baseball_game.h"
+#include "baseball_tournament.h"
+#include "baseball_snapshot.h"
+
+#define REPLAY_MAX_ROOMS (1 + TOURNAMENT_MAX_ENTRANTS / 2)  // 일반 대전 방 + 토너먼트 경기 방
+#define REPLAY_ATTEMPT_BUCKETS 10                           // 후보 분석에서 따로 집계하는 시도 횟수 (이후는 마지막 칸)
+
+// ──────────────────────────────────────────────────────────
+// 리플레이 상태 전역 변수
+// ──────────────────────────────────────────────────────────
+GameManager rooms[REPLAY_MAX_ROOMS];    // 리플레이 대상 방 (0: 일반 대전 방, 1~: 토너먼트 경기 방)
+int rooms_used = 1;                     // 한 번이라도 열린 방 수 (시간 경과 처리 대상)
+uint32_t last_match_id = 0;             // 리플레이 중 본 가장 큰 경기 번호
+const JournalRecord *records;           // 기록된 레코드 배열
+uint64_t record_count;                  // 기록된 레코드 수
+uint64_t expect_idx;                    // 다음으로 비교할 기록 레코드 위치
+uint64_t virtual_now_ms;                // 가상 시계 (기록된 타임스탬프를 따라감)
+int mismatch = 0;                       // 불일치 발생 여부
+int verbose = 0;                        // 이벤트별 로그 출력 여부
+unsigned long long frames_sent = 0;     // 직렬화한 메시지 수
+unsigned long long bytes_sent = 0;      // 직렬화한 메시지 바이트 수
+
+// ──────────────────────────────────────────────────────────
+// 게임 로직 훅 구현 (소켓 없음, 가상 시계)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 가상 시계 - 현재 처리 중인 레코드의 타임스탬프
+ */
+uint64_t replay_now_ms(void) {
+    return virtual_now_ms;
+}
+
+/**
+ * 전송 훅 - 실제 전송 없이 크기만 집계 (인코딩 비용은 서버와 같음)
+ */
+void replay_send(GameManager *g, int player_id, SharedFrame *f) {
+    (void)g;
+    (void)player_id;
+    frames_sent++;
+    bytes_sent += f->len;  // 2바이트 길이 prefix 포함
+}
+
+/**
+ * 방 전체 전송 훅 - 서버처럼 수신자 수와 무관하게 한 번만 인코딩
+ */
+void replay_publish(GameManager *g, SharedFrame *f, int audience) {
+    (void)g;
+    (void)audience;
+    frames_sent++;
+    bytes_sent += f->len;
+}
+
+/**
+ * 기록 레코드 중 비교 대상이 아닌 것(서버 재시작/인계/방 열기 표시)을 건너뜀
+ */
+void skip_markers(void) {
+    while (expect_idx < record_count &&
+           (records[expect_idx].type == JOURNAL_SERVER_START ||
+            records[expect_idx].type == JOURNAL_HANDOFF ||
+            records[expect_idx].type == JOURNAL_ROOM_OPEN)) {
+        expect_idx++;
+    }
+}
+
+/**
+ * 레코드 한 건을 사람이 읽을 수 있게 출력
+ */
+void print_record(const char *label, uint64_t idx, const JournalRecord *r) {
+    printf("  %s #%llu: match=%u room=%u type=%s player=%u number=%.3s target=%u S=%u B=%u attempts=%u remaining=%u\n",
+           label, (unsigned long long)idx, r->match_id, r->room_id, journal_event_name(r->type),
+           r->player_id, r->number[0] ? r->number : "---", r->target, r->strikes, r->balls, r->attempts,
+           r->remaining);
+}
+
+/**
+ * 이벤트 훅 - 게임 로직이 발생시킨 이벤트를 기록과 비교
+ */
+void replay_on_event(GameManager *g, JournalEventType type, int player_id,
+                     const char *number, const GuessResult *result) {
+    if (mismatch) return;
+
+    JournalRecord got;
+    memset(&got, 0, sizeof(got));
+    got.match_id = g->match_id;
+    got.room_id = g->room_id;
+    got.type = type;
+    got.player_id = (uint8_t)player_id;
+    if (number) strncpy(got.number, number, NUMBER_LENGTH);
+    if (result) {
+        got.strikes = result->strikes;
+        got.balls = result->balls;
+        got.target = (uint8_t)result->target;
+        got.remaining = (uint16_t)result->remaining;
+    }
+    if (player_id >= 0 && player_id < MAX_CLIENTS) {
+        got.attempts = g->players[player_id].attempts;
+    }
+
+    skip_markers();
+    if (expect_idx >= record_count) {
+        printf("[Replay] ❌ 기록에 없는 추가 이벤트 발생\n");
+        print_record("replay", expect_idx, &got);
+        mismatch = 1;
+        return;
+    }
+
+    const JournalRecord *want = &records[expect_idx];
+    if (want->type != got.type || want->player_id != got.player_id ||
+        want->match_id != got.match_id || want->room_id != got.room_id ||
+        want->strikes != got.strikes ||
+        want->balls != got.balls || want->attempts != got.attempts ||
+        (want->remaining != 0 && want->remaining != got.remaining) ||  // 0: 남은 후보 기록 이전 저널
+        strncmp(want->number, got.number, NUMBER_LENGTH) != 0) {
+        printf("[Replay] ❌ 결과 불일치 (방 %u)\n", g->room_id);
+        print_record("recorded", expect_idx, want);
+        print_record("replay  ", expect_idx, &got);
+        mismatch = 1;
+        return;
+    }
+
+    if (verbose) print_record("ok", expect_idx, want);
+    if (got.match_id > last_match_id) last_match_id = got.match_id;
+    expect_idx++;
+}
+
+// ──────────────────────────────────────────────────────────
+// 리플레이 실행
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 기록된 입력을 게임 로직에 투입할 메시지로 변환 (서버가 스캔한 것과 같은 구조체)
+ */
+void build_input_message(const JournalRecord *r, ClientMsg *msg) {
+    memset(msg, 0, sizeof(*msg));
+    msg->fields = CMSG_ACTION;
+
+    if (r->type == JOURNAL_SET_NUMBER) {
+        snprintf(msg->action, sizeof(msg->action), "%s", ACTION_SET_NUMBER);
+        memcpy(msg->number, r->number, NUMBER_LENGTH);
+        msg->fields |= CMSG_NUMBER;
+        return;
+    }
+    snprintf(msg->action, sizeof(msg->action), "%s", ACTION_GUESS);
+    memcpy(msg->guess, r->number, NUMBER_LENGTH);
+    msg->fields |= CMSG_GUESS;
+    // 정원이 기록되지 않은 이전 저널은 1:1 방이라 대상 생략 (게임 로직이 상대방으로 지정)
+    if (r->capacity) {
+        msg->target = r->target;
+        msg->fields |= CMSG_TARGET;
+    }
+}
+
+/**
+ * 레코드에 기록된 방 정원 (정원 기록 이전 저널은 1:1)
+ */
+int record_capacity(const JournalRecord *r) {
+    return r->capacity ? r->capacity : DEFAULT_ROOM_PLAYERS;
+}
+
+int replay_records(uint64_t end);
+
+/**
+ * 크래시 복구 표시 처리 - 저널을 처음부터 snapshot_seq까지 다시 돌려 스냅샷과 같은 방 상태를 만들고
+ * 서버와 같은 game_restore_room()을 적용 (스냅샷 이후 크래시 전까지의 기록은 버려진 상태)
+ * 같은 스냅샷에서 복원한 방이 연속으로 기록되므로 되감기는 첫 레코드에서 한 번만
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int replay_restore(uint64_t i) {
+    const JournalRecord *r = &records[i];
+    if (r->snapshot_seq > i || r->room_id >= REPLAY_MAX_ROOMS) {
+        printf("[Replay] ❌ 복원 지점이 잘못되었습니다\n");
+        print_record("recorded", i, r);
+        return -1;
+    }
+
+    int first = i == 0 || records[i - 1].type != JOURNAL_RESTORE ||
+                records[i - 1].snapshot_seq != r->snapshot_seq;
+    if (first) {
+        int saved_verbose = verbose;
+        uint32_t saved_last_match = last_match_id;
+        verbose = 0;
+        int rc = replay_records(r->snapshot_seq);
+        verbose = saved_verbose;
+        if (saved_last_match > last_match_id) last_match_id = saved_last_match;
+        if (rc < 0) return -1;
+        if (verbose) {
+            printf("  restore #%llu: 레코드 %u 시점으로 되감음\n",
+                   (unsigned long long)i, r->snapshot_seq);
+        }
+    }
+
+    GameManager *game = &rooms[r->room_id];
+    virtual_now_ms = r->timestamp_ms;
+    game_restore_room(game);
+    game->room_id = r->room_id;
+    game->match_id = r->match_id;
+    game->capacity = record_capacity(r);
+    if (r->room_id >= rooms_used) rooms_used = r->room_id + 1;
+    return 0;
+}
+
+/**
+ * 저널 전체를 한 번 리플레이
+ * @return: 기록과 일치하면 0, 불일치 시 -1
+ */
+int replay_once(void) {
+    return replay_records(record_count);
+}
+
+/**
+ * 빈 상태에서 레코드 [0, end)를 리플레이
+ * @return: 기록과 일치하면 0, 불일치 시 -1
+ */
+int replay_records(uint64_t end) {
+    game_init(&rooms[0]);
+    rooms_used = 1;
+    last_match_id = 0;
+    expect_idx = 0;
+    virtual_now_ms = 0;
+    mismatch = 0;
+
+    uint64_t i = 0;
+    while (i < end && !mismatch) {
+        const JournalRecord *r = &records[i];
+        if (r->type == JOURNAL_RESTORE) {
+            // 크래시 복구: 재시작 사이에는 시간 경과 처리가 없었으므로 되감기 전에 tick하지 않음
+            if (replay_restore(i) < 0) return -1;
+            i++;
+            expect_idx = i;
+            continue;
+        }
+        virtual_now_ms = r->timestamp_ms;
+        for (int room = 0; room < rooms_used; room++) {
+            game_tick(&rooms[room]);  // 서버와 같은 순서 (일반 방 → 경기 방)
+        }
+
+        // 시간 경과로 발생한 이벤트(재접속 대기 만료 등)는 이미 비교 완료
+        if (expect_idx > i) {
+            i = expect_idx;
+            continue;
+        }
+
+        if (r->room_id >= REPLAY_MAX_ROOMS) {
+            printf("[Replay] ❌ 기록된 방 번호 %u를 지원하지 않습니다\n", r->room_id);
+            print_record("recorded", i, r);
+            return -1;
+        }
+        GameManager *game = &rooms[r->room_id];
+
+        switch (r->type) {
+            case JOURNAL_SERVER_START:
+                // 서버 재시작: 방 상태는 사라지고 경기 번호만 이어짐
+                for (int room = 0; room < rooms_used; room++) game_init(&rooms[room]);
+                rooms_used = 1;
+                rooms[0].match_id = r->match_id;
+                rooms[0].capacity = record_capacity(r);
+                i++;
+                expect_idx = i;
+                continue;
+            case JOURNAL_ROOM_OPEN:
+                // 토너먼트 경기 방 열기: 경기 번호는 서버가 배정한 값을 그대로 사용
+                game_init(game);
+                game->room_id = r->room_id;
+                game->match_id = r->match_id;
+                game->capacity = record_capacity(r);
+                if (r->room_id >= rooms_used) rooms_used = r->room_id + 1;
+                i++;
+                expect_idx = i;
+                continue;
+            case JOURNAL_HANDOFF:
+                // 무중단 재시작: 방 상태가 그대로 이어지므로 표시만 건너뜀
+                i++;
+                expect_idx = i;
+                continue;
+            case JOURNAL_CONNECT:
+                if (r->player_id >= game->capacity || game->players[r->player_id].connected ||
+                    game->players[r->player_id].suspended) {
+                    printf("[Replay] ❌ 기록된 좌석 %u에 입장할 수 없습니다\n", r->player_id);
+                    print_record("recorded", i, r);
+                    return -1;
+                }
+                game->players[r->player_id].sockfd = -1;
+                game_player_join(game, r->player_id);
+                break;
+            case JOURNAL_DISCONNECT:
+                if (r->player_id < game->capacity) game_player_leave(game, r->player_id);
+                break;
+            case JOURNAL_RESUME:
+                if (r->player_id >= game->capacity || !game->players[r->player_id].suspended) {
+                    printf("[Replay] ❌ 기록된 좌석 %u는 재접속 대기 중이 아닙니다\n", r->player_id);
+                    print_record("recorded", i, r);
+                    return -1;
+                }
+                game->players[r->player_id].sockfd = -1;
+                game_player_resume(game, r->player_id);
+                break;
+            case JOURNAL_SET_NUMBER:
+            case JOURNAL_GUESS: {
+                if (r->player_id >= game->capacity) break;
+                ClientMsg msg;
+                build_input_message(r, &msg);
+                game_handle_message(game, r->player_id, &msg);
+                break;
+            }
+            default:
+                // 게임 시작/종료는 출력 이벤트 - 게임 로직이 스스로 발생시켜야 함
+                printf("[Replay] ❌ 기록된 이벤트가 리플레이에서 발생하지 않았습니다\n");
+                print_record("recorded", i, r);
+                return -1;
+        }
+
+        // 입력 이벤트는 최소한 자기 자신을 이벤트로 발생시켜야 함
+        if (!mismatch && expect_idx <= i) {
+            printf("[Replay] ❌ 입력이 게임 로직에서 거부되었습니다\n");
+            print_record("recorded", i, r);
+            return -1;
+        }
+        i = expect_idx;
+    }
+
+    return mismatch ? -1 : 0;
+}
+
+double elapsed_sec(const struct timespec *a, const struct timespec *b) {
+    return (b->tv_sec - a->tv_sec) + (b->tv_nsec - a->tv_nsec) / 1e9;
+}
+
+// ──────────────────────────────────────────────────────────
+// 남은 후보 분석
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 추측자의 시도 횟수별 평균 남은 후보 수 출력 (기록된 값 기준, 남은 후보 기록 이전 저널은 건너뜀)
+ * 정보량이 많은 추측일수록 앞쪽 시도에서 후보가 빨리 줄어듦
+ */
+void report_candidates(void) {
+    uint64_t sum[REPLAY_ATTEMPT_BUCKETS] = {0};
+    uint64_t count[REPLAY_ATTEMPT_BUCKETS] = {0};
+    uint64_t guesses = 0, total_attempts = 0, solved = 0;
+
+    for (uint64_t i = 0; i < record_count; i++) {
+        const JournalRecord *r = &records[i];
+        if (r->type != JOURNAL_GUESS || r->remaining == 0 || r->attempts == 0) continue;
+        int bucket = r->attempts < REPLAY_ATTEMPT_BUCKETS ? r->attempts - 1 : REPLAY_ATTEMPT_BUCKETS - 1;
+        sum[bucket] += r->remaining;
+        count[bucket]++;
+        guesses++;
+        if (r->strikes == NUMBER_LENGTH) {
+            solved++;
+            total_attempts += r->attempts;
+        }
+    }
+    if (guesses == 0) return;
+
+    printf("[Replay] 남은 후보 분석: 추측 %llu회, 정답 %llu회 (평균 %.2f번째 시도)\n",
+           (unsigned long long)guesses, (unsigned long long)solved,
+           solved ? (double)total_attempts / solved : 0.0);
+    printf("[Replay] 시도별 평균 남은 후보 (전체 %d개):", CANDIDATE_COUNT);
+    for (int b = 0; b < REPLAY_ATTEMPT_BUCKETS; b++) {
+        if (count[b] == 0) continue;
+        printf(" %d%s회 %.1f", b + 1, b == REPLAY_ATTEMPT_BUCKETS - 1 ? "+" : "", (double)sum[b] / count[b]);
+    }
+    printf("\n");
+}
+
+// ──────────────────────────────────────────────────────────
+// 스냅샷 복구 벤치마크 (-b)
+// ──────────────────────────────────────────────────────────
+#define BENCH_SNAPSHOT_PATH "/tmp/baseball_replay_bench.snapshot"
+
+/**
+ * 게임 중인 1:1 방 채우기 (숫자 설정 후 몇 번씩 추측한 상태)
+ */
+void bench_fill_room(GameManager *g, int room_id) {
+    static const char *numbers[] = { "123", "456", "789", "102", "358", "947" };
+    game_init(g);
+    g->room_id = (uint16_t)room_id;
+    g->match_id = (uint32_t)room_id + 1;
+    g->state = GAME_PLAYING;
+    g->players_ready = g->capacity;
+    g->current_turn = room_id % g->capacity;
+    for (int i = 0; i < g->capacity; i++) {
+        PlayerInfo *p = &g->players[i];
+        p->connected = 1;
+        p->sockfd = 3 + i;
+        p->state = i == g->current_turn ? PLAYER_TURN : PLAYER_WAITING_TURN;
+        p->attempts = (room_id + i) % 7;
+        snprintf(p->secret_number, sizeof(p->secret_number), "%s", numbers[(room_id + i) % 6]);
+        snprintf(p->resume_token, sizeof(p->resume_token), "%08x%08x", (unsigned)room_id, (unsigned)i);
+        snprintf(p->name, sizeof(p->name), "bench%u_%u", (uint16_t)room_id, (uint8_t)i);
+    }
+}
+
+/**
+ * 방 수를 두 배씩 늘리며 스냅샷 비용 측정
+ * - fork: 방 상태를 들고 있는 프로세스의 fork() 시간 (이벤트 루프가 멈추는 유일한 구간)
+ * - 기록: 자식이 하는 직렬화 + fsync + rename (부모는 기다리지 않음)
+ * - 복원: 서버 시작 시의 읽기 + 검증 + 방 복원 + 좌석 재접속 대기 전환
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int run_snapshot_bench(int max_rooms) {
+    GameManager *bench_rooms = malloc((size_t)max_rooms * sizeof(GameManager));
+    if (!bench_rooms) return -1;
+
+    printf("[Bench] 스냅샷 복구 시간 (방마다 1:1 게임 진행 중, %s)\n", BENCH_SNAPSHOT_PATH);
+    for (int n = 1; n <= max_rooms; n = n < max_rooms && n * 2 > max_rooms ? max_rooms : n * 2) {
+        for (int i = 0; i < n; i++) bench_fill_room(&bench_rooms[i], i);
+
+        struct timespec t0, tf, t1, t2, t3;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        pid_t pid = fork();
+        if (pid == 0) _exit(0);
+        clock_gettime(CLOCK_MONOTONIC, &tf);
+        if (pid > 0) waitpid(pid, NULL, 0);
+
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        snapshot_write_begin(BENCH_SNAPSHOT_PATH);
+        for (int i = 0; i < n; i++) snapshot_write_room(&bench_rooms[i], -1, NULL);
+        long size = snapshot_write_commit(0, 0, (uint32_t)n);
+        clock_gettime(CLOCK_MONOTONIC, &t2);
+        if (size < 0) {
+            printf("[Bench] 스냅샷 기록 실패\n");
+            free(bench_rooms);
+            return -1;
+        }
+
+        // 복원: 서버의 restore_snapshot과 같은 순서 (읽기/검증 → 방별 복원 → 재접속 대기 전환)
+        memset(bench_rooms, 0, (size_t)n * sizeof(GameManager));
+        SnapshotReader rd;
+        int restored = 0;
+        if (snapshot_load(BENCH_SNAPSHOT_PATH, &rd) == 0) {
+            uint32_t type, sec_size;
+            const void *body;
+            SnapshotRoom meta;
+            while ((body = snapshot_next(&rd, &type, &sec_size)) != NULL && restored < n) {
+                if (type != SNAPSHOT_SEC_ROOM) continue;
+                GameManager *g = &bench_rooms[restored];
+                game_init(g);
+                if (snapshot_room_unpack(body, sec_size, g, &meta) < 0) break;
+                game_restore_room(g);
+                restored++;
+            }
+            snapshot_free(&rd);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t3);
+        if (restored != n) {
+            printf("[Bench] 스냅샷 복원 실패 (%d/%d개)\n", restored, n);
+            free(bench_rooms);
+            return -1;
+        }
+
+        double restore_ms = elapsed_sec(&t2, &t3) * 1e3;
+        printf("[Bench] 방 %6d개: 파일 %9ld bytes, fork %7.1fµs, 기록 %8.2fms, 복원 %8.2fms (방당 %.2fµs)\n",
+               n, size, elapsed_sec(&t0, &tf) * 1e6, elapsed_sec(&t1, &t2) * 1e3,
+               restore_ms, restore_ms * 1e3 / n);
+        if (n == max_rooms) break;
+    }
+    unlink(BENCH_SNAPSHOT_PATH);
+    free(bench_rooms);
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────
+// 메인 함수
+// ──────────────────────────────────────────────────────────
+int main(int argc, char *argv[]) {
+    int repeat = 1;
+    int bench_rooms = 0;
+    int opt_ch;
+
+    // 옵션 파싱: -r <반복 횟수>, -v (이벤트별 로그), -b <최대 방 수> (스냅샷 복구 벤치마크)
+    while ((opt_ch = getopt(argc, argv, "r:vb:")) != -1) {
+        switch (opt_ch) {
+            case 'r':
+                repeat = atoi(optarg);
+                if (repeat < 1) repeat = 1;
+                break;
+            case 'v':
+                verbose = 1;
+                break;
+            case 'b':
+                bench_rooms = atoi(optarg);
+                if (bench_rooms < 1 || bench_rooms > UINT16_MAX) {
+                    printf("[Bench] 방 수는 1~%d개여야 합니다\n", UINT16_MAX);
+                    return 1;
+                }
+                break;
+            default:
+                printf("사용법: %s [-r 반복횟수] [-v] <저널파일> | -b <최대 방 수>\n", argv[0]);
+                return 1;
+        }
+    }
+
+    GameHooks hooks = {
+        .send_to_player = replay_send,
+        .publish = replay_publish,
+        .on_event = replay_on_event,
+        .now_ms = replay_now_ms,
+        .verbose = 0,
+    };
+    game_set_hooks(&hooks);
+
+    if (bench_rooms > 0) return run_snapshot_bench(bench_rooms) == 0 ? 0 : 1;
+    if (optind != argc - 1) {
+        printf("사용법: %s [-r 반복횟수] [-v] <저널파일> | -b <최대 방 수>\n", argv[0]);
+        return 1;
+    }
+
+    size_t map_size;
+    void *map = journal_map_readonly(argv[optind], &records, &record_count, &map_size);
+    if (!map) return 1;
+
+    printf("[Replay] 저널 %s: 레코드 %llu개, %d회 반복\n",
+           argv[optind], (unsigned long long)record_count, repeat);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int result = 0;
+    for (int r = 0; r < repeat && result == 0; r++) {
+        result = replay_once();
+        verbose = 0;  // 상세 로그는 첫 반복에서만
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double sec = elapsed_sec(&t0, &t1);
+    unsigned long long events = (unsigned long long)record_count * repeat;
+    if (result == 0) {
+        printf("[Replay] ✅ 모든 이벤트가 기록과 일치합니다 (마지막 경기 번호 %u)\n", last_match_id);
+    }
+    printf("[Replay] 처리 이벤트: %llu개, 소요 시간: %.3f초, %.0f events/sec\n",
+           events, sec, sec > 0 ? events / sec : 0.0);
+    printf("[Replay] 직렬화 메시지: %llu개 (%llu bytes)\n", frames_sent, bytes_sent);
+    if (result == 0) report_candidates();
+
+    journal_unmap_readonly(map, map_size);
+    return result == 0 ? 0 : 1;
+}
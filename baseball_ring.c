@@ -0,0 +1,82 @@
+/**
+ * baseball_ring.c - 일관 해싱 링 구현
+ *
+ * 📋 동작 방식:
+ * - 서버 추가 시 "key#i" (i = 0..RING_VNODES-1)를 해시한 가상 노드를 정렬된 배열에 삽입
+ * - 조회는 이진 탐색으로 해시 이상인 첫 가상 노드를 찾고, 배열 끝을 넘으면 처음으로 돌아감
+ * - 서버 수가 적어(최대 RING_MAX_NODES) 삽입은 단순 정렬 삽입으로 충분
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+
+#include "baseball_ring.h"
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+uint32_t ring_hash(const void *data, size_t len) {
+    const unsigned char *p = data;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    // FNV-1a는 마지막 바이트만 다른 입력의 상위 비트가 비슷하므로 한 번 더 섞음 (murmur3 fmix32)
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+void ring_init(HashRing *r) {
+    r->nodes = 0;
+    r->count = 0;
+}
+
+int ring_add(HashRing *r, const char *key) {
+    if (r->nodes >= RING_MAX_NODES) return -1;
+    int node = r->nodes++;
+
+    for (int v = 0; v < RING_VNODES; v++) {
+        char vkey[128];
+        int n = snprintf(vkey, sizeof(vkey), "%s#%d", key, v);
+        uint32_t point = ring_hash(vkey, (size_t)n < sizeof(vkey) ? (size_t)n : sizeof(vkey) - 1);
+
+        int pos = r->count;
+        while (pos > 0 && r->points[pos - 1].point > point) {
+            r->points[pos] = r->points[pos - 1];
+            pos--;
+        }
+        r->points[pos].point = point;
+        r->points[pos].node = node;
+        r->count++;
+    }
+    return node;
+}
+
+int ring_walk(const HashRing *r, uint32_t hash, int *order, int max) {
+    if (r->count == 0) return 0;
+
+    // hash 이상인 첫 가상 노드 (없으면 원을 돌아 0번)
+    int lo = 0, hi = r->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (r->points[mid].point < hash) lo = mid + 1;
+        else hi = mid;
+    }
+
+    int filled = 0;
+    for (int i = 0; i < r->count && filled < max && filled < r->nodes; i++) {
+        int node = r->points[(lo + i) % r->count].node;
+        int seen = 0;
+        for (int k = 0; k < filled && !seen; k++) seen = order[k] == node;
+        if (!seen) order[filled++] = node;
+    }
+    return filled;
+}
@@ -0,0 +1,56 @@
+// baseball_ring.h - 일관 해싱 링 (게이트웨이의 방 → 게임 서버 배정)
+// 서버마다 주소를 해시한 가상 노드 RING_VNODES개를 32비트 원 위에 뿌려 두고,
+// 방 id를 해시한 지점에서 시계 방향으로 처음 만나는 가상 노드의 서버가 방의 주인 후보가 된다.
+// 서버를 더하거나 빼도 그 서버의 구간에 떨어지던 방만 옮겨 가고 나머지 방의 배정은 그대로다.
+#ifndef BASEBALL_RING_H
+#define BASEBALL_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ──────────────────────────────────────────────────────────
+// 1) 링 설정 상수
+// ──────────────────────────────────────────────────────────
+#define RING_MAX_NODES      16      // 최대 서버 수
+#define RING_VNODES         64      // 서버당 가상 노드 수 (많을수록 방이 고르게 나뉨)
+
+typedef struct {
+    uint32_t point;                 // 원 위의 위치
+    int node;                       // 서버 번호
+} RingPoint;
+
+typedef struct {
+    int nodes;                      // 등록된 서버 수
+    int count;                      // 가상 노드 수 (points는 point 오름차순)
+    RingPoint points[RING_MAX_NODES * RING_VNODES];
+} HashRing;
+
+// ──────────────────────────────────────────────────────────
+// 2) 링 API
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 바이트열 해시 (FNV-1a + 비트 섞기 - 연속된 방 번호도 원 위에 고르게 흩어짐)
+ */
+uint32_t ring_hash(const void *data, size_t len);
+
+/**
+ * 빈 링으로 초기화
+ */
+void ring_init(HashRing *r);
+
+/**
+ * 서버 추가 (key는 "주소:포트"처럼 재시작해도 같은 값 - 같은 key면 같은 위치)
+ * @return: 서버 번호 (추가 순서), 가득 차면 -1
+ */
+int ring_add(HashRing *r, const char *key);
+
+/**
+ * 해시 지점에서 시계 방향으로 만나는 서버 순서 (중복 제외)
+ * 첫 번째가 주인 후보, 나머지는 주인이 받을 수 없을 때 차례로 시도할 후보
+ * @param order: 서버 번호를 받을 배열 (max개)
+ * @return: 채운 서버 수
+ */
+int ring_walk(const HashRing *r, uint32_t hash, int *order, int max);
+
+#endif // BASEBALL_RING_H
@@ -0,0 +1,286 @@
+/**
+ * baseball_scan.c - 고정 필드 메시지용 JSON 스캐너 구현
+ *
+ * 📋 스캔 규칙:
+ * - 최상위는 객체 하나, 키는 이스케이프 없는 문자열
+ * - 필드 표에 있는 키: 문자열 필드는 문자열, 정수 필드는 정수/true/false/null만 허용
+ * - 표에 없는 키: 문자열/숫자/리터럴 값은 건너뜀
+ * - 중첩 객체/배열, \u 이스케이프, 버퍼보다 긴 문자열, 타입 불일치, 뒤에 남은 문자 → SCAN_FALLBACK
+ *
+ * 같은 필드 표로 json-c 트리에서도 값을 꺼내므로 두 경로의 결과가 같다.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "baseball_scan.h"
+
+// ──────────────────────────────────────────────────────────
+// 필드 표
+// ──────────────────────────────────────────────────────────
+
+typedef enum {
+    FIELD_STR = 0,
+    FIELD_INT
+} FieldType;
+
+typedef struct {
+    const char *key;
+    size_t key_len;
+    FieldType type;
+    uint32_t bit;                   // 구조체 fields에 표시할 비트
+    size_t offset;                  // 구조체 안의 위치
+    size_t size;                    // 문자열 필드 버퍼 크기
+} FieldSpec;
+
+#define STR_FIELD(T, key, member, bit) \
+    { key, sizeof(key) - 1, FIELD_STR, bit, offsetof(T, member), sizeof(((T *)0)->member) }
+#define INT_FIELD(T, key, member, bit) \
+    { key, sizeof(key) - 1, FIELD_INT, bit, offsetof(T, member), sizeof(int) }
+
+static const FieldSpec client_fields[] = {
+    STR_FIELD(ClientMsg, "action", action, CMSG_ACTION),
+    STR_FIELD(ClientMsg, "number", number, CMSG_NUMBER),
+    STR_FIELD(ClientMsg, "guess",  guess,  CMSG_GUESS),
+    INT_FIELD(ClientMsg, "target", target, CMSG_TARGET),
+    STR_FIELD(ClientMsg, "token",  token,  CMSG_TOKEN),
+    STR_FIELD(ClientMsg, "name",   name,   CMSG_NAME),
+    INT_FIELD(ClientMsg, "top",    top,    CMSG_TOP),
+    INT_FIELD(ClientMsg, "caps",   caps,   CMSG_CAPS),
+    STR_FIELD(ClientMsg, "timestamp", timestamp, CMSG_TIMESTAMP),
+};
+
+static const FieldSpec server_fields[] = {
+    STR_FIELD(ServerMsg, "action",          action,          SMSG_ACTION),
+    STR_FIELD(ServerMsg, "message",         message,         SMSG_MESSAGE),
+    STR_FIELD(ServerMsg, "state",           state,           SMSG_STATE),
+    STR_FIELD(ServerMsg, "status",          status,          SMSG_STATUS),
+    STR_FIELD(ServerMsg, "result",          result,          SMSG_RESULT),
+    INT_FIELD(ServerMsg, "player_id",       player_id,       SMSG_PLAYER_ID),
+    STR_FIELD(ServerMsg, "resume_token",    resume_token,    SMSG_RESUME_TOKEN),
+    STR_FIELD(ServerMsg, "number",          number,          SMSG_NUMBER),
+    INT_FIELD(ServerMsg, "your_turn",       your_turn,       SMSG_YOUR_TURN),
+    INT_FIELD(ServerMsg, "current_player",  current_player,  SMSG_CURRENT_PLAYER),
+    INT_FIELD(ServerMsg, "capacity",        capacity,        SMSG_CAPACITY),
+    INT_FIELD(ServerMsg, "out",             out,             SMSG_OUT),
+    STR_FIELD(ServerMsg, "guess",           guess,           SMSG_GUESS),
+    INT_FIELD(ServerMsg, "strikes",         strikes,         SMSG_STRIKES),
+    INT_FIELD(ServerMsg, "balls",           balls,           SMSG_BALLS),
+    INT_FIELD(ServerMsg, "attempts",        attempts,        SMSG_ATTEMPTS),
+    INT_FIELD(ServerMsg, "target",          target,          SMSG_TARGET),
+    INT_FIELD(ServerMsg, "eliminated",      eliminated,      SMSG_ELIMINATED),
+    INT_FIELD(ServerMsg, "winner",          winner,          SMSG_WINNER),
+    STR_FIELD(ServerMsg, "your_number",     your_number,     SMSG_YOUR_NUMBER),
+    STR_FIELD(ServerMsg, "opponent_number", opponent_number, SMSG_OPPONENT_NUMBER),
+    INT_FIELD(ServerMsg, "next_player",     next_player,     SMSG_NEXT_PLAYER),
+    INT_FIELD(ServerMsg, "caps",            caps,            SMSG_CAPS),
+    INT_FIELD(ServerMsg, "players",         players,         SMSG_PLAYERS),
+    INT_FIELD(ServerMsg, "suspended",       suspended,       SMSG_SUSPENDED),
+    STR_FIELD(ServerMsg, "timestamp",       timestamp,       SMSG_TIMESTAMP),
+    INT_FIELD(ServerMsg, "remaining",       remaining,       SMSG_REMAINING),
+};
+
+#define FIELD_COUNT(table) ((int)(sizeof(table) / sizeof((table)[0])))
+
+static const FieldSpec *find_field(const FieldSpec *table, int count, const char *key, size_t key_len) {
+    for (int i = 0; i < count; i++) {
+        if (table[i].key_len == key_len && memcmp(table[i].key, key, key_len) == 0) return &table[i];
+    }
+    return NULL;
+}
+
+// ──────────────────────────────────────────────────────────
+// 스캐너
+// ──────────────────────────────────────────────────────────
+
+static const char *skip_ws(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    return p;
+}
+
+/**
+ * 문자열 값 읽기 (p는 여는 따옴표)
+ * @param dst: 복사할 버퍼 (NULL이면 건너뛰기만)
+ * @return: 닫는 따옴표 다음 위치, 예상 밖의 모양이면 NULL
+ */
+static const char *scan_string(const char *p, const char *end, char *dst, size_t cap) {
+    size_t n = 0;
+    for (p++; p < end; p++) {
+        char c = *p;
+        if (c == '"') {
+            if (dst) dst[n] = '\0';
+            return p + 1;
+        }
+        if (c == '\\') {
+            if (++p >= end) return NULL;
+            switch (*p) {
+                case '"':  c = '"';  break;
+                case '\\': c = '\\'; break;
+                case '/':  c = '/';  break;
+                case 'b':  c = '\b'; break;
+                case 'f':  c = '\f'; break;
+                case 'n':  c = '\n'; break;
+                case 'r':  c = '\r'; break;
+                case 't':  c = '\t'; break;
+                default:   return NULL;     // \u 등은 json-c에 맡김
+            }
+        }
+        if (dst) {
+            if (n + 1 >= cap) return NULL;  // 버퍼보다 긴 값
+            dst[n++] = c;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * 숫자/리터럴 값 읽기
+ * @param value: 정수면 값 저장 (true=1, false/null=0)
+ * @param is_int: 정수(또는 리터럴)로 읽혔으면 1, 소수/지수/큰 수면 0
+ * @return: 값 다음 위치, 예상 밖의 모양이면 NULL
+ */
+static const char *scan_scalar(const char *p, const char *end, int *value, int *is_int) {
+    static const struct { const char *word; size_t len; int value; } literals[] = {
+        { "true", 4, 1 }, { "false", 5, 0 }, { "null", 4, 0 }
+    };
+    for (size_t i = 0; i < sizeof(literals) / sizeof(literals[0]); i++) {
+        if ((size_t)(end - p) >= literals[i].len && memcmp(p, literals[i].word, literals[i].len) == 0) {
+            *value = literals[i].value;
+            *is_int = 1;
+            return p + literals[i].len;
+        }
+    }
+
+    int negative = 0, digits = 0;
+    long v = 0;
+    *is_int = 1;
+    if (p < end && *p == '-') {
+        negative = 1;
+        p++;
+    }
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        if (++digits > 9) *is_int = 0;   // int 범위를 넘을 수 있는 값
+        else v = v * 10 + (*p - '0');
+    }
+    if (digits == 0) return NULL;
+    for (; p < end && (*p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-' ||
+                       (*p >= '0' && *p <= '9')); p++) {
+        *is_int = 0;
+    }
+    *value = negative ? (int)-v : (int)v;
+    return p;
+}
+
+/**
+ * 한 단계 객체를 필드 표에 따라 구조체로 스캔
+ * @return: SCAN_OK 또는 SCAN_FALLBACK
+ */
+static int scan_object(const char *buf, size_t len, const FieldSpec *table, int count,
+                       void *out, uint32_t *fields) {
+    const char *p = buf, *end = buf + len;
+    char *base = out;
+
+    p = skip_ws(p, end);
+    if (p >= end || *p != '{') return SCAN_FALLBACK;
+    p = skip_ws(p + 1, end);
+    if (p < end && *p == '}') {
+        p++;
+    } else {
+        for (;;) {
+            // 키 (이스케이프가 있으면 json-c에 맡김)
+            if (p >= end || *p != '"') return SCAN_FALLBACK;
+            const char *key = ++p;
+            while (p < end && *p != '"' && *p != '\\') p++;
+            if (p >= end || *p != '"') return SCAN_FALLBACK;
+            const FieldSpec *f = find_field(table, count, key, (size_t)(p - key));
+            p = skip_ws(p + 1, end);
+            if (p >= end || *p != ':') return SCAN_FALLBACK;
+            p = skip_ws(p + 1, end);
+            if (p >= end) return SCAN_FALLBACK;
+
+            // 값
+            if (*p == '"') {
+                if (f && f->type != FIELD_STR) return SCAN_FALLBACK;
+                p = f ? scan_string(p, end, base + f->offset, f->size) : scan_string(p, end, NULL, 0);
+            } else if (*p == '{' || *p == '[') {
+                return SCAN_FALLBACK;
+            } else {
+                int value = 0, is_int = 0;
+                p = scan_scalar(p, end, &value, &is_int);
+                if (p && f) {
+                    if (f->type != FIELD_INT || !is_int) return SCAN_FALLBACK;
+                    memcpy(base + f->offset, &value, sizeof(int));
+                }
+            }
+            if (!p) return SCAN_FALLBACK;
+            if (f) *fields |= f->bit;
+
+            p = skip_ws(p, end);
+            if (p < end && *p == ',') {
+                p = skip_ws(p + 1, end);
+                continue;
+            }
+            if (p < end && *p == '}') {
+                p++;
+                break;
+            }
+            return SCAN_FALLBACK;
+        }
+    }
+    return skip_ws(p, end) == end ? SCAN_OK : SCAN_FALLBACK;
+}
+
+/**
+ * json-c 트리에서 필드 표에 있는 값만 구조체로 복사
+ */
+static void object_from_json(struct json_object *jmsg, const FieldSpec *table, int count,
+                             void *out, uint32_t *fields) {
+    char *base = out;
+    for (int i = 0; i < count; i++) {
+        struct json_object *jval = NULL;
+        if (!json_object_object_get_ex(jmsg, table[i].key, &jval)) continue;
+        if (table[i].type == FIELD_STR) {
+            const char *s = json_object_get_string(jval);
+            snprintf(base + table[i].offset, table[i].size, "%s", s ? s : "");
+        } else {
+            int value = json_object_get_int(jval);
+            memcpy(base + table[i].offset, &value, sizeof(int));
+        }
+        *fields |= table[i].bit;
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+int scan_client_msg(const char *buf, size_t len, ClientMsg *msg) {
+    memset(msg, 0, sizeof(*msg));
+    if (scan_object(buf, len, client_fields, FIELD_COUNT(client_fields), msg, &msg->fields) == SCAN_OK) {
+        return SCAN_OK;
+    }
+    memset(msg, 0, sizeof(*msg));  // 중간까지 채운 값은 버림
+    return SCAN_FALLBACK;
+}
+
+void client_msg_from_json(struct json_object *jmsg, ClientMsg *msg) {
+    memset(msg, 0, sizeof(*msg));
+    object_from_json(jmsg, client_fields, FIELD_COUNT(client_fields), msg, &msg->fields);
+}
+
+int scan_server_msg(const char *buf, size_t len, ServerMsg *msg) {
+    memset(msg, 0, sizeof(*msg));
+    if (scan_object(buf, len, server_fields, FIELD_COUNT(server_fields), msg, &msg->fields) == SCAN_OK) {
+        return SCAN_OK;
+    }
+    memset(msg, 0, sizeof(*msg));
+    return SCAN_FALLBACK;
+}
+
+void server_msg_from_json(struct json_object *jmsg, ServerMsg *msg) {
+    memset(msg, 0, sizeof(*msg));
+    object_from_json(jmsg, server_fields, FIELD_COUNT(server_fields), msg, &msg->fields);
+}
@@ -0,0 +1,137 @@
+// baseball_scan.h - 고정 필드 메시지용 JSON 스캐너 (힙 할당 없음)
+// 클라이언트/서버 메시지는 대부분 문자열과 정수 값만 가진 한 단계 객체이므로,
+// 필요한 필드만 수신 버퍼에서 바로 스택 구조체로 복사한다 (트리 생성, 해시 조회 없음).
+// 중첩 배열/객체, \u 이스케이프, 타입이 다른 값처럼 예상 밖의 모양이면 스캔을 포기하고
+// 호출자가 json-c로 파싱한 뒤 *_from_json()으로 같은 구조체를 채운다.
+#ifndef BASEBALL_SCAN_H
+#define BASEBALL_SCAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "baseball_protocol.h"
+
+#define SCAN_OK         0       // 스캔 성공 (구조체 사용)
+#define SCAN_FALLBACK  -1       // 예상 밖의 모양 - json-c로 다시 파싱
+
+#define SCAN_ACTION_LEN     24
+#define SCAN_NUMBER_LEN     (NUMBER_LENGTH + 1)
+#define SCAN_TIMESTAMP_LEN  24      // 하트비트 타임스탬프 (10진수 문자열)
+
+// ──────────────────────────────────────────────────────────
+// 1) 클라이언트 → 서버 메시지
+// ──────────────────────────────────────────────────────────
+typedef enum {
+    CMSG_ACTION = 1 << 0,
+    CMSG_NUMBER = 1 << 1,
+    CMSG_GUESS  = 1 << 2,
+    CMSG_TARGET = 1 << 3,
+    CMSG_TOKEN  = 1 << 4,
+    CMSG_NAME   = 1 << 5,
+    CMSG_TOP    = 1 << 6,
+    CMSG_CAPS   = 1 << 7,
+    CMSG_TIMESTAMP = 1 << 8
+} ClientMsgField;
+
+// 서버가 검증하는 문자열 필드는 용량보다 1바이트 여유를 둠: 너무 긴 값은 잘려도 길이 검사에서 걸러짐
+typedef struct {
+    uint32_t fields;                        // 메시지에 있던 필드 (ClientMsgField 비트)
+    char action[SCAN_ACTION_LEN];
+    char number[SCAN_NUMBER_LEN + 1];       // set_number
+    char guess[SCAN_NUMBER_LEN + 1];        // guess
+    int target;                             // guess 대상 좌석
+    char token[RESUME_TOKEN_LEN + 2];       // resume
+    char name[PLAYER_NAME_LEN + 2];         // set_name, leaderboard
+    int top;                                // leaderboard
+    int caps;                               // hello
+    char timestamp[SCAN_TIMESTAMP_LEN];     // heartbeat 응답 (서버가 보낸 값 그대로)
+} ClientMsg;
+
+/**
+ * 클라이언트 메시지 스캔
+ * @param buf: JSON 문자열 (len 바이트, NUL 종료 불필요)
+ * @return: SCAN_OK, 예상 밖의 모양이면 SCAN_FALLBACK
+ */
+int scan_client_msg(const char *buf, size_t len, ClientMsg *msg);
+
+/**
+ * json-c로 파싱한 메시지에서 같은 필드 추출 (스캔 실패 시)
+ */
+void client_msg_from_json(struct json_object *jmsg, ClientMsg *msg);
+
+// ──────────────────────────────────────────────────────────
+// 2) 서버 → 클라이언트 메시지 (고정 필드만 - 배열/객체 필드는 json-c 트리에서 읽음)
+// ──────────────────────────────────────────────────────────
+typedef enum {
+    SMSG_ACTION          = 1 << 0,
+    SMSG_MESSAGE         = 1 << 1,
+    SMSG_STATE           = 1 << 2,
+    SMSG_STATUS          = 1 << 3,
+    SMSG_RESULT          = 1 << 4,
+    SMSG_PLAYER_ID       = 1 << 5,
+    SMSG_RESUME_TOKEN    = 1 << 6,
+    SMSG_NUMBER          = 1 << 7,
+    SMSG_YOUR_TURN       = 1 << 8,
+    SMSG_CURRENT_PLAYER  = 1 << 9,
+    SMSG_CAPACITY        = 1 << 10,
+    SMSG_OUT             = 1 << 11,
+    SMSG_GUESS           = 1 << 12,
+    SMSG_STRIKES         = 1 << 13,
+    SMSG_BALLS           = 1 << 14,
+    SMSG_ATTEMPTS        = 1 << 15,
+    SMSG_TARGET          = 1 << 16,
+    SMSG_ELIMINATED      = 1 << 17,
+    SMSG_WINNER          = 1 << 18,
+    SMSG_YOUR_NUMBER     = 1 << 19,
+    SMSG_OPPONENT_NUMBER = 1 << 20,
+    SMSG_NEXT_PLAYER     = 1 << 21,
+    SMSG_CAPS            = 1 << 22,
+    SMSG_PLAYERS         = 1 << 23,
+    SMSG_SUSPENDED       = 1 << 24,
+    SMSG_TIMESTAMP       = 1 << 25,
+    SMSG_REMAINING       = 1 << 26
+} ServerMsgField;
+
+typedef struct {
+    uint32_t fields;                        // 메시지에 있던 필드 (ServerMsgField 비트)
+    char action[SCAN_ACTION_LEN];
+    char message[512];
+    char state[16];
+    char status[16];
+    char result[16];
+    int player_id;
+    char resume_token[RESUME_TOKEN_LEN + 1];
+    char number[SCAN_NUMBER_LEN];
+    int your_turn;
+    int current_player;
+    int capacity;
+    int out;
+    char guess[SCAN_NUMBER_LEN];
+    int strikes;
+    int balls;
+    int attempts;
+    int target;
+    int eliminated;
+    int winner;
+    char your_number[SCAN_NUMBER_LEN];
+    char opponent_number[SCAN_NUMBER_LEN];
+    int next_player;                        // turn_result
+    int caps;                               // hello
+    int players;                            // node_status (게이트웨이)
+    int suspended;                          // node_status (게이트웨이)
+    char timestamp[SCAN_TIMESTAMP_LEN];     // heartbeat
+    int remaining;                          // guess_result, turn_result (대상의 남은 후보 수)
+} ServerMsg;
+
+/**
+ * 서버 메시지 스캔
+ * @return: SCAN_OK, 예상 밖의 모양(배열 필드가 있는 스냅샷/결과 등)이면 SCAN_FALLBACK
+ */
+int scan_server_msg(const char *buf, size_t len, ServerMsg *msg);
+
+/**
+ * json-c로 파싱한 메시지에서 같은 필드 추출 (스캔 실패 시)
+ */
+void server_msg_from_json(struct json_object *jmsg, ServerMsg *msg);
+
+#endif // BASEBALL_SCAN_H
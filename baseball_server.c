@@ -13,10 +13,23 @@
  * - 상태 관리: GameManager를 통한 중앙집중식 게임 상태 관리
  * - 에러 처리: 연결 해제, 타임아웃, 프로토콜 오류 처리
  * - 메시지 프로토콜: 길이 prefix + JSON 페이로드 방식
+ * - 경기 저널: 모든 방 이벤트를 mmap 기반 append-only 파일에 기록
+ * - 재접속: 게임 중 끊긴 플레이어는 토큰으로 같은 좌석에 복귀 (RESUME_GRACE_SEC 이내)
+ * - 무중단 재시작: -H 제어 소켓으로 소켓과 방 상태를 새 프로세스에 인계
+ * - 리더보드: -L 파일에 플레이어 이름별 전적을 기록하고 상위 N명/개인 순위 조회 제공
+ * - 관전: -w 포트로 접속한 관전자에게 방 이벤트를 한 번 직렬화한 공유 버퍼로 전달
+ * - 토너먼트: -T 명단으로 대진표를 만들고 경기마다 방을 열어 여러 경기를 동시에 진행
+ * - 다인전: -P로 3~8인 방 (라운드 로빈 턴, 추측 대상 지정, 숫자가 맞춰지면 탈락)
+ * - 로컬 전송: 같은 호스트의 봇/게이트웨이는 -U AF_UNIX 소켓 또는 -M 공유 메모리 링(eventfd 깨우기)으로 접속
+ * - 크래시 복구: -S 파일에 주기적으로 fork() 스냅샷을 남기고, 비정상 종료 후 시작하면 진행 중이던 방을 복원
+ * - 게이트웨이: -G 포트로 baseball_gateway의 링크를 받아 링크 하나 위에 여러 클라이언트 세션을 다중화
+ *   (방 상태를 링크로 보고 - 서버 여러 개를 둔 게이트웨이는 이 보고로 새 경기를 빈 서버에 배정)
  * 
  * 네트워크 프로그래밍 과제용 - 고급 TCP 서버 구현
  */
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -26,31 +39,258 @@
 #include <sys/socket.h>
 #include <sys/select.h>
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <time.h>
+#include <sys/resource.h>
+#include <sys/un.h>
+#include <netinet/tcp.h>
+#ifdef __linux__
+#include <sys/random.h>
+#endif
 
 #include "baseball_protocol.h"
+#include "baseball_journal.h"
+#include "baseball_game.h"
+#include "baseball_handoff.h"
+#include "baseball_leaderboard.h"
+#include "baseball_spectator.h"
+#include "baseball_tournament.h"
+#include "baseball_ratelimit.h"
+#include "baseball_outbox.h"
+#include "baseball_inbox.h"
+#include "baseball_pool.h"
+#include "baseball_scan.h"
+#include "baseball_shm.h"
+#include "baseball_gwlink.h"
+#include "baseball_snapshot.h"
+#include "baseball_heartbeat.h"
+#include "baseball_clock.h"
 
 // ──────────────────────────────────────────────────────────
 // 전역 변수
 // ──────────────────────────────────────────────────────────
 GameManager game;           // 전역 게임 상태 관리자
-time_t last_heartbeat_check; // 마지막 하트비트 체크 시간
+Journal journal = { .fd = -1 }; // 경기 저널 (-j 옵션으로 활성화)
+Leaderboard leaderboard = { .fd = -1 }; // 영구 리더보드 (-L 옵션으로 활성화)
+uint64_t loop_now_ms = 0;   // 이벤트 루프 반복 시작 게임 시각 (게임 시계 훅/저널 - epoch 기준이지만 단조 증가)
+SpectatorList spectators;   // 관전자 연결 (-w 옵션으로 활성화)
+RateLimiter ratelimit;      // 연결별 수신 메시지 속도 제한 (-R 옵션으로 조정)
+uint64_t last_rate_report_ms = 0; // 마지막 속도 제한/송신 큐 통계 출력 시각
+Outbox *outboxes[FD_SETSIZE]; // 클라이언트 연결별 송신 큐 (fd로 바로 찾기, 관전자는 별도 관리)
+Inbox *inboxes[FD_SETSIZE];   // 소켓 연결별 수신 버퍼 (처음 읽을 때 할당, 공유 메모리/게이트웨이 세션은 없음)
+ShmChannel shm_conns[FD_SETSIZE]; // 공유 메모리 연결 (수신 eventfd로 찾기, region이 NULL이면 소켓 연결)
+int shm_listen_fd = -1;     // 공유 메모리 접속 소켓 (-M 옵션)
+uint64_t last_shm_check_ms = 0; // 마지막 공유 메모리 상대 프로세스 확인 시각
+uint64_t shm_attach_deadline[FD_SETSIZE]; // fd 전달을 기다리는 접속 소켓의 마감 시각 (0: 핸드셰이크 중 아님)
+int shm_ready_fd = -1;      // fd 전달이 끝나 입장 처리를 기다리는 채널의 수신 eventfd
+GwLink gw_links[GWLINK_MAX_LINKS]; // 게이트웨이 링크 (-G 옵션)
+GwSession *gw_sessions[FD_SETSIZE]; // 게이트웨이 세션 (세션 eventfd로 찾기, NULL이면 다른 연결)
+int gw_slot_fd[GWLINK_MAX_LINKS][GWLINK_MAX_SLOTS]; // 링크별 세션 슬롯 → 세션 eventfd (-1: 없음)
+int gw_accept_queue[FD_SETSIZE]; // 링크에서 새로 열린 세션 (리스닝 소켓의 대기열처럼 입장 처리)
+int gw_accept_head = 0;
+int gw_accept_count = 0;
+int gw_listen_fd = -1;      // 게이트웨이 링크 리스닝 소켓 (-G 옵션)
+Pool gw_session_pool;       // 게이트웨이 세션 레코드 (수신 대기 버퍼 포함)
+char gw_status_last[128];   // 마지막으로 보고한 방 상태 (바뀌면 바로 다시 보고)
+size_t gw_status_len = 0;   // 0이면 다음 반복에 보고 (새 링크)
+uint64_t gw_status_sent_ms = 0;
+Pool conn_pool;             // 연결 레코드(송신 큐) 슬랩 - 수용 인원만큼 미리 할당
+Pool inbox_pool;            // 소켓 연결의 수신 버퍼 슬랩 (조립 중인 프레임 보관)
+Pool room_pool;             // 토너먼트 경기 방 슬랩 - 동시에 열릴 수 있는 방 수만큼 미리 할당
+Snapshotter snapshotter;    // 크래시 복구 스냅샷 (-S 옵션으로 활성화)
+HeartbeatScheduler heartbeats; // 연결별 하트비트 마감 (한 주기 동안 송신이 없던 연결에만 전송)
+Arena loop_arena;           // 반복 단위 임시 메모리 (수신 프레임 본문 등, 반복마다 되돌림)
+#define LOOP_ARENA_SIZE     (64 * 1024)
+
+// 재접속 대기 좌석이 있을 때 들어온 연결 (첫 메시지로 resume 토큰을 기다림)
+#define MAX_PENDING_CONNECTIONS 8
+
+// 연결 폭주 대응 (이벤트 시작 시각 등에 수천 개의 연결이 한꺼번에 들어오는 경우)
+#define DEFAULT_LISTEN_BACKLOG  1024    // listen() 대기열 길이 (-B 옵션, 커널의 somaxconn으로 잘릴 수 있음)
+#define ACCEPT_BATCH_MAX        1024    // 한 번 깨어날 때 수락하는 최대 연결 수 (나머지는 다음 반복에)
+#define RESERVED_FDS            16      // 리스닝/저널/리더보드/인계 소켓 등 연결 외의 fd 여유분
+int reserve_fd = -1;        // fd 한도에 걸렸을 때 대기열의 연결을 받아 닫기 위해 비워 둘 예비 fd
+int pending_fds[MAX_PENDING_CONNECTIONS] = { -1, -1, -1, -1, -1, -1, -1, -1 };
 
 // ──────────────────────────────────────────────────────────
 // 함수 전방 선언 (Forward Declarations)
 // ──────────────────────────────────────────────────────────
-void start_turn(void);                          // 게임 턴 시작 처리
-void check_all_numbers_set(void);               // 모든 플레이어 숫자 설정 완료 확인
-void check_player_timeouts(fd_set *master_set); // 플레이어 타임아웃 체크 (새로 추가)
-void send_heartbeat_to_all(void);               // 모든 플레이어에게 하트비트 전송 (새로 추가)
-void cleanup_disconnected_player(int player_id, fd_set *master_set); // 연결 해제 정리 (새로 추가)
+void check_player_timeouts(GameManager *g);     // 방의 비활성 플레이어 연결 중단 (정리는 일반 연결 해제 경로)
+void send_idle_heartbeats(void);                // 한 주기 동안 송신이 없던 연결에 하트비트 전송
+void send_to_player(GameManager *g, int player_id, SharedFrame *f); // 개별 메시지 전송 (게임 로직 훅)
+void publish_to_room(GameManager *g, SharedFrame *f, int audience); // 방 전체 전송 (게임 로직 훅)
+void tournament_room_finished(GameManager *g, int winner_seat); // 토너먼트 경기 종료 (대진표 반영 예약)
+void tournament_schedule(void);                 // 시작 가능한 토너먼트 경기 배정
+int accept_connection(int listen_fd, struct sockaddr_storage *addr); // 대기열의 연결 하나 수락 (non-blocking)
+int accept_client(int listen_fd, struct sockaddr_storage *addr); // TCP/AF_UNIX/공유 메모리/게이트웨이 세션 수락
+void set_nonblocking(int fd, int on);           // 소켓 블로킹 모드 설정
+void track_fd(int fd, fd_set *master_set, int *max_fd); // select() 감시 집합에 fd 추가
 
 // ──────────────────────────────────────────────────────────
 // JSON 송수신 함수들 (Network Communication Layer)
 // ──────────────────────────────────────────────────────────
 
 /**
- * JSON 객체를 소켓으로 전송
+ * 공유 메모리 연결인지 (연결 fd는 채널의 수신 eventfd)
+ */
+int is_shm_connection(int fd) {
+    return fd >= 0 && fd < FD_SETSIZE && shm_conns[fd].region != NULL;
+}
+
+/**
+ * 게이트웨이 세션인지 (연결 fd는 세션의 eventfd)
+ */
+int is_gateway_session(int fd) {
+    return fd >= 0 && fd < FD_SETSIZE && gw_sessions[fd] != NULL;
+}
+
+/**
+ * 게이트웨이 링크 소켓인지
+ * @return: 링크 번호, 링크가 아니면 -1
+ */
+int gateway_link_index(int fd) {
+    for (int i = 0; i < GWLINK_MAX_LINKS; i++) {
+        if (gw_links[i].fd >= 0 && gw_links[i].fd == fd) return i;
+    }
+    return -1;
+}
+
+/**
+ * 게이트웨이 세션 정리 (게이트웨이에 닫힘 알림, 슬롯 해제, eventfd 닫기)
+ */
+void gateway_session_release(int fd) {
+    GwSession *s = gw_sessions[fd];
+    if (s->link) {
+        int *slot = &gw_slot_fd[s->link - gw_links][GWLINK_SLOT(s->sid)];
+        if (*slot == fd) *slot = -1;  // 같은 슬롯에 이미 새 세션이 열렸으면 그대로 둠
+    }
+    gw_session_close(s);
+    pool_free(&gw_session_pool, s);
+    gw_sessions[fd] = NULL;
+}
+
+/**
+ * 연결 레코드(송신 큐) 조회 - 처음 보내는 연결이면 풀에서 할당
+ * @return: 송신 큐, 할당 실패 시 NULL
+ */
+Outbox *connection_outbox(int fd) {
+    if (!outboxes[fd]) {
+        outboxes[fd] = pool_alloc(&conn_pool);
+        if (outboxes[fd]) {
+            memset(outboxes[fd], 0, sizeof(Outbox));
+            if (is_shm_connection(fd)) outboxes[fd]->shm = &shm_conns[fd];
+            if (is_gateway_session(fd)) outboxes[fd]->gw = gw_sessions[fd];
+        }
+    }
+    return outboxes[fd];
+}
+
+/**
+ * 수신 버퍼 조회 - 처음 읽는 연결이면 풀에서 할당
+ * @return: 수신 버퍼, 할당 실패 시 NULL
+ */
+Inbox *connection_inbox(int fd) {
+    if (!inboxes[fd]) {
+        inboxes[fd] = pool_alloc(&inbox_pool);
+        if (inboxes[fd]) inbox_reset(inboxes[fd]);
+    }
+    return inboxes[fd];
+}
+
+/**
+ * 연결 레코드 반환 (새 연결이 같은 fd를 받기 전, 또는 연결을 닫을 때)
+ */
+void connection_release(int fd) {
+    if (fd < 0 || fd >= FD_SETSIZE) return;
+    if (inboxes[fd]) {
+        pool_free(&inbox_pool, inboxes[fd]);
+        inboxes[fd] = NULL;
+    }
+    if (!outboxes[fd]) return;
+    outbox_clear(outboxes[fd]);
+    pool_free(&conn_pool, outboxes[fd]);
+    outboxes[fd] = NULL;
+}
+
+/**
+ * 클라이언트 연결 닫기 (송신 큐 정리 포함)
+ * 이번 반복에 쌓아 둔 메시지(거부 사유 등)는 닫기 전에 한 번 전송 시도
+ */
+void close_connection(int fd) {
+    if (fd >= 0 && fd < FD_SETSIZE && outboxes[fd]) outbox_flush(outboxes[fd], fd);
+    connection_release(fd);
+    heartbeat_untrack(&heartbeats, fd);
+    if (is_shm_connection(fd)) {
+        shm_channel_close(&shm_conns[fd]);  // eventfd, 접속 소켓, 매핑 모두 정리
+    } else if (is_gateway_session(fd)) {
+        gateway_session_release(fd);        // 게이트웨이에 닫힘 알림, eventfd 정리
+    } else {
+        close(fd);
+    }
+}
+
+/**
+ * 연결의 송수신 중단 (정리는 다음 수신에서 일반 연결 해제와 같은 경로로)
+ * 공유 메모리 연결은 채널을, 게이트웨이 세션은 세션을 닫힘으로 표시하고 깨움
+ */
+void shutdown_connection(int fd) {
+    if (is_shm_connection(fd)) {
+        shm_channel_shutdown(&shm_conns[fd]);
+    } else if (is_gateway_session(fd)) {
+        gw_session_shutdown(gw_sessions[fd]);
+    } else {
+        shutdown(fd, SHUT_RDWR);
+    }
+}
+
+/**
+ * 직렬화된 메시지를 연결의 송신 큐에 추가 (non-blocking)
+ * 실제 전송은 반복 끝의 outbox_flush_dirty()에서 연결마다 한 번에 모아서 수행하고,
+ * 소켓 버퍼가 가득 차면 남은 부분은 select() 쓰기 가능 이벤트에서 이어서 전송
+ * 송신 예산을 넘긴 느린 소비자나 전송 오류는 소켓을 shutdown()해 두고,
+ * 연결 정리는 다음 수신(EOF)에서 일반 연결 해제와 같은 경로로 처리
+ * 
+ * @param fd: 소켓 파일 디스크립터
+ * @param f: 전송할 공유 버퍼 (큐에 넣으면 참조 추가)
+ * @param kind: OutboxKind (하트비트 등 저가치 메시지는 합치거나 먼저 버림)
+ * @return: 성공 시 0 (대기), 실패 시 -1
+ */
+int send_frame(int fd, SharedFrame *f, int kind) {
+    if (fd < 0 || fd >= FD_SETSIZE) return -1;
+    Outbox *ob = connection_outbox(fd);
+    if (!ob) return -1;
+    
+    if (outbox_push(ob, fd, f, kind) == 0) {
+        heartbeat_note_tx(&heartbeats, fd, clock_now_ms());  // 어떤 프레임이든 생존 신호 - 하트비트 주기 재시작
+        return 0;
+    }
+    
+    printf("[Server] 느린 소비자 - 송신 예산 초과로 연결을 끊습니다 (fd=%d, 미전송 %zu바이트)\n",
+           fd, ob->bytes);
+    outbox_clear(ob);
+    shutdown_connection(fd);
+    return -1;
+}
+
+/**
+ * 방금 만든 메시지를 전송하고 참조 해제 (frame_<name>() 결과를 바로 넘기는 용도)
+ * 
+ * @param fd: 소켓 파일 디스크립터
+ * @param f: 전송할 공유 버퍼 (NULL이면 생성 실패)
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int send_message(int fd, SharedFrame *f) {
+    if (!f) {
+        printf("[Server] 메시지 생성 실패 (fd=%d)\n", fd);
+        return -1;
+    }
+    int ret = send_frame(fd, f, OUTBOX_ESSENTIAL);
+    frame_unref(f);
+    return ret;
+}
+
+/**
+ * JSON 객체를 소켓으로 전송 (스키마 밖의 중첩 메시지용 - 리더보드 결과)
  * 프로토콜: [2바이트 길이] + [JSON 문자열]
  * 
  * @param fd: 소켓 파일 디스크립터
@@ -58,672 +298,2294 @@ void cleanup_disconnected_player(int player_id, fd_set *master_set); // 연결 
  * @return: 성공 시 0, 실패 시 -1
  */
 int send_json(int fd, struct json_object *jobj) {
-    const char *s = json_object_to_json_string(jobj);
-    int len = strlen(s);
-    uint16_t netlen = htons(len);  // 네트워크 바이트 순서로 변환
+    return send_message(fd, frame_from_json(jobj));
+}
+
+/**
+ * 자주 보내는 고정 오류 응답 (처음 쓸 때 한 번만 직렬화해 재사용)
+ */
+typedef struct {
+    const char *message;
+    SharedFrame *frame;
+} CannedReply;
+
+CannedReply reply_busy = { "현재 게임이 진행 중입니다. 잠시 후 다시 시도해주세요.", NULL };
+CannedReply reply_full = { "서버에 접속할 수 없습니다. 나중에 다시 시도해주세요.", NULL };
+CannedReply reply_rate_limited = { "요청이 너무 많습니다. 잠시 후 다시 시도해주세요.", NULL };
+
+/**
+ * 고정 오류 응답 전송 (non-blocking, 소켓 버퍼에 들어가지 않으면 버림)
+ * 곧 닫을 연결이나 속도 제한 안내처럼 전달이 보장되지 않아도 되는 경우에 사용
+ */
+void send_canned_reply(int fd, CannedReply *r) {
+    if (!r->frame) {
+        r->frame = frame_error(&(ErrorMsg){ .message = r->message });
+        if (!r->frame) return;
+    }
+    struct iovec iov = { .iov_base = r->frame->data, .iov_len = r->frame->len };
+    if (is_shm_connection(fd)) {
+        shm_channel_writev(&shm_conns[fd], &iov, 1);
+    } else if (is_gateway_session(fd)) {
+        gw_session_writev(gw_sessions[fd], &iov, 1);
+    } else {
+        send(fd, r->frame->data, r->frame->len, MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+}
+
+/**
+ * 소켓에서 클라이언트 메시지 수신
+ * 소켓은 non-blocking - 받은 만큼 연결의 수신 버퍼에 이어 붙이고, 프레임이 완성됐을 때만 처리
+ * (본문 일부만 보내고 멈춘 상대가 있어도 이벤트 루프는 다른 연결을 계속 처리)
+ * 프레임을 다 읽은 뒤 파싱 전에 속도 제한을 확인 (버린 프레임은 파싱도 응답도 하지 않음)
+ * 알려진 필드는 수신 버퍼에서 바로 스캔하고, 예상 밖의 모양일 때만 json-c로 파싱
+ * 
+ * @param fd: 소켓 파일 디스크립터
+ * @param msg: 스캔한 메시지 필드
+ * @param dropped: 속도 제한으로 프레임을 버렸거나, 읽을 프레임이 없었거나 (아직 조립 중 포함),
+ *                 하트비트 응답처럼 여기서 처리를 끝낸 프레임이면 1 (연결은 유지, -1 반환)
+ * @return: 성공 시 0, 연결 종료/오류 시 -1
+ */
+int recv_message(int fd, ClientMsg *msg, int *dropped) {
+    *dropped = 0;
+    ShmChannel *shm = is_shm_connection(fd) ? &shm_conns[fd] : NULL;
+    GwSession *gw = is_gateway_session(fd) ? gw_sessions[fd] : NULL;
+    char *buf;
+    int len;
+    
+    if (shm || gw) {
+        // 공유 메모리 링과 게이트웨이 세션에는 완전한 프레임만 들어오므로 확인 후 바로 복사
+        len = shm ? shm_channel_next_len(shm) : gw_session_next_len(gw);
+        if (len == 0) {
+            *dropped = 1;  // 이미 읽은 프레임의 깨우기만 남은 경우
+            return -1;
+        }
+        if (len < 0) {
+            printf("[Server] %s이 닫혔습니다 (fd=%d)\n", shm ? "공유 메모리 채널" : "게이트웨이 세션", fd);
+            return -1;
+        }
+        if (len > BUF_SIZE) {
+            printf("[Server] 잘못된 메시지 길이: %d bytes (fd=%d)\n", len, fd);
+            return -1;
+        }
+        
+        // 반복 단위 아레나 - 반복이 끝나면 되돌림
+        static char fallback_buf[BUF_SIZE + 1];
+        buf = arena_alloc(&loop_arena, len + 1);
+        if (!buf) buf = fallback_buf;
+        if (shm) {
+            shm_channel_read(shm, buf, len);
+        } else {
+            gw_session_read(gw, buf, len);
+        }
+        buf[len] = '\0';
+    } else {
+        // 1~2단계: 길이 prefix와 본문을 받는 만큼 조립 (완성 전에는 기다리지 않고 돌아감)
+        Inbox *ib = connection_inbox(fd);
+        if (!ib) {
+            printf("[Server] 수신 버퍼를 할당할 수 없습니다 (fd=%d)\n", fd);
+            return -1;
+        }
+        len = inbox_read(ib, fd);
+        switch (len) {
+            case INBOX_PARTIAL:
+                *dropped = 1;  // 나머지는 다음 읽기 이벤트에서 이어서
+                return -1;
+            case INBOX_CLOSED:
+                printf("[Server] 클라이언트가 연결을 종료했습니다 (fd=%d)\n", fd);
+                return -1;
+            case INBOX_ERROR:
+                printf("[Server] 메시지 수신 실패 (fd=%d): %s\n", fd, strerror(errno));
+                return -1;
+            case INBOX_BAD_LEN:
+                // 길이 유효성 검사 (DoS 공격 방지)
+                printf("[Server] 잘못된 메시지 길이: %u bytes (fd=%d)\n", ib->len, fd);
+                return -1;
+        }
+        buf = ib->body;
+    }
+    
+    // 3단계: 속도 제한 (파싱 전에 토큰 확인)
+    switch (ratelimit_admit(&ratelimit, fd, clock_now_ms())) {
+        case RATE_PASS:
+            break;
+        case RATE_DROP:
+            // 연속 위반의 첫 프레임에만 안내 (이후 프레임은 조용히 버림)
+            if (ratelimit.buckets[fd].score == 1) send_canned_reply(fd, &reply_rate_limited);
+            *dropped = 1;
+            return -1;
+        case RATE_KICK:
+            printf("[RateLimit] 메시지 폭주로 연결 해제 (fd=%d, 버린 메시지 %u개)\n",
+                   fd, ratelimit_dropped(&ratelimit, fd));
+            return -1;
+    }
+    
+    // 4단계: 고정 필드 스캔 (힙 할당 없음)
+    if (scan_client_msg(buf, len, msg) != SCAN_OK) {
+        // 5단계: 예상 밖의 모양이면 json-c로 파싱 (토크나이저는 하나를 만들어 재사용)
+        static struct json_tokener *tok = NULL;
+        if (!tok) tok = json_tokener_new();
+        struct json_object *jobj = NULL;
+        if (tok) {
+            json_tokener_reset(tok);
+            jobj = json_tokener_parse_ex(tok, buf, len);
+        }
+        if (jobj == NULL) {
+            printf("[Server] JSON 파싱 실패 (fd=%d): %s\n", fd, buf);
+            return -1;
+        }
+        client_msg_from_json(jobj, msg);
+        json_object_put(jobj);
+    }
+    
+    // 6단계: 하트비트 응답은 연결 종류(대기실/게임/토너먼트)와 무관하게 여기서 RTT만 반영
+    //        (루프 시각이 아닌 읽은 순간의 시계 - 같은 반복에서 먼저 처리한 메시지 시간이 섞이지 않도록)
+    if ((msg->fields & CMSG_ACTION) && strcmp(msg->action, ACTION_HEARTBEAT) == 0) {
+        heartbeat_echo(&heartbeats, fd, msg->timestamp, clock_precise_us());
+        *dropped = 1;
+        return -1;
+    }
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────
+// 경기 저널 기록 (Journal Layer)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 방의 이벤트를 저널에 기록 (게임 로직의 이벤트 훅)
+ * 저널이 비활성화되어 있으면 아무 일도 하지 않음
+ * 
+ * @param g: 이벤트가 발생한 게임
+ * @param type: 이벤트 종류 (JournalEventType)
+ * @param player_id: 이벤트 주체 플레이어 ID
+ * @param number: 설정/추측 숫자 (없으면 NULL)
+ * @param result: 추측 결과 (JOURNAL_GUESS 외에는 NULL)
+ */
+void journal_event(GameManager *g, JournalEventType type, int player_id,
+                   const char *number, const GuessResult *result) {
+    if (journal.fd < 0) return;
+    
+    JournalRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.match_id = g->match_id;
+    rec.room_id = g->room_id;
+    rec.type = type;
+    rec.player_id = (uint8_t)player_id;
+    if (number) strncpy(rec.number, number, NUMBER_LENGTH);
+    if (result) {
+        rec.strikes = result->strikes;
+        rec.balls = result->balls;
+        rec.target = (uint8_t)result->target;
+        rec.remaining = (uint16_t)result->remaining;
+    }
+    if (player_id >= 0 && player_id < MAX_CLIENTS) {
+        rec.attempts = g->players[player_id].attempts;
+    }
+    rec.capacity = (uint8_t)g->capacity;
+    rec.timestamp_ms = loop_now_ms;  // 게임 로직이 본 시각과 동일 (리플레이 결정성)
+    
+    if (journal_append(&journal, &rec) < 0) {
+        printf("[Server] 저널 기록 실패 (event=%s)\n", journal_event_name(type));
+    }
+}
+
+/**
+ * 게임 로직의 이벤트 훅 - 저널 기록 + 게임 종료 시 리더보드 갱신
+ * 다인전은 승자가 좌석에 남아 있는 나머지 플레이어 각각을 이긴 것으로 기록
+ */
+void on_game_event(GameManager *g, JournalEventType type, int player_id,
+                   const char *number, const GuessResult *result) {
+    journal_event(g, type, player_id, number, result);
+    
+    if (type == JOURNAL_GAME_OVER && player_id >= 0 && player_id < g->capacity) {
+        const PlayerInfo *winner = &g->players[player_id];
+        for (int i = 0; i < g->capacity; i++) {
+            const PlayerInfo *loser = &g->players[i];
+            if (i == player_id || (!loser->connected && !loser->suspended)) continue;
+            leaderboard_record_result(&leaderboard, winner->name, winner->attempts,
+                                      loser->name, loser->attempts);
+        }
+        if (g->room_id != 0) tournament_room_finished(g, player_id);
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 게임 초기화 및 관리 함수들 (Game Management Layer)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 루프 시각 갱신 - 이벤트 루프 반복마다 한 번 호출
+ * 타임아웃/하트비트/속도 제한/통계 주기는 캐시된 단조 시각(clock_now_ms())을,
+ * 게임 로직(재접속 대기/새 게임 준비 마감)과 저널은 같은 순간의 게임 시각(loop_now_ms)을 사용
+ * (epoch 시각 그대로는 스냅샷 타임스탬프에만)
+ */
+void update_loop_clock(void) {
+    clock_update();
+    loop_now_ms = clock_game_ms();
+}
+
+/**
+ * 서버 시계 - 게임 로직의 시계 훅
+ * 같은 반복 안의 타이머 판정과 저널 타임스탬프가 같은 값을 보도록 루프 시각을 반환
+ */
+uint64_t server_now_ms(void) {
+    return loop_now_ms;
+}
+
+/**
+ * 게임 매니저 초기화
+ * 모든 플레이어 상태를 기본값으로 설정하고 게임 준비
+ */
+void init_game() {
+    // 게임 로직 훅 등록 (전송, 이벤트 기록, 시계)
+    GameHooks hooks = {
+        .send_to_player = send_to_player,
+        .publish = publish_to_room,
+        .on_event = on_game_event,
+        .now_ms = server_now_ms,
+        .verbose = 1,
+    };
+    game_set_hooks(&hooks);
+    spectator_init(&spectators);
+    
+    // 게임 전체 상태 및 모든 플레이어 정보 초기화
+    game_init(&game);
+    
+    // 연결별 하트비트 스케줄러 초기화 (연결은 입장할 때 추적 시작)
+    heartbeat_init(&heartbeats, HEARTBEAT_INTERVAL_SEC * 1000, clock_now_ms());
+    
+    printf("[Server] 숫자 야구 게임 서버 초기화 완료\n");
+    printf("[Server] 네트워크 타임아웃: %d초, 하트비트 간격: %d초\n", 
+           NETWORK_TIMEOUT_SEC, HEARTBEAT_INTERVAL_SEC);
+}
+
+// ──────────────────────────────────────────────────────────
+// 네트워크 지연 및 안정성 처리 함수들 (Network Reliability Layer)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 방의 모든 플레이어 타임아웃 상태 체크 (메인 방과 토너먼트 경기 방 공통)
+ * 30초 이상 아무것도 받지 못한 플레이어는 연결을 중단하고,
+ * 정리는 다음 수신(EOF)에서 일반 연결 해제와 같은 경로(game_player_leave - 게임 중이면 재접속 대기)로 처리
+ * (이벤트 루프 매 반복, 캐시된 단조 시각)
+ */
+void check_player_timeouts(GameManager *g) {
+    uint64_t now_ms = clock_now_ms();  // 반복의 캐시된 시각 - 플레이어마다 시계를 읽지 않음
+    
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        PlayerInfo *player = &g->players[i];
+        if (!player->connected) continue;
+        
+        // 타임아웃 체크 (30초 이상 수신 없음)
+        if (is_player_timeout(player, now_ms)) {
+            if (g->room_id != 0) {
+                printf("[Server] 방 %d 플레이어 %d 타임아웃 - 연결을 해제합니다\n", g->room_id, i);
+            } else {
+                printf("[Server] 플레이어 %d 타임아웃 - 연결을 해제합니다\n", i);
+            }
+            shutdown_connection(player->sockfd);
+            player->last_activity_ms = 0;  // EOF를 처리하기 전 반복에서 다시 판정하지 않도록
+        }
+    }
+}
+
+/**
+ * 한 주기(HEARTBEAT_INTERVAL_SEC) 내내 아무 프레임도 보내지 않은 연결에만 하트비트 전송
+ * 게임 메시지가 오간 연결은 그 메시지가 생존 신호이므로 건너뛰고,
+ * 연결마다 지터를 더한 마감을 타이밍 휠로 관리해 전송이 한 순간에 몰리지 않음
+ * 타임스탬프는 단조 시계 마이크로초 - 클라이언트가 돌려주면 recv_message()에서 RTT로 반영
+ * (이벤트 루프 매 반복, 마감이 된 연결만 확인)
+ */
+void send_idle_heartbeats(void) {
+    static int due[FD_SETSIZE];
+    int n = heartbeat_collect_due(&heartbeats, clock_now_ms(), due, FD_SETSIZE);
+    if (n == 0) return;
+    
+    // 이번 반복에 마감된 연결들은 같은 프레임을 공유 (한 번 인코딩, 아직 못 보낸 하트비트는 새 것과 합침)
+    uint64_t stamp_us = clock_precise_us();
+    char stamp[HEARTBEAT_STAMP_LEN];
+    snprintf(stamp, sizeof(stamp), "%llu", (unsigned long long)stamp_us);
+    SharedFrame *f = frame_heartbeat(&(HeartbeatMsg){ .timestamp = stamp });
+    if (!f) return;
+    for (int i = 0; i < n; i++) {
+        if (send_frame(due[i], f, OUTBOX_HEARTBEAT) == 0) {  // 실패한 연결은 다음 수신에서 정리
+            heartbeat_probe(&heartbeats, due[i], stamp_us);
+        }
+    }
+    frame_unref(f);
+}
+
+// ──────────────────────────────────────────────────────────
+// 메시징 함수들 (Messaging Layer)
+// 게임 로직(baseball_game.c)의 전송 훅으로 등록됨
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 특정 플레이어에게 개별 메시지 전송
+ * 턴 알림, 개인별 게임 결과 등 개별 통신용
+ * 
+ * @param g: 플레이어가 속한 게임
+ * @param player_id: 대상 플레이어 ID (0 또는 1)
+ * @param f: 전송할 공유 버퍼 (큐에 남으면 참조 추가)
+ */
+void send_to_player(GameManager *g, int player_id, SharedFrame *f) {
+    // 유효성 검사
+    if (player_id < 0 || player_id >= MAX_CLIENTS) {
+        printf("[Server] 잘못된 플레이어 ID: %d\n", player_id);
+        return;
+    }
+    
+    PlayerInfo *player = &g->players[player_id];
+    if (!player->connected) {
+        printf("[Server] 플레이어 %d는 연결되어 있지 않습니다\n", player_id);
+        return;
+    }
+    
+    // 메시지 전송 (못 보낸 부분은 송신 큐에서 재시도, 예산 초과 시 연결 해제는 메인 루프가 처리)
+    if (send_frame(player->sockfd, f, OUTBOX_ESSENTIAL) == 0) {
+        printf("[Server] 플레이어 %d에게 메시지 전송 완료\n", player_id);
+    } else {
+        printf("[Server] 플레이어 %d에게 메시지 전송 실패 - 연결을 정리합니다\n", player_id);
+    }
+}
+
+/**
+ * 방금 만든 메시지를 플레이어에게 전송하고 참조 해제 (게임 로직 밖의 응답용)
+ */
+void reply_to_player(GameManager *g, int player_id, SharedFrame *f) {
+    if (!f) return;
+    send_to_player(g, player_id, f);
+    frame_unref(f);
+}
+
+/**
+ * 방 전체에 메시지 전송 (게임 시작, 추측 결과, 관전자 알림 등)
+ * 수신자가 몇 명이든 인코딩은 한 번만 하고 같은 버퍼를 공유
+ * 
+ * @param g: 메시지를 보낼 방
+ * @param f: 전송할 공유 버퍼
+ * @param audience: AUDIENCE_PLAYERS / AUDIENCE_SPECTATORS 조합
+ */
+void publish_to_room(GameManager *g, SharedFrame *f, int audience) {
+    // 관전 채널은 일반 대전 방 하나만 중계 (토너먼트 경기 방은 결과 알림만 별도로 전송)
+    if (g != &game) audience &= ~AUDIENCE_SPECTATORS;
+    if (!f || (!(audience & AUDIENCE_PLAYERS) && spectators.count == 0)) return;
+
+    if (audience & AUDIENCE_PLAYERS) {
+        for (int i = 0; i < MAX_CLIENTS; i++) {
+            if (g->players[i].connected) send_to_player(g, i, f);
+        }
+    }
+    if (audience & AUDIENCE_SPECTATORS) {
+        // 턴 변경은 최신 값만 의미가 있으므로 밀린 관전자에게는 대기 중인 알림과 합침
+        int kind = f->msg_id == MSG_ID_turn ? OUTBOX_TURN_UPDATE : OUTBOX_ESSENTIAL;
+        spectator_publish(&spectators, f, kind);
+    }
+}
+
+/**
+ * 관전자 연결 수락 (대기열을 비우며, 현재 방 상태 스냅샷을 먼저 전송)
+ * 한 번에 들어온 관전자들은 같은 스냅샷 버퍼를 공유
+ */
+void handle_spectator_connection(int watch_fd) {
+    SharedFrame *snapshot = NULL;
+    int rejected = 0;
+
+    for (int n = 0; n < ACCEPT_BATCH_MAX; n++) {
+        int conn_fd = accept_connection(watch_fd, NULL);
+        if (conn_fd < 0) break;
+
+        int idx = spectator_add(&spectators, conn_fd);
+        if (idx < 0) {
+            close(conn_fd);
+            rejected++;
+            continue;
+        }
+
+        if (!snapshot) snapshot = game_spectate_snapshot(&game);
+        if (snapshot) spectator_send(&spectators, idx, snapshot);
+        printf("[Server] 관전자 입장 (fd=%d, 관전자 %d명)\n", conn_fd, spectators.count);
+    }
+
+    frame_unref(snapshot);
+    if (rejected > 0) printf("[Server] 관전자 수 초과 - 연결 %d개 거부\n", rejected);
+}
+
+// ──────────────────────────────────────────────────────────
+// 재접속 처리 (Session Resume Layer)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 재접속 토큰 생성 (16자리 16진수)
+ * 커널 난수를 사용하여 다른 플레이어가 추측할 수 없도록 함
+ */
+void generate_resume_token(char *out) {
+    unsigned char raw[RESUME_TOKEN_LEN / 2];
+    ssize_t n = -1;
+#ifdef __linux__
+    n = getrandom(raw, sizeof(raw), 0);
+#endif
+    if (n != (ssize_t)sizeof(raw)) {
+        int fd = open("/dev/urandom", O_RDONLY);
+        n = fd >= 0 ? read(fd, raw, sizeof(raw)) : -1;
+        if (fd >= 0) close(fd);
+        if (n != (ssize_t)sizeof(raw)) {
+            // 난수 장치를 쓸 수 없는 환경: 시각과 PID로 대체
+            uint64_t seed = loop_now_ms ^ ((uint64_t)getpid() << 32);
+            memcpy(raw, &seed, sizeof(raw));
+        }
+    }
+    for (size_t i = 0; i < sizeof(raw); i++) {
+        snprintf(out + i * 2, 3, "%02x", raw[i]);
+    }
+}
+
+/**
+ * 재접속 대기 목록에 연결 추가
+ * @return: 성공 시 0, 목록이 가득 차면 -1
+ */
+int add_pending_connection(int fd) {
+    for (int i = 0; i < MAX_PENDING_CONNECTIONS; i++) {
+        if (pending_fds[i] < 0) {
+            pending_fds[i] = fd;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * 재접속 대기 목록에서 fd 위치 찾기
+ * @return: 목록 인덱스, 없으면 -1
+ */
+int find_pending_connection(int fd) {
+    for (int i = 0; i < MAX_PENDING_CONNECTIONS; i++) {
+        if (pending_fds[i] == fd) return i;
+    }
+    return -1;
+}
+
+/**
+ * 대기 목록의 연결이 보낸 첫 메시지 처리
+ * resume + 유효한 토큰이면 유지 중인 좌석에 연결, 아니면 거부 후 종료
+ */
+void handle_pending_message(int idx, fd_set *master_set) {
+    int fd = pending_fds[idx];
+    
+    int dropped;
+    ClientMsg msg;
+    int received = recv_message(fd, &msg, &dropped) == 0;
+    if (dropped) return;  // 대기 목록에 남겨 두고 다음 메시지를 기다림
+    pending_fds[idx] = -1;
+    int player_id = -1;
+    if (received && (msg.fields & CMSG_TOKEN) && strcmp(msg.action, ACTION_RESUME) == 0) {
+        player_id = game_find_resume_seat(&game, msg.token);
+    }
     
-    // 1단계: 메시지 길이 전송 (2바이트)
-    if (send(fd, &netlen, sizeof(netlen), 0) != sizeof(netlen)) {
-        printf("[Server] 메시지 길이 전송 실패 (fd=%d): %s\n", fd, strerror(errno));
+    if (player_id < 0) {
+        if (received) send_canned_reply(fd, &reply_busy);
+        printf("[Server] 재접속 요청 거부 (fd=%d)\n", fd);
+        FD_CLR(fd, master_set);
+        close_connection(fd);
+        return;
+    }
+    
+    game.players[player_id].sockfd = fd;
+    game.players[player_id].caps = 0;  // 새 연결은 hello로 다시 협상
+    update_player_activity(&game.players[player_id], clock_now_ms());
+    printf("[Server] 플레이어 %d 재접속 (fd=%d)\n", player_id, fd);
+    game_player_resume(&game, player_id);
+}
+
+/**
+ * 재접속 대기 좌석이 모두 정리되면 대기 목록의 연결을 일반 입장 처리
+ * (대기 시간 만료로 빈 좌석이 생긴 경우)
+ */
+void admit_pending_connections(fd_set *master_set) {
+    if (game_has_suspended(&game)) return;
+    
+    for (int i = 0; i < MAX_PENDING_CONNECTIONS; i++) {
+        int fd = pending_fds[i];
+        if (fd < 0) continue;
+        pending_fds[i] = -1;
+        
+        int player_id = -1;
+        for (int p = 0; p < MAX_CLIENTS; p++) {
+            if (!game.players[p].connected) {
+                player_id = p;
+                break;
+            }
+        }
+        if (player_id < 0) {
+            send_canned_reply(fd, &reply_full);
+            FD_CLR(fd, master_set);
+            close_connection(fd);
+            continue;
+        }
+        
+        game.players[player_id].sockfd = fd;
+        game.players[player_id].caps = 0;
+        update_player_activity(&game.players[player_id], clock_now_ms());
+        generate_resume_token(game.players[player_id].resume_token);
+        printf("[Server] 대기 중이던 연결을 플레이어 %d로 입장 처리 (fd=%d)\n", player_id, fd);
+        game_player_join(&game, player_id);
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 새로운 연결 처리
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 소켓의 블로킹 모드 설정
+ * 연결은 수락할 때부터 끝까지 non-blocking (수신은 연결별 수신 버퍼, 송신은 송신 큐)
+ */
+void set_nonblocking(int fd, int on) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) return;
+    fcntl(fd, F_SETFL, on ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+}
+
+/**
+ * 대기열의 연결 하나 수락 (non-blocking, close-on-exec)
+ * fd 한도(EMFILE/ENFILE)에 걸리면 예비 fd를 잠시 풀어 연결을 받아서 바로 닫음
+ * (그대로 두면 대기열이 비지 않아 select()가 계속 깨어남)
+ * 
+ * @param addr: 상대 주소 (NULL이면 받지 않음)
+ * @return: 새 소켓, 대기열이 비었거나 실패하면 -1
+ */
+int accept_connection(int listen_fd, struct sockaddr_storage *addr) {
+    socklen_t len = sizeof(*addr);
+    while (1) {
+        int fd = accept4(listen_fd, (struct sockaddr *)addr, addr ? &len : NULL,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0) {
+            if (fd < FD_SETSIZE) return fd;
+            // select()로 감시할 수 없는 fd - 바로 거부
+            send_canned_reply(fd, &reply_full);
+            close(fd);
+            continue;
+        }
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if ((errno == EMFILE || errno == ENFILE) && reserve_fd >= 0) {
+            printf("[Server] 파일 디스크립터 한도 도달 - 대기열의 연결을 거부합니다\n");
+            close(reserve_fd);
+            fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) close(fd);
+            reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept4");
+        return -1;
+    }
+}
+
+/**
+ * 공유 메모리 접속 소켓의 대기열 비우기 - 접속 소켓만 받아 select()에 등록하고 fd 전달은 기다리지 않음
+ * 마감(SHM_ATTACH_TIMEOUT_MS)까지 fd가 오지 않은 접속은 shm_service()에서 정리
+ */
+void shm_accept_handshakes(int listen_fd, fd_set *master_set, int *max_fd) {
+    for (int n = 0; n < ACCEPT_BATCH_MAX; n++) {
+        int ctl_fd = shm_channel_accept(listen_fd);
+        if (ctl_fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept4(shm)");
+            return;
+        }
+        if (ctl_fd >= FD_SETSIZE) {
+            // select()로 감시할 수 없는 fd - 바로 거부
+            close(ctl_fd);
+            continue;
+        }
+        shm_attach_deadline[ctl_fd] = clock_now_ms() + SHM_ATTACH_TIMEOUT_MS;
+        track_fd(ctl_fd, master_set, max_fd);
+    }
+}
+
+/**
+ * 핸드셰이크 중인 접속 소켓인지
+ */
+int is_shm_handshake(int fd) {
+    return fd >= 0 && fd < FD_SETSIZE && shm_attach_deadline[fd] != 0;
+}
+
+/**
+ * 읽기 가능해진 접속 소켓에서 fd를 받아 채널 매핑
+ * 연결은 채널의 수신 eventfd로 식별 (select 감시, 송신 큐, 좌석의 sockfd 모두 이 fd)
+ * 
+ * @return: 입장 처리할 채널이 준비되면 1 (accept_client(shm_listen_fd)로 꺼냄), 아직이거나 실패하면 0
+ */
+int shm_finish_handshake(int ctl_fd, fd_set *master_set) {
+    ShmChannel ch;
+    if (shm_channel_attach(&ch, ctl_fd) < 0) {
+        if (errno == EAGAIN) return 0;
+        printf("[Server] 공유 메모리 접속 요청이 올바르지 않습니다 - 거부\n");
+        shm_attach_deadline[ctl_fd] = 0;
+        FD_CLR(ctl_fd, master_set);  // 소켓은 shm_channel_attach()가 닫음
+        return 0;
+    }
+    // 접속 소켓은 이제 채널의 상대 프로세스 종료 감지용 (select 감시 대상은 수신 eventfd)
+    shm_attach_deadline[ctl_fd] = 0;
+    FD_CLR(ctl_fd, master_set);
+    if (ch.rx_efd >= FD_SETSIZE) {
+        shm_channel_close(&ch);
+        return 0;
+    }
+    shm_conns[ch.rx_efd] = ch;
+    shm_ready_fd = ch.rx_efd;
+    return 1;
+}
+
+/**
+ * 핸드셰이크를 마친 공유 메모리 연결 꺼내기 (접속 소켓을 리스닝 소켓처럼 취급)
+ * @return: 수신 eventfd, 준비된 연결이 없으면 -1
+ */
+int accept_shm_connection(void) {
+    int fd = shm_ready_fd;
+    shm_ready_fd = -1;
+    return fd;
+}
+
+/**
+ * 게이트웨이 링크에서 새로 열린 세션 하나 꺼내기 (링크 소켓을 세션의 리스닝 소켓처럼 취급)
+ * @return: 세션 eventfd, 대기 중인 세션이 없으면 -1
+ */
+int accept_gateway_session(void) {
+    while (gw_accept_count > 0) {
+        int fd = gw_accept_queue[gw_accept_head];
+        gw_accept_head = (gw_accept_head + 1) % FD_SETSIZE;
+        gw_accept_count--;
+        if (is_gateway_session(fd)) return fd;  // 입장 전에 링크가 끊겨 정리된 세션은 건너뜀
+    }
+    return -1;
+}
+
+int accept_client(int listen_fd, struct sockaddr_storage *addr) {
+    if (gateway_link_index(listen_fd) >= 0) {
+        if (addr) addr->ss_family = AF_UNSPEC;
+        return accept_gateway_session();
+    }
+    if (listen_fd != shm_listen_fd) return accept_connection(listen_fd, addr);
+    if (addr) addr->ss_family = AF_UNSPEC;
+    return accept_shm_connection();
+}
+
+/**
+ * 접속 주소를 로그용 문자열로 (같은 호스트의 로컬 전송과 게이트웨이 세션은 종류만 표시)
+ */
+const char *peer_label(int fd, const struct sockaddr_storage *addr) {
+    if (is_gateway_session(fd)) return "게이트웨이";
+    if (addr->ss_family == AF_INET) return inet_ntoa(((const struct sockaddr_in *)addr)->sin_addr);
+    if (addr->ss_family == AF_UNIX) return "로컬(unix)";
+    return "로컬(공유 메모리)";
+}
+
+/**
+ * 리스닝 소켓의 대기열을 비우며 새 플레이어 입장 처리 (TCP, AF_UNIX, 공유 메모리 접속 소켓, 게이트웨이 링크 공통)
+ * 거부할 연결에는 미리 직렬화한 응답을 non-blocking으로 보내고 바로 닫으며,
+ * 거부 로그는 연결마다 찍지 않고 한 번에 모아서 출력
+ */
+void handle_new_connection(int listen_fd) {
+    int rejected_busy = 0, rejected_full = 0;
+    
+    for (int n = 0; n < ACCEPT_BATCH_MAX; n++) {
+        struct sockaddr_storage cli_addr;
+        int conn_fd = accept_client(listen_fd, &cli_addr);
+        if (conn_fd < 0) break;
+        ratelimit_reset(&ratelimit, conn_fd);
+        heartbeat_track(&heartbeats, conn_fd, clock_now_ms());
+        connection_release(conn_fd);
+        
+        // 빈 슬롯 찾기 (재접속 대기 중인 좌석은 제외, 다인전 도중 비워진 좌석은 다음 게임까지 비워 둠)
+        int player_id = -1;
+        int in_game = (game.state == GAME_PLAYING || game.state == GAME_SETTING);
+        for (int i = 0; i < game.capacity && !in_game; i++) {
+            if (!game.players[i].connected && !game.players[i].suspended) {
+                player_id = i;
+                break;
+            }
+        }
+        
+        // 빈 좌석은 없지만 재접속 대기 좌석이 있으면 resume 요청을 기다림
+        if (player_id < 0 && game_has_suspended(&game) && add_pending_connection(conn_fd) == 0) {
+            printf("[Server] 재접속 대기 목록에 연결 추가 (fd=%d, IP: %s)\n",
+                   conn_fd, peer_label(conn_fd, &cli_addr));
+            continue;
+        }
+        
+        if (player_id < 0) {
+            // 현재 게임이 진행 중이라면 정중하게 알림 (소켓 버퍼에 바로 들어가지 않으면 생략)
+            if (in_game) {
+                send_canned_reply(conn_fd, &reply_busy);
+                rejected_busy++;
+            } else {
+                send_canned_reply(conn_fd, &reply_full);
+                rejected_full++;
+            }
+            close_connection(conn_fd);
+            continue;
+        }
+        
+        // 플레이어 등록 (ID 할당, 정원이 모이면 게임 시작)
+        game.players[player_id].sockfd = conn_fd;
+        game.players[player_id].caps = 0;
+        update_player_activity(&game.players[player_id], clock_now_ms());
+        generate_resume_token(game.players[player_id].resume_token);
+        printf("[Server] 플레이어 %d 연결됨 (IP: %s)\n", 
+               player_id, peer_label(conn_fd, &cli_addr));
+        game_player_join(&game, player_id);
+    }
+    
+    if (rejected_busy > 0) {
+        printf("[Server] 게임 진행 중 - 새 연결 %d개 거부\n", rejected_busy);
+    }
+    if (rejected_full > 0) {
+        printf("[Server] 서버 용량 초과 - 새 연결 %d개 거부\n", rejected_full);
+    }
+}
+
+// ──────────────────────────────────────────────────────────
+// 게임 외 요청 처리 (이름 등록, 리더보드 조회)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 리더보드 행을 JSON 객체로 변환
+ */
+struct json_object *leaderboard_row_json(const LeaderboardRow *row) {
+    struct json_object *jrow = json_object_new_object();
+    json_object_object_add(jrow, "rank", json_object_new_int(row->rank));
+    json_object_object_add(jrow, "name", json_object_new_string(row->name));
+    json_object_object_add(jrow, "wins", json_object_new_int(row->wins));
+    json_object_object_add(jrow, "losses", json_object_new_int(row->losses));
+    json_object_object_add(jrow, "avg_attempts", json_object_new_double(row->avg_attempts));
+    return jrow;
+}
+
+/**
+ * 리더보드 조회 응답 생성
+ * 요청 필드: top (상위 N명, 기본 10), name (개인 순위, 생략 시 요청자 이름)
+ * 
+ * @param my_name: 요청자 이름 (name 필드가 없을 때 사용)
+ * @return: leaderboard_result 메시지 (호출자가 해제)
+ */
+struct json_object *build_leaderboard_result(const char *my_name, const ClientMsg *msg) {
+    int top_n = 10;
+    if (msg->fields & CMSG_TOP) top_n = msg->top;
+    if (top_n < 0) top_n = 0;
+    if (top_n > LEADERBOARD_QUERY_MAX) top_n = LEADERBOARD_QUERY_MAX;
+    
+    const char *name = my_name;
+    if (msg->fields & CMSG_NAME) name = msg->name;
+    
+    struct json_object *jres = create_message(ACTION_LEADERBOARD_RESULT);
+    LeaderboardRow rows[LEADERBOARD_QUERY_MAX];
+    int count = leaderboard_top(&leaderboard, top_n, rows);
+    struct json_object *jarr = json_object_new_array();
+    for (int i = 0; i < count; i++) {
+        json_object_array_add(jarr, leaderboard_row_json(&rows[i]));
+    }
+    json_object_object_add(jres, "top", jarr);
+    
+    LeaderboardRow me;
+    if (name && leaderboard_lookup(&leaderboard, name, &me) == 0) {
+        json_object_object_add(jres, "player", leaderboard_row_json(&me));
+    }
+    return jres;
+}
+
+/**
+ * 게임 로직 밖의 요청 처리
+ * @return: 처리했으면 1, 게임 로직으로 넘길 메시지면 0
+ */
+int handle_lobby_message(GameManager *g, int player_id, const ClientMsg *msg) {
+    if (!(msg->fields & CMSG_ACTION)) return 0;
+    const char *action = msg->action;
+    
+    if (strcmp(action, ACTION_SET_NAME) == 0) {
+        if (g->room_id != 0) {
+            // 토너먼트 경기 방: 이름은 명단으로 고정
+            reply_to_player(g, player_id, frame_error(&(ErrorMsg){ .message = "토너먼트 중에는 이름을 바꿀 수 없습니다." }));
+            return 1;
+        }
+        const char *name = (msg->fields & CMSG_NAME) ? msg->name : NULL;
+        if (!name || !leaderboard_valid_name(name)) {
+            reply_to_player(g, player_id, frame_error(&(ErrorMsg){ .message = "이름은 1~16바이트로 입력해주세요." }));
+            return 1;
+        }
+        snprintf(g->players[player_id].name, sizeof(g->players[player_id].name), "%.*s", PLAYER_NAME_LEN, name);
+        printf("[Server] 플레이어 %d 이름 등록: %s\n", player_id, name);
+        return 1;
+    }
+    
+    if (strcmp(action, ACTION_HELLO) == 0) {
+        // 프로토콜 기능 협상: 서버가 지원하는 것만 받아들이고 결과를 알려 줌
+        g->players[player_id].caps = msg->caps & SERVER_CAPS;
+        reply_to_player(g, player_id, frame_hello(&(HelloMsg){ .caps = g->players[player_id].caps }));
+        return 1;
+    }
+    
+    if (strcmp(action, ACTION_LEADERBOARD) == 0) {
+        struct json_object *jres = build_leaderboard_result(g->players[player_id].name, msg);
+        reply_to_player(g, player_id, frame_from_json(jres));
+        json_object_put(jres);
+        return 1;
+    }
+    
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────
+// 클라이언트 메시지 처리
+// ──────────────────────────────────────────────────────────
+void handle_client_message(GameManager *g, int player_id, fd_set *master_set) {
+    uint64_t allocs_before = alloc_heap_count();
+    int dropped;
+    ClientMsg msg;
+    int rc = recv_message(g->players[player_id].sockfd, &msg, &dropped);
+    if (rc == 0 || dropped) update_player_activity(&g->players[player_id], clock_now_ms());  // 하트비트 응답 포함
+    if (dropped) return;  // 속도 제한으로 버린 메시지
+    
+    if (rc < 0) {
+        // 연결 종료
+        printf("[Server] 플레이어 %d 연결 해제\n", player_id);
+        close_connection(g->players[player_id].sockfd);
+        FD_CLR(g->players[player_id].sockfd, master_set);
+        g->players[player_id].sockfd = -1;
+        game_player_leave(g, player_id);
+        return;
+    }
+    
+    if (!handle_lobby_message(g, player_id, &msg)) {
+        game_handle_message(g, player_id, &msg);
+    }
+    alloc_note_message(allocs_before);  // 메시지 처리(턴 진행 포함) 중 힙 할당 집계
+}
+
+// ──────────────────────────────────────────────────────────
+// 토너먼트 모드 (Tournament Layer)
+// -T 명단으로 대진표를 만들고, 경기마다 별도의 방(GameManager)을 열어 동시에 진행
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 토너먼트 모드의 fd별 연결 정보 (fd로 바로 찾기 위해 FD_SETSIZE 크기 배열)
+ */
+typedef enum {
+    TCONN_NONE = 0,     // 토너먼트 연결 아님
+    TCONN_LOBBY,        // 접속 직후 - 이름(체크인) 또는 resume 대기
+    TCONN_ENTRANT,      // 체크인 완료, 다음 경기 배정 대기
+    TCONN_ROOM,         // 경기 방에 입장
+    TCONN_FINISHED      // 탈락 또는 우승 - 더 치를 경기 없음 (리더보드 조회만)
+} TourConnKind;
+
+typedef struct {
+    uint8_t kind;       // TourConnKind
+    int16_t entrant;    // 참가자 번호
+    int16_t room;       // 경기 방 인덱스 (TCONN_ROOM)
+    int8_t seat;        // 방 안의 좌석 (TCONN_ROOM)
+    uint8_t caps;       // 로비에서 협상한 프로토콜 기능 (경기 방 좌석으로 옮김)
+} TourConn;
+
+#define TOURNAMENT_MAX_ROOMS (TOURNAMENT_MAX_ENTRANTS / 2)  // 동시에 진행될 수 있는 최대 경기 수
+
+Tournament tournament;
+int tournament_mode = 0;
+TourConn tour_conns[FD_SETSIZE];
+GameManager *tour_rooms[TOURNAMENT_MAX_ROOMS];          // 진행 중인 경기 방 (room_pool에서 할당)
+int tour_room_match[TOURNAMENT_MAX_ROOMS];             // 방 → 경기 노드 (-1: 빈 방)
+int tour_room_entrants[TOURNAMENT_MAX_ROOMS][DEFAULT_ROOM_PLAYERS]; // 경기 방은 1:1 (기본 정원)
+int tour_room_winner[TOURNAMENT_MAX_ROOMS];            // 끝난 경기의 승자 좌석 (-1: 진행 중)
+int tour_free_rooms[TOURNAMENT_MAX_ROOMS];             // 빈 방 스택
+int tour_free_count = 0;
+int tour_finished[TOURNAMENT_MAX_ROOMS];               // 이번 반복에 끝난 방 (정산 대기)
+int tour_finished_count = 0;
+int tour_entrant_fd[TOURNAMENT_MAX_ENTRANTS];          // 참가자 → 소켓 (-1: 미접속)
+uint8_t tour_match_waiting[2 * TOURNAMENT_MAX_ENTRANTS]; // 대진은 정해졌지만 참가자 미접속으로 대기 중인 경기
+uint64_t tour_match_deadline[2 * TOURNAMENT_MAX_ENTRANTS]; // 대기 중인 경기의 부전승 판정 시각 (단조 시계, 0: 아무도 미접속)
+
+/**
+ * 토너먼트 상태 초기화 (명단 로드 후 호출)
+ */
+void tournament_setup(void) {
+    tournament_mode = 1;
+    memset(tour_conns, 0, sizeof(tour_conns));
+    memset(tour_match_waiting, 0, sizeof(tour_match_waiting));
+    memset(tour_match_deadline, 0, sizeof(tour_match_deadline));
+    for (int i = 0; i < TOURNAMENT_MAX_ENTRANTS; i++) tour_entrant_fd[i] = -1;
+    tour_free_count = 0;
+    for (int r = TOURNAMENT_MAX_ROOMS - 1; r >= 0; r--) {
+        tour_room_match[r] = -1;
+        tour_free_rooms[tour_free_count++] = r;
+    }
+    
+    // 동시에 열릴 수 있는 방은 참가자 수의 절반 - 그만큼만 미리 할당
+    if (pool_init(&room_pool, "경기 방", sizeof(GameManager), tournament.entrant_count / 2) < 0) {
+        printf("[Tournament] 경기 방을 준비할 수 없습니다\n");
+    }
+    // 1라운드(와 부전승으로 정해진) 경기는 참가자가 체크인하는 대로 시작
+    tournament_schedule();
+}
+
+/**
+ * 토너먼트 진행 상황 메시지
+ * @param status: lobby / checked_in / advance / eliminated / champion / result
+ */
+SharedFrame *tournament_message(const char *status, int round, const char *message) {
+    return frame_tournament(&(TournamentMsg){
+        .status = status,
+        .round = round,
+        .rounds = tournament.rounds,
+        .message = message,
+    });
+}
+
+/**
+ * 참가자에게 토너먼트 상태 전송
+ */
+void tournament_notify(int entrant, const char *status, int round, const char *message) {
+    int fd = tour_entrant_fd[entrant];
+    if (fd < 0) return;
+    send_message(fd, tournament_message(status, round, message));
+}
+
+/**
+ * 경기 시작 - 빈 방을 배정하고 두 참가자를 입장시킴
+ * 한쪽이라도 접속해 있지 않으면 대기 표시만 하고, 체크인 시 다시 시도
+ * 한쪽이 먼저 와 있으면 그때부터 TOURNAMENT_NO_SHOW_SEC 뒤에 부전승 판정 (tournament_tick)
+ */
+void tournament_start_match(int match) {
+    int entrants[DEFAULT_ROOM_PLAYERS];
+    tournament_match_entrants(&tournament, match, &entrants[0], &entrants[1]);
+    if (tour_entrant_fd[entrants[0]] < 0 || tour_entrant_fd[entrants[1]] < 0) {
+        tour_match_waiting[match] = 1;
+        if (tour_match_deadline[match] == 0 && (tour_entrant_fd[entrants[0]] >= 0 || tour_entrant_fd[entrants[1]] >= 0)) {
+            tour_match_deadline[match] = clock_now_ms() + TOURNAMENT_NO_SHOW_SEC * 1000ULL;
+        }
+        return;
+    }
+    tour_match_waiting[match] = 0;
+    tour_match_deadline[match] = 0;
+    
+    GameManager *room = pool_alloc(&room_pool);
+    if (!room) {
+        printf("[Tournament] 경기 방 할당 실패 - 다음 체크인 때 다시 시도\n");
+        tour_match_waiting[match] = 1;
+        return;
+    }
+    int r = tour_free_rooms[--tour_free_count];
+    tour_rooms[r] = room;
+    game_init(room);
+    room->room_id = (uint16_t)(r + 1);
+    room->match_id = game.match_id;  // 경기 번호는 모든 방이 하나의 순번을 공유
+    tour_room_match[r] = match;
+    tour_room_winner[r] = -1;
+    journal_event(room, JOURNAL_ROOM_OPEN, 0, NULL, NULL);
+    
+    int round = tournament_match_round(&tournament, match);
+    printf("[Tournament] %d라운드 경기 시작: %s vs %s (방 %d)\n", round,
+           tournament.names[entrants[0]], tournament.names[entrants[1]], room->room_id);
+    
+    for (int seat = 0; seat < room->capacity; seat++) {
+        int e = entrants[seat];
+        int fd = tour_entrant_fd[e];
+        tour_room_entrants[r][seat] = e;
+        tour_conns[fd] = (TourConn){ TCONN_ROOM, (int16_t)e, (int16_t)r, (int8_t)seat, tour_conns[fd].caps };
+        room->players[seat].sockfd = fd;
+        room->players[seat].caps = tour_conns[fd].caps;
+        update_player_activity(&room->players[seat], clock_now_ms());
+        snprintf(room->players[seat].name, sizeof(room->players[seat].name), "%s", tournament.names[e]);
+        generate_resume_token(room->players[seat].resume_token);
+        game_player_join(room, seat);  // 두 번째 입장에서 게임 시작
+    }
+    game.match_id = room->match_id;
+}
+
+/**
+ * 시작 가능해진 경기를 모두 시작 (라운드 경계 없이 대진이 정해지는 즉시)
+ */
+void tournament_schedule(void) {
+    int match;
+    while ((match = tournament_next_ready(&tournament)) >= 0) {
+        tournament_start_match(match);
+    }
+}
+
+/**
+ * 게임 종료 이벤트 (on_game_event에서 호출)
+ * 종료 메시지가 아직 전송되기 전이므로 방 정리는 이번 반복이 끝날 때 수행
+ */
+void tournament_room_finished(GameManager *g, int winner_seat) {
+    int r = g->room_id - 1;
+    if (r < 0 || r >= TOURNAMENT_MAX_ROOMS || tour_room_match[r] < 0) return;
+    if (tour_room_winner[r] >= 0) return;
+    tour_room_winner[r] = winner_seat;
+    tour_finished[tour_finished_count++] = r;
+}
+
+/**
+ * 경기 결과 반영과 알림 (방에서 끝난 경기와 상대 미접속 부전승이 공유)
+ * 탈락자와 우승자의 연결은 더 치를 경기가 없으므로 TCONN_FINISHED로
+ * @param no_show: 상대가 체크인하지 않아 부전승이면 1
+ */
+void tournament_record(int match, int winner, int loser, int no_show) {
+    int round = tournament_match_round(&tournament, match);
+    tournament_record_result(&tournament, match, winner);
+    
+    char msg[128];
+    if (no_show) {
+        printf("[Tournament] %d라운드 결과: %s 부전승 (%s 미접속)\n", round,
+               tournament.names[winner], tournament.names[loser]);
+        snprintf(msg, sizeof(msg), "%d라운드: %s 부전승 (%s 미접속)", round,
+                 tournament.names[winner], tournament.names[loser]);
+    } else {
+        printf("[Tournament] %d라운드 결과: %s 승리 (vs %s)\n", round,
+               tournament.names[winner], tournament.names[loser]);
+        snprintf(msg, sizeof(msg), "%d라운드: %s 승리 (vs %s)", round,
+                 tournament.names[winner], tournament.names[loser]);
+    }
+    SharedFrame *result = tournament_message("result", round, msg);
+    publish_to_room(&game, result, AUDIENCE_SPECTATORS);
+    frame_unref(result);
+    
+    if (tournament_champion(&tournament) == winner) {
+        snprintf(msg, sizeof(msg), "🏆 %s 님이 토너먼트에서 우승했습니다!", tournament.names[winner]);
+        tournament_notify(winner, "champion", round, msg);
+        printf("[Tournament] 우승: %s\n", tournament.names[winner]);
+        if (tour_entrant_fd[winner] >= 0) tour_conns[tour_entrant_fd[winner]].kind = TCONN_FINISHED;
+    } else {
+        snprintf(msg, sizeof(msg), no_show ? "%d라운드 부전승! 다음 상대를 기다리는 중..."
+                                           : "%d라운드 통과! 다음 상대를 기다리는 중...", round);
+        tournament_notify(winner, "advance", round + 1, msg);
+    }
+    tournament_notify(loser, "eliminated", round, "토너먼트에서 탈락했습니다. 수고하셨습니다!");
+    if (tour_entrant_fd[loser] >= 0) tour_conns[tour_entrant_fd[loser]].kind = TCONN_FINISHED;
+}
+
+/**
+ * 끝난 방 정산: 대진표에 결과 반영 (O(1)), 참가자를 대기 상태로 되돌리고 방 반환
+ */
+void tournament_settle(void) {
+    for (int i = 0; i < tour_finished_count; i++) {
+        int r = tour_finished[i];
+        GameManager *room = tour_rooms[r];
+        int match = tour_room_match[r];
+        int winner = tour_room_entrants[r][tour_room_winner[r]];
+        int loser = tour_room_entrants[r][1 - tour_room_winner[r]];
+        
+        // 방에 남아 있는 연결은 대기 상태로 (결과 반영에서 탈락자는 다시 TCONN_FINISHED로)
+        for (int seat = 0; seat < room->capacity; seat++) {
+            int fd = room->players[seat].connected ? room->players[seat].sockfd : -1;
+            int e = tour_room_entrants[r][seat];
+            if (fd >= 0) {
+                tour_conns[fd] = (TourConn){ TCONN_ENTRANT, (int16_t)e, -1, -1, (uint8_t)room->players[seat].caps };
+            } else {
+                tour_entrant_fd[e] = -1;
+            }
+        }
+        room->state = GAME_WAITING;
+        room->players_ready = 0;
+        tour_room_match[r] = -1;
+        tour_free_rooms[tour_free_count++] = r;
+        pool_free(&room_pool, room);
+        tour_rooms[r] = NULL;
+        
+        tournament_record(match, winner, loser, 0);
+    }
+    tour_finished_count = 0;
+    tournament_schedule();
+}
+
+/**
+ * 대기 중인 경기의 상대 미접속 판정 (부전승 시각이 지난 경기만)
+ * 한쪽만 와 있으면 그 참가자의 부전승, 둘 다 없으면 다음 체크인까지 판정 보류,
+ * 둘 다 와 있으면 (방 할당 실패로 밀린 경기) 다시 시작 시도
+ */
+void tournament_check_no_shows(void) {
+    uint64_t now = clock_now_ms();
+    int decided = 0;
+    for (int match = 1; match < tournament.size; match++) {
+        if (!tour_match_waiting[match] || tour_match_deadline[match] == 0 || now < tour_match_deadline[match]) continue;
+        int a, b;
+        tournament_match_entrants(&tournament, match, &a, &b);
+        int here_a = tour_entrant_fd[a] >= 0, here_b = tour_entrant_fd[b] >= 0;
+        tour_match_deadline[match] = 0;
+        if (here_a && here_b) {
+            tournament_start_match(match);
+        } else if (here_a || here_b) {
+            tour_match_waiting[match] = 0;
+            tournament_record(match, here_a ? a : b, here_a ? b : a, 1);
+            decided = 1;
+        }
+    }
+    if (decided) tournament_schedule();
+}
+
+/**
+ * 진행 중인 모든 경기 방의 시간 경과 처리
+ * 양쪽 모두 재접속하지 않아 승자 없이 비워진 방은 먼저 배정된 참가자의 부전승으로 처리
+ * 상대가 끝내 체크인하지 않은 경기는 와 있는 참가자의 부전승으로 처리
+ */
+void tournament_tick(void) {
+    for (int r = 0; r < TOURNAMENT_MAX_ROOMS; r++) {
+        if (tour_room_match[r] < 0 || tour_room_winner[r] >= 0) continue;
+        GameManager *room = tour_rooms[r];
+        game_tick(room);
+        check_player_timeouts(room);
+        if (room->state == GAME_WAITING && room->players_ready == 0 && tour_room_winner[r] < 0) {
+            printf("[Tournament] 방 %d 양쪽 모두 이탈 - 부전승 처리\n", room->room_id);
+            tournament_room_finished(room, 0);
+        }
+    }
+    if (tour_finished_count > 0) tournament_settle();
+    tournament_check_no_shows();
+}
+
+/**
+ * 토너먼트 모드의 새 연결 (대기열을 비우며 이름 체크인을 기다리는 로비에 추가)
+ * 로비 안내는 한 번만 직렬화해 이번에 들어온 연결들이 공유
+ */
+void tournament_accept(int listen_fd, fd_set *master_set, int *max_fd) {
+    SharedFrame *lobby = NULL;
+    
+    for (int n = 0; n < ACCEPT_BATCH_MAX; n++) {
+        int conn_fd = accept_client(listen_fd, NULL);
+        if (conn_fd < 0) break;
+        ratelimit_reset(&ratelimit, conn_fd);
+        heartbeat_track(&heartbeats, conn_fd, clock_now_ms());
+        connection_release(conn_fd);
+        tour_conns[conn_fd] = (TourConn){ TCONN_LOBBY, -1, -1, -1, 0 };
+        
+        if (!lobby) {
+            lobby = tournament_message("lobby", 0,
+                "토너먼트 진행 중입니다. 명단에 등록된 이름으로 체크인하세요.");
+        }
+        if (lobby) send_frame(conn_fd, lobby, OUTBOX_ESSENTIAL);
+        track_fd(conn_fd, master_set, max_fd);
+    }
+    frame_unref(lobby);
+}
+
+/**
+ * 로비/대기 중인 연결의 메시지 처리 (체크인, 재접속, 리더보드 조회)
+ */
+void tournament_lobby_message(int fd, const ClientMsg *msg) {
+    TourConn *c = &tour_conns[fd];
+    const char *action = msg->action;  // 필드가 없으면 빈 문자열
+    const char *error = NULL;
+    
+    if (strcmp(action, ACTION_SET_NAME) == 0 && c->kind == TCONN_LOBBY) {
+        const char *name = msg->name;
+        int e = tournament_find_entrant(&tournament, name);
+        int next = tournament_entrant_next_match(&tournament, e);
+        if (e < 0) {
+            error = "토너먼트 명단에 없는 이름입니다.";
+        } else if (tour_entrant_fd[e] >= 0) {
+            error = "이미 접속 중인 참가자입니다.";
+        } else if (next < 0) {
+            error = "이미 탈락했거나 토너먼트가 끝났습니다.";
+        } else {
+            tour_entrant_fd[e] = fd;
+            *c = (TourConn){ TCONN_ENTRANT, (int16_t)e, -1, -1, c->caps };
+            printf("[Tournament] 체크인: %s\n", name);
+            tournament_notify(e, "checked_in", tournament_match_round(&tournament, next),
+                              "체크인 완료! 경기 배정을 기다리는 중...");
+            if (tour_match_waiting[next]) tournament_start_match(next);
+            return;
+        }
+    } else if (strcmp(action, ACTION_RESUME) == 0 && c->kind == TCONN_LOBBY) {
+        const char *token = msg->token;
+        for (int r = 0; r < TOURNAMENT_MAX_ROOMS; r++) {
+            if (tour_room_match[r] < 0) continue;
+            int seat = game_find_resume_seat(tour_rooms[r], token);
+            if (seat < 0) continue;
+            int e = tour_room_entrants[r][seat];
+            tour_entrant_fd[e] = fd;
+            *c = (TourConn){ TCONN_ROOM, (int16_t)e, (int16_t)r, (int8_t)seat, c->caps };
+            tour_rooms[r]->players[seat].sockfd = fd;
+            tour_rooms[r]->players[seat].caps = c->caps;
+            update_player_activity(&tour_rooms[r]->players[seat], clock_now_ms());
+            game_player_resume(tour_rooms[r], seat);
+            return;
+        }
+        error = "재접속할 경기를 찾을 수 없습니다.";
+    } else if (strcmp(action, ACTION_HELLO) == 0) {
+        c->caps = (uint8_t)(msg->caps & SERVER_CAPS);
+        send_message(fd, frame_hello(&(HelloMsg){ .caps = c->caps }));
+        return;
+    } else if (strcmp(action, ACTION_LEADERBOARD) == 0) {
+        const char *my_name = c->entrant >= 0 ? tournament.names[c->entrant] : "";
+        struct json_object *jres = build_leaderboard_result(my_name, msg);
+        send_json(fd, jres);
+        json_object_put(jres);
+        return;
+    } else {
+        error = c->kind == TCONN_LOBBY    ? "먼저 명단에 등록된 이름으로 체크인하세요."
+              : c->kind == TCONN_FINISHED ? "토너먼트 일정이 끝났습니다. 리더보드 조회만 가능합니다."
+                                          : "다음 경기 배정을 기다리는 중입니다.";
+    }
+    
+    send_message(fd, frame_error(&(ErrorMsg){ .message = error }));
+}
+
+/**
+ * 토너먼트 연결의 메시지 처리 (fd → 로비/대기/경기 방으로 분기)
+ * @return: 토너먼트 연결이었으면 1, 아니면 0
+ */
+int tournament_handle_fd(int fd, fd_set *master_set) {
+    if (fd >= FD_SETSIZE || tour_conns[fd].kind == TCONN_NONE) return 0;
+    TourConn *c = &tour_conns[fd];
+    
+    if (c->kind == TCONN_ROOM) {
+        GameManager *room = tour_rooms[c->room];
+        int seat = c->seat;
+        int e = c->entrant;
+        handle_client_message(room, seat, master_set);
+        if (room->players[seat].sockfd < 0) {
+            // 경기 중 연결 끊김 - 좌석은 RESUME_GRACE_SEC 동안 유지
+            tour_entrant_fd[e] = -1;
+            tour_conns[fd].kind = TCONN_NONE;
+        }
+        return 1;
+    }
+    
+    int dropped;
+    ClientMsg msg;
+    int rc = recv_message(fd, &msg, &dropped);
+    if (dropped) return 1;
+    if (rc < 0) {
+        if (c->kind == TCONN_ENTRANT) {
+            printf("[Tournament] %s 연결 해제 (대기 중)\n", tournament.names[c->entrant]);
+            tour_entrant_fd[c->entrant] = -1;
+        } else if (c->kind == TCONN_FINISHED) {
+            tour_entrant_fd[c->entrant] = -1;
+        }
+        c->kind = TCONN_NONE;
+        FD_CLR(fd, master_set);
+        close_connection(fd);
+        return 1;
+    }
+    tournament_lobby_message(fd, &msg);
+    return 1;
+}
+
+// ──────────────────────────────────────────────────────────
+// 크래시 복구 스냅샷 (Crash Recovery Layer)
+// ──────────────────────────────────────────────────────────
+
+// 토너먼트 진행 상황 (대진표 + 참가자 미접속으로 대기 중인 경기)
+typedef struct {
+    Tournament bracket;
+    uint8_t match_waiting[2 * TOURNAMENT_MAX_ENTRANTS];
+} TournamentSnapshot;
+
+/**
+ * 스냅샷 기록 (fork된 자식 프로세스에서 호출 - fork 시점의 상태가 고정되어 있음)
+ * 토너먼트 대진표를 방보다 먼저 기록 (복원할 때 대진표를 받아들여야 경기 방도 되살림)
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int write_snapshot(void) {
+    if (snapshot_write_begin(snapshotter.path) < 0) return -1;
+    snapshot_write_room(&game, -1, NULL);
+    if (tournament_mode) {
+        TournamentSnapshot ts;
+        ts.bracket = tournament;
+        memcpy(ts.match_waiting, tour_match_waiting, sizeof(ts.match_waiting));
+        snapshot_write_section(SNAPSHOT_SEC_BRACKET, &ts, sizeof(ts));
+        for (int r = 0; r < TOURNAMENT_MAX_ROOMS; r++) {
+            if (tour_room_match[r] < 0 || tour_room_winner[r] >= 0) continue;
+            snapshot_write_room(tour_rooms[r], tour_room_match[r], tour_room_entrants[r]);
+        }
+    }
+    uint64_t seq = journal.fd >= 0 ? journal.header->count : 0;
+    return snapshot_write_commit(clock_wall_ms(), seq, game.match_id) < 0 ? -1 : 0;
+}
+
+/**
+ * 스냅샷 주기 처리 - 반복 끝(메시지 전송과 저널 기록 후)에 호출
+ * 부모는 fork()만 하고 바로 돌아옴, 자식은 기록 후 종료
+ */
+void snapshot_service(void) {
+    snapshot_reap(&snapshotter);
+    if (snapshot_fork_if_due(&snapshotter, clock_now_ms()) == 1) {
+        _exit(write_snapshot() < 0 ? 1 : 0);
+    }
+}
+
+/**
+ * 복원한 방 표시 - 리플레이는 이 레코드에서 저널을 snapshot_seq까지 다시 돌려 같은 상태를 만든 뒤
+ * game_restore_room()을 똑같이 적용
+ */
+void journal_restore_event(GameManager *g, uint64_t snapshot_seq) {
+    if (journal.fd < 0) return;
+    JournalRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.match_id = g->match_id;
+    rec.room_id = g->room_id;
+    rec.type = JOURNAL_RESTORE;
+    rec.capacity = (uint8_t)g->capacity;
+    rec.snapshot_seq = (uint32_t)snapshot_seq;
+    rec.timestamp_ms = loop_now_ms;
+    if (journal_append(&journal, &rec) < 0) {
+        printf("[Server] 저널 기록 실패 (event=%s)\n", journal_event_name(JOURNAL_RESTORE));
+    }
+}
+
+/**
+ * 시작 시 마지막 스냅샷으로 방 복원 (무중단 재시작으로 인수한 경우는 호출하지 않음)
+ * 게임 중이던 방의 플레이어는 모두 재접속 대기가 되어 토큰으로 같은 좌석에 복귀,
+ * 게임 전/종료 후였던 방은 빈 방으로 시작
+ * @param room_players: -P로 지정한 방 정원 (빈 방으로 시작하는 일반 방에 적용)
+ * @return: 복원한 방 수
+ */
+int restore_snapshot(const char *path, int room_players) {
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    
+    SnapshotReader rd;
+    int rc = snapshot_load(path, &rd);
+    if (rc == 1) {
+        printf("[Snapshot] 스냅샷 %s 없음 - 빈 상태로 시작합니다\n", path);
+        return 0;
+    }
+    if (rc < 0) {
+        printf("[Snapshot] 스냅샷 %s이 손상되었거나 형식이 다릅니다 - 빈 상태로 시작합니다\n", path);
+        return 0;
+    }
+    
+    uint32_t last_match = game.match_id;  // 저널의 마지막 경기 번호 (저널이 없으면 0)
+    uint32_t type, size;
+    const void *body;
+    int bracket_ok = 0;
+    int restored = 0;
+    while ((body = snapshot_next(&rd, &type, &size)) != NULL) {
+        if (type == SNAPSHOT_SEC_BRACKET && tournament_mode) {
+            // 같은 명단으로 다시 시작한 경우에만 대진표를 이어받음
+            static TournamentSnapshot ts;
+            if (size == sizeof(ts)) memcpy(&ts, body, sizeof(ts));
+            if (size == sizeof(ts) &&
+                ts.bracket.entrant_count == tournament.entrant_count &&
+                memcmp(ts.bracket.names, tournament.names, sizeof(tournament.names)) == 0) {
+                tournament = ts.bracket;
+                memcpy(tour_match_waiting, ts.match_waiting, sizeof(tour_match_waiting));
+                bracket_ok = 1;
+            } else {
+                printf("[Snapshot] 토너먼트 명단이 스냅샷과 달라 대진표를 새로 시작합니다\n");
+            }
+            continue;
+        }
+        if (type != SNAPSHOT_SEC_ROOM) continue;
+        
+        SnapshotRoom meta;
+        uint16_t room_id;
+        if (size != sizeof(SnapshotRoom)) continue;
+        memcpy(&room_id, body, sizeof(room_id));  // 섹션 본문은 정렬이 보장되지 않음
+        if (room_id > 0) {
+            int r = room_id - 1;
+            GameManager *room;
+            if (!bracket_ok || r >= TOURNAMENT_MAX_ROOMS || tour_room_match[r] >= 0) continue;
+            room = pool_alloc(&room_pool);
+            if (!room) continue;
+            game_init(room);
+            if (snapshot_room_unpack(body, size, room, &meta) < 0 ||
+                meta.entrants[0] < 0 || meta.entrants[0] >= tournament.entrant_count ||
+                meta.entrants[1] < 0 || meta.entrants[1] >= tournament.entrant_count) {
+                pool_free(&room_pool, room);
+                continue;
+            }
+            tour_rooms[r] = room;
+            tour_room_match[r] = meta.match_node;
+            tour_room_entrants[r][0] = meta.entrants[0];
+            tour_room_entrants[r][1] = meta.entrants[1];
+            tour_room_winner[r] = -1;
+        } else if (snapshot_room_unpack(body, size, &game, &meta) < 0) {
+            game_init(&game);
+            game.capacity = room_players;
+            continue;
+        }
+        restored++;
+    }
+    
+    // 빈 방 스택을 복원한 방을 뺀 나머지로 다시 구성
+    if (tournament_mode) {
+        tour_free_count = 0;
+        for (int r = TOURNAMENT_MAX_ROOMS - 1; r >= 0; r--) {
+            if (tour_room_match[r] < 0) tour_free_rooms[tour_free_count++] = r;
+        }
+    }
+    
+    // 좌석 정리: 게임 중인 방은 재접속 대기로, 나머지는 빈 방으로 (리플레이와 같은 순서)
+    uint64_t journal_count = journal.fd >= 0 ? journal.header->count : 0;
+    int playing = 0, waiting_players = 0;
+    game_restore_room(&game);
+    if (game.state == GAME_WAITING) {
+        game.capacity = room_players;
+        game.match_id = rd.header.match_id > last_match ? rd.header.match_id : last_match;
+    } else {
+        playing++;
+    }
+    journal_restore_event(&game, rd.header.journal_seq);
+    for (int r = 0; r < TOURNAMENT_MAX_ROOMS && tournament_mode; r++) {
+        if (tour_room_match[r] < 0) continue;
+        game_restore_room(tour_rooms[r]);
+        if (tour_rooms[r]->state != GAME_WAITING) playing++;
+        journal_restore_event(tour_rooms[r], rd.header.journal_seq);
+    }
+    for (int i = 0; i < MAX_CLIENTS; i++) waiting_players += game.players[i].suspended;
+    for (int r = 0; r < TOURNAMENT_MAX_ROOMS && tournament_mode; r++) {
+        if (tour_room_match[r] < 0) continue;
+        for (int i = 0; i < MAX_CLIENTS; i++) waiting_players += tour_rooms[r]->players[i].suspended;
+    }
+    snapshot_free(&rd);
+    
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ms = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    printf("[Snapshot] %.1f초 전 스냅샷에서 방 %d개 복원 (게임 중 %d개, 재접속 대기 %d명) - %.2fms\n",
+           (clock_wall_ms() - rd.header.taken_ms) / 1000.0, restored, playing, waiting_players, ms);
+    if (journal.fd >= 0 && journal_count > rd.header.journal_seq + 1) {
+        // 스냅샷 이후 크래시 전까지의 기록 (SERVER_START 표시 제외)은 복원 상태에 반영되지 않음
+        printf("[Snapshot] 스냅샷 이후의 저널 기록 %llu건은 복원되지 않았습니다\n",
+               (unsigned long long)(journal_count - rd.header.journal_seq - 1));
+    }
+    return restored;
+}
+
+// ──────────────────────────────────────────────────────────
+// 리스닝 소켓 생성
+// ──────────────────────────────────────────────────────────
+
+/**
+ * TCP 리스닝 소켓 생성 (non-blocking - 대기열이 빌 때까지 accept4()를 반복)
+ * @param backlog: listen() 대기열 길이
+ * @param reuse_port: SO_REUSEPORT 설정 (인계 대상이 아닌 포트를 새 프로세스가 이전 프로세스 종료 전에 바인딩)
+ * @return: 리스닝 소켓, 실패 시 -1
+ */
+int create_listen_socket(int port, int backlog, int reuse_port) {
+    int listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    
+    int opt = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    if (reuse_port) setsockopt(listen_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
+    
+    struct sockaddr_in serv_addr;
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_addr.s_addr = INADDR_ANY;
+    serv_addr.sin_port = htons(port);
+    
+    if (bind(listen_fd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+        perror("bind");
+        close(listen_fd);
+        return -1;
+    }
+    
+    if (listen(listen_fd, backlog) < 0) {
+        perror("listen");
+        close(listen_fd);
+        return -1;
+    }
+    
+    return listen_fd;
+}
+
+/**
+ * AF_UNIX 리스닝 소켓 생성 (같은 호스트의 클라이언트용, non-blocking, 기존 소켓 파일은 교체)
+ * @return: 리스닝 소켓, 실패 시 -1
+ */
+int create_unix_listen_socket(const char *path, int backlog) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        printf("[Server] 소켓 경로가 너무 깁니다: %s\n", path);
         return -1;
     }
+    strcpy(addr.sun_path, path);
     
-    // 2단계: JSON 문자열 전송
-    if (send(fd, s, len, 0) != len) {
-        printf("[Server] JSON 데이터 전송 실패 (fd=%d): %s\n", fd, strerror(errno));
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        perror("socket(AF_UNIX)");
         return -1;
     }
     
-    return 0;
+    unlink(path);  // 이전 프로세스가 남긴 소켓 파일 교체
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, backlog) < 0) {
+        printf("[Server] AF_UNIX 소켓 생성 실패 (%s): %s\n", path, strerror(errno));
+        close(listen_fd);
+        return -1;
+    }
+    return listen_fd;
 }
 
 /**
- * 소켓에서 JSON 객체 수신
- * 타임아웃과 부분 수신 처리를 포함한 안전한 수신
+ * 파일 디스크립터 한도(RLIMIT_NOFILE)를 설정된 수용 인원에 맞게 올림
+ * select()가 다룰 수 있는 FD_SETSIZE보다 크게 올리지는 않음
  * 
- * @param fd: 소켓 파일 디스크립터
- * @return: 수신된 JSON 객체 포인터, 실패 시 NULL
+ * @param needed: 필요한 fd 수 (연결 + 고정 fd 여유분)
  */
-struct json_object *recv_json(int fd) {
-    uint16_t netlen;
+void raise_fd_limit(rlim_t needed) {
+    if (needed > FD_SETSIZE) needed = FD_SETSIZE;
     
-    // 1단계: 메시지 길이 수신 (2바이트, 완전 수신까지 대기)
-    ssize_t n = recv(fd, &netlen, sizeof(netlen), MSG_WAITALL);
-    if (n <= 0) {
-        if (n == 0) {
-            printf("[Server] 클라이언트가 연결을 종료했습니다 (fd=%d)\n", fd);
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) < 0) {
+        perror("getrlimit");
+        return;
+    }
+    if (rl.rlim_cur < needed) {
+        rlim_t old = rl.rlim_cur;
+        rl.rlim_cur = (rl.rlim_max != RLIM_INFINITY && rl.rlim_max < needed) ? rl.rlim_max : needed;
+        if (setrlimit(RLIMIT_NOFILE, &rl) < 0) {
+            perror("setrlimit");
         } else {
-            printf("[Server] 메시지 길이 수신 실패 (fd=%d): %s\n", fd, strerror(errno));
+            printf("[Server] 파일 디스크립터 한도 %lu → %lu\n", (unsigned long)old, (unsigned long)rl.rlim_cur);
         }
-        return NULL;
-    }
-    
-    int len = ntohs(netlen);  // 호스트 바이트 순서로 변환
-    
-    // 길이 유효성 검사 (DoS 공격 방지)
-    if (len <= 0 || len > BUF_SIZE) {
-        printf("[Server] 잘못된 메시지 길이: %d bytes (fd=%d)\n", len, fd);
-        return NULL;
-    }
-    
-    // 2단계: JSON 문자열 수신
-    char buf[BUF_SIZE + 1];
-    n = recv(fd, buf, len, MSG_WAITALL);
-    if (n <= 0) {
-        printf("[Server] JSON 데이터 수신 실패 (fd=%d): %s\n", fd, strerror(errno));
-        return NULL;
     }
-    
-    buf[len] = '\0';  // NULL terminator 추가
-    
-    // 3단계: JSON 파싱
-    struct json_object *jobj = json_tokener_parse(buf);
-    if (jobj == NULL) {
-        printf("[Server] JSON 파싱 실패 (fd=%d): %s\n", fd, buf);
-        return NULL;
+    if (rl.rlim_cur < needed) {
+        printf("[Server] 경고: 파일 디스크립터 한도(%lu)가 필요한 수(%lu)보다 작습니다\n",
+               (unsigned long)rl.rlim_cur, (unsigned long)needed);
     }
-    
-    return jobj;
 }
 
 // ──────────────────────────────────────────────────────────
-// 게임 초기화 및 관리 함수들 (Game Management Layer)
+// 공유 메모리 연결 점검 (Local Transport)
 // ──────────────────────────────────────────────────────────
 
 /**
- * 게임 매니저 초기화
- * 모든 플레이어 상태를 기본값으로 설정하고 게임 준비
+ * 공유 메모리 연결 점검 (이벤트 루프 반복마다 호출)
+ * - 링이 가득 차 남은 송신 큐 재전송 (eventfd에는 쓰기 가능 이벤트가 없으므로 select()로 감시하지 않음)
+ * - SHM_PEER_CHECK_MS마다 상대 프로세스 종료(접속 소켓 EOF) 확인 → 채널을 닫아 다음 수신에서 정리
+ * - 마감까지 fd를 보내지 않은 접속 소켓 정리
  */
-void init_game() {
-    // 게임 전체 상태 초기화
-    game.state = GAME_WAITING;
-    game.current_turn = 0;
-    game.players_ready = 0;
-    game.game_start_time = time(NULL);
-    game.last_heartbeat = time(NULL);
-    
-    // 모든 플레이어 정보 초기화
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        game.players[i].sockfd = -1;
-        game.players[i].player_id = i;
-        game.players[i].connected = 0;
-        game.players[i].state = PLAYER_WAITING;
-        memset(game.players[i].secret_number, 0, 4);
-        game.players[i].attempts = 0;
-        game.players[i].is_winner = 0;
-        game.players[i].last_activity = time(NULL);  // 네트워크 지연 처리용
-        game.players[i].retry_count = 0;             // 재시도 횟수 초기화
-    }
+void shm_service(int max_fd, fd_set *master_set) {
+    int check_peers = clock_now_ms() - last_shm_check_ms >= SHM_PEER_CHECK_MS;
+    if (check_peers) last_shm_check_ms = clock_now_ms();
     
-    // 전역 하트비트 타이머 초기화
-    last_heartbeat_check = time(NULL);
-    
-    printf("[Server] 숫자 야구 게임 서버 초기화 완료\n");
-    printf("[Server] 네트워크 타임아웃: %d초, 하트비트 간격: %d초\n", 
-           NETWORK_TIMEOUT_SEC, HEARTBEAT_INTERVAL_SEC);
+    for (int fd = 0; fd <= max_fd; fd++) {
+        if (is_shm_handshake(fd) && clock_now_ms() >= shm_attach_deadline[fd]) {
+            printf("[Server] 공유 메모리 접속 요청 시간 초과 - 거부 (fd=%d)\n", fd);
+            shm_attach_deadline[fd] = 0;
+            FD_CLR(fd, master_set);
+            close(fd);
+            continue;
+        }
+        ShmChannel *ch = &shm_conns[fd];
+        if (!ch->region) continue;
+        if (outboxes[fd] && outbox_pending(outboxes[fd]) && outbox_flush(outboxes[fd], fd) < 0) {
+            outbox_clear(outboxes[fd]);
+            shm_channel_shutdown(ch);
+        }
+        if (check_peers && !shm_channel_peer_alive(ch)) {
+            printf("[Server] 공유 메모리 클라이언트 프로세스 종료 감지 (fd=%d)\n", fd);
+            shm_channel_shutdown(ch);
+        }
+    }
 }
 
 // ──────────────────────────────────────────────────────────
-// 네트워크 지연 및 안정성 처리 함수들 (Network Reliability Layer)
+// 게이트웨이 링크 (Gateway Layer)
+// baseball_gateway가 클라이언트 연결을 받고, 이 서버와는 소수의 링크 위에 세션 id를 붙인 레코드로 다중화
 // ──────────────────────────────────────────────────────────
 
 /**
- * 모든 플레이어의 타임아웃 상태 체크
- * 30초 이상 비활성 플레이어는 연결 해제 처리
- * 
- * @param master_set: select()용 파일 디스크립터 집합
+ * 게이트웨이 링크 연결 수락 (빈 링크 자리가 없으면 거부)
  */
-void check_player_timeouts(fd_set *master_set) {
-    time_t current_time = time(NULL);
-    
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (!game.players[i].connected) continue;
-        
-        // 타임아웃 체크 (30초 이상 비활성)
-        if (is_player_timeout(&game.players[i])) {
-            printf("[Server] 플레이어 %d 타임아웃 - 연결을 해제합니다\n", i);
-            
-            // 상대방에게 타임아웃 알림
-            int opponent_id = 1 - i;
-            if (game.players[opponent_id].connected) {
-                struct json_object *timeout_msg = create_timeout_message("상대방이 연결을 잃었습니다");
-                send_json(game.players[opponent_id].sockfd, timeout_msg);
-                json_object_put(timeout_msg);
-            }
-            
-            // 연결 정리
-            cleanup_disconnected_player(i, master_set);
+void handle_gateway_link(int listen_fd, fd_set *master_set, int *max_fd) {
+    int fd;
+    while ((fd = accept_connection(listen_fd, NULL)) >= 0) {
+        int idx = -1;
+        for (int i = 0; i < GWLINK_MAX_LINKS && idx < 0; i++) {
+            if (gw_links[i].fd < 0) idx = i;
         }
+        if (idx < 0) {
+            printf("[Server] 게이트웨이 링크 수 초과 (최대 %d개) - 연결 거부\n", GWLINK_MAX_LINKS);
+            close(fd);
+            continue;
+        }
+        // 레코드는 반복 끝에 직접 모아 보내므로 Nagle 지연을 더할 필요 없음
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        gwlink_reset(&gw_links[idx], fd);
+        track_fd(fd, master_set, max_fd);
+        gw_status_len = 0;  // 새 링크에 방 상태를 바로 알림
+        printf("[Server] 게이트웨이 링크 %d 연결 (fd=%d)\n", idx, fd);
     }
 }
 
 /**
- * 모든 연결된 플레이어에게 하트비트 메시지 전송
- * 10초마다 연결 상태 확인용 메시지 전송
+ * 게이트웨이 링크 끊김 - 링크의 모든 세션을 닫힘으로 표시
+ * 세션 정리는 세션마다 다음 수신에서 일반 연결 해제와 같은 경로로 (게임 중이면 재접속 대기 좌석)
  */
-void send_heartbeat_to_all(void) {
-    time_t current_time = time(NULL);
-    
-    // 하트비트 간격 체크 (10초마다)
-    if (current_time - last_heartbeat_check < HEARTBEAT_INTERVAL_SEC) {
-        return;
+void gateway_link_down(int idx, fd_set *master_set) {
+    GwLink *l = &gw_links[idx];
+    int closed = 0;
+    for (int fd = 0; fd < FD_SETSIZE; fd++) {
+        GwSession *s = gw_sessions[fd];
+        if (!s || s->link != l) continue;
+        gw_session_shutdown(s);
+        s->link = NULL;  // 닫힘 알림을 보낼 곳이 없음
+        closed++;
     }
+    for (int slot = 0; slot < GWLINK_MAX_SLOTS; slot++) gw_slot_fd[idx][slot] = -1;
     
-    // 모든 연결된 플레이어에게 하트비트 전송
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (game.players[i].connected) {
-            struct json_object *heartbeat = create_heartbeat_message();
-            if (send_json(game.players[i].sockfd, heartbeat) < 0) {
-                printf("[Server] 플레이어 %d 하트비트 전송 실패\n", i);
-            }
-            json_object_put(heartbeat);
-        }
+    printf("[Server] 게이트웨이 링크 %d 끊김 (fd=%d, 세션 %d개 종료, 받은 레코드 %llu개, 보낸 레코드 %llu개, 쓰기 %llu회)\n",
+           idx, l->fd, closed, (unsigned long long)l->records_in,
+           (unsigned long long)l->records_out, (unsigned long long)l->writes);
+    FD_CLR(l->fd, master_set);
+    close(l->fd);
+    gwlink_reset(l, -1);
+}
+
+/**
+ * 새 세션 생성 (세션 레코드 할당, eventfd를 연결 식별 fd로 등록)
+ * 만들 수 없으면 게이트웨이에 닫힘 알림
+ * @return: 세션 eventfd, 실패 시 -1
+ */
+int gateway_session_open(GwLink *l, uint32_t sid) {
+    GwSession *s = pool_alloc(&gw_session_pool);
+    int fd = s ? gw_session_open(s, l, sid) : -1;
+    if (fd >= 0 && fd < FD_SETSIZE) {
+        gw_sessions[fd] = s;
+        return fd;
     }
-    
-    last_heartbeat_check = current_time;
-    printf("[Server] 하트비트 전송 완료\n");
+    if (fd >= 0) {
+        gw_session_close(s);  // select()로 감시할 수 없는 fd - 닫힘 알림 포함
+    } else {
+        gwlink_send_control(l, sid, GWLINK_CLOSE);
+    }
+    if (s) pool_free(&gw_session_pool, s);
+    return -1;
 }
 
 /**
- * 연결 해제된 플레이어 정리
- * 소켓 닫기, 상태 초기화, select() 집합에서 제거
- * 
- * @param player_id: 정리할 플레이어 ID
- * @param master_set: select()용 파일 디스크립터 집합
+ * 게이트웨이 링크에서 받은 레코드를 세션별로 전달
+ * 새로 열린 세션은 입장 대기열에 넣고, 호출자가 리스닝 소켓처럼 입장 처리 (accept_client())
+ * @return: 새로 열린 세션 수
  */
-void cleanup_disconnected_player(int player_id, fd_set *master_set) {
-    if (player_id < 0 || player_id >= MAX_CLIENTS) return;
-    
-    PlayerInfo *player = &game.players[player_id];
+int gateway_link_receive(int fd, fd_set *master_set) {
+    int idx = gateway_link_index(fd);
+    GwLink *l = &gw_links[idx];
+    ssize_t n = gwlink_receive(l);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        gateway_link_down(idx, master_set);
+        return 0;
+    }
     
-    if (player->sockfd >= 0) {
-        // select() 집합에서 제거
-        FD_CLR(player->sockfd, master_set);
+    int opened = 0;
+    size_t pos = 0;
+    GwRecord rec;
+    int rc;
+    while ((rc = gwlink_next(l, &pos, &rec)) > 0) {
+        int slot = GWLINK_SLOT(rec.sid);
+        if (slot >= GWLINK_MAX_SLOTS) {
+            rc = -1;
+            break;
+        }
+        int sfd = gw_slot_fd[idx][slot];
+        GwSession *s = sfd >= 0 ? gw_sessions[sfd] : NULL;
         
-        // 소켓 종료
-        close(player->sockfd);
-        printf("[Server] 플레이어 %d 소켓 종료 (fd=%d)\n", player_id, player->sockfd);
+        if (rec.type == GWREC_OPEN) {
+            // 같은 슬롯의 이전 세션이 남아 있으면 (닫힘 알림 유실) 닫고 새 세션으로 교체
+            if (s) gw_session_shutdown(s);
+            gw_slot_fd[idx][slot] = sfd = gateway_session_open(l, rec.sid);
+            if (sfd >= 0) {
+                gw_accept_queue[(gw_accept_head + gw_accept_count++) % FD_SETSIZE] = sfd;
+                opened++;
+            }
+            continue;
+        }
+        if (!s || s->sid != rec.sid) continue;  // 이미 닫은 세션의 늦은 레코드
+        if (gw_session_deliver(s, &rec) < 0) {
+            printf("[Server] 게이트웨이 세션 수신 대기 초과 - 세션을 닫습니다 (fd=%d)\n", sfd);
+            gw_session_shutdown(s);
+        }
     }
+    gwlink_consume(l, pos);
     
-    // 플레이어 상태 초기화
-    player->sockfd = -1;
-    player->connected = 0;
-    player->state = PLAYER_WAITING;
-    memset(player->secret_number, 0, 4);
-    player->attempts = 0;
-    player->is_winner = 0;
-    player->retry_count = 0;
-    
-    // 게임 상태 조정
-    game.players_ready--;
-    if (game.players_ready < 0) game.players_ready = 0;
-    
-    // 게임 중이었다면 게임 종료
-    if (game.state == GAME_PLAYING || game.state == GAME_SETTING) {
-        game.state = GAME_WAITING;
-        printf("[Server] 플레이어 연결 해제로 인한 게임 종료\n");
+    if (rc < 0) {
+        printf("[Server] 게이트웨이 링크 %d 레코드 형식 오류 - 링크를 닫습니다\n", idx);
+        gateway_link_down(idx, master_set);
     }
+    return opened;
 }
 
-// ──────────────────────────────────────────────────────────
-// 메시징 및 브로드캐스트 함수들 (Messaging Layer)
-// ──────────────────────────────────────────────────────────
-
 /**
- * 모든 연결된 플레이어에게 메시지 브로드캐스트
- * 게임 상태 변경, 공지사항 등 전체 알림용
- * 
- * @param jmsg: 브로드캐스트할 JSON 메시지
+ * 게이트웨이 세션 송신 재시도 (이벤트 루프 반복마다 호출)
+ * 링크 송신 버퍼가 가득 차 남은 세션 송신 큐를 링크가 비워진 만큼 다시 채움
+ * (eventfd에는 쓰기 가능 이벤트가 없으므로 select()로 감시하지 않음)
  */
-void broadcast_to_all(struct json_object *jmsg) {
-    int sent_count = 0;
-    
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (game.players[i].connected) {
-            if (send_json(game.players[i].sockfd, jmsg) == 0) {
-                sent_count++;
-                update_player_activity(&game.players[i]); // 활동 시간 업데이트
-            } else {
-                printf("[Server] 플레이어 %d에게 브로드캐스트 실패\n", i);
-            }
+void gateway_service(int max_fd) {
+    for (int fd = 0; fd <= max_fd; fd++) {
+        if (!is_gateway_session(fd) || !outboxes[fd] || !outbox_pending(outboxes[fd])) continue;
+        if (outbox_flush(outboxes[fd], fd) < 0) {
+            outbox_clear(outboxes[fd]);
+            gw_session_shutdown(gw_sessions[fd]);
         }
     }
-    
-    printf("[Server] 브로드캐스트 완료: %d명에게 전송\n", sent_count);
 }
 
 /**
- * 특정 플레이어에게 개별 메시지 전송
- * 턴 알림, 개인별 게임 결과 등 개별 통신용
- * 
- * @param player_id: 대상 플레이어 ID (0 또는 1)
- * @param jmsg: 전송할 JSON 메시지
+ * 방 상태를 모든 게이트웨이 링크에 보고 (반복 끝 링크 전송 직전에 호출)
+ * 상태나 인원이 바뀌었으면 바로, 그대로면 GWLINK_STATUS_MS마다 - 게이트웨이는 이 보고로 빈 방을 찾고
+ * 보고가 끊긴 서버에는 새 경기를 배정하지 않음
  */
-void send_to_player(int player_id, struct json_object *jmsg) {
-    // 유효성 검사
-    if (player_id < 0 || player_id >= MAX_CLIENTS) {
-        printf("[Server] 잘못된 플레이어 ID: %d\n", player_id);
-        return;
+void gateway_publish_status(void) {
+    int players = 0, suspended = 0;
+    for (int i = 0; i < game.capacity; i++) {
+        if (game.players[i].connected) players++;
+        else if (game.players[i].suspended) suspended++;
     }
     
-    if (!game.players[player_id].connected) {
-        printf("[Server] 플레이어 %d는 연결되어 있지 않습니다\n", player_id);
-        return;
-    }
+    char buf[sizeof(gw_status_last)];
+    size_t len = encode_node_status(buf, sizeof(buf), &(NodeStatusMsg){
+        .state = game_state_name(game.state), .capacity = game.capacity,
+        .players = players, .suspended = suspended });
+    if (len == 0) return;
+    if (len == gw_status_len && memcmp(buf, gw_status_last, len) == 0 &&
+        clock_now_ms() - gw_status_sent_ms < GWLINK_STATUS_MS) return;
     
-    // 메시지 전송
-    if (send_json(game.players[player_id].sockfd, jmsg) == 0) {
-        update_player_activity(&game.players[player_id]); // 활동 시간 업데이트
-        printf("[Server] 플레이어 %d에게 메시지 전송 완료\n", player_id);
-    } else {
-        printf("[Server] 플레이어 %d에게 메시지 전송 실패\n", player_id);
-        
-        // 전송 실패 시 재시도 카운터 증가
-        game.players[player_id].retry_count++;
-        if (game.players[player_id].retry_count >= MAX_RETRY_COUNT) {
-            printf("[Server] 플레이어 %d 최대 재시도 횟수 초과 - 연결 해제\n", player_id);
-            // 연결 해제는 메인 루프에서 처리하도록 플래그만 설정
-            game.players[player_id].connected = 0;
-        }
+    struct iovec iov = { .iov_base = buf, .iov_len = len };
+    for (int i = 0; i < GWLINK_MAX_LINKS; i++) {
+        if (gw_links[i].fd >= 0) gwlink_writev(&gw_links[i], GWLINK_SID_NODE, &iov, 1);  // 가득 차면 다음 주기에
     }
+    memcpy(gw_status_last, buf, len);
+    gw_status_len = len;
+    gw_status_sent_ms = clock_now_ms();
 }
 
-// ──────────────────────────────────────────────────────────
-// 게임 초기화
-// ──────────────────────────────────────────────────────────
-void start_game() {
-    if (game.state != GAME_WAITING || game.players_ready < 2) return;
-    
-    game.state = GAME_SETTING;
-    printf("[Server] 게임 시작! 플레이어들이 숫자를 설정하세요.\n");
-    
-    // 모든 플레이어에게 게임 시작 알림
-    struct json_object *jmsg = create_message(ACTION_GAME_START);
-    json_object_object_add(jmsg, "message", 
-        json_object_new_string("게임이 시작되었습니다! 3자리 숫자를 설정하세요."));
-    broadcast_to_all(jmsg);
-    json_object_put(jmsg);
-    
-    // 각 플레이어 상태를 설정 중으로 변경
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (game.players[i].connected) {
-            game.players[i].state = PLAYER_SETTING;
+/**
+ * 링크 송신 버퍼 전송 (outbox_flush_dirty() 뒤에 호출 - 이번 반복의 모든 세션 메시지를 링크마다 send() 한 번으로)
+ * 전송 오류는 링크를 shutdown()해 두고 다음 수신(EOF)에서 링크 끊김으로 정리
+ */
+void gateway_flush_links(void) {
+    for (int i = 0; i < GWLINK_MAX_LINKS; i++) {
+        GwLink *l = &gw_links[i];
+        if (l->fd < 0 || !gwlink_pending(l)) continue;
+        if (gwlink_flush(l) < 0) {
+            l->out_len = 0;
+            shutdown(l->fd, SHUT_RDWR);
         }
     }
 }
 
 // ──────────────────────────────────────────────────────────
-// 숫자 설정 완료 확인 및 게임 진행 시작
+// 무중단 재시작 (Hot Restart)
 // ──────────────────────────────────────────────────────────
-void check_all_numbers_set() {
-    int ready_count = 0;
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (game.players[i].connected && game.players[i].state == PLAYER_READY) {
-            ready_count++;
+
+/**
+ * select() 감시 집합에 fd 추가
+ */
+void track_fd(int fd, fd_set *master_set, int *max_fd) {
+    if (fd < 0) return;
+    FD_SET(fd, master_set);
+    if (fd > *max_fd) *max_fd = fd;
+}
+
+/**
+ * 인계 전 TCP 연결의 송신 큐 비우기 (소켓은 넘어가지만 큐에 남은 바이트는 넘어가지 않으므로)
+ * 쓰기 가능해질 때마다 이어서 보내며 HANDOFF_DRAIN_MS까지 기다림
+ * 그래도 남은 연결과 수신 중이던 프레임이 반만 들어온 연결은 shutdown() - 어긋난 스트림을 넘기는 대신
+ * 새 프로세스가 첫 수신(EOF)에서 재접속 대기로 돌리고, 클라이언트는 재접속 토큰으로 복귀
+ */
+void drain_connections_for_handoff(void) {
+    outbox_flush_dirty();
+    clock_update();
+    uint64_t deadline = clock_now_ms() + HANDOFF_DRAIN_MS;
+    for (;;) {
+        fd_set write_set;
+        FD_ZERO(&write_set);
+        int max_fd = -1;
+        for (int fd = 0; fd < FD_SETSIZE; fd++) {
+            Outbox *ob = outboxes[fd];
+            if (!ob || ob->shm || ob->gw || !outbox_pending(ob)) continue;
+            if (outbox_flush(ob, fd) < 0) {
+                outbox_clear(ob);
+                shutdown(fd, SHUT_RDWR);
+                continue;
+            }
+            if (outbox_pending(ob)) {
+                FD_SET(fd, &write_set);
+                if (fd > max_fd) max_fd = fd;
+            }
         }
+        if (max_fd < 0) break;
+        clock_update();
+        uint64_t now = clock_now_ms();
+        if (now >= deadline) break;
+        struct timeval tv = { .tv_sec = (time_t)((deadline - now) / 1000),
+                              .tv_usec = (suseconds_t)((deadline - now) % 1000) * 1000 };
+        if (select(max_fd + 1, NULL, &write_set, NULL, &tv) < 0 && errno != EINTR) break;
     }
     
-    if (ready_count == 2) {
-        game.state = GAME_PLAYING;
-        game.current_turn = 0;  // 첫 번째 플레이어부터 시작
-        
-        printf("[Server] 모든 플레이어가 숫자를 설정했습니다. 게임을 시작합니다!\n");
-        
-        // 턴 알림
-        start_turn();
+    int cut = 0;
+    for (int fd = 0; fd < FD_SETSIZE; fd++) {
+        Outbox *ob = outboxes[fd];
+        int unsent = ob && !ob->shm && !ob->gw && outbox_pending(ob);
+        int partial = inboxes[fd] && inbox_pending(inboxes[fd]);
+        if (!unsent && !partial) continue;
+        if (ob) outbox_clear(ob);
+        shutdown(fd, SHUT_RDWR);
+        cut++;
     }
-}
-
-// ──────────────────────────────────────────────────────────
-// 턴 시작 처리
-// ──────────────────────────────────────────────────────────
-void start_turn() {
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (!game.players[i].connected) continue;
-        
-        struct json_object *jmsg;
-        if (i == game.current_turn) {
-            // 현재 턴 플레이어
-            jmsg = create_message(ACTION_YOUR_TURN);
-            json_object_object_add(jmsg, "message", 
-                json_object_new_string("당신의 턴입니다! 3자리 숫자를 추측하세요."));
-            game.players[i].state = PLAYER_TURN;
-        } else {
-            // 대기 중인 플레이어
-            jmsg = create_message(ACTION_WAIT_TURN);
-            json_object_object_add(jmsg, "message", 
-                json_object_new_string("상대방의 턴입니다. 잠시 기다려주세요."));
-            game.players[i].state = PLAYER_WAITING_TURN;
-        }
-        
-        send_to_player(i, jmsg);
-        json_object_put(jmsg);
+    if (cut > 0) {
+        printf("[Server] 인계 전 송수신을 마치지 못한 연결 %d개는 끊습니다 (재접속으로 복귀)\n", cut);
     }
 }
 
-// ──────────────────────────────────────────────────────────
-// 게임 종료 처리
-// ──────────────────────────────────────────────────────────
-void end_game(int winner_id) {
-    game.state = GAME_FINISHED;
+/**
+ * 인계하지 않는 연결에 재접속 안내 (공유 메모리 채널, 게이트웨이 세션, 관전자)
+ * 메인 방 좌석은 여기서 연결 해제(게임 중이면 재접속 대기)로 돌려 두어 새 프로세스는 빈 좌석으로 받고,
+ * 클라이언트는 안내를 받는 즉시 재접속 토큰으로 새 프로세스에 복귀
+ */
+void notify_local_connections_for_handoff(fd_set *master_set) {
+    SharedFrame *notice = frame_reconnect(&(ReconnectMsg){
+        .message = "서버를 재시작합니다. 잠시 후 자동으로 다시 연결합니다.",
+    });
+    if (!notice) return;
     
     for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (!game.players[i].connected) continue;
-        
-        struct json_object *jmsg = create_message(ACTION_GAME_OVER);
-        
-        if (i == winner_id) {
-            json_object_object_add(jmsg, "result", json_object_new_string("victory"));
-            json_object_object_add(jmsg, "message", 
-                json_object_new_string("🎉 축하합니다! 숫자를 맞추셨습니다!"));
-        } else {
-            json_object_object_add(jmsg, "result", json_object_new_string("defeat"));
-            json_object_object_add(jmsg, "message", 
-                json_object_new_string("😢 아쉽네요! 상대방이 먼저 맞췄습니다."));
-        }
-        
-        // 정답 공개
-        json_object_object_add(jmsg, "your_number", 
-            json_object_new_string(game.players[i].secret_number));
-        json_object_object_add(jmsg, "opponent_number", 
-            json_object_new_string(game.players[1-i].secret_number));
-        
-        send_to_player(i, jmsg);
-        json_object_put(jmsg);
+        int fd = game.players[i].sockfd;
+        if (!game.players[i].connected || !(is_shm_connection(fd) || is_gateway_session(fd))) continue;
+        send_frame(fd, notice, OUTBOX_ESSENTIAL);
+        printf("[Server] 플레이어 %d 연결 해제 (인계 대상 아님 - 재접속 안내)\n", i);
+        close_connection(fd);  // 안내는 닫기 전에 전송
+        FD_CLR(fd, master_set);
+        game.players[i].sockfd = -1;
+        game_player_leave(&game, i);
     }
-    
-    printf("[Server] 게임 종료! 플레이어 %d 승리\n", winner_id);
-    
-    // 5초 후 게임 상태를 대기 상태로 초기화
-    printf("[Server] 5초 후 새 게임 준비...\n");
-    sleep(5);
-    
-    // 게임 상태 초기화 (플레이어 연결은 유지)
-    game.state = GAME_WAITING;
-    game.current_turn = 0;
-    
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (game.players[i].connected) {
-            game.players[i].state = PLAYER_WAITING;
-            memset(game.players[i].secret_number, 0, 4);
-            game.players[i].attempts = 0;
-            game.players[i].is_winner = 0;
-        }
+    for (int fd = 0; fd < FD_SETSIZE; fd++) {
+        if (is_shm_connection(fd) || is_gateway_session(fd)) send_frame(fd, notice, OUTBOX_ESSENTIAL);
     }
     
-    printf("[Server] 새 게임 준비 완료 - 플레이어들이 새 게임을 시작할 수 있습니다!\n");
+    // 관전자 연결은 넘기지 않으므로 안내만 한 번 시도 (쓰기 가능한 만큼)
+    spectator_publish(&spectators, notice, OUTBOX_ESSENTIAL);
+    fd_set read_set, write_set;
+    int max_fd = -1;
+    FD_ZERO(&read_set);
+    FD_ZERO(&write_set);
+    spectator_fill_fdsets(&spectators, &read_set, &write_set, &max_fd);
+    FD_ZERO(&read_set);
+    spectator_handle_io(&spectators, &read_set, &write_set);
+    frame_unref(notice);
 }
 
-// ──────────────────────────────────────────────────────────
-// 새로운 연결 처리
-// ──────────────────────────────────────────────────────────
-void handle_new_connection(int listen_fd) {
-    struct sockaddr_in cli_addr;
-    socklen_t cli_len = sizeof(cli_addr);
-    int conn_fd = accept(listen_fd, (struct sockaddr *)&cli_addr, &cli_len);
+/**
+ * 새 프로세스에 소켓과 방 상태 인계 (TCP 리스닝 소켓, 메인 방의 TCP 연결, 재접속 대기 연결)
+ * 공유 메모리 채널, 게이트웨이 세션, 관전자는 넘기지 않고 재접속을 안내 (토너먼트 모드는 인계 불가)
+ * 인계 중에는 저널을 닫아 두 프로세스가 동시에 기록하지 않도록 함
+ * 
+ * @return: 인계 성공 시 0 (호출자는 종료), 실패 시 -1 (계속 서비스)
+ */
+int perform_handoff(int ctl_fd, int listen_fd, int watch_fd, const char *journal_path, fd_set *master_set) {
+    printf("[Server] 새 프로세스의 인계 요청 - 소켓과 방 상태를 넘깁니다\n");
+    notify_local_connections_for_handoff(master_set);
+    drain_connections_for_handoff();  // 큐에 남은 메시지는 소켓을 넘기기 전에 모두 전송
     
-    if (conn_fd < 0) {
-        perror("accept");
-        return;
+    int extra_fds[MAX_PENDING_CONNECTIONS];
+    int extra_count = 0;
+    for (int i = 0; i < MAX_PENDING_CONNECTIONS; i++) {
+        int fd = pending_fds[i];
+        if (fd >= 0 && !is_shm_connection(fd) && !is_gateway_session(fd)) extra_fds[extra_count++] = fd;
     }
     
-    // 빈 슬롯 찾기
-    int player_id = -1;
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (!game.players[i].connected) {
-            player_id = i;
-            break;
-        }
+    // 공유 메모리 매핑은 넘기지 않음: 안내를 보낸 채널을 닫힘으로 표시 (클라이언트는 링을 비운 뒤 재접속)
+    for (int fd = 0; fd < FD_SETSIZE; fd++) shm_channel_shutdown(&shm_conns[fd]);
+    // 게이트웨이 세션도 같은 방식: 링크는 이 프로세스가 끝나면 끊기고 게이트웨이가 새 프로세스에 다시 연결
+    for (int fd = 0; fd < FD_SETSIZE; fd++) {
+        if (gw_sessions[fd]) gw_session_shutdown(gw_sessions[fd]);
     }
-    
-    if (player_id < 0) {
-        // 현재 게임이 진행 중이라면 정중하게 알림
-        if (game.state == GAME_PLAYING || game.state == GAME_SETTING) {
-            struct json_object *jerr = create_error("현재 게임이 진행 중입니다. 잠시 후 다시 시도해주세요.");
-            send_json(conn_fd, jerr);
-            json_object_put(jerr);
-            printf("[Server] 게임 진행 중 - 새 플레이어 연결 거부 (IP: %s)\n", 
-                   inet_ntoa(cli_addr.sin_addr));
-        } else {
-            struct json_object *jerr = create_error("서버에 접속할 수 없습니다. 나중에 다시 시도해주세요.");
-            send_json(conn_fd, jerr);
-            json_object_put(jerr);
-            printf("[Server] 서버 용량 초과 - 연결 거부 (IP: %s)\n", 
-                   inet_ntoa(cli_addr.sin_addr));
-        }
-        close(conn_fd);
-        return;
+    gateway_flush_links();
+    journal_close(&journal);
+    if (handoff_send(ctl_fd, &game, listen_fd, watch_fd, extra_fds, extra_count) == 0) {
+        return 0;
     }
     
-    // 플레이어 등록
-    game.players[player_id].sockfd = conn_fd;
-    game.players[player_id].connected = 1;
-    game.players[player_id].state = PLAYER_WAITING;
-    game.players_ready++;
-    
-    // 플레이어 ID 할당 메시지
-    struct json_object *jmsg = create_message(ACTION_ASSIGN_ID);
-    json_object_object_add(jmsg, "player_id", json_object_new_int(player_id));
-    send_to_player(player_id, jmsg);
-    json_object_put(jmsg);
-    
-    printf("[Server] 플레이어 %d 연결됨 (IP: %s)\n", 
-           player_id, inet_ntoa(cli_addr.sin_addr));
-    
-    if (game.players_ready == 2) {
-        start_game();
-    } else {
-        // 상대방 대기 중 메시지
-        struct json_object *wait_msg = create_message(ACTION_WAIT_PLAYER);
-        json_object_object_add(wait_msg, "message", 
-            json_object_new_string("상대방을 기다리고 있습니다..."));
-        send_to_player(player_id, wait_msg);
-        json_object_put(wait_msg);
+    // 인계 실패: 저널을 다시 열고 계속 서비스
+    if (journal_path && journal_open(&journal, journal_path) < 0) {
+        printf("[Server] 저널을 다시 열 수 없습니다 - 저널 없이 계속합니다\n");
     }
+    return -1;
 }
 
 // ──────────────────────────────────────────────────────────
-// 클라이언트 메시지 처리
+// 메인 함수
 // ──────────────────────────────────────────────────────────
-void handle_client_message(int player_id, fd_set *master_set) {
-    struct json_object *jmsg = recv_json(game.players[player_id].sockfd);
+int main(int argc, char *argv[]) {
+    const char *journal_path = NULL;
+    const char *handoff_path = NULL;
+    const char *leaderboard_path = NULL;
+    const char *roster_path = NULL;
+    const char *unix_path = NULL;
+    const char *shm_path = NULL;
+    char *snapshot_path = NULL;
+    unsigned snapshot_interval_ms = SNAPSHOT_INTERVAL_MS;
+    int watch_port = 0;
+    int gateway_port = 0;
+    int room_players = DEFAULT_ROOM_PLAYERS;
+    unsigned rate_per_sec = RATE_LIMIT_PER_SEC;
+    unsigned rate_burst = RATE_LIMIT_BURST;
+    int backlog = DEFAULT_LISTEN_BACKLOG;
+    int opt_ch;
     
-    if (!jmsg) {
-        // 연결 종료
-        printf("[Server] 플레이어 %d 연결 해제\n", player_id);
-        close(game.players[player_id].sockfd);
-        FD_CLR(game.players[player_id].sockfd, master_set);
-        game.players[player_id].connected = 0;
-        game.players_ready--;
-        
-        // 게임 중이었다면 상대방에게 승리 메시지
-        if (game.state == GAME_PLAYING || game.state == GAME_SETTING) {
-            int other_player = 1 - player_id;
-            if (game.players[other_player].connected) {
-                struct json_object *win_msg = create_message(ACTION_GAME_OVER);
-                json_object_object_add(win_msg, "result", json_object_new_string("victory"));
-                json_object_object_add(win_msg, "message", 
-                    json_object_new_string("🎉 상대방이 나갔습니다. 당신의 승리!"));
-                send_to_player(other_player, win_msg);
-                json_object_put(win_msg);
+    // 옵션 파싱: -j <저널 파일>, -H <인계 제어 소켓>, -L <리더보드 파일>, -w <관전 포트>, -T <토너먼트 명단>,
+    //           -P <방 정원>, -R <초당 메시지>[:<버스트>] (0이면 속도 제한 끔), -B <listen 대기열 길이>,
+    //           -U <AF_UNIX 소켓 경로>, -M <공유 메모리 접속 소켓 경로>, -G <게이트웨이 링크 포트>,
+    //           -S <스냅샷 파일>[:<주기 밀리초>]
+    while ((opt_ch = getopt(argc, argv, "j:H:L:w:T:P:R:B:U:M:G:S:")) != -1) {
+        switch (opt_ch) {
+            case 'j':
+                journal_path = optarg;
+                break;
+            case 'H':
+                handoff_path = optarg;
+                break;
+            case 'L':
+                leaderboard_path = optarg;
+                break;
+            case 'w':
+                watch_port = atoi(optarg);
+                break;
+            case 'T':
+                roster_path = optarg;
+                break;
+            case 'P':
+                room_players = atoi(optarg);
+                if (room_players < 2 || room_players > MAX_CLIENTS) {
+                    printf("[Server] 방 정원은 2~%d명이어야 합니다.\n", MAX_CLIENTS);
+                    return 1;
+                }
+                break;
+            case 'R':
+                rate_burst = 0;
+                if (sscanf(optarg, "%u:%u", &rate_per_sec, &rate_burst) < 1) {
+                    printf("[Server] 속도 제한 형식: -R <초당 메시지>[:<버스트>]\n");
+                    return 1;
+                }
+                if (rate_burst == 0) rate_burst = 2 * rate_per_sec;
+                break;
+            case 'B':
+                backlog = atoi(optarg);
+                if (backlog <= 0) {
+                    printf("[Server] listen 대기열 길이는 1 이상이어야 합니다.\n");
+                    return 1;
+                }
+                break;
+            case 'U':
+                unix_path = optarg;
+                break;
+            case 'M':
+                shm_path = optarg;
+                break;
+            case 'G':
+                gateway_port = atoi(optarg);
+                break;
+            case 'S': {
+                snapshot_path = optarg;
+                char *colon = strrchr(optarg, ':');
+                if (colon && colon[1] >= '0' && colon[1] <= '9') {
+                    *colon = '\0';
+                    snapshot_interval_ms = (unsigned)atoi(colon + 1);
+                }
+                if (snapshot_interval_ms == 0 || !snapshot_path[0]) {
+                    printf("[Server] 스냅샷 형식: -S <파일>[:<주기 밀리초>]\n");
+                    return 1;
+                }
+                break;
             }
+            default:
+                printf("사용법: %s [-j 저널파일] [-H 인계소켓] [-L 리더보드파일] [-w 관전포트] [-T 명단파일] [-P 방정원] [-R 초당메시지[:버스트]] [-B 대기열] [-U 유닉스소켓] [-M 공유메모리소켓] [-G 게이트웨이포트] [-S 스냅샷파일[:주기ms]] <포트>\n", argv[0]);
+                return 1;
         }
-        return;
     }
     
-    // action 필드 확인
-    struct json_object *jact = NULL;
-    if (!json_object_object_get_ex(jmsg, "action", &jact)) {
-        json_object_put(jmsg);
-        return;
+    if (optind != argc - 1) {
+        printf("사용법: %s [-j 저널파일] [-H 인계소켓] [-L 리더보드파일] [-w 관전포트] [-T 명단파일] [-P 방정원] [-R 초당메시지[:버스트]] [-B 대기열] [-U 유닉스소켓] [-M 공유메모리소켓] [-G 게이트웨이포트] [-S 스냅샷파일[:주기ms]] <포트>\n", argv[0]);
+        return 1;
     }
     
-    const char *action = json_object_get_string(jact);
+    int port = atoi(argv[optind]);
     
-    // 숫자 설정 처리
-    if (strcmp(action, ACTION_SET_NUMBER) == 0) {
-        if (game.players[player_id].state != PLAYER_SETTING) {
-            struct json_object *jerr = create_error("지금은 숫자를 설정할 수 없습니다.");
-            send_to_player(player_id, jerr);
-            json_object_put(jerr);
-            json_object_put(jmsg);
-            return;
+    // 토너먼트의 여러 경기 방은 인계 대상이 아님 (인계는 일반 대전 방 하나만 지원)
+    if (roster_path && handoff_path) {
+        printf("[Server] 토너먼트 모드(-T)는 무중단 재시작(-H)과 함께 사용할 수 없습니다.\n");
+        return 1;
+    }
+    
+    // 게임 초기화
+    update_loop_clock();
+    init_game();
+    ratelimit_init(&ratelimit, rate_per_sec, rate_burst);
+    for (int i = 0; i < GWLINK_MAX_LINKS; i++) gwlink_reset(&gw_links[i], -1);
+    memset(gw_slot_fd, 0xff, sizeof(gw_slot_fd));  // 모두 -1 (세션 없음)
+    game.capacity = room_players;  // 무중단 재시작으로 인수하면 이전 프로세스의 정원을 따름
+    if (roster_path) {
+        if (tournament_load_roster(&tournament, roster_path) < 0) return 1;
+        tournament_setup();
+    }
+    
+    // fd 한도: 플레이어 + 재접속 대기 + 관전자 + 토너먼트 참가자 + 고정 fd 여유분
+    rlim_t fds_needed = RESERVED_FDS + MAX_CLIENTS + MAX_PENDING_CONNECTIONS;
+    if (watch_port > 0) fds_needed += MAX_SPECTATORS;
+    if (roster_path) fds_needed += tournament.entrant_count;
+    if (shm_path) fds_needed += 2 * (fds_needed - RESERVED_FDS);  // 공유 메모리 연결은 eventfd 2개 + 접속 소켓
+    if (gateway_port > 0) fds_needed += GWLINK_MAX_LINKS;          // 게이트웨이 세션은 연결처럼 eventfd 1개
+    raise_fd_limit(fds_needed);
+    reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    
+    // 연결 레코드, 송신 버퍼, 반복 단위 아레나를 미리 할당 (게임 진행 중에는 재사용만)
+    if (pool_init(&conn_pool, "연결 레코드", sizeof(Outbox), fds_needed) < 0 ||
+        pool_init(&inbox_pool, "수신 버퍼", sizeof(Inbox), fds_needed) < 0 ||
+        frame_pools_init(fds_needed) < 0 ||
+        arena_init(&loop_arena, LOOP_ARENA_SIZE) < 0 ||
+        (gateway_port > 0 &&
+         pool_init(&gw_session_pool, "게이트웨이 세션", sizeof(GwSession), fds_needed - RESERVED_FDS) < 0)) {
+        printf("[Server] 메모리 풀을 준비할 수 없습니다\n");
+        return 1;
+    }
+    
+    // 실행 중인 이전 프로세스가 있으면 소켓과 방 상태 인수
+    int listen_fd = -1;
+    int watch_fd = -1;
+    int taken_over = 0;
+    if (handoff_path) {
+        int extra_count = 0;
+        taken_over = handoff_receive(handoff_path, &game, &listen_fd, &watch_fd,
+                                     pending_fds, MAX_PENDING_CONNECTIONS, &extra_count);
+        if (taken_over < 0) return 1;
+        if (taken_over) update_loop_clock();  // 이전 프로세스의 게임 시계 기준점으로 다시 읽기
+        if (taken_over && listen_fd >= 0) set_nonblocking(listen_fd, 1);  // 이전 버전이 넘긴 소켓일 수 있음
+        if (taken_over && watch_fd >= 0) set_nonblocking(watch_fd, 1);
+        for (int i = 0; taken_over && i < MAX_CLIENTS; i++) {
+            if (!game.players[i].connected) continue;
+            set_nonblocking(game.players[i].sockfd, 1);  // 블로킹으로 수신하던 이전 버전이 넘긴 연결일 수 있음
+            heartbeat_track(&heartbeats, game.players[i].sockfd, clock_now_ms());
         }
-        
-        struct json_object *jnum = NULL;
-        if (json_object_object_get_ex(jmsg, "number", &jnum)) {
-            const char *number = json_object_get_string(jnum);
-            
-            if (is_valid_number(number)) {
-                strcpy(game.players[player_id].secret_number, number);
-                game.players[player_id].state = PLAYER_READY;
-                
-                struct json_object *jresp = create_message(ACTION_NUMBER_SET);
-                json_object_object_add(jresp, "message", 
-                    json_object_new_string("숫자가 설정되었습니다. 상대방을 기다리는 중..."));
-                send_to_player(player_id, jresp);
-                json_object_put(jresp);
-                
-                printf("[Server] 플레이어 %d가 숫자를 설정했습니다.\n", player_id);
-                check_all_numbers_set();
-            } else {
-                struct json_object *jerr = create_error("올바르지 않은 숫자입니다. 3자리 서로 다른 숫자를 입력하세요.");
-                send_to_player(player_id, jerr);
-                json_object_put(jerr);
-            }
+        for (int i = 0; taken_over && i < MAX_PENDING_CONNECTIONS; i++) {
+            if (pending_fds[i] < 0) continue;
+            set_nonblocking(pending_fds[i], 1);
+            heartbeat_track(&heartbeats, pending_fds[i], clock_now_ms());
         }
     }
-    // 추측 처리
-    else if (strcmp(action, ACTION_GUESS) == 0) {
-        if (game.players[player_id].state != PLAYER_TURN) {
-            struct json_object *jerr = create_error("지금은 당신의 턴이 아닙니다.");
-            send_to_player(player_id, jerr);
-            json_object_put(jerr);
-            json_object_put(jmsg);
-            return;
+    
+    // 경기 저널 열기 (기존 저널이면 경기 번호를 이어서 사용)
+    if (journal_path) {
+        if (journal_open(&journal, journal_path) < 0) {
+            return 1;
         }
-        
-        struct json_object *jguess = NULL;
-        if (json_object_object_get_ex(jmsg, "guess", &jguess)) {
-            const char *guess = json_object_get_string(jguess);
-            
-            if (is_valid_number(guess)) {
-                int opponent_id = 1 - player_id;
-                GuessResult result = calculate_result(
-                    game.players[opponent_id].secret_number, guess);
-                
-                game.players[player_id].attempts++;
-                
-                // 결과 메시지 생성
-                struct json_object *jresult = create_message(ACTION_GUESS_RESULT);
-                json_object_object_add(jresult, "guess", json_object_new_string(guess));
-                json_object_object_add(jresult, "strikes", json_object_new_int(result.strikes));
-                json_object_object_add(jresult, "balls", json_object_new_int(result.balls));
-                json_object_object_add(jresult, "attempts", json_object_new_int(game.players[player_id].attempts));
-                json_object_object_add(jresult, "current_player", json_object_new_int(player_id));
-                
-                // 양쪽 플레이어에게 결과 전송
-                broadcast_to_all(jresult);
-                json_object_put(jresult);
-                
-                printf("[Server] 플레이어 %d 추측: %s -> %dS %dB\n", 
-                       player_id, guess, result.strikes, result.balls);
-                
-                if (result.is_correct) {
-                    // 게임 종료
-                    end_game(player_id);
-                } else {
-                    // 턴 변경
-                    game.current_turn = 1 - game.current_turn;
-                    start_turn();
-                }
-            } else {
-                struct json_object *jerr = create_error("올바르지 않은 숫자입니다. 3자리 서로 다른 숫자를 입력하세요.");
-                send_to_player(player_id, jerr);
-                json_object_put(jerr);
-            }
+        if (taken_over) {
+            // 인수한 방은 계속 진행 - 리플레이가 방 상태를 초기화하지 않도록 별도 표시
+            journal_event(&game, JOURNAL_HANDOFF, 0, NULL, NULL);
+        } else {
+            game.match_id = journal_last_match_id(&journal);
+            journal_event(&game, JOURNAL_SERVER_START, 0, NULL, NULL);
         }
     }
     
-    json_object_put(jmsg);
-}
-
-// ──────────────────────────────────────────────────────────
-// 메인 함수
-// ──────────────────────────────────────────────────────────
-int main(int argc, char *argv[]) {
-    if (argc != 2) {
-        printf("사용법: %s <포트>\n", argv[0]);
-        return 1;
+    // 비정상 종료 전의 방 복원 (인수한 경우는 이전 프로세스의 현재 상태가 더 최신)
+    if (snapshot_path) {
+        if (!taken_over) restore_snapshot(snapshot_path, room_players);
+        snapshot_init(&snapshotter, snapshot_path, snapshot_interval_ms, clock_now_ms());
+        printf("[Server] %ums마다 방 상태 스냅샷을 %s에 기록합니다.\n", snapshot_interval_ms, snapshot_path);
     }
     
-    int port = atoi(argv[1]);
-    
-    // 게임 초기화
-    init_game();
-    
-    // 소켓 생성
-    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (listen_fd < 0) {
-        perror("socket");
+    // 리더보드 열기 (인계 중에도 같은 파일을 MAP_SHARED로 공유하므로 그대로 이어짐)
+    if (leaderboard_path && leaderboard_open(&leaderboard, leaderboard_path) < 0) {
         return 1;
     }
     
-    int opt = 1;
-    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    // 다음 재시작을 위한 인계 제어 소켓
+    int ctl_fd = -1;
+    if (handoff_path) {
+        ctl_fd = handoff_listen(handoff_path);
+        if (ctl_fd < 0) return 1;
+    }
     
-    struct sockaddr_in serv_addr;
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    serv_addr.sin_addr.s_addr = INADDR_ANY;
-    serv_addr.sin_port = htons(port);
+    if (!taken_over) {
+        listen_fd = create_listen_socket(port, backlog, 0);
+        if (listen_fd < 0) return 1;
+        printf("[Server] 숫자 야구 서버가 포트 %d에서 시작되었습니다.\n", port);
+        if (tournament_mode) {
+            printf("[Server] 토너먼트 참가자 %d명의 체크인을 기다리는 중...\n", tournament.entrant_count);
+        } else {
+            printf("[Server] 플레이어 %d명을 기다리는 중...\n", game.capacity);
+        }
+    } else {
+        printf("[Server] 무중단 재시작 완료 - 진행 중인 게임을 이어서 서비스합니다.\n");
+    }
     
-    if (bind(listen_fd, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
-        perror("bind");
-        return 1;
+    // 관전 포트 (인수한 소켓이 있으면 그대로 사용)
+    if (watch_port > 0 && watch_fd < 0) {
+        watch_fd = create_listen_socket(watch_port, backlog, 0);
+        if (watch_fd < 0) return 1;
+        printf("[Server] 관전 포트 %d에서 관전자를 받습니다.\n", watch_port);
+    } else if (watch_port == 0 && watch_fd >= 0) {
+        close(watch_fd);
+        watch_fd = -1;
     }
     
-    if (listen(listen_fd, MAX_CLIENTS) < 0) {
-        perror("listen");
-        return 1;
+    // 같은 호스트 클라이언트용 AF_UNIX / 공유 메모리 접속 소켓 (인계 대상이 아니므로 시작할 때마다 새로 만듦)
+    int unix_fd = -1;
+    if (unix_path) {
+        unix_fd = create_unix_listen_socket(unix_path, backlog);
+        if (unix_fd < 0) return 1;
+        printf("[Server] AF_UNIX 소켓 %s에서 로컬 클라이언트를 받습니다.\n", unix_path);
+    }
+    if (shm_path) {
+        shm_listen_fd = create_unix_listen_socket(shm_path, backlog);
+        if (shm_listen_fd < 0) return 1;
+        printf("[Server] 공유 메모리 접속 소켓 %s에서 로컬 클라이언트를 받습니다 (방향별 링 %d바이트).\n",
+               shm_path, SHM_RING_SIZE);
     }
     
-    printf("[Server] 숫자 야구 서버가 포트 %d에서 시작되었습니다.\n", port);
-    printf("[Server] 플레이어 2명을 기다리는 중...\n");
+    // 게이트웨이 링크 포트 (인계 대상이 아님 - 이전 프로세스가 아직 잡고 있어도 바인딩되도록 SO_REUSEPORT)
+    if (gateway_port > 0) {
+        gw_listen_fd = create_listen_socket(gateway_port, backlog, 1);
+        if (gw_listen_fd < 0) return 1;
+        printf("[Server] 게이트웨이 포트 %d에서 게이트웨이 링크를 받습니다 (최대 %d개).\n",
+               gateway_port, GWLINK_MAX_LINKS);
+    }
     
-    // select() 설정
-    fd_set master_set, read_set;
-    int max_fd = listen_fd;
+    // select() 설정 (인수한 클라이언트 소켓 포함)
+    fd_set master_set, read_set, write_set;
+    int max_fd = -1;
     FD_ZERO(&master_set);
-    FD_SET(listen_fd, &master_set);
+    track_fd(listen_fd, &master_set, &max_fd);
+    track_fd(ctl_fd, &master_set, &max_fd);
+    track_fd(watch_fd, &master_set, &max_fd);
+    track_fd(unix_fd, &master_set, &max_fd);
+    track_fd(shm_listen_fd, &master_set, &max_fd);
+    track_fd(gw_listen_fd, &master_set, &max_fd);
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (game.players[i].connected) track_fd(game.players[i].sockfd, &master_set, &max_fd);
+    }
+    for (int i = 0; i < MAX_PENDING_CONNECTIONS; i++) {
+        track_fd(pending_fds[i], &master_set, &max_fd);
+    }
     
     // 메인 루프
+    int handed_off = 0;
     while (1) {
         read_set = master_set;
+        FD_ZERO(&write_set);
+        
+        // 관전자는 매 반복 감시 집합을 다시 구성 (미전송 메시지가 있을 때만 쓰기 감시)
+        int select_max_fd = max_fd;
+        spectator_fill_fdsets(&spectators, &read_set, &write_set, &select_max_fd);
+        
+        // 송신 큐에 밀린 메시지가 있는 클라이언트만 쓰기 감시
+        // (공유 메모리 연결은 shm_service(), 게이트웨이 세션은 gateway_service()에서 재시도)
+        for (int fd = 0; fd <= max_fd; fd++) {
+            if (outboxes[fd] && outbox_pending(outboxes[fd]) && !outboxes[fd]->shm && !outboxes[fd]->gw &&
+                FD_ISSET(fd, &master_set)) {
+                FD_SET(fd, &write_set);
+            }
+        }
+        for (int i = 0; i < GWLINK_MAX_LINKS; i++) {
+            if (gw_links[i].fd >= 0 && gwlink_pending(&gw_links[i])) FD_SET(gw_links[i].fd, &write_set);
+        }
         
-        int activity = select(max_fd + 1, &read_set, NULL, NULL, NULL);
+        // 저널 flush 주기마다 깨어나도록 select 타임아웃 설정
+        struct timeval tv = { 0, JOURNAL_FLUSH_INTERVAL_MS * 1000 };
+        int activity = select(select_max_fd + 1, &read_set, &write_set, NULL, &tv);
         if (activity < 0 && errno != EINTR) {
             perror("select");
             break;
         }
         
+        // 반복마다 시각을 한 번 읽고 시간 경과 처리를 메시지보다 먼저 수행
+        update_loop_clock();
+        arena_reset(&loop_arena);
+        game_tick(&game);
+        check_player_timeouts(&game);
+        if (tournament_mode) tournament_tick();
+        admit_pending_connections(&master_set);
+        if (shm_listen_fd >= 0) shm_service(max_fd, &master_set);
+        if (gw_listen_fd >= 0) gateway_service(max_fd);
+        send_idle_heartbeats();
+        if (clock_now_ms() - last_rate_report_ms >= RATE_LIMIT_REPORT_MS) {
+            ratelimit_report(&ratelimit, 0);  // 지난 출력 이후 버린 메시지가 있을 때만
+            outbox_report(0);                 // 지난 출력 이후 느린 소비자/합치기/버림이 있을 때만
+            inbox_report(0);                  // 지난 출력 이후 프레임 중간에서 멈춘 읽기가 있을 때만
+            alloc_report(0);                  // 지난 출력 이후 처리한 메시지가 있을 때만
+            snapshot_report(&snapshotter, 0); // 지난 출력 이후 새 스냅샷이 있을 때만
+            heartbeat_report(&heartbeats, 0); // 지난 출력 이후 보낸 하트비트가 있을 때만
+            last_rate_report_ms = clock_now_ms();
+        }
+        if (activity <= 0) {
+            outbox_flush_dirty();  // 시간 경과 처리(재접속 만료 등)에서 생긴 메시지
+            if (gw_listen_fd >= 0) gateway_publish_status();
+            gateway_flush_links();
+            journal_flush_if_due(&journal, clock_now_ms());
+            snapshot_service();
+            continue;
+        }
+        
+        // 관전자 소켓: 밀린 메시지 전송, 연결 종료 감지
+        spectator_handle_io(&spectators, &read_set, &write_set);
+        
+        // 클라이언트 송신 큐: 쓰기 가능해진 소켓에 밀린 메시지 전송 (오류는 다음 수신에서 정리)
+        for (int fd = 0; fd <= max_fd; fd++) {
+            if (!FD_ISSET(fd, &write_set) || !outboxes[fd] || !outbox_pending(outboxes[fd])) continue;
+            if (outbox_flush(outboxes[fd], fd) < 0) {
+                outbox_clear(outboxes[fd]);
+                shutdown_connection(fd);
+            }
+        }
+        gateway_flush_links();  // 쓰기 가능해진 게이트웨이 링크에 밀린 레코드 전송
+        
         // 읽기 가능한 fd 확인
         for (int fd = 0; fd <= max_fd; fd++) {
             if (!FD_ISSET(fd, &read_set)) continue;
+            int is_listener = (fd == listen_fd || fd == unix_fd);
+            int accept_fd = fd;
+            if (gateway_link_index(fd) >= 0) {
+                // 게이트웨이 링크: 레코드를 세션별로 나누고, 새로 열린 세션은 리스닝 소켓처럼 입장 처리
+                if (gateway_link_receive(fd, &master_set) == 0) continue;
+                is_listener = 1;
+            }
+            if (fd == shm_listen_fd) {
+                // 공유 메모리 접속: 접속 소켓만 받아 두고 fd 전달은 읽기 가능해질 때 처리 (루프를 막지 않음)
+                shm_accept_handshakes(fd, &master_set, &max_fd);
+                continue;
+            }
+            if (is_shm_handshake(fd)) {
+                if (!shm_finish_handshake(fd, &master_set)) continue;
+                is_listener = 1;
+                accept_fd = shm_listen_fd;
+            }
             
-            if (fd == listen_fd) {
-                // 새로운 연결
-                handle_new_connection(listen_fd);
+            if (is_listener && tournament_mode) {
+                // 토너먼트 참가자 연결 (체크인 로비로)
+                tournament_accept(accept_fd, &master_set, &max_fd);
+            } else if (is_listener) {
+                // 새로운 연결 (TCP, AF_UNIX, 공유 메모리, 게이트웨이 세션)
+                handle_new_connection(accept_fd);
                 
                 // 새로 열린 소켓을 master_set에 추가
                 for (int i = 0; i < MAX_CLIENTS; i++) {
                     if (game.players[i].connected) {
-                        FD_SET(game.players[i].sockfd, &master_set);
-                        if (game.players[i].sockfd > max_fd) {
-                            max_fd = game.players[i].sockfd;
-                        }
+                        track_fd(game.players[i].sockfd, &master_set, &max_fd);
                     }
                 }
+                for (int i = 0; i < MAX_PENDING_CONNECTIONS; i++) {
+                    track_fd(pending_fds[i], &master_set, &max_fd);
+                }
+            } else if (fd == gw_listen_fd) {
+                // 새 게이트웨이 링크
+                handle_gateway_link(gw_listen_fd, &master_set, &max_fd);
+            } else if (fd == watch_fd) {
+                // 새로운 관전자
+                handle_spectator_connection(watch_fd);
+            } else if (fd == ctl_fd) {
+                // 새 프로세스의 인계 요청: 성공하면 이 프로세스는 종료
+                if (perform_handoff(ctl_fd, listen_fd, watch_fd, journal_path, &master_set) == 0) {
+                    printf("[Server] 인계 완료 - 이전 프로세스를 종료합니다\n");
+                    handed_off = 1;
+                    break;
+                }
+            } else if (tournament_mode && tournament_handle_fd(fd, &master_set)) {
+                // 토너먼트 로비/경기 방 메시지 (fd → 방 O(1) 조회)
             } else {
                 // 기존 클라이언트 메시지 처리
                 int player_id = -1;
@@ -735,12 +2597,52 @@ int main(int argc, char *argv[]) {
                 }
                 
                 if (player_id >= 0) {
-                    handle_client_message(player_id, &master_set);
+                    handle_client_message(&game, player_id, &master_set);
+                } else {
+                    int idx = find_pending_connection(fd);
+                    if (idx >= 0) handle_pending_message(idx, &master_set);
                 }
             }
         }
+        
+        if (handed_off) break;
+        if (tournament_mode && tour_finished_count > 0) tournament_settle();
+        
+        // 이번 반복에 쌓인 메시지를 연결마다 시스템 콜 한 번으로 전송 (추측 결과 + 턴 알림 등)
+        outbox_flush_dirty();
+        if (gw_listen_fd >= 0) gateway_publish_status();
+        gateway_flush_links();  // 세션들의 메시지를 링크마다 send() 한 번으로
+        journal_flush_if_due(&journal, clock_now_ms());
+        snapshot_service();     // 이번 반복의 상태와 저널 위치가 맞아떨어지는 지점에서 fork
     }
     
+    // 인계 후에는 소켓이 새 프로세스에 있으므로 닫기만 하고 제어 소켓 파일은 유지
+    journal_close(&journal);
+    leaderboard_close(&leaderboard);
+    spectator_close_all(&spectators);
+    ratelimit_report(&ratelimit, 1);
+    outbox_report(1);
+    inbox_report(1);
+    alloc_report(1);
+    snapshot_report(&snapshotter, 1);
+    heartbeat_report(&heartbeats, 1);
+    pool_report(&conn_pool);
+    pool_report(&inbox_pool);
+    if (tournament_mode) pool_report(&room_pool);
+    if (gw_listen_fd >= 0) pool_report(&gw_session_pool);
+    frame_pools_report();
     close(listen_fd);
+    if (watch_fd >= 0) close(watch_fd);
+    if (ctl_fd >= 0) close(ctl_fd);
+    if (unix_fd >= 0) close(unix_fd);
+    if (shm_listen_fd >= 0) close(shm_listen_fd);
+    if (gw_listen_fd >= 0) close(gw_listen_fd);
+    for (int i = 0; i < GWLINK_MAX_LINKS; i++) {
+        if (gw_links[i].fd >= 0) close(gw_links[i].fd);
+    }
+    if (reserve_fd >= 0) close(reserve_fd);
+    if (handoff_path && !handed_off) unlink(handoff_path);
+    if (unix_path && !handed_off) unlink(unix_path);  // 인계 후에는 새 프로세스가 같은 경로를 사용
+    if (shm_path && !handed_off) unlink(shm_path);
     return 0;
 } 
\ No newline at end of file
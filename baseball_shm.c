@@ -0,0 +1,303 @@
+/**
+ * baseball_shm.c - 공유 메모리 링 전송 구현
+ *
+ * 📋 동작 방식:
+ * - 방향마다 단일 생산자/단일 소비자 링: 생산자는 head만, 소비자는 tail만 씀 (잠금 없음)
+ * - 생산자는 프레임을 다 복사한 뒤 head를 release로 전진, 소비자는 acquire로 읽으므로
+ *   소비자는 항상 완전한 프레임만 봄 (소켓처럼 길이와 본문을 나눠 기다릴 필요 없음)
+ * - 깨우기: 생산자는 쓰기 호출마다 eventfd에 한 번 쓰고, 소비자는 읽기 전에 카운터를 비운 뒤
+ *   링에 프레임이 남아 있으면 다시 올림 → select()에는 소켓처럼 "읽을 것이 남아 있는 동안 읽기 가능"으로 보임
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/eventfd.h>
+
+#include "baseball_shm.h"
+#include "baseball_protocol.h"
+
+#define SHM_ATTACH_FDS  3       // 공유 영역, 클라이언트→서버 eventfd, 서버→클라이언트 eventfd
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 링의 pos 위치부터 n바이트 복사 (끝에서 처음으로 넘어가는 경우 두 번에 나눠 복사)
+ */
+static void ring_copy_in(ShmRing *r, uint32_t pos, const void *src, size_t n) {
+    size_t off = pos & (SHM_RING_SIZE - 1);
+    size_t first = n < SHM_RING_SIZE - off ? n : SHM_RING_SIZE - off;
+    memcpy(r->data + off, src, first);
+    memcpy(r->data, (const char *)src + first, n - first);
+}
+
+static void ring_copy_out(const ShmRing *r, uint32_t pos, void *dst, size_t n) {
+    size_t off = pos & (SHM_RING_SIZE - 1);
+    size_t first = n < SHM_RING_SIZE - off ? n : SHM_RING_SIZE - off;
+    memcpy(dst, r->data + off, first);
+    memcpy((char *)dst + first, r->data, n - first);
+}
+
+/**
+ * eventfd 카운터 올리기 / 비우기 (non-blocking - 실패해도 다음 깨우기에서 회복)
+ */
+static void wake(int efd) {
+    uint64_t one = 1;
+    ssize_t n = write(efd, &one, sizeof(one));
+    (void)n;
+}
+
+static void drain_wake(int efd) {
+    uint64_t count;
+    ssize_t n = read(efd, &count, sizeof(count));
+    (void)n;
+}
+
+/**
+ * 접속 소켓 수신 대기 시간 설정
+ */
+static void set_attach_timeout(int fd) {
+    struct timeval tv = { 0, SHM_ATTACH_TIMEOUT_MS * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+static void channel_reset(ShmChannel *ch) {
+    memset(ch, 0, sizeof(*ch));
+    ch->rx_efd = ch->tx_efd = ch->ctl_fd = -1;
+}
+
+// ──────────────────────────────────────────────────────────
+// 접속
+// ──────────────────────────────────────────────────────────
+
+int shm_channel_connect(ShmChannel *ch, const char *path) {
+    channel_reset(ch);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    strcpy(addr.sun_path, path);
+
+    // 1단계: 공유 영역과 eventfd 준비 (memfd는 0으로 채워져 있으므로 head/tail/closed 초기화 불필요)
+    int fds[SHM_ATTACH_FDS] = { -1, -1, -1 };
+    fds[0] = memfd_create("baseball_shm", MFD_CLOEXEC);
+    if (fds[0] < 0 || ftruncate(fds[0], sizeof(ShmRegion)) < 0) goto fail;
+    void *map = mmap(NULL, sizeof(ShmRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    if (map == MAP_FAILED) goto fail;
+    ch->region = map;
+    ch->region->magic = SHM_MAGIC;
+    ch->region->version = SHM_VERSION;
+    fds[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    fds[2] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fds[1] < 0 || fds[2] < 0) goto fail;
+
+    // 2단계: 접속 소켓으로 fd 전달
+    ch->ctl_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (ch->ctl_fd < 0 || connect(ch->ctl_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) goto fail;
+
+    union {
+        char buf[CMSG_SPACE(sizeof(fds))];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+    char hello = 1;
+    struct iovec iov = { .iov_base = &hello, .iov_len = 1 };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    struct cmsghdr *c = CMSG_FIRSTHDR(&msg);
+    c->cmsg_level = SOL_SOCKET;
+    c->cmsg_type = SCM_RIGHTS;
+    c->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(c), fds, sizeof(fds));
+    if (sendmsg(ch->ctl_fd, &msg, 0) != 1) goto fail;
+
+    // 3단계: 서버의 매핑 완료 응답
+    char ack = 0;
+    set_attach_timeout(ch->ctl_fd);
+    if (recv(ch->ctl_fd, &ack, 1, 0) != 1 || ack != 1) goto fail;
+
+    close(fds[0]);  // 매핑은 fd를 닫아도 유지
+    ch->rx = &ch->region->to_client;
+    ch->tx = &ch->region->to_server;
+    ch->rx_efd = fds[2];
+    ch->tx_efd = fds[1];
+    return 0;
+
+fail:
+    for (int i = 0; i < SHM_ATTACH_FDS; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+    shm_channel_close(ch);
+    return -1;
+}
+
+int shm_channel_accept(int listen_fd) {
+    return accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+}
+
+int shm_channel_attach(ShmChannel *ch, int ctl_fd) {
+    channel_reset(ch);
+
+    // 1단계: 1바이트 + fd 3개 수신 (아직 도착하지 않았으면 다음 읽기 가능 이벤트에서 다시)
+    char hello = 0;
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * SHM_ATTACH_FDS)];
+        struct cmsghdr align;
+    } control;
+    struct iovec iov = { .iov_base = &hello, .iov_len = 1 };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    ssize_t n = recvmsg(ctl_fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        errno = EAGAIN;
+        return -1;
+    }
+    ch->ctl_fd = ctl_fd;
+    int fds[SHM_ATTACH_FDS] = { -1, -1, -1 };
+    int fd_count = 0;
+    for (struct cmsghdr *c = CMSG_FIRSTHDR(&msg); n > 0 && c; c = CMSG_NXTHDR(&msg, c)) {
+        if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS) {
+            fd_count = (c->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            if (fd_count > SHM_ATTACH_FDS) fd_count = SHM_ATTACH_FDS;
+            memcpy(fds, CMSG_DATA(c), fd_count * sizeof(int));
+        }
+    }
+
+    // 2단계: 공유 영역 검증 후 매핑
+    struct stat st;
+    if (n != 1 || hello != 1 || fd_count != SHM_ATTACH_FDS || (msg.msg_flags & MSG_CTRUNC) ||
+        fstat(fds[0], &st) < 0 || (size_t)st.st_size < sizeof(ShmRegion)) goto fail;
+    void *map = mmap(NULL, sizeof(ShmRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    if (map == MAP_FAILED) goto fail;
+    ch->region = map;
+    if (ch->region->magic != SHM_MAGIC || ch->region->version != SHM_VERSION) goto fail;
+
+    // 깨우기 카운터를 비울 때 막히지 않도록 (상대가 blocking eventfd를 보냈더라도)
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fds[2], F_SETFL, fcntl(fds[2], F_GETFL, 0) | O_NONBLOCK);
+    close(fds[0]);
+    ch->rx = &ch->region->to_server;
+    ch->tx = &ch->region->to_client;
+    ch->rx_efd = fds[1];
+    ch->tx_efd = fds[2];
+
+    // 3단계: 매핑 완료 응답
+    char ack = 1;
+    if (send(ch->ctl_fd, &ack, 1, MSG_NOSIGNAL) != 1) {
+        shm_channel_close(ch);
+        errno = EPROTO;
+        return -1;
+    }
+    return 0;
+
+fail:
+    for (int i = 0; i < fd_count; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+    shm_channel_close(ch);
+    errno = EPROTO;
+    return -1;
+}
+
+// ──────────────────────────────────────────────────────────
+// 송수신
+// ──────────────────────────────────────────────────────────
+
+ssize_t shm_channel_writev(ShmChannel *ch, const struct iovec *iov, int iovcnt) {
+    ShmRing *r = ch->tx;
+    if (__atomic_load_n(&r->closed, __ATOMIC_ACQUIRE)) {
+        errno = EPIPE;
+        return -1;
+    }
+
+    uint32_t head = __atomic_load_n(&r->head, __ATOMIC_RELAXED);  // 생산자만 씀
+    uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    size_t space = SHM_RING_SIZE - (uint32_t)(head - tail);
+    size_t written = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len > space - written) break;
+        ring_copy_in(r, head + (uint32_t)written, iov[i].iov_base, iov[i].iov_len);
+        written += iov[i].iov_len;
+    }
+    if (written == 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    __atomic_store_n(&r->head, head + (uint32_t)written, __ATOMIC_RELEASE);
+    wake(ch->tx_efd);
+    return (ssize_t)written;
+}
+
+int shm_channel_next_len(ShmChannel *ch) {
+    drain_wake(ch->rx_efd);
+
+    ShmRing *r = ch->rx;
+    uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);  // 소비자만 씀
+    uint32_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    uint32_t used = head - tail;
+    if (used < 2) return __atomic_load_n(&r->closed, __ATOMIC_ACQUIRE) ? -1 : 0;
+
+    uint16_t netlen;
+    ring_copy_out(r, tail, &netlen, sizeof(netlen));
+    int len = ntohs(netlen);
+    if (len <= 0 || len > BUF_SIZE || used < 2 + (uint32_t)len) return -1;
+    return len;
+}
+
+void shm_channel_read(ShmChannel *ch, char *buf, int len) {
+    ShmRing *r = ch->rx;
+    uint32_t tail = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+    ring_copy_out(r, tail + 2, buf, len);
+    tail += 2 + (uint32_t)len;
+    __atomic_store_n(&r->tail, tail, __ATOMIC_RELEASE);
+
+    // 남은 프레임(또는 닫힘)이 있으면 계속 읽기 가능하도록
+    if (__atomic_load_n(&r->head, __ATOMIC_ACQUIRE) != tail ||
+        __atomic_load_n(&r->closed, __ATOMIC_ACQUIRE)) {
+        wake(ch->rx_efd);
+    }
+}
+
+void shm_channel_shutdown(ShmChannel *ch) {
+    if (!ch->region) return;
+    __atomic_store_n(&ch->tx->closed, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&ch->rx->closed, 1, __ATOMIC_RELEASE);
+    wake(ch->tx_efd);
+    wake(ch->rx_efd);
+}
+
+int shm_channel_peer_alive(const ShmChannel *ch) {
+    char c;
+    ssize_t n = recv(ch->ctl_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0) return 0;
+    if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return 0;
+    return 1;
+}
+
+void shm_channel_close(ShmChannel *ch) {
+    if (ch->region) munmap(ch->region, sizeof(ShmRegion));
+    if (ch->rx_efd >= 0) close(ch->rx_efd);
+    if (ch->tx_efd >= 0) close(ch->tx_efd);
+    if (ch->ctl_fd >= 0) close(ch->ctl_fd);
+    channel_reset(ch);
+}
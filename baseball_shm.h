@@ -0,0 +1,127 @@
+// baseball_shm.h - 같은 호스트의 클라이언트용 공유 메모리 링 전송
+// 봇/게이트웨이/테스트 하네스처럼 서버와 같은 머신에서 도는 클라이언트는 TCP 루프백 대신
+// 방향별 단일 생산자/단일 소비자 링 버퍼로 프레임을 주고받고, eventfd로 상대를 깨운다.
+// 링에는 소켓과 같은 [2바이트 길이] + [JSON 문자열] 프레임을 통째로 넣으므로 상위 계층은 그대로 쓴다.
+//
+// 접속 순서: 클라이언트가 공유 메모리(memfd)와 eventfd 2개를 만들어 서버의 접속 소켓(AF_UNIX)으로
+// SCM_RIGHTS 전송 → 서버가 매핑 후 1바이트 응답. 접속 소켓은 끝까지 열어 두어 상대 프로세스가
+// 끝나면 EOF로 알아챈다 (링에는 프로세스 종료를 알릴 방법이 없음).
+#ifndef BASEBALL_SHM_H
+#define BASEBALL_SHM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+// ──────────────────────────────────────────────────────────
+// 1) 공유 메모리 전송 설정 상수
+// ──────────────────────────────────────────────────────────
+#define SHM_MAGIC               0x4242534du  // "BBSM"
+#define SHM_VERSION             1
+#define SHM_RING_SIZE           (64 * 1024)  // 방향별 링 크기 (2의 거듭제곱, 연결별 송신 예산보다 크게)
+#define SHM_ATTACH_TIMEOUT_MS   500          // 접속 소켓에서 fd/응답을 기다리는 최대 시간 (서버는 이벤트 루프에서 마감으로)
+#define SHM_PEER_CHECK_MS       1000         // 상대 프로세스 종료(접속 소켓 EOF) 확인 주기
+
+// ──────────────────────────────────────────────────────────
+// 2) 공유 영역 배치 (두 프로세스가 같은 구조체로 매핑)
+//    head/tail은 계속 증가하는 바이트 위치 (링 크기로 나눈 나머지가 오프셋)
+//    생산자와 소비자가 쓰는 값은 캐시 라인을 나눠 서로 무효화하지 않도록 함
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint32_t head;                  // 생산자가 게시한 위치 (프레임을 다 쓴 뒤에만 전진)
+    uint32_t closed;                // 어느 한쪽이 채널을 닫음 (남은 프레임을 읽은 뒤 연결 종료)
+    char pad_producer[56];
+    uint32_t tail;                  // 소비자가 읽은 위치
+    char pad_consumer[60];
+    char data[SHM_RING_SIZE];
+} ShmRing;
+
+typedef struct {
+    uint32_t magic;                 // SHM_MAGIC
+    uint32_t version;               // SHM_VERSION
+    char pad[56];
+    ShmRing to_server;              // 클라이언트 → 서버
+    ShmRing to_client;              // 서버 → 클라이언트
+} ShmRegion;
+
+/**
+ * 한쪽 끝에서 본 채널 (서버와 클라이언트는 rx/tx가 서로 반대)
+ */
+typedef struct ShmChannel {
+    ShmRegion *region;              // 매핑한 공유 영역 (NULL: 채널 없음)
+    ShmRing *rx;                    // 내가 읽는 링
+    ShmRing *tx;                    // 내가 쓰는 링
+    int rx_efd;                     // 상대가 rx에 프레임을 넣으면 읽기 가능 (select 대상, 연결 식별 fd)
+    int tx_efd;                     // tx에 프레임을 넣은 뒤 상대를 깨움
+    int ctl_fd;                     // 접속 소켓 (상대 프로세스 종료 감지용)
+} ShmChannel;
+
+// ──────────────────────────────────────────────────────────
+// 3) 접속
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 클라이언트: 공유 영역과 eventfd를 만들어 서버의 접속 소켓으로 전달
+ * @param path: 서버의 공유 메모리 접속 소켓 경로 (-M 옵션)
+ * @return: 성공 시 0 (ch->rx_efd를 select로 감시), 실패 시 -1
+ */
+int shm_channel_connect(ShmChannel *ch, const char *path);
+
+/**
+ * 서버: 접속 소켓의 대기열에서 연결 하나 수락 (fd 전달은 기다리지 않음)
+ * 반환한 소켓을 select()로 감시하다가 읽기 가능해지면 shm_channel_attach() 호출
+ * @param listen_fd: non-blocking AF_UNIX 리스닝 소켓
+ * @return: non-blocking 접속 소켓, 대기열이 비었으면 -1 (errno = EAGAIN)
+ */
+int shm_channel_accept(int listen_fd);
+
+/**
+ * 서버: 접속 소켓으로 도착한 fd를 받아 채널 매핑 후 1바이트 응답 (non-blocking)
+ * @param ctl_fd: shm_channel_accept()가 반환한 소켓 (성공하면 채널 소유, 잘못된 요청이면 닫음)
+ * @return: 성공 시 0, 아직 도착하지 않았으면 -1 (errno = EAGAIN, ctl_fd는 그대로), 잘못된 요청이면 -1 (EPROTO)
+ */
+int shm_channel_attach(ShmChannel *ch, int ctl_fd);
+
+// ──────────────────────────────────────────────────────────
+// 4) 송수신 (프레임 단위 - 길이 prefix 포함 프레임을 통째로 쓰고 읽음)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 앞에서부터 들어가는 만큼의 프레임을 링에 쓰고 상대를 한 번 깨움 (sendmsg()와 같은 모양)
+ * 각 iovec은 완전한 프레임 하나여야 하며, 일부만 쓰는 일은 없음
+ * @return: 쓴 바이트 수, 첫 프레임도 들어가지 않으면 -1 (errno = EAGAIN), 닫힌 채널이면 -1 (EPIPE)
+ */
+ssize_t shm_channel_writev(ShmChannel *ch, const struct iovec *iov, int iovcnt);
+
+/**
+ * 다음 프레임의 JSON 길이 확인 (읽기 전에 버퍼 준비용)
+ * 깨우기 카운터를 비우므로 반환값이 양수면 이어서 shm_channel_read()를 호출해야 함
+ * @return: JSON 길이, 읽을 프레임이 없으면 0, 채널이 닫혔거나 길이가 잘못됐으면 -1
+ */
+int shm_channel_next_len(ShmChannel *ch);
+
+/**
+ * 다음 프레임의 JSON 문자열을 buf에 복사하고 링에서 제거
+ * 링에 프레임이 남아 있으면 깨우기 카운터를 다시 올려 select()가 계속 알리도록 함
+ * @param len: shm_channel_next_len()이 반환한 길이
+ */
+void shm_channel_read(ShmChannel *ch, char *buf, int len);
+
+/**
+ * 채널을 닫힘으로 표시하고 양쪽을 깨움 (shutdown()에 해당 - 정리는 다음 수신에서)
+ */
+void shm_channel_shutdown(ShmChannel *ch);
+
+/**
+ * 상대 프로세스가 아직 접속 소켓을 열고 있는지 (non-blocking)
+ * @return: 살아 있으면 1, EOF/오류면 0
+ */
+int shm_channel_peer_alive(const ShmChannel *ch);
+
+/**
+ * 매핑 해제, 모든 fd 닫기
+ */
+void shm_channel_close(ShmChannel *ch);
+
+#endif // BASEBALL_SHM_H
@@ -0,0 +1,308 @@
+/**
+ * baseball_snapshot.c - 크래시 복구용 주기적 방 상태 스냅샷 구현
+ *
+ * 📋 동작 순서:
+ * 1) 이벤트 루프가 한 반복을 마친 뒤 주기가 되면 fork() - 부모는 곧바로 다음 반복으로
+ * 2) 자식은 fork 시점에 고정된 (copy-on-write) 방 상태를 path.tmp에 기록하고 fsync
+ * 3) 헤더(체크섬 포함)를 마지막에 채우고 rename으로 교체한 뒤 _exit
+ * 4) 부모는 매 반복 waitpid(WNOHANG)로 자식을 회수하고 통계만 갱신
+ *
+ * 자식은 부모의 stdio 버퍼/malloc 잠금을 물려받으므로 printf/malloc 없이 write()만 사용하고,
+ * 부모가 연 소켓에는 손대지 않는다. rename 전에 죽으면 이전 스냅샷이 그대로 남는다.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "baseball_snapshot.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+#define SNAPSHOT_WRITE_BUF  (64 * 1024)
+
+// 자식 프로세스의 기록 상태 (자식마다 부모의 빈 상태를 물려받음)
+static struct {
+    int fd;
+    char path[512];
+    char tmp_path[520];
+    char buf[SNAPSHOT_WRITE_BUF];
+    size_t buf_len;
+    uint32_t body_size;
+    uint32_t section_count;
+    uint32_t checksum;
+    int failed;
+} writer = { .fd = -1 };
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * FNV-1a 누적 (본문 손상 검사용)
+ */
+static uint32_t checksum_update(uint32_t h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * 쓰기 버퍼 비우기 (부분 쓰기/EINTR 재시도)
+ */
+static int writer_drain(void) {
+    size_t off = 0;
+    while (off < writer.buf_len) {
+        ssize_t n = write(writer.fd, writer.buf + off, writer.buf_len - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        off += (size_t)n;
+    }
+    writer.buf_len = 0;
+    return 0;
+}
+
+/**
+ * 본문 바이트 추가 (버퍼가 차면 write)
+ */
+static int writer_put(const void *data, size_t len) {
+    if (writer.fd < 0 || writer.failed) return -1;
+    writer.checksum = checksum_update(writer.checksum, data, len);
+    writer.body_size += (uint32_t)len;
+
+    const char *p = data;
+    while (len > 0) {
+        size_t room = SNAPSHOT_WRITE_BUF - writer.buf_len;
+        size_t n = len < room ? len : room;
+        memcpy(writer.buf + writer.buf_len, p, n);
+        writer.buf_len += n;
+        p += n;
+        len -= n;
+        if (writer.buf_len == SNAPSHOT_WRITE_BUF && writer_drain() < 0) {
+            writer.failed = 1;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────
+// 주기적 스냅샷 (부모 프로세스)
+// ──────────────────────────────────────────────────────────
+
+void snapshot_init(Snapshotter *s, const char *path, uint64_t interval_ms, uint64_t now_ms) {
+    memset(s, 0, sizeof(*s));
+    s->path = path;
+    s->interval_ms = interval_ms;
+    s->next_ms = now_ms + interval_ms;
+    s->last_size = -1;
+}
+
+int snapshot_fork_if_due(Snapshotter *s, uint64_t now_ms) {
+    if (!s->path || now_ms < s->next_ms) return 0;
+    s->next_ms = now_ms + s->interval_ms;
+    if (s->child > 0) {
+        // 디스크가 느려 이전 스냅샷이 아직 기록 중 - 자식을 겹쳐 띄우지 않음
+        s->skipped++;
+        return 0;
+    }
+
+    fflush(stdout);  // 자식이 부모의 버퍼를 물려받아도 출력되지 않도록 (자식은 _exit)
+    uint64_t t0 = monotonic_ns();
+    pid_t pid = fork();
+    if (pid == 0) return 1;
+    if (pid < 0) {
+        s->failed++;
+        printf("[Snapshot] fork 실패: %s\n", strerror(errno));
+        return -1;
+    }
+
+    uint64_t fork_ns = monotonic_ns() - t0;
+    s->child = pid;
+    s->fork_started_ns = t0;
+    s->fork_ns_total += fork_ns;
+    if (fork_ns > s->fork_ns_max) s->fork_ns_max = fork_ns;
+    return 0;
+}
+
+void snapshot_reap(Snapshotter *s) {
+    if (s->child <= 0) return;
+    int status;
+    pid_t pid = waitpid(s->child, &status, WNOHANG);
+    if (pid == 0) return;
+    s->child = 0;
+    if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        s->failed++;
+        printf("[Snapshot] 스냅샷 기록 실패 - 이전 스냅샷을 유지합니다\n");
+        return;
+    }
+
+    s->taken++;
+    s->last_write_ns = monotonic_ns() - s->fork_started_ns;
+    struct stat st;
+    s->last_size = stat(s->path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+void snapshot_report(Snapshotter *s, int force) {
+    if (!s->path || (!force && s->taken == s->reported_taken)) return;
+    s->reported_taken = s->taken;
+    uint64_t forks = s->taken + s->failed;
+    printf("[Snapshot] 완료 %llu회, 실패 %llu회, 건너뜀 %llu회, fork 평균 %.1fµs / 최대 %.1fµs, "
+           "마지막 fork→회수 %.1fms (%ld bytes)\n",
+           (unsigned long long)s->taken, (unsigned long long)s->failed, (unsigned long long)s->skipped,
+           forks ? s->fork_ns_total / 1000.0 / forks : 0.0, s->fork_ns_max / 1000.0,
+           s->last_write_ns / 1e6, s->last_size);
+}
+
+// ──────────────────────────────────────────────────────────
+// 스냅샷 파일 쓰기 (자식 프로세스)
+// ──────────────────────────────────────────────────────────
+
+int snapshot_write_begin(const char *path) {
+    snprintf(writer.path, sizeof(writer.path), "%s", path);
+    snprintf(writer.tmp_path, sizeof(writer.tmp_path), "%s.tmp", path);
+    writer.fd = open(writer.tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (writer.fd < 0) return -1;
+
+    // 헤더 자리는 비워 두고 본문부터 기록 (크기/체크섬은 commit에서)
+    writer.buf_len = 0;
+    writer.body_size = 0;
+    writer.section_count = 0;
+    writer.checksum = 2166136261u;
+    writer.failed = 0;
+    if (lseek(writer.fd, sizeof(SnapshotHeader), SEEK_SET) < 0) {
+        writer.failed = 1;
+        return -1;
+    }
+    return 0;
+}
+
+int snapshot_write_section(uint32_t type, const void *data, uint32_t size) {
+    SnapshotSection sec = { .type = type, .size = size };
+    if (writer_put(&sec, sizeof(sec)) < 0 || writer_put(data, size) < 0) return -1;
+    writer.section_count++;
+    return 0;
+}
+
+int snapshot_write_room(const GameManager *g, int match_node, const int *entrants) {
+    SnapshotRoom rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.room_id = g->room_id;
+    rec.match_node = match_node;
+    rec.entrants[0] = entrants ? entrants[0] : -1;
+    rec.entrants[1] = entrants ? entrants[1] : -1;
+    rec.room.magic = HANDOFF_MAGIC;
+    rec.room.version = HANDOFF_VERSION;
+    handoff_pack_room(g, &rec.room, NULL);
+    return snapshot_write_section(SNAPSHOT_SEC_ROOM, &rec, sizeof(rec));
+}
+
+long snapshot_write_commit(uint64_t taken_ms, uint64_t journal_seq, uint32_t match_id) {
+    if (writer.fd < 0) return -1;
+
+    SnapshotHeader hdr = {
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .taken_ms = taken_ms,
+        .journal_seq = journal_seq,
+        .match_id = match_id,
+        .section_count = writer.section_count,
+        .body_size = writer.body_size,
+        .checksum = writer.checksum,
+    };
+    int ok = !writer.failed && writer_drain() == 0 &&
+             pwrite(writer.fd, &hdr, sizeof(hdr), 0) == (ssize_t)sizeof(hdr) &&
+             fsync(writer.fd) == 0;
+    close(writer.fd);
+    writer.fd = -1;
+
+    if (!ok || rename(writer.tmp_path, writer.path) < 0) {
+        unlink(writer.tmp_path);
+        return -1;
+    }
+    return (long)(sizeof(hdr) + hdr.body_size);
+}
+
+// ──────────────────────────────────────────────────────────
+// 스냅샷 파일 읽기
+// ──────────────────────────────────────────────────────────
+
+int snapshot_load(const char *path, SnapshotReader *r) {
+    memset(r, 0, sizeof(*r));
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return errno == ENOENT ? 1 : -1;
+
+    int rc = -1;
+    if (read(fd, &r->header, sizeof(r->header)) != (ssize_t)sizeof(r->header)) goto out;
+    if (r->header.magic != SNAPSHOT_MAGIC || r->header.version != SNAPSHOT_VERSION ||
+        r->header.body_size > SNAPSHOT_MAX_SIZE) {
+        goto out;
+    }
+
+    r->data = malloc(r->header.body_size ? r->header.body_size : 1);
+    if (!r->data) goto out;
+    size_t got = 0;
+    while (got < r->header.body_size) {
+        ssize_t n = read(fd, r->data + got, r->header.body_size - got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        got += (size_t)n;
+    }
+    if (got != r->header.body_size ||
+        checksum_update(2166136261u, r->data, got) != r->header.checksum) {
+        snapshot_free(r);
+        goto out;
+    }
+    rc = 0;
+
+out:
+    close(fd);
+    return rc;
+}
+
+const void *snapshot_next(SnapshotReader *r, uint32_t *type, uint32_t *size) {
+    if (r->offset + sizeof(SnapshotSection) > r->header.body_size) return NULL;
+    SnapshotSection sec;
+    memcpy(&sec, r->data + r->offset, sizeof(sec));
+    if (sec.size > r->header.body_size - r->offset - sizeof(sec)) return NULL;
+
+    const void *body = r->data + r->offset + sizeof(sec);
+    r->offset += sizeof(sec) + sec.size;
+    *type = sec.type;
+    *size = sec.size;
+    return body;
+}
+
+int snapshot_room_unpack(const void *data, uint32_t size, GameManager *g, SnapshotRoom *meta) {
+    if (size != sizeof(SnapshotRoom)) return -1;
+    memcpy(meta, data, sizeof(*meta));
+    const HandoffState *st = &meta->room;
+    if (st->magic != HANDOFF_MAGIC || st->version != HANDOFF_VERSION) return -1;
+    if (st->capacity < 2 || st->capacity > MAX_CLIENTS || st->current_turn >= st->capacity) return -1;
+
+    handoff_unpack_room(st, NULL, g);
+    g->room_id = meta->room_id;
+    // 소켓이 없어 connected는 모두 0이 됨 - 앉아 있던 좌석은 game_restore_room()이 알 수 있도록 표시만 되살림
+    for (int i = 0; i < MAX_CLIENTS; i++) g->players[i].connected = st->players[i].connected;
+    return 0;
+}
+
+void snapshot_free(SnapshotReader *r) {
+    free(r->data);
+    r->data = NULL;
+}
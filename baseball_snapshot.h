@@ -0,0 +1,155 @@
+// baseball_snapshot.h - 크래시 복구용 주기적 방 상태 스냅샷
+// 이벤트 루프는 fork()만 하고, 자식 프로세스가 copy-on-write로 고정된 메모리에서
+// 모든 방/플레이어 상태를 파일에 기록한다. 직렬화 동안 부모는 게임을 계속 진행한다.
+// 서버가 비정상 종료되면 다음 시작 때 마지막 스냅샷으로 방을 되살리고
+// 플레이어는 재접속 토큰으로 같은 좌석에 복귀한다.
+#ifndef BASEBALL_SNAPSHOT_H
+#define BASEBALL_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "baseball_handoff.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 스냅샷 설정 상수
+// ──────────────────────────────────────────────────────────
+#define SNAPSHOT_MAGIC          0x42425350u  // "BBSP"
+#define SNAPSHOT_VERSION        1
+#define SNAPSHOT_INTERVAL_MS    2000         // 스냅샷 주기 기본값 (-S 경로[:주기])
+#define SNAPSHOT_MAX_SIZE       (16u << 20)  // 불러올 수 있는 최대 파일 크기
+
+// 섹션 종류
+#define SNAPSHOT_SEC_ROOM       1            // SnapshotRoom
+#define SNAPSHOT_SEC_BRACKET    2            // 토너먼트 대진표 (형식은 서버가 정함, 크기로 검증)
+
+// ──────────────────────────────────────────────────────────
+// 2) 파일 형식: 헤더 + (섹션 헤더 + 본문)* (고정 크기 필드만 사용)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    uint32_t magic;                  // SNAPSHOT_MAGIC
+    uint32_t version;                // SNAPSHOT_VERSION
+    uint64_t taken_ms;               // 스냅샷 시각 (epoch 밀리초)
+    uint64_t journal_seq;            // 스냅샷 시점의 저널 레코드 수 (저널이 없으면 0)
+    uint32_t match_id;               // 서버 전체의 마지막 경기 번호
+    uint32_t section_count;
+    uint32_t body_size;              // 헤더 뒤 바이트 수
+    uint32_t checksum;               // 헤더 뒤 바이트 전체의 FNV-1a
+} SnapshotHeader;
+
+typedef struct {
+    uint32_t type;                   // SNAPSHOT_SEC_*
+    uint32_t size;                   // 본문 바이트 수
+} SnapshotSection;
+
+typedef struct {
+    uint16_t room_id;                // 0 = 일반 대전 방, 1~ = 토너먼트 경기 방
+    uint16_t reserved;
+    int32_t  match_node;             // 토너먼트 경기 노드 (일반 방은 -1)
+    int32_t  entrants[2];            // 좌석별 참가자 번호 (토너먼트 경기 방)
+    HandoffState room;               // 방/좌석 상태 (fd 위치는 모두 -1)
+} SnapshotRoom;
+
+// ──────────────────────────────────────────────────────────
+// 3) 주기적 스냅샷 (부모 프로세스 쪽 상태)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    const char *path;                // 스냅샷 파일 (임시 파일에 쓰고 rename으로 교체)
+    uint64_t interval_ms;
+    uint64_t next_ms;                // 다음 스냅샷 예정 시각
+    pid_t child;                     // 기록 중인 자식 (0: 없음)
+    uint64_t fork_started_ns;        // 자식 시작 시각 (CLOCK_MONOTONIC)
+    uint64_t taken;                  // 성공한 스냅샷 수
+    uint64_t failed;                 // 실패한 스냅샷 수
+    uint64_t skipped;                // 이전 자식이 끝나지 않아 건너뛴 주기 수
+    uint64_t fork_ns_max;            // 가장 긴 fork() 소요 시간 (이벤트 루프가 멈춘 시간)
+    uint64_t fork_ns_total;
+    uint64_t last_write_ns;          // 마지막 스냅샷의 fork부터 자식 회수까지 (루프가 깨어나는 간격만큼 늦게 잡힘)
+    long last_size;                  // 마지막 스냅샷 파일 크기
+    uint64_t reported_taken;         // 마지막 통계 출력 시점의 taken
+} Snapshotter;
+
+/**
+ * 주기적 스냅샷 초기화 (첫 스냅샷은 한 주기 뒤)
+ */
+void snapshot_init(Snapshotter *s, const char *path, uint64_t interval_ms, uint64_t now_ms);
+
+/**
+ * 주기가 됐으면 자식 프로세스 생성 (이전 자식이 기록 중이면 이번 주기는 건너뜀)
+ * 반드시 한 반복의 메시지 처리와 저널 기록이 끝난 뒤 호출 (방 상태와 저널 위치가 일치하도록)
+ * @return: 자식 프로세스에서 1 (호출자가 snapshot_write 후 _exit), 부모에서 0, fork 실패 시 -1
+ */
+int snapshot_fork_if_due(Snapshotter *s, uint64_t now_ms);
+
+/**
+ * 끝난 자식 프로세스 회수 및 결과 기록 (이벤트 루프 매 반복, 블로킹 없음)
+ */
+void snapshot_reap(Snapshotter *s);
+
+/**
+ * 누적 통계 출력 (force가 0이면 지난 출력 이후 새 스냅샷이 있을 때만)
+ */
+void snapshot_report(Snapshotter *s, int force);
+
+// ──────────────────────────────────────────────────────────
+// 4) 스냅샷 파일 쓰기 (자식 프로세스 - malloc/stdio 없이 write()만 사용)
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 스냅샷 기록 시작 (path.tmp 생성)
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int snapshot_write_begin(const char *path);
+
+/**
+ * 방 하나 기록
+ * @param match_node: 토너먼트 경기 노드 (일반 방은 -1)
+ * @param entrants: 좌석별 참가자 번호 (일반 방은 NULL)
+ */
+int snapshot_write_room(const GameManager *g, int match_node, const int *entrants);
+
+/**
+ * 임의 섹션 기록 (토너먼트 대진표 등 서버가 형식을 정하는 상태)
+ */
+int snapshot_write_section(uint32_t type, const void *data, uint32_t size);
+
+/**
+ * 헤더를 채우고 fsync 후 rename으로 이전 스냅샷 교체
+ * @return: 성공 시 기록한 바이트 수, 실패 시 -1 (임시 파일 삭제)
+ */
+long snapshot_write_commit(uint64_t taken_ms, uint64_t journal_seq, uint32_t match_id);
+
+// ──────────────────────────────────────────────────────────
+// 5) 스냅샷 파일 읽기 (서버 시작 시 복원, 벤치마크)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    SnapshotHeader header;
+    char *data;                      // 헤더 뒤 본문 (snapshot_free로 해제)
+    size_t offset;                   // 다음 섹션 위치
+} SnapshotReader;
+
+/**
+ * 스냅샷 파일 읽기 및 검증 (매직/버전/크기/체크섬)
+ * @return: 성공 시 0, 파일 없음 1, 손상/형식 불일치 -1
+ */
+int snapshot_load(const char *path, SnapshotReader *r);
+
+/**
+ * 다음 섹션 (본문 크기까지 검증됨)
+ * @return: 본문 포인터, 더 없으면 NULL
+ */
+const void *snapshot_next(SnapshotReader *r, uint32_t *type, uint32_t *size);
+
+/**
+ * 방 섹션을 게임 상태로 복원 (game_restore_room 전 단계 - 좌석 상태는 스냅샷 그대로)
+ * @return: 성공 시 0, 섹션 크기나 정원이 맞지 않으면 -1
+ */
+int snapshot_room_unpack(const void *data, uint32_t size, GameManager *g, SnapshotRoom *meta);
+
+/**
+ * snapshot_load로 읽은 본문 해제
+ */
+void snapshot_free(SnapshotReader *r);
+
+#endif // BASEBALL_SNAPSHOT_H
@@ -0,0 +1,150 @@
+/**
+ * baseball_spectator.c - 관전자 연결 관리 구현
+ *
+ * 📋 전송 방식:
+ * - 이벤트는 frame_from_json()으로 한 번만 직렬화 (길이 prefix 포함)
+ * - 관전자마다 버퍼를 복사하지 않고 참조 카운트만 올려 송신 큐(Outbox)에 추가
+ * - 큐가 비어 있던 관전자는 즉시 non-blocking 전송을 시도하고,
+ *   남은 부분만 select() 쓰기 가능 이벤트에서 이어서 전송
+ * - 송신 예산을 넘긴 관전자는 느린 소비자로 보고 연결 해제 (게임 진행에 영향 없음)
+ *
+ * 관전자 소켓은 읽기 전용 채널이라 수신 데이터는 버리고 연결 종료만 감지한다.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+#include "baseball_spectator.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 관전자 슬롯 정리 (소켓 닫기)
+ */
+static void release_slot(SpectatorList *list, Spectator *s) {
+    outbox_clear(&s->outbox);
+    close(s->fd);
+    s->fd = -1;
+    s->closing = 0;
+    list->count--;
+}
+
+/**
+ * 관전자 큐에 메시지 추가 (전송은 반복 끝에 모아서)
+ * 예산을 넘기면 정리 대상으로 표시 (이번 반복의 fd 집합이 닫힌 fd를 가리키지 않도록 지연 정리)
+ */
+static void enqueue(SpectatorList *list, Spectator *s, SharedFrame *f, int kind) {
+    uint64_t slow_before = outbox_stats.slow_consumers;
+    if (outbox_push(&s->outbox, s->fd, f, kind) < 0) {
+        if (outbox_stats.slow_consumers != slow_before) {
+            printf("[Spectator] 송신 예산을 넘긴 느린 관전자 연결 해제 (fd=%d, 미전송 %zu바이트)\n",
+                   s->fd, s->outbox.bytes);
+            list->dropped_slow++;
+        }
+        s->closing = 1;
+        return;
+    }
+    list->frames_queued++;
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+void spectator_init(SpectatorList *list) {
+    memset(list, 0, sizeof(*list));
+    for (int i = 0; i < MAX_SPECTATORS; i++) {
+        list->slots[i].fd = -1;
+    }
+}
+
+int spectator_add(SpectatorList *list, int fd) {
+    if (fd >= FD_SETSIZE) return -1;
+
+    for (int i = 0; i < MAX_SPECTATORS; i++) {
+        Spectator *s = &list->slots[i];
+        if (s->fd >= 0) continue;
+
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+        s->fd = fd;
+        s->closing = 0;
+        outbox_clear(&s->outbox);
+        list->count++;
+        if (i >= list->high_water) list->high_water = i + 1;
+        return i;
+    }
+    return -1;
+}
+
+void spectator_send(SpectatorList *list, int idx, SharedFrame *f) {
+    Spectator *s = &list->slots[idx];
+    if (s->fd < 0 || s->closing || !f) return;
+    enqueue(list, s, f, OUTBOX_ESSENTIAL);
+}
+
+void spectator_publish(SpectatorList *list, SharedFrame *f, int kind) {
+    if (!f) return;
+    list->frames_published++;
+
+    for (int i = 0; i < list->high_water; i++) {
+        Spectator *s = &list->slots[i];
+        if (s->fd < 0 || s->closing) continue;
+        enqueue(list, s, f, kind);
+    }
+}
+
+void spectator_fill_fdsets(SpectatorList *list, fd_set *read_set, fd_set *write_set, int *max_fd) {
+    int top = 0;
+    for (int i = 0; i < list->high_water; i++) {
+        Spectator *s = &list->slots[i];
+        if (s->fd < 0) continue;
+
+        if (s->closing) {
+            printf("[Spectator] 관전자 연결 종료 (fd=%d)\n", s->fd);
+            release_slot(list, s);
+            continue;
+        }
+
+        top = i + 1;
+        FD_SET(s->fd, read_set);
+        if (outbox_pending(&s->outbox)) FD_SET(s->fd, write_set);
+        if (s->fd > *max_fd) *max_fd = s->fd;
+    }
+    list->high_water = top;
+}
+
+void spectator_handle_io(SpectatorList *list, const fd_set *read_set, const fd_set *write_set) {
+    for (int i = 0; i < list->high_water; i++) {
+        Spectator *s = &list->slots[i];
+        if (s->fd < 0 || s->closing) continue;
+
+        if (FD_ISSET(s->fd, read_set)) {
+            // 관전자는 보낼 것이 없으므로 읽은 데이터는 버리고 종료만 확인
+            char discard[256];
+            ssize_t n = recv(s->fd, discard, sizeof(discard), MSG_DONTWAIT);
+            if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                s->closing = 1;
+                continue;
+            }
+        }
+
+        if (FD_ISSET(s->fd, write_set) && outbox_flush(&s->outbox, s->fd) < 0) s->closing = 1;
+    }
+}
+
+void spectator_close_all(SpectatorList *list) {
+    for (int i = 0; i < list->high_water; i++) {
+        if (list->slots[i].fd >= 0) release_slot(list, &list->slots[i]);
+    }
+    list->high_water = 0;
+}
@@ -0,0 +1,76 @@
+// baseball_spectator.h - 관전자 연결 관리 (한 번 직렬화한 메시지를 모든 관전자가 공유)
+// 이벤트마다 JSON을 한 번만 직렬화해 참조 카운트 버퍼(SharedFrame)로 만들고,
+// 각 관전자의 송신 큐에는 버퍼 포인터만 넣어 관전자 수와 무관하게 인코딩 비용을 고정한다.
+#ifndef BASEBALL_SPECTATOR_H
+#define BASEBALL_SPECTATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/select.h>
+
+#include "baseball_protocol.h"
+#include "baseball_outbox.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 관전 설정 상수
+// ──────────────────────────────────────────────────────────
+#define MAX_SPECTATORS       512    // 최대 관전자 수 (select()의 FD_SETSIZE 안에서)
+                                    // 관전자별 미전송 한도는 송신 큐 예산 (넘치면 느린 관전자로 보고 연결 해제)
+
+// ──────────────────────────────────────────────────────────
+// 2) 관전자 목록 (공유 송신 버퍼 SharedFrame은 baseball_outbox.h)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    int fd;                                     // 관전자 소켓 (-1: 빈 슬롯, O_NONBLOCK)
+    int closing;                                // 1이면 다음 spectator_fill_fdsets()에서 정리
+    Outbox outbox;                              // 미전송 메시지 (바이트 예산 안에서 대기)
+} Spectator;
+
+typedef struct {
+    Spectator slots[MAX_SPECTATORS];
+    int count;                                  // 연결된 관전자 수
+    int high_water;                             // 사용한 적 있는 슬롯 수 (순회 범위)
+    uint64_t frames_published;                  // 직렬화한 공유 메시지 수
+    uint64_t frames_queued;                     // 관전자 큐에 넣은 횟수 (직렬화 없이 공유)
+    uint64_t dropped_slow;                      // 송신 예산을 넘겨 끊은 관전자 수
+} SpectatorList;
+
+/**
+ * 관전자 목록 초기화
+ */
+void spectator_init(SpectatorList *list);
+
+/**
+ * 관전자 등록 (소켓을 non-blocking으로 전환)
+ * @return: 슬롯 번호, 가득 차면 -1 (호출자가 소켓을 닫음)
+ */
+int spectator_add(SpectatorList *list, int fd);
+
+/**
+ * 관전자 한 명에게 메시지 전송 (접속 직후 스냅샷 등)
+ */
+void spectator_send(SpectatorList *list, int idx, SharedFrame *f);
+
+/**
+ * 모든 관전자에게 메시지 전송 (버퍼는 공유, 예산이 넘친 관전자는 정리 대상으로 표시)
+ * @param kind: OutboxKind (턴 변경처럼 최신 값만 의미 있는 메시지는 대기 중인 것과 합침)
+ */
+void spectator_publish(SpectatorList *list, SharedFrame *f, int kind);
+
+/**
+ * select() 감시 집합 구성: 정리 대상 관전자를 닫고,
+ * 모든 관전자를 읽기 집합에(연결 종료 감지), 미전송 메시지가 있는 관전자를 쓰기 집합에 추가
+ */
+void spectator_fill_fdsets(SpectatorList *list, fd_set *read_set, fd_set *write_set, int *max_fd);
+
+/**
+ * select() 결과 처리: 읽기 가능하면 연결 종료 확인, 쓰기 가능하면 큐 전송
+ */
+void spectator_handle_io(SpectatorList *list, const fd_set *read_set, const fd_set *write_set);
+
+/**
+ * 모든 관전자 연결 종료 (서버 종료/인계 시)
+ */
+void spectator_close_all(SpectatorList *list);
+
+#endif // BASEBALL_SPECTATOR_H
@@ -0,0 +1,188 @@
+/**
+ * baseball_tournament.c - 싱글 엘리미네이션 대진표 구현
+ *
+ * 📋 동작 방식:
+ * - 참가자를 잎 노드에 배치 (부전승은 1라운드 쌍마다 최대 하나)
+ * - 경기 결과가 들어오면 승자를 부모 노드에 기록
+ * - 형제 노드의 승자도 이미 정해져 있으면 부모 경기를 시작 가능 목록에 추가
+ *
+ * 라운드 단위로 기다리지 않고 양쪽 참가자가 정해지는 즉시 경기를 시작할 수 있으므로
+ * 빨리 끝난 쪽 대진은 같은 라운드의 다른 경기가 끝나기 전에 다음 경기를 진행한다.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+
+#include "baseball_tournament.h"
+
+// ──────────────────────────────────────────────────────────
+// 내부 헬퍼 함수들
+// ──────────────────────────────────────────────────────────
+
+/**
+ * 시작 가능 목록에 경기 추가
+ */
+static void push_ready(Tournament *t, int match) {
+    t->ready[(t->ready_head + t->ready_count) % TOURNAMENT_MAX_ENTRANTS] = (int16_t)match;
+    t->ready_count++;
+}
+
+/**
+ * 노드의 승자가 정해졌을 때 부모 경기 준비 여부 확인
+ */
+static void advance(Tournament *t, int node) {
+    if (node == 1) return;  // 결승 승자 = 우승
+    int parent = node >> 1;
+    if (t->winner[node ^ 1] >= 0) push_ready(t, parent);
+}
+
+/**
+ * 노드 깊이 (결승 = 0)
+ */
+static int node_depth(int node) {
+    int depth = 0;
+    while (node > 1) {
+        node >>= 1;
+        depth++;
+    }
+    return depth;
+}
+
+// ──────────────────────────────────────────────────────────
+// 공개 API
+// ──────────────────────────────────────────────────────────
+
+int tournament_init(Tournament *t, const char names[][PLAYER_NAME_LEN + 1], int count) {
+    if (count < TOURNAMENT_MIN_ENTRANTS || count > TOURNAMENT_MAX_ENTRANTS) return -1;
+
+    memset(t, 0, sizeof(*t));
+    t->entrant_count = count;
+    t->size = 1;
+    while (t->size < count) {
+        t->size <<= 1;
+        t->rounds++;
+    }
+    for (int n = 0; n < 2 * t->size; n++) t->winner[n] = -1;
+
+    for (int i = 0; i < count; i++) {
+        snprintf(t->names[i], sizeof(t->names[i]), "%s", names[i]);
+        for (int j = 0; j < i; j++) {
+            if (strcmp(t->names[i], t->names[j]) == 0) {
+                printf("[Tournament] 중복된 참가자 이름: %s\n", names[i]);
+                return -1;
+            }
+        }
+    }
+
+    // 1라운드 배치: 앞쪽 쌍은 두 명, 나머지 쌍은 한 명 + 부전승
+    int pairs = t->size / 2;
+    int full_pairs = count - pairs;
+    int entrant = 0;
+    for (int p = 0; p < pairs; p++) {
+        int leaf = t->size + 2 * p;
+        t->winner[leaf] = (int16_t)entrant;
+        t->entrant_leaf[entrant++] = (int16_t)leaf;
+        if (p < full_pairs) {
+            t->winner[leaf + 1] = (int16_t)entrant;
+            t->entrant_leaf[entrant++] = (int16_t)(leaf + 1);
+        }
+    }
+
+    // 부전승은 바로 올리고, 두 명이 있는 1라운드 경기는 시작 가능
+    t->matches_left = count - 1;
+    for (int p = 0; p < pairs; p++) {
+        int match = (t->size + 2 * p) >> 1;
+        if (p < full_pairs) {
+            push_ready(t, match);
+        } else {
+            t->winner[match] = t->winner[2 * match];
+            advance(t, match);
+        }
+    }
+    return 0;
+}
+
+int tournament_load_roster(Tournament *t, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        printf("[Tournament] 참가자 명단을 열 수 없습니다: %s\n", path);
+        return -1;
+    }
+
+    static char names[TOURNAMENT_MAX_ENTRANTS][PLAYER_NAME_LEN + 1];
+    int count = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+        if (strlen(line) > PLAYER_NAME_LEN || count == TOURNAMENT_MAX_ENTRANTS) {
+            printf("[Tournament] 명단 오류 (이름은 %d바이트, 최대 %d명): %s\n",
+                   PLAYER_NAME_LEN, TOURNAMENT_MAX_ENTRANTS, line);
+            fclose(fp);
+            return -1;
+        }
+        memcpy(names[count++], line, strlen(line) + 1);  // 길이는 위에서 확인
+    }
+    fclose(fp);
+
+    if (tournament_init(t, (const char (*)[PLAYER_NAME_LEN + 1])names, count) < 0) {
+        printf("[Tournament] 대진표를 만들 수 없습니다 (참가자 %d명)\n", count);
+        return -1;
+    }
+    printf("[Tournament] 참가자 %d명, %d라운드 대진표 생성\n", t->entrant_count, t->rounds);
+    return 0;
+}
+
+int tournament_find_entrant(const Tournament *t, const char *name) {
+    for (int i = 0; i < t->entrant_count; i++) {
+        if (strcmp(t->names[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+int tournament_next_ready(Tournament *t) {
+    if (t->ready_count == 0) return -1;
+    int match = t->ready[t->ready_head];
+    t->ready_head = (t->ready_head + 1) % TOURNAMENT_MAX_ENTRANTS;
+    t->ready_count--;
+    return match;
+}
+
+void tournament_match_entrants(const Tournament *t, int match, int *a, int *b) {
+    *a = t->winner[2 * match];
+    *b = t->winner[2 * match + 1];
+}
+
+int tournament_record_result(Tournament *t, int match, int winner) {
+    if (match < 1 || match >= t->size || t->winner[match] >= 0) return -1;
+    if (winner != t->winner[2 * match] && winner != t->winner[2 * match + 1]) return -1;
+
+    t->winner[match] = (int16_t)winner;
+    t->matches_left--;
+    advance(t, match);
+    return 0;
+}
+
+int tournament_match_round(const Tournament *t, int match) {
+    return t->rounds - node_depth(match);
+}
+
+int tournament_entrant_next_match(const Tournament *t, int entrant) {
+    if (entrant < 0 || entrant >= t->entrant_count) return -1;
+
+    // 잎에서 위로 올라가며 이 참가자가 아직 통과하지 못한 첫 노드 (탈락했으면 -1)
+    int node = t->entrant_leaf[entrant];
+    while (node > 1) {
+        int parent = node >> 1;
+        if (t->winner[parent] < 0) return parent;
+        if (t->winner[parent] != entrant) return -1;
+        node = parent;
+    }
+    return -1;
+}
+
+int tournament_champion(const Tournament *t) {
+    return t->matches_left == 0 ? t->winner[1] : -1;
+}
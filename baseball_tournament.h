@@ -0,0 +1,90 @@
+// baseball_tournament.h - 싱글 엘리미네이션 토너먼트 대진표 (소켓과 분리된 대진 엔진)
+// 참가자 명단으로 대진표를 만들고, 경기 결과가 들어올 때마다 승자를 다음 경기로 올린다.
+// 대진표는 완전 이진 트리(힙 배열)라서 결과 하나를 반영하는 비용은 O(1)이다.
+#ifndef BASEBALL_TOURNAMENT_H
+#define BASEBALL_TOURNAMENT_H
+
+#include <stdint.h>
+
+#include "baseball_protocol.h"
+
+// ──────────────────────────────────────────────────────────
+// 1) 토너먼트 설정 상수
+// ──────────────────────────────────────────────────────────
+#define TOURNAMENT_MAX_ENTRANTS  512    // 최대 참가자 수 (select()의 FD_SETSIZE 안에서)
+#define TOURNAMENT_MIN_ENTRANTS  2
+#define TOURNAMENT_NO_SHOW_SEC   120    // 한쪽만 체크인한 경기에서 상대를 기다리는 최대 시간 (지나면 부전승)
+
+// ──────────────────────────────────────────────────────────
+// 2) 대진표 구조
+//    노드 1 = 결승, 노드 m의 두 하위 경기 = 2m, 2m+1, 잎 노드 [size, 2*size) = 참가자 자리
+//    winner[n]: 노드 n을 통과한 참가자 (-1: 아직 미정)
+// ──────────────────────────────────────────────────────────
+typedef struct {
+    int entrant_count;                              // 참가자 수
+    int size;                                       // 잎 노드 수 (참가자 수 이상의 2의 거듭제곱)
+    int rounds;                                     // 전체 라운드 수 (log2(size))
+    char names[TOURNAMENT_MAX_ENTRANTS][PLAYER_NAME_LEN + 1];
+    int16_t winner[2 * TOURNAMENT_MAX_ENTRANTS];    // 노드별 승자 (참가자 번호)
+    int16_t entrant_leaf[TOURNAMENT_MAX_ENTRANTS];  // 참가자 → 잎 노드
+    int16_t ready[TOURNAMENT_MAX_ENTRANTS];         // 양쪽 참가자가 정해진 경기 (원형 큐)
+    int ready_head;
+    int ready_count;
+    int matches_left;                               // 남은 경기 수 (0이면 우승자 확정)
+} Tournament;
+
+/**
+ * 참가자 명단으로 대진표 생성
+ * 부전승은 1라운드에만 생기도록 배치하고 생성 시점에 바로 올려 둠
+ * @param names: 참가자 이름 배열 (중복 불가)
+ * @return: 성공 시 0, 인원이 범위를 벗어나거나 이름이 중복되면 -1
+ */
+int tournament_init(Tournament *t, const char names[][PLAYER_NAME_LEN + 1], int count);
+
+/**
+ * 참가자 명단 파일 읽기 (한 줄에 한 명, 빈 줄과 #으로 시작하는 줄은 무시)
+ * @return: 성공 시 0, 실패 시 -1
+ */
+int tournament_load_roster(Tournament *t, const char *path);
+
+/**
+ * 이름으로 참가자 번호 찾기
+ * @return: 참가자 번호, 명단에 없으면 -1
+ */
+int tournament_find_entrant(const Tournament *t, const char *name);
+
+/**
+ * 시작할 수 있는 다음 경기 꺼내기 (양쪽 참가자가 모두 정해진 경기)
+ * @return: 경기 노드 번호, 없으면 -1
+ */
+int tournament_next_ready(Tournament *t);
+
+/**
+ * 경기의 두 참가자
+ */
+void tournament_match_entrants(const Tournament *t, int match, int *a, int *b);
+
+/**
+ * 경기 결과 반영 - 승자를 상위 노드로 올리고, 상위 경기의 상대가 이미 정해져 있으면
+ * 그 경기를 시작 가능 목록에 추가 (O(1))
+ * @param winner: 승자 참가자 번호 (경기의 두 참가자 중 하나)
+ * @return: 성공 시 0, 잘못된 결과면 -1
+ */
+int tournament_record_result(Tournament *t, int match, int winner);
+
+/**
+ * 경기의 라운드 번호 (1 = 1라운드, rounds = 결승)
+ */
+int tournament_match_round(const Tournament *t, int match);
+
+/**
+ * 참가자가 다음에 치를 경기 노드 (탈락했거나 우승했으면 -1)
+ */
+int tournament_entrant_next_match(const Tournament *t, int entrant);
+
+/**
+ * 우승자 참가자 번호 (아직 미정이면 -1)
+ */
+int tournament_champion(const Tournament *t);
+
+#endif // BASEBALL_TOURNAMENT_H